@@ -222,10 +222,11 @@ void Engine::Get(const std::string &variableName,
 template <class T>
 void Engine::Get(Variable<T> variable, T **data) const
 {
-    if (m_Engine->m_EngineType != "InlineReader")
+    if (m_Engine->m_EngineType != "InlineReader" &&
+        m_Engine->m_EngineType != "InlineShmReader")
     {
-        throw std::domain_error(
-            "Get calls with T** are only supported with the InlineReader.");
+        throw std::domain_error("Get calls with T** are only supported with "
+                                "the InlineReader and InlineShmReader.");
     }
 
     using IOType = typename TypeInfo<T>::IOType;
@@ -354,6 +354,7 @@ constexpr char accuracy[] = "accuracy";
 constexpr char backend[] = "backend";
 constexpr char rate[] = "rate";
 constexpr char precision[] = "precision";
+constexpr char threads[] = "threads";
 }
 
 namespace value
@@ -470,6 +471,31 @@ constexpr char blockSize100k_9[] = "9";
 } // end namespace bzip2
 #endif
 
+// SHUFFLE PARAMETERS, always available
+
+constexpr char LosslessShuffle[] = "shuffle";
+namespace shuffle
+{
+
+namespace key
+{
+constexpr char predictor[] = "predictor";
+constexpr char dimension[] = "dimension";
+constexpr char shuffle[] = "shuffle";
+constexpr char compressor[] = "compressor";
+}
+
+namespace value
+{
+constexpr char predictor_none[] = "none";
+constexpr char predictor_delta[] = "delta";
+constexpr char predictor_xor[] = "xor";
+
+constexpr char compressor_none[] = "none";
+} // end namespace value
+
+} // end namespace shuffle
+
 // BBlosc PARAMETERS
 #ifdef ADIOS2_HAVE_BLOSC
 
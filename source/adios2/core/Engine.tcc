@@ -16,6 +16,9 @@
 #include <stdexcept>
 
 #include "adios2/engine/inline/InlineReader.h"
+#ifdef ADIOS2_HAVE_SYSVSHMEM
+#include "adios2/engine/inlineshm/InlineShmReader.h"
+#endif
 #include "adios2/helper/adiosFunctions.h" // CheckforNullptr
 
 namespace adios2
@@ -146,14 +149,21 @@ void Engine::Get(core::Variable<T> &variable, T **data) const
     if (eng)
     {
         eng->Get(variable, data);
+        return;
     }
-    else
+#ifdef ADIOS2_HAVE_SYSVSHMEM
+    const auto *shmEng =
+        dynamic_cast<const adios2::core::engine::InlineShmReader *>(this);
+    if (shmEng)
     {
-        helper::Throw<std::runtime_error>(
-            "Core", "Engine", "Get",
-            "Engine " + m_EngineType +
-                " does not support Get(core::Variable<T>&, T**)");
+        shmEng->Get(variable, data);
+        return;
     }
+#endif
+    helper::Throw<std::runtime_error>(
+        "Core", "Engine", "Get",
+        "Engine " + m_EngineType +
+            " does not support Get(core::Variable<T>&, T**)");
 }
 
 template <class T>
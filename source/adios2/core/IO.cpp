@@ -28,6 +28,10 @@
 #endif
 #include "adios2/engine/inline/InlineReader.h"
 #include "adios2/engine/inline/InlineWriter.h"
+#ifdef ADIOS2_HAVE_SYSVSHMEM
+#include "adios2/engine/inlineshm/InlineShmReader.h"
+#include "adios2/engine/inlineshm/InlineShmWriter.h"
+#endif
 #include "adios2/engine/mhs/MhsReader.h"
 #include "adios2/engine/mhs/MhsWriter.h"
 #include "adios2/engine/null/NullReader.h"
@@ -125,6 +129,15 @@ std::unordered_map<std::string, IO::EngineFactoryEntry> Factory = {
     {"inline",
      {IO::MakeEngine<engine::InlineReader>,
       IO::MakeEngine<engine::InlineWriter>}},
+    {"inlineshm",
+#ifdef ADIOS2_HAVE_SYSVSHMEM
+     {IO::MakeEngine<engine::InlineShmReader>,
+      IO::MakeEngine<engine::InlineShmWriter>}
+#else
+     IO::NoEngineEntry("ERROR: this version didn't compile with "
+                       "SysV shared memory, can't use InlineShm engine\n")
+#endif
+    },
     {"null",
      {IO::MakeEngine<engine::NullReader>, IO::MakeEngine<engine::NullWriter>}},
     {"nullcore",
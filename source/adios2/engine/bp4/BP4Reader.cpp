@@ -13,8 +13,12 @@
 
 #include <adios2-perfstubs-interface.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <errno.h>
+#include <future>
+#include <mutex>
 
 namespace adios2
 {
@@ -151,6 +155,11 @@ void BP4Reader::PerformGets()
         return;
     }
 
+    // the reads of all variables are ordered and shared among threads
+    const bool threaded = (m_BP4Deserializer.m_Parameters.Threads > 1);
+    std::vector<BlockRead> reads;
+    std::vector<std::function<void()>> clearBlocksInfo;
+
     for (const std::string &name : m_BP4Deserializer.m_DeferredVariables)
     {
         const DataType type = m_IO.InquireVariableType(name);
@@ -167,17 +176,185 @@ void BP4Reader::PerformGets()
         {                                                                      \
             m_BP4Deserializer.SetVariableBlockInfo(variable, blockInfo);       \
         }                                                                      \
-        ReadVariableBlocks(variable);                                          \
-        variable.m_BlocksInfo.clear();                                         \
+        if (threaded)                                                          \
+        {                                                                      \
+            AddBlockReads(variable, reads);                                    \
+            clearBlocksInfo.push_back(                                         \
+                [&variable]() { variable.m_BlocksInfo.clear(); });             \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            ReadVariableBlocks(variable);                                      \
+            variable.m_BlocksInfo.clear();                                     \
+        }                                                                      \
     }
         ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
     }
 
+    if (threaded)
+    {
+        ReadBlocks(reads);
+        for (auto &clear : clearBlocksInfo)
+        {
+            clear();
+        }
+    }
     m_BP4Deserializer.m_DeferredVariables.clear();
 }
 
 // PRIVATE
+void BP4Reader::OpenSubFile(transportman::TransportMan &fileManager,
+                            const size_t subStreamID)
+{
+    // check if subfile is already opened
+    if (fileManager.m_Transports.count(subStreamID) > 0)
+    {
+        return;
+    }
+    const bool profile = m_BP4Deserializer.m_Profiler.m_IsActive;
+    const std::string subFileName = m_BP4Deserializer.GetBPSubFileName(
+        m_Name, subStreamID, m_BP4Deserializer.m_Minifooter.HasSubFiles, true);
+
+    std::string library;
+    helper::SetParameterValue("Library", m_IO.m_TransportsParameters[0],
+                              library);
+    helper::SetParameterValue("library", m_IO.m_TransportsParameters[0],
+                              library);
+    if (library == "Daos" || library == "daos")
+    {
+        fileManager.OpenFileID(subFileName, subStreamID, Mode::Read,
+                               {{"transport", "File"}, {"library", "daos"}},
+                               profile);
+    }
+    else
+    {
+        fileManager.OpenFileID(subFileName, subStreamID, Mode::Read,
+                               {{"transport", "File"}}, profile);
+    }
+}
+
+void BP4Reader::ReadBlocks(std::vector<BlockRead> &reads)
+{
+    /* payloads closer than this, e.g. separated by the header of the next
+     * block, are read together up to a size of maxCombinedSize */
+    constexpr size_t maxGap = 4096;
+    constexpr size_t maxCombinedSize = 16 * 1024 * 1024;
+
+    std::sort(reads.begin(), reads.end(),
+              [](const BlockRead &a, const BlockRead &b) {
+                  return (a.SubStreamID < b.SubStreamID) ||
+                         ((a.SubStreamID == b.SubStreamID) &&
+                          (a.PayloadOffset < b.PayloadOffset));
+              });
+    // reads [First, End) done with a single ReadFile
+    struct Run
+    {
+        size_t First;
+        size_t End;
+        size_t Offset;
+        size_t Size;
+    };
+    // with several threads, runs are also kept small enough to give every
+    // thread a share of the reads and of the decompression
+    size_t runLimit = maxCombinedSize;
+    const size_t nThreads = m_BP4Deserializer.m_Parameters.Threads;
+    if (nThreads > 1)
+    {
+        size_t total = 0;
+        for (const auto &read : reads)
+        {
+            total += read.PayloadSize;
+        }
+        runLimit = std::min(runLimit, std::max<size_t>(total / nThreads, 1));
+    }
+    std::vector<Run> runs;
+    for (size_t i = 0; i < reads.size(); ++i)
+    {
+        const BlockRead &read = reads[i];
+        if (!runs.empty())
+        {
+            Run &run = runs.back();
+            const size_t readEnd = read.PayloadOffset + read.PayloadSize;
+            if ((read.SubStreamID == reads[run.First].SubStreamID) &&
+                (read.PayloadOffset <= run.Offset + run.Size + maxGap) &&
+                (readEnd - run.Offset <= runLimit))
+            {
+                run.End = i + 1;
+                run.Size = std::max(run.Size, readEnd - run.Offset);
+                continue;
+            }
+        }
+        runs.push_back({i, i + 1, read.PayloadOffset, read.PayloadSize});
+    }
+
+    const size_t threads = std::min(nThreads, runs.size());
+    for (size_t t = 0; t < threads; ++t)
+    {
+        // created here, threads only use their own
+        m_BP4Deserializer.m_ThreadBuffers[t][0];
+        m_BP4Deserializer.m_ThreadBuffers[t][1];
+    }
+
+    size_t nextRun = 0;
+    std::mutex nextRunMutex;
+    auto lf_Read = [&](transportman::TransportMan &fileManager,
+                       const size_t threadID) {
+        std::vector<char> combined;
+        while (true)
+        {
+            size_t r;
+            {
+                std::lock_guard<std::mutex> lock(nextRunMutex);
+                if (nextRun == runs.size())
+                {
+                    break;
+                }
+                r = nextRun++;
+            }
+            const Run &run = runs[r];
+            const BlockRead &first = reads[run.First];
+            OpenSubFile(fileManager, first.SubStreamID);
+            if (run.End - run.First == 1)
+            {
+                char *buffer = first.PreDataRead(threadID);
+                fileManager.ReadFile(buffer, first.PayloadSize,
+                                     first.PayloadOffset, first.SubStreamID);
+                first.PostDataRead(threadID);
+                continue;
+            }
+            combined.resize(run.Size);
+            fileManager.ReadFile(combined.data(), run.Size, run.Offset,
+                                 first.SubStreamID);
+            for (size_t i = run.First; i < run.End; ++i)
+            {
+                char *buffer = reads[i].PreDataRead(threadID);
+                std::memcpy(buffer,
+                            combined.data() + reads[i].PayloadOffset -
+                                run.Offset,
+                            reads[i].PayloadSize);
+                reads[i].PostDataRead(threadID);
+            }
+        }
+    };
+
+    helper::Comm singleComm;
+    std::vector<transportman::TransportMan> fileManagers(
+        threads > 1 ? threads - 1 : 0, transportman::TransportMan(singleComm));
+    std::vector<std::future<void>> futures;
+    for (size_t t = 1; t < threads; ++t)
+    {
+        futures.push_back(std::async(std::launch::async, lf_Read,
+                                     std::ref(fileManagers[t - 1]), t));
+    }
+    // the main thread reads with the handles kept open between calls
+    lf_Read(m_DataFileManager, 0);
+    for (auto &f : futures)
+    {
+        f.get();
+    }
+}
+
 void BP4Reader::Init()
 {
     if (m_OpenMode != Mode::Read)
@@ -18,6 +18,9 @@
 #include "adios2/toolkit/format/bp/bp4/BP4Deserializer.h"
 #include "adios2/toolkit/transportman/TransportMan.h"
 
+#include <functional>
+#include <vector>
+
 namespace adios2
 {
 namespace core
@@ -166,6 +169,28 @@ private:
     template <class T>
     void ReadVariableBlocks(Variable<T> &variable);
 
+    /** A read of a box of a block from a subfile, for ReadBlocks */
+    struct BlockRead
+    {
+        size_t SubStreamID;
+        size_t PayloadOffset;
+        size_t PayloadSize;
+        /** the deserializer buffer of threadID to read the payload into */
+        std::function<char *(const size_t threadID)> PreDataRead;
+        /** put the payload read into the destination of the Get */
+        std::function<void(const size_t threadID)> PostDataRead;
+    };
+
+    template <class T>
+    void AddBlockReads(Variable<T> &variable, std::vector<BlockRead> &reads);
+
+    /** Read on up to Threads threads, each with its own subfile handles, in
+     * order of subfile and offset, adjacent payloads in a single read */
+    void ReadBlocks(std::vector<BlockRead> &reads);
+
+    void OpenSubFile(transportman::TransportMan &fileManager,
+                     const size_t subStreamID);
+
 #define declare_type(T)                                                        \
     std::map<size_t, std::vector<typename Variable<T>::BPInfo>>                \
     DoAllStepsBlocksInfo(const Variable<T> &variable) const final;             \
@@ -63,7 +63,13 @@ void BP4Reader::GetDeferredCommon(Variable<T> &variable, T *data)
 template <class T>
 void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
 {
-    const bool profile = m_BP4Deserializer.m_Profiler.m_IsActive;
+    if (m_BP4Deserializer.m_Parameters.Threads > 1)
+    {
+        std::vector<BlockRead> reads;
+        AddBlockReads(variable, reads);
+        ReadBlocks(reads);
+        return;
+    }
 
     for (typename Variable<T>::BPInfo &blockInfo : variable.m_BlocksInfo)
     {
@@ -79,36 +85,7 @@ void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
                     continue;
                 }
 
-                // check if subfile is already opened
-                if (m_DataFileManager.m_Transports.count(
-                        subStreamBoxInfo.SubStreamID) == 0)
-                {
-                    const std::string subFileName =
-                        m_BP4Deserializer.GetBPSubFileName(
-                            m_Name, subStreamBoxInfo.SubStreamID,
-                            m_BP4Deserializer.m_Minifooter.HasSubFiles, true);
-
-                    std::string library;
-                    helper::SetParameterValue(
-                        "Library", m_IO.m_TransportsParameters[0], library);
-                    helper::SetParameterValue(
-                        "library", m_IO.m_TransportsParameters[0], library);
-                    if (library == "Daos" || library == "daos")
-                    {
-
-                        m_DataFileManager.OpenFileID(
-                            subFileName, subStreamBoxInfo.SubStreamID,
-                            Mode::Read,
-                            {{"transport", "File"}, {"library", "daos"}},
-                            profile);
-                    }
-                    else
-                    {
-                        m_DataFileManager.OpenFileID(
-                            subFileName, subStreamBoxInfo.SubStreamID,
-                            Mode::Read, {{"transport", "File"}}, profile);
-                    }
-                }
+                OpenSubFile(m_DataFileManager, subStreamBoxInfo.SubStreamID);
 
                 char *buffer = nullptr;
                 size_t payloadSize = 0, payloadStart = 0;
@@ -131,6 +108,59 @@ void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
     } // deferred blocks loop
 }
 
+template <class T>
+void BP4Reader::AddBlockReads(Variable<T> &variable,
+                              std::vector<BlockRead> &reads)
+{
+    const bool isRowMajor = (m_IO.m_ArrayOrder == ArrayOrdering::RowMajor);
+    for (typename Variable<T>::BPInfo &blockInfo : variable.m_BlocksInfo)
+    {
+        /* what PostDataRead uses of blockInfo, with Data of each step,
+         * as the steps are not read in order */
+        typename Variable<T>::BPInfo stepInfo;
+        stepInfo.Start = blockInfo.Start;
+        stepInfo.Count = blockInfo.Count;
+        stepInfo.Operations = blockInfo.Operations;
+        stepInfo.IsGPU = blockInfo.IsGPU;
+        stepInfo.Data = blockInfo.Data;
+
+        for (const auto &stepPair : blockInfo.StepBlockSubStreamsInfo)
+        {
+            for (const helper::SubStreamBoxInfo &subStreamBoxInfo :
+                 stepPair.second)
+            {
+                if (subStreamBoxInfo.ZeroBlock)
+                {
+                    continue;
+                }
+                BlockRead read;
+                read.SubStreamID = subStreamBoxInfo.SubStreamID;
+                m_BP4Deserializer.DataReadRange(
+                    subStreamBoxInfo, read.PayloadSize, read.PayloadOffset);
+                read.PreDataRead = [this, &variable, &blockInfo,
+                                    &subStreamBoxInfo](const size_t threadID) {
+                    char *buffer = nullptr;
+                    size_t payloadSize = 0, payloadStart = 0;
+                    m_BP4Deserializer.PreDataRead(
+                        variable, blockInfo, subStreamBoxInfo, buffer,
+                        payloadSize, payloadStart, threadID);
+                    return buffer;
+                };
+                read.PostDataRead = [this, &variable, stepInfo,
+                                     &subStreamBoxInfo, isRowMajor](
+                                        const size_t threadID) mutable {
+                    m_BP4Deserializer.PostDataRead(variable, stepInfo,
+                                                   subStreamBoxInfo,
+                                                   isRowMajor, threadID);
+                };
+                reads.push_back(std::move(read));
+            } // substreams loop
+            // advance pointer to next step
+            stepInfo.Data += helper::GetTotalSize(blockInfo.Count);
+        } // steps loop
+    }     // deferred blocks loop
+}
+
 } // end namespace engine
 } // end namespace core
 } // end namespace adios2
@@ -14,6 +14,7 @@
 #include "adios2/common/ADIOSMacros.h"
 #include "adios2/core/IO.h"
 #include "adios2/helper/adiosFunctions.h" //CheckIndexRange
+#include "adios2/toolkit/burstbuffer/FileDrainerMultiThread.h"
 #include "adios2/toolkit/transport/file/FileFStream.h"
 #include <adios2-perfstubs-interface.h>
 
@@ -31,7 +32,7 @@ BP4Writer::BP4Writer(IO &io, const std::string &name, const Mode mode,
                      helper::Comm comm)
 : Engine("BP4Writer", io, name, mode, std::move(comm)), m_BP4Serializer(m_Comm),
   m_FileDataManager(m_Comm), m_FileMetadataManager(m_Comm),
-  m_FileMetadataIndexManager(m_Comm), m_FileDrainer()
+  m_FileMetadataIndexManager(m_Comm)
 {
     PERFSTUBS_SCOPED_TIMER("BP4Writer::Open");
     helper::GetParameter(m_IO.m_Parameters, "Verbose", m_Verbosity);
@@ -199,6 +200,23 @@ void BP4Writer::InitParameters()
                                  "in call to BP4::Open to write");
     m_WriteToBB = !(m_BP4Serializer.m_Parameters.BurstBufferPath.empty());
     m_DrainBB = m_WriteToBB && m_BP4Serializer.m_Parameters.BurstBufferDrain;
+    if (m_DrainBB)
+    {
+        const auto &params = m_BP4Serializer.m_Parameters;
+#ifndef _WIN32
+        if (params.BurstBufferDrainThreads > 1 ||
+            params.BurstBufferDrainBandwidth > 0.0)
+        {
+            m_FileDrainer.reset(new burstbuffer::FileDrainerMultiThread(
+                params.BurstBufferDrainThreads,
+                params.BurstBufferDrainBandwidth * 1048576.0));
+        }
+        else
+#endif
+        {
+            m_FileDrainer.reset(new burstbuffer::FileDrainerSingleThread());
+        }
+    }
 }
 
 void BP4Writer::InitTransports()
@@ -236,10 +254,10 @@ void BP4Writer::InitTransports()
             m_DrainSubStreamNames =
                 m_BP4Serializer.GetBPSubStreamNames(drainTransportNames);
             /* start up BB thread */
-            m_FileDrainer.SetVerbose(
+            m_FileDrainer->SetVerbose(
                 m_BP4Serializer.m_Parameters.BurstBufferVerbose,
                 m_BP4Serializer.m_RankMPI);
-            m_FileDrainer.Start();
+            m_FileDrainer->Start();
         }
     }
 
@@ -279,7 +297,7 @@ void BP4Writer::InitTransports()
         {
             for (const auto &name : m_DrainSubStreamNames)
             {
-                m_FileDrainer.AddOperationOpen(name, m_OpenMode);
+                m_FileDrainer->AddOperationOpen(name, m_OpenMode);
             }
         }
     }
@@ -323,11 +341,11 @@ void BP4Writer::InitTransports()
 
             for (const auto &name : m_DrainMetadataFileNames)
             {
-                m_FileDrainer.AddOperationOpen(name, m_OpenMode);
+                m_FileDrainer->AddOperationOpen(name, m_OpenMode);
             }
             for (const auto &name : m_DrainMetadataIndexFileNames)
             {
-                m_FileDrainer.AddOperationOpen(name, m_OpenMode);
+                m_FileDrainer->AddOperationOpen(name, m_OpenMode);
             }
         }
         //}
@@ -482,7 +500,7 @@ void BP4Writer::DoClose(const int transportIndex)
         {
             for (const auto &name : m_SubStreamNames)
             {
-                m_FileDrainer.AddOperationDelete(name);
+                m_FileDrainer->AddOperationDelete(name);
             }
         }
     }
@@ -519,18 +537,18 @@ void BP4Writer::DoClose(const int transportIndex)
         {
             for (const auto &name : m_MetadataFileNames)
             {
-                m_FileDrainer.AddOperationDelete(name);
+                m_FileDrainer->AddOperationDelete(name);
             }
             for (const auto &name : m_MetadataIndexFileNames)
             {
-                m_FileDrainer.AddOperationDelete(name);
+                m_FileDrainer->AddOperationDelete(name);
             }
             const std::vector<std::string> transportsNames =
                 m_FileDataManager.GetFilesBaseNames(
                     m_BBName, m_IO.m_TransportsParameters);
             for (const auto &name : transportsNames)
             {
-                m_FileDrainer.AddOperationDelete(name);
+                m_FileDrainer->AddOperationDelete(name);
             }
         }
     }
@@ -538,7 +556,7 @@ void BP4Writer::DoClose(const int transportIndex)
     if (m_BP4Serializer.m_Aggregator.m_IsAggregator && m_DrainBB)
     {
         /* Signal the BB thread that no more work is coming */
-        m_FileDrainer.Finish();
+        m_FileDrainer->Finish();
     }
     // m_BP4Serializer.DeleteBuffers();
 }
@@ -592,7 +610,7 @@ void BP4Writer::WriteProfilingJSONFile()
             {
                 profileFileName = bpTargetNames[0] + "_profiling.json";
             }
-            m_FileDrainer.AddOperationWrite(
+            m_FileDrainer->AddOperationWrite(
                 profileFileName, profilingJSON.size(), profilingJSON.data());
         }
         else
@@ -647,10 +665,11 @@ void BP4Writer::UpdateActiveFlag(const bool active)
     {
         for (size_t i = 0; i < m_MetadataIndexFileNames.size(); ++i)
         {
-            m_FileDrainer.AddOperationWriteAt(
+            m_FileDrainer->AddOperationWriteAt(
                 m_DrainMetadataIndexFileNames[i],
                 m_BP4Serializer.m_ActiveFlagPosition, 1, &activeChar);
-            m_FileDrainer.AddOperationSeekEnd(m_DrainMetadataIndexFileNames[i]);
+            m_FileDrainer->AddOperationSeekEnd(
+                m_DrainMetadataIndexFileNames[i]);
         }
     }
 }
@@ -681,7 +700,7 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
         {
             for (size_t i = 0; i < m_MetadataFileNames.size(); ++i)
             {
-                m_FileDrainer.AddOperationCopy(
+                m_FileDrainer->AddOperationCopy(
                     m_MetadataFileNames[i], m_DrainMetadataFileNames[i],
                     m_BP4Serializer.m_Metadata.m_Position);
             }
@@ -744,7 +763,7 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
         {
             for (size_t i = 0; i < m_MetadataIndexFileNames.size(); ++i)
             {
-                m_FileDrainer.AddOperationWrite(
+                m_FileDrainer->AddOperationWrite(
                     m_DrainMetadataIndexFileNames[i],
                     m_BP4Serializer.m_MetadataIndex.m_Position,
                     m_BP4Serializer.m_MetadataIndex.m_Buffer.data());
@@ -777,16 +796,18 @@ void BP4Writer::WriteData(const bool isFinal, const int transportIndex)
         dataSize = m_BP4Serializer.CloseStream(m_IO, false);
     }
 
-    m_FileDataManager.WriteFiles(m_BP4Serializer.m_Data.m_Buffer.data(),
-                                 dataSize, transportIndex);
+    const std::vector<core::iovec> dataVec = m_BP4Serializer.DataVec();
+    m_FileDataManager.WriteFiles(dataVec.data(), dataVec.size(),
+                                 transportIndex);
+    m_BP4Serializer.ReleaseDataChunks();
 
     m_FileDataManager.FlushFiles(transportIndex);
     if (m_DrainBB)
     {
         for (size_t i = 0; i < m_SubStreamNames.size(); ++i)
         {
-            m_FileDrainer.AddOperationCopy(m_SubStreamNames[i],
-                                           m_DrainSubStreamNames[i], dataSize);
+            m_FileDrainer->AddOperationCopy(m_SubStreamNames[i],
+                                            m_DrainSubStreamNames[i], dataSize);
         }
     }
 }
@@ -796,49 +817,88 @@ void BP4Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
     PERFSTUBS_SCOPED_TIMER("BP4Writer::AggregateWriteData");
     m_BP4Serializer.CloseStream(m_IO, false);
     size_t totalBytesWritten = 0;
-    const size_t dataBufferSize = m_BP4Serializer.m_Data.m_Position;
 
-    // async?
-    for (int r = 0; r < m_BP4Serializer.m_Aggregator.m_Size; ++r)
+    if (m_BP4Serializer.m_Aggregator.m_IsAggregator)
     {
-        aggregator::MPIChain::ExchangeRequests dataRequests =
-            m_BP4Serializer.m_Aggregator.IExchange(m_BP4Serializer.m_Data, r);
-
-        aggregator::MPIChain::ExchangeAbsolutePositionRequests
-            absolutePositionRequests =
-                m_BP4Serializer.m_Aggregator.IExchangeAbsolutePosition(
-                    m_BP4Serializer.m_Data, r);
-
-        if (m_BP4Serializer.m_Aggregator.m_IsAggregator)
+        // the sealed data chunks go first, the aggregation writes the last
+        const std::vector<core::iovec> dataVec = m_BP4Serializer.DataVec();
+        if (dataVec.size() > 1)
         {
-            const format::Buffer &bufferSTL =
-                m_BP4Serializer.m_Aggregator.GetConsumerBuffer(
-                    m_BP4Serializer.m_Data);
-            if (bufferSTL.m_Position > 0)
+            m_FileDataManager.WriteFiles(dataVec.data(), dataVec.size() - 1,
+                                         transportIndex);
+            for (size_t i = 0; i + 1 < dataVec.size(); ++i)
             {
-                m_FileDataManager.WriteFiles(
-                    bufferSTL.Data(), bufferSTL.m_Position, transportIndex);
+                totalBytesWritten += dataVec[i].iov_len;
+            }
+        }
+    }
+    else
+    {
+        // the data is sent to the aggregator in one message
+        m_BP4Serializer.JoinDataChunks();
+    }
+    m_BP4Serializer.ReleaseDataChunks();
+    const size_t dataBufferSize = m_BP4Serializer.m_Data.m_Position;
 
+    if (m_BP4Serializer.m_Parameters.AggregationFanIn > 0)
+    {
+        m_BP4Serializer.m_Profiler.Start("aggregation");
+        m_BP4Serializer.m_Aggregator.TreeAggregate(
+            m_BP4Serializer.m_Data,
+            m_BP4Serializer.m_Parameters.AggregationFanIn,
+            m_BP4Serializer.m_Parameters.AggregationBuffers,
+            [&](const char *data, size_t size) {
+                m_FileDataManager.WriteFiles(data, size, transportIndex);
                 m_FileDataManager.FlushFiles(transportIndex);
+                totalBytesWritten += size;
+            },
+            m_BP4Serializer.m_Profiler);
+        m_BP4Serializer.m_Profiler.Stop("aggregation");
+    }
+    else
+    {
+        for (int r = 0; r < m_BP4Serializer.m_Aggregator.m_Size; ++r)
+        {
+            aggregator::MPIChain::ExchangeRequests dataRequests =
+                m_BP4Serializer.m_Aggregator.IExchange(m_BP4Serializer.m_Data,
+                                                       r);
 
-                totalBytesWritten += bufferSTL.m_Position;
+            aggregator::MPIChain::ExchangeAbsolutePositionRequests
+                absolutePositionRequests =
+                    m_BP4Serializer.m_Aggregator.IExchangeAbsolutePosition(
+                        m_BP4Serializer.m_Data, r);
+
+            if (m_BP4Serializer.m_Aggregator.m_IsAggregator)
+            {
+                const format::Buffer &bufferSTL =
+                    m_BP4Serializer.m_Aggregator.GetConsumerBuffer(
+                        m_BP4Serializer.m_Data);
+                if (bufferSTL.m_Position > 0)
+                {
+                    m_FileDataManager.WriteFiles(
+                        bufferSTL.Data(), bufferSTL.m_Position, transportIndex);
+
+                    m_FileDataManager.FlushFiles(transportIndex);
+
+                    totalBytesWritten += bufferSTL.m_Position;
+                }
             }
-        }
 
-        m_BP4Serializer.m_Aggregator.WaitAbsolutePosition(
-            absolutePositionRequests, r);
+            m_BP4Serializer.m_Aggregator.WaitAbsolutePosition(
+                absolutePositionRequests, r);
 
-        m_BP4Serializer.m_Aggregator.Wait(dataRequests, r);
-        m_BP4Serializer.m_Aggregator.SwapBuffers(r);
+            m_BP4Serializer.m_Aggregator.Wait(dataRequests, r);
+            m_BP4Serializer.m_Aggregator.SwapBuffers(r);
+        }
     }
 
     if (m_DrainBB)
     {
         for (size_t i = 0; i < m_SubStreamNames.size(); ++i)
         {
-            m_FileDrainer.AddOperationCopy(m_SubStreamNames[i],
-                                           m_DrainSubStreamNames[i],
-                                           totalBytesWritten);
+            m_FileDrainer->AddOperationCopy(m_SubStreamNames[i],
+                                            m_DrainSubStreamNames[i],
+                                            totalBytesWritten);
         }
     }
 
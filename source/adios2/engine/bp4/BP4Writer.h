@@ -73,7 +73,7 @@ private:
     /** true if burst buffer is drained to disk  */
     bool m_DrainBB = true;
     /** File drainer thread if burst buffer is used */
-    burstbuffer::FileDrainerSingleThread m_FileDrainer;
+    std::unique_ptr<burstbuffer::FileDrainer> m_FileDrainer;
     /** m_Name modified with burst buffer path if BB is used,
      * == m_Name otherwise.
      * m_Name is a constant of Engine and is the user provided target path
@@ -93,6 +93,11 @@ void BP4Writer::PutSyncCommon(Variable<T> &variable,
     {
         DoFlush(false);
         m_BP4Serializer.ResetBuffer(m_BP4Serializer.m_Data, false, false);
+        m_BP4Serializer.ResizeBuffer(
+            helper::PayloadSize(blockInfo.Data, blockInfo.Count) +
+                m_BP4Serializer.GetBPIndexSizeInData(variable.m_Name,
+                                                     blockInfo.Count),
+            "in call to variable " + variable.m_Name + " Put");
 
         // new group index for incoming variable
         m_BP4Serializer.PutProcessGroupIndex(
@@ -130,8 +135,7 @@ T *BP4Writer::BufferDataCommon(const int /*bufferIdx*/,
                                const size_t payloadPosition,
                                const size_t /*bufferID*/) noexcept
 {
-    T *data = reinterpret_cast<T *>(m_BP4Serializer.m_Data.m_Buffer.data() +
-                                    payloadPosition);
+    T *data = reinterpret_cast<T *>(m_BP4Serializer.DataAt(payloadPosition));
     return data;
 }
 
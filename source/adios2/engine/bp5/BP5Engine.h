@@ -63,6 +63,7 @@ public:
     static constexpr size_t m_BPMinorVersionPosition = 38;
     static constexpr size_t m_ActiveFlagPosition = 39;
     static constexpr size_t m_ColumnMajorFlagPosition = 40;
+    static constexpr size_t m_KeyframeIntervalPosition = 41;
     static constexpr size_t m_VersionTagPosition = 0;
     static constexpr size_t m_VersionTagLength = 32;
 
@@ -134,13 +135,21 @@ public:
     MACRO(StreamReader, Bool, bool, false)                                     \
     MACRO(BurstBufferDrain, Bool, bool, true)                                  \
     MACRO(BurstBufferPath, String, std::string, "")                            \
+    MACRO(BurstBufferDrainThreads, UInt, unsigned int, 1)                      \
+    MACRO(BurstBufferDrainBandwidth, Float, float, 0.0f)                       \
     MACRO(NodeLocal, Bool, bool, false)                                        \
     MACRO(verbose, Int, int, 0)                                                \
     MACRO(CollectiveMetadata, Bool, bool, true)                                \
     MACRO(NumAggregators, UInt, unsigned int, 0)                               \
     MACRO(AggregatorRatio, UInt, unsigned int, 0)                              \
     MACRO(NumSubFiles, UInt, unsigned int, 0)                                  \
+    MACRO(AdaptiveAggregation, Bool, bool, false)                              \
+    MACRO(AdaptiveSteps, UInt, unsigned int, 4)                                \
+    MACRO(AdaptiveTargetBandwidth, Float, float, 0.0f)                         \
     MACRO(StripeSize, UInt, unsigned int, 4096)                                \
+    MACRO(FileStripeCount, UInt, unsigned int, 0)                              \
+    MACRO(FileStripeSize, SizeBytes, size_t, 0)                                \
+    MACRO(AlignToFileStripes, Bool, bool, false)                               \
     MACRO(DirectIO, Bool, bool, false)                                         \
     MACRO(DirectIOAlignOffset, UInt, unsigned int, 512)                        \
     MACRO(DirectIOAlignBuffer, UInt, unsigned int, 0)                          \
@@ -158,8 +167,14 @@ public:
     MACRO(SelectSteps, String, std::string, "")                                \
     MACRO(ReaderShortCircuitReads, Bool, bool, false)                          \
     MACRO(StatsLevel, UInt, unsigned int, 1)                                   \
+    MACRO(MetadataDelta, Bool, bool, false)                                    \
+    MACRO(OperatorChunkSize, SizeBytes, size_t, 0)                             \
+    MACRO(OperatorChunkThreads, UInt, unsigned int, 1)                         \
+    MACRO(KeyframeInterval, UInt, unsigned int, 0)                             \
+    MACRO(KeyframeDeltaRatio, Float, float, 0.5f)                              \
     MACRO(StatsBlockSize, SizeBytes, size_t, DefaultStatsBlockSize)            \
     MACRO(Threads, UInt, unsigned int, 0)                                      \
+    MACRO(MetadataCacheSize, SizeBytes, size_t, 0)                             \
     MACRO(MaxOpenFilesAtOnce, UInt, unsigned int, UINT_MAX)
 
     struct BP5Params
@@ -13,6 +13,7 @@
 #include <adios2-perfstubs-interface.h>
 
 #include <chrono>
+#include <cstring> // memcpy
 #include <errno.h>
 #include <mutex>
 #include <thread>
@@ -57,9 +58,12 @@ void BP5Reader::DestructorClose(bool Verbose) noexcept
     m_IsOpen = false;
 }
 
-void BP5Reader::InstallMetadataForTimestep(size_t Step)
+void BP5Reader::InstallMetadataForTimestep(
+    size_t Step, std::vector<format::BP5Deserializer::MetaDataBlock> *Blocks)
 {
-    size_t pgstart = m_MetadataIndexTable[Step][0];
+    std::vector<char> &Buffer =
+        m_CacheMetadata ? m_MetadataCache[Step].Buffer : m_Metadata.m_Buffer;
+    size_t pgstart = m_CacheMetadata ? 0 : m_MetadataIndexTable[Step][0];
     size_t Position = pgstart + sizeof(uint64_t); // skip total data size
     const uint64_t WriterCount =
         m_WriterMap[m_WriterMapIndex[Step]].WriterCount;
@@ -68,9 +72,13 @@ void BP5Reader::InstallMetadataForTimestep(size_t Step)
     {
         // variable metadata for timestep
         size_t ThisMDSize = helper::ReadValue<uint64_t>(
-            m_Metadata.m_Buffer, Position, m_Minifooter.IsLittleEndian);
-        char *ThisMD = m_Metadata.m_Buffer.data() + MDPosition;
-        if (m_OpenMode == Mode::ReadRandomAccess)
+            Buffer, Position, m_Minifooter.IsLittleEndian);
+        char *ThisMD = Buffer.data() + MDPosition;
+        if (Blocks)
+        {
+            Blocks->push_back({ThisMD, ThisMDSize, WriterRank, Step});
+        }
+        else if (m_OpenMode == Mode::ReadRandomAccess)
         {
             m_BP5Deserializer->InstallMetaData(ThisMD, ThisMDSize, WriterRank,
                                                Step);
@@ -85,8 +93,8 @@ void BP5Reader::InstallMetadataForTimestep(size_t Step)
     {
         // attribute metadata for timestep
         size_t ThisADSize = helper::ReadValue<uint64_t>(
-            m_Metadata.m_Buffer, Position, m_Minifooter.IsLittleEndian);
-        char *ThisAD = m_Metadata.m_Buffer.data() + MDPosition;
+            Buffer, Position, m_Minifooter.IsLittleEndian);
+        char *ThisAD = Buffer.data() + MDPosition;
         if (ThisADSize > 0)
             m_BP5Deserializer->InstallAttributeData(ThisAD, ThisADSize);
         MDPosition += ThisADSize;
@@ -215,7 +223,20 @@ BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
     size_t DataPosPos = m_MetadataIndexTable[Timestep][3];
     size_t SubfileNum = static_cast<size_t>(
         m_WriterMap[m_WriterMapIndex[Timestep]].RankToSubfile[WriterRank]);
+    size_t InfoStartPos =
+        DataPosPos + (WriterRank * (2 * FlushCount + 1) * sizeof(uint64_t));
+    return ReadDataAt(FileManager, maxOpenFiles, SubfileNum, FlushCount,
+                      m_MetadataIndex.m_Buffer, InfoStartPos, StartOffset,
+                      Length, Destination);
+}
 
+std::pair<double, double>
+BP5Reader::ReadDataAt(adios2::transportman::TransportMan &FileManager,
+                      const size_t maxOpenFiles, const size_t SubfileNum,
+                      const size_t FlushCount, const std::vector<char> &Index,
+                      size_t InfoStartPos, const size_t StartOffset,
+                      const size_t Length, char *Destination)
+{
     // check if subfile is already opened
     TP startSubfile = NOW();
     if (FileManager.m_Transports.count(SubfileNum) == 0)
@@ -237,17 +258,13 @@ BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
        as if all the flushes were in a single contiguous block in file.
     */
     TP startRead = NOW();
-    size_t InfoStartPos =
-        DataPosPos + (WriterRank * (2 * FlushCount + 1) * sizeof(uint64_t));
     size_t SumDataSize = 0; // count in contiguous space
     for (size_t flush = 0; flush < FlushCount; flush++)
     {
-        size_t ThisDataPos =
-            helper::ReadValue<uint64_t>(m_MetadataIndex.m_Buffer, InfoStartPos,
-                                        m_Minifooter.IsLittleEndian);
-        size_t ThisDataSize =
-            helper::ReadValue<uint64_t>(m_MetadataIndex.m_Buffer, InfoStartPos,
-                                        m_Minifooter.IsLittleEndian);
+        size_t ThisDataPos = helper::ReadValue<uint64_t>(
+            Index, InfoStartPos, m_Minifooter.IsLittleEndian);
+        size_t ThisDataSize = helper::ReadValue<uint64_t>(
+            Index, InfoStartPos, m_Minifooter.IsLittleEndian);
 
         if (StartOffset < SumDataSize + ThisDataSize)
         {
@@ -263,7 +280,7 @@ BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
     }
 
     size_t ThisDataPos = helper::ReadValue<uint64_t>(
-        m_MetadataIndex.m_Buffer, InfoStartPos, m_Minifooter.IsLittleEndian);
+        Index, InfoStartPos, m_Minifooter.IsLittleEndian);
     size_t Offset = StartOffset - SumDataSize;
     FileManager.ReadFile(Destination, Length, ThisDataPos + Offset, SubfileNum);
 
@@ -272,6 +289,51 @@ BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
     return std::make_pair(timeSubfile, timeRead);
 }
 
+std::pair<double, double>
+BP5Reader::ReadRequestData(adios2::transportman::TransportMan &FileManager,
+                           const size_t maxOpenFiles,
+                           format::BP5Deserializer::ReadRequest &Req,
+                           std::vector<char> &KeyframeBuffer)
+{
+    std::pair<double, double> t =
+        ReadData(FileManager, maxOpenFiles, Req.WriterRank, Req.Timestep,
+                 Req.StartOffset, Req.ReadLength, Req.DestinationAddr);
+    size_t followOffset, followLength;
+    if (m_BP5Deserializer->GetFollowUpRead(Req, followOffset, followLength))
+    {
+        auto t2 = ReadData(FileManager, maxOpenFiles, Req.WriterRank,
+                           Req.Timestep, followOffset, followLength,
+                           Req.DestinationAddr + Req.ReadLength);
+        t.first += t2.first;
+        t.second += t2.second;
+    }
+    size_t keyStep, keyOffset, keyLength;
+    if (m_BP5Deserializer->GetKeyframeRead(Req, keyStep, keyOffset, keyLength))
+    {
+        auto it = m_KeyframeLocations.find(keyStep);
+        if (it == m_KeyframeLocations.end())
+        {
+            helper::Throw<std::runtime_error>(
+                "Engine", "BP5Reader", "ReadRequestData",
+                "no data locations of keyframe step " +
+                    std::to_string(keyStep) + " of " + m_Name);
+        }
+        const StepDataLocations &loc = it->second;
+        const size_t SubfileNum = static_cast<size_t>(
+            m_WriterMap.at(loc.WriterMapStep).RankToSubfile[Req.WriterRank]);
+        KeyframeBuffer.resize(keyLength);
+        auto t2 = ReadDataAt(FileManager, maxOpenFiles, SubfileNum,
+                             loc.FlushCount, loc.Record,
+                             Req.WriterRank * (2 * loc.FlushCount + 1) *
+                                 sizeof(uint64_t),
+                             keyOffset, keyLength, KeyframeBuffer.data());
+        Req.KeyframeAddr = KeyframeBuffer.data();
+        t.first += t2.first;
+        t.second += t2.second;
+    }
+    return t;
+}
+
 void BP5Reader::PerformGets()
 {
     auto lf_CompareReqSubfile =
@@ -316,6 +378,7 @@ void BP5Reader::PerformGets()
         double subfileTotal = 0.0;
         size_t nReads = 0;
         std::vector<char> buf(maxReadSize);
+        std::vector<char> keyframeBuf;
 
         while (true)
         {
@@ -329,9 +392,8 @@ void BP5Reader::PerformGets()
             {
                 Req.DestinationAddr = buf.data();
             }
-            std::pair<double, double> t = ReadData(
-                FileManager, maxOpenFiles, Req.WriterRank, Req.Timestep,
-                Req.StartOffset, Req.ReadLength, Req.DestinationAddr);
+            std::pair<double, double> t =
+                ReadRequestData(FileManager, maxOpenFiles, Req, keyframeBuf);
 
             TP startCopy = NOW();
             m_BP5Deserializer->FinalizeGet(Req, false);
@@ -354,6 +416,8 @@ void BP5Reader::PerformGets()
         // TP endSort = NOW();
         // sortTime = DURATION(startSort, endSort);
         size_t nThreads = (m_Threads < nRequest ? m_Threads : nRequest);
+        // threads not needed for whole requests decompress their chunks
+        m_BP5Deserializer->m_DecompressThreads = m_Threads / nThreads;
 
         size_t maxOpenFiles = helper::SetWithinLimit(
             (size_t)m_Parameters.MaxOpenFilesAtOnce / nThreads, (size_t)1,
@@ -406,16 +470,16 @@ void BP5Reader::PerformGets()
     {
         size_t maxOpenFiles = helper::SetWithinLimit(
             (size_t)m_Parameters.MaxOpenFilesAtOnce, (size_t)1, MaxSizeT);
+        m_BP5Deserializer->m_DecompressThreads = m_Threads;
         std::vector<char> buf(maxReadSize);
+        std::vector<char> keyframeBuf;
         for (auto &Req : ReadRequests)
         {
             if (!Req.DestinationAddr)
             {
                 Req.DestinationAddr = buf.data();
             }
-            ReadData(m_DataFileManager, maxOpenFiles, Req.WriterRank,
-                     Req.Timestep, Req.StartOffset, Req.ReadLength,
-                     Req.DestinationAddr);
+            ReadRequestData(m_DataFileManager, maxOpenFiles, Req, keyframeBuf);
             m_BP5Deserializer->FinalizeGet(Req, false);
         }
     }
@@ -425,6 +489,7 @@ void BP5Reader::PerformGets()
         std::vector<adios2::format::BP5Deserializer::ReadRequest> empty;
         m_BP5Deserializer->FinalizeGets(empty);
     }
+    TrimMetadataCache();
 
     /*TP end = NOW();
     double t1 = DURATION(start, end);
@@ -486,6 +551,8 @@ void BP5Reader::InitParameters()
         }
     }
 
+    m_CacheMetadata = (m_OpenMode == Mode::ReadRandomAccess) &&
+                      (m_Parameters.MetadataCacheSize > 0);
     m_Threads = m_Parameters.Threads;
     if (m_Threads == 0)
     {
@@ -667,17 +734,20 @@ void BP5Reader::OpenFiles(TimePoint &timeoutInstant, const Seconds &pollSeconds,
 MinVarInfo *BP5Reader::MinBlocksInfo(const VariableBase &Var,
                                      const size_t Step) const
 {
+    TrimMetadataCache();
     return m_BP5Deserializer->MinBlocksInfo(Var, Step);
 }
 
 Dims *BP5Reader::VarShape(const VariableBase &Var, const size_t Step) const
 {
+    TrimMetadataCache();
     return m_BP5Deserializer->VarShape(Var, Step);
 }
 
 bool BP5Reader::VariableMinMax(const VariableBase &Var, const size_t Step,
                                MinMaxStruct &MinMax)
 {
+    TrimMetadataCache();
     return m_BP5Deserializer->VariableMinMax(Var, Step, MinMax);
 }
 
@@ -794,7 +864,12 @@ void BP5Reader::UpdateBuffer(const TimePoint &timeoutInstant,
                 }
             } while (SleepOrQuit(timeoutInstant, pollSeconds));
 
-            if (actualFileSize >= expectedMinFileSize)
+            if (m_CacheMetadata && (actualFileSize >= expectedMinFileSize))
+            {
+                // read by InstallCachedMetadata()
+                m_MDFileAlreadyReadSize = expectedMinFileSize;
+            }
+            else if (actualFileSize >= expectedMinFileSize)
             {
                 m_Metadata.Resize(fileFilteredSize,
                                   "allocating metadata buffer, "
@@ -846,26 +921,158 @@ void BP5Reader::UpdateBuffer(const TimePoint &timeoutInstant,
             }
         }
 
-        // broadcast buffer to all ranks from zero
-        m_Comm.BroadcastVector(m_Metadata.m_Buffer);
+        // broadcast buffer to all ranks from zero, with MetadataCacheSize
+        // every rank reads the metadata of the steps itself
+        if (!m_CacheMetadata)
+        {
+            m_Comm.BroadcastVector(m_Metadata.m_Buffer);
+        }
 
         // broadcast metadata index buffer to all ranks from zero
         m_Comm.BroadcastVector(m_MetaMetadata.m_Buffer);
 
         InstallMetaMetaData(m_MetaMetadata);
 
-        if (m_OpenMode == Mode::ReadRandomAccess)
+        if (m_CacheMetadata)
         {
+            InstallCachedMetadata();
+        }
+        else if (m_OpenMode == Mode::ReadRandomAccess)
+        {
+            // the metadata of all steps is installed on m_Threads threads
+            std::vector<format::BP5Deserializer::MetaDataBlock> Blocks;
             for (size_t Step = 0; Step < m_MetadataIndexTable.size(); Step++)
             {
                 m_BP5Deserializer->SetupForStep(
                     Step, m_WriterMap[m_WriterMapIndex[Step]].WriterCount);
-                InstallMetadataForTimestep(Step);
+                InstallMetadataForTimestep(Step, &Blocks);
             }
+            m_BP5Deserializer->InstallMetaData(Blocks, m_Threads);
         }
     }
 }
 
+void BP5Reader::InstallCachedMetadata()
+{
+    m_BP5Deserializer->m_StepMetaDataAccess = [this](size_t Step) {
+        AccessStepMetadata(Step);
+    };
+    const size_t StepsCount = m_MetadataIndexTable.size();
+    size_t Step = 0;
+    while (Step < StepsCount)
+    {
+        // as many steps as fit in the cache, at least one, are read by rank
+        // 0 from the md.0 ranges in the index and broadcast together
+        size_t EndStep = Step + 1;
+        size_t PartSize = m_MetadataIndexTable[Step][1];
+        while ((EndStep < StepsCount) &&
+               (PartSize + m_MetadataIndexTable[EndStep][1] <=
+                m_Parameters.MetadataCacheSize))
+        {
+            PartSize += m_MetadataIndexTable[EndStep][1];
+            ++EndStep;
+        }
+        std::vector<char> Part;
+        if (m_Comm.Rank() == 0)
+        {
+            Part.resize(PartSize);
+            size_t PartPosition = 0;
+            for (size_t s = Step; s < EndStep; s++)
+            {
+                m_MDFileManager.ReadFile(Part.data() + PartPosition,
+                                         m_MetadataIndexTable[s][1],
+                                         m_MetadataIndexTable[s][4]);
+                PartPosition += m_MetadataIndexTable[s][1];
+            }
+        }
+        m_Comm.BroadcastVector(Part);
+        std::vector<format::BP5Deserializer::MetaDataBlock> Blocks;
+        size_t PartPosition = 0;
+        for (size_t s = Step; s < EndStep; s++)
+        {
+            std::vector<char> &Buffer = NewMetadataCacheEntry(s);
+            std::memcpy(Buffer.data(), Part.data() + PartPosition,
+                        Buffer.size());
+            PartPosition += Buffer.size();
+            m_BP5Deserializer->SetupForStep(
+                s, m_WriterMap[m_WriterMapIndex[s]].WriterCount);
+            InstallMetadataForTimestep(s, &Blocks);
+        }
+        m_BP5Deserializer->InstallMetaData(Blocks, m_Threads);
+        TrimMetadataCache();
+        Step = EndStep;
+    }
+}
+
+std::vector<char> &BP5Reader::NewMetadataCacheEntry(size_t Step)
+{
+    MetadataCacheEntry &Entry = m_MetadataCache[Step];
+    Entry.Buffer.resize(m_MetadataIndexTable[Step][1]);
+    m_MetadataCacheLRU.push_front(Step);
+    Entry.LRUPosition = m_MetadataCacheLRU.begin();
+    m_MetadataCacheBytes += Entry.Buffer.size();
+    return Entry.Buffer;
+}
+
+void BP5Reader::AccessStepMetadata(size_t Step)
+{
+    std::lock_guard<std::mutex> Lock(m_MetadataCacheMutex);
+    auto it = m_MetadataCache.find(Step);
+    if (it != m_MetadataCache.end())
+    {
+        m_MetadataCacheLRU.splice(m_MetadataCacheLRU.begin(),
+                                  m_MetadataCacheLRU, it->second.LRUPosition);
+        return;
+    }
+    // read again by this rank alone, it may be the only one using the step;
+    // only rank 0 has md.0 open after Open, the others open it on first use
+    if (m_MDFileManager.m_Transports.empty())
+    {
+        m_MDFileManager.OpenFiles({GetBPMetadataFileName(m_Name)},
+                                  adios2::Mode::Read,
+                                  m_IO.m_TransportsParameters, false);
+    }
+    std::vector<char> &Buffer = NewMetadataCacheEntry(Step);
+    m_MDFileManager.ReadFile(Buffer.data(), Buffer.size(),
+                             m_MetadataIndexTable[Step][4]);
+    size_t Position = sizeof(uint64_t); // skip total data size
+    const uint64_t WriterCount =
+        m_WriterMap[m_WriterMapIndex[Step]].WriterCount;
+    size_t MDPosition = Position + 2 * sizeof(uint64_t) * WriterCount;
+    for (size_t WriterRank = 0; WriterRank < WriterCount; WriterRank++)
+    {
+        size_t ThisMDSize = helper::ReadValue<uint64_t>(
+            Buffer, Position, m_Minifooter.IsLittleEndian);
+        m_BP5Deserializer->ReinstallMetaData(Buffer.data() + MDPosition,
+                                             ThisMDSize, WriterRank, Step);
+        MDPosition += ThisMDSize;
+    }
+}
+
+void BP5Reader::TrimMetadataCache() const
+{
+    if (!m_CacheMetadata)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> Lock(m_MetadataCacheMutex);
+    auto it = m_MetadataCacheLRU.end();
+    while ((m_MetadataCacheBytes > m_Parameters.MetadataCacheSize) &&
+           (it != m_MetadataCacheLRU.begin()))
+    {
+        --it;
+        if (m_BP5Deserializer->MetaDataInUse(*it))
+        {
+            continue;
+        }
+        m_BP5Deserializer->ReleaseMetaData(*it);
+        auto Entry = m_MetadataCache.find(*it);
+        m_MetadataCacheBytes -= Entry->second.Buffer.size();
+        m_MetadataCache.erase(Entry);
+        it = m_MetadataCacheLRU.erase(it);
+    }
+}
+
 size_t BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL,
                                      const size_t absoluteStartPos,
                                      const bool hasHeader)
@@ -934,6 +1141,10 @@ size_t BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL,
         const uint8_t val = helper::ReadValue<uint8_t>(
             buffer, position, m_Minifooter.IsLittleEndian);
         m_WriterIsRowMajor = val == 'n';
+
+        position = m_KeyframeIntervalPosition;
+        m_KeyframeInterval = helper::ReadValue<uint32_t>(
+            buffer, position, m_Minifooter.IsLittleEndian);
         // move position to first row
         position = m_IndexHeaderSize;
     }
@@ -950,6 +1161,8 @@ size_t BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL,
     uint64_t MetadataPosTotalSkip = 0;
     m_MetadataIndexTable.clear();
     m_FilteredMetadataInfo.clear();
+    // steps before this one can no longer be read
+    const size_t firstAbsStep = m_AbsStepsInFile;
     uint64_t minfo_pos = 0;
     uint64_t minfo_size = 0;
     int n = 0;    // a loop counter for current run4
@@ -1053,8 +1266,18 @@ size_t BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL,
             }
 
             // skip over the writer -> data file offset records
-            position +=
+            const size_t RecordSize =
                 sizeof(uint64_t) * m_LastWriterCount * ((2 * FlushCount) + 1);
+            if (m_KeyframeInterval)
+            {
+                StepDataLocations &loc =
+                    m_KeyframeLocations[m_AbsStepsInFile];
+                loc.WriterMapStep = m_LastMapStep;
+                loc.FlushCount = FlushCount;
+                loc.Record.assign(buffer.begin() + position,
+                                  buffer.begin() + position + RecordSize);
+            }
+            position += RecordSize;
             ++m_AbsStepsInFile;
             ++n;
             break;
@@ -1079,6 +1302,14 @@ size_t BP5Reader::ParseMetadataIndex(format::BufferSTL &bufferSTL,
     {
         m_FilteredMetadataInfo.push_back(std::make_pair(minfo_pos, minfo_size));
     }
+    // and no delta refers to a keyframe further back than this
+    if (firstAbsStep >= m_KeyframeInterval)
+    {
+        m_KeyframeLocations.erase(
+            m_KeyframeLocations.begin(),
+            m_KeyframeLocations.lower_bound(firstAbsStep -
+                                            m_KeyframeInterval + 1));
+    }
 
     return position;
 }
@@ -21,7 +21,10 @@
 #include "adios2/toolkit/transportman/TransportMan.h"
 
 #include <chrono>
+#include <list>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace adios2
@@ -235,12 +238,53 @@ private:
     format::BufferSTL m_Metadata;
 
     void InstallMetaMetaData(format::BufferSTL MetaMetadata);
-    void InstallMetadataForTimestep(size_t Step);
+    /* install the metadata of a step, or only append its variable
+     * metadata blocks to Blocks if that is given */
+    void InstallMetadataForTimestep(
+        size_t Step,
+        std::vector<format::BP5Deserializer::MetaDataBlock> *Blocks = nullptr);
+
+    /* MetadataCacheSize in random access mode: the metadata of a step is
+     * read from md.0 when it is used, the least recently used steps beyond
+     * that size are released again in TrimMetadataCache() */
+    bool m_CacheMetadata = false;
+    struct MetadataCacheEntry
+    {
+        std::vector<char> Buffer;
+        std::list<size_t>::iterator LRUPosition;
+    };
+    mutable std::unordered_map<size_t, MetadataCacheEntry> m_MetadataCache;
+    mutable std::list<size_t> m_MetadataCacheLRU; // most recently used first
+    mutable size_t m_MetadataCacheBytes = 0;
+    mutable std::mutex m_MetadataCacheMutex;
+    // install the indexed steps from their md.0 ranges, read by rank 0 and
+    // broadcast at most MetadataCacheSize at a time
+    void InstallCachedMetadata();
+    std::vector<char> &NewMetadataCacheEntry(size_t Step);
+    // m_StepMetaDataAccess of the deserializer
+    void AccessStepMetadata(size_t Step);
+    void TrimMetadataCache() const;
+
     std::pair<double, double>
     ReadData(adios2::transportman::TransportMan &FileManager,
              const size_t maxOpenFiles, const size_t WriterRank,
              const size_t Timestep, const size_t StartOffset,
              const size_t Length, char *Destination);
+    /* as ReadData, from the Index record of the data locations of the
+     * writers at InfoStartPos */
+    std::pair<double, double>
+    ReadDataAt(adios2::transportman::TransportMan &FileManager,
+               const size_t maxOpenFiles, const size_t SubfileNum,
+               const size_t FlushCount, const std::vector<char> &Index,
+               size_t InfoStartPos, const size_t StartOffset,
+               const size_t Length, char *Destination);
+    /* read everything FinalizeGet() needs for Req: the block, the rest of it
+     * after its chunk table and the keyframe block it is a difference to */
+    std::pair<double, double>
+    ReadRequestData(adios2::transportman::TransportMan &FileManager,
+                    const size_t maxOpenFiles,
+                    format::BP5Deserializer::ReadRequest &Req,
+                    std::vector<char> &KeyframeBuffer);
 
     struct WriterMapStruct
     {
@@ -255,6 +299,18 @@ private:
     // step -> writermap index (for all steps)
     std::vector<uint64_t> m_WriterMapIndex;
 
+    /* Most steps between keyframes of the writers (KeyframeInterval) and
+     * where the data of each of the last that many steps in the file is,
+     * by absolute step, for reading keyframe blocks of earlier steps */
+    uint32_t m_KeyframeInterval = 0;
+    struct StepDataLocations
+    {
+        uint64_t WriterMapStep;
+        uint64_t FlushCount;
+        std::vector<char> Record; // the data location record of the Index
+    };
+    std::map<uint64_t, StepDataLocations> m_KeyframeLocations;
+
     void DestructorClose(bool Verbose) noexcept;
 
     /* Communicator connecting ranks on each Compute Node.
@@ -15,9 +15,12 @@
 #include "adios2/helper/adiosMath.h"      // SetWithinLimit
 #include "adios2/toolkit/format/buffer/chunk/ChunkV.h"
 #include "adios2/toolkit/format/buffer/malloc/MallocV.h"
+#include "adios2/toolkit/burstbuffer/FileDrainerMultiThread.h"
 #include "adios2/toolkit/transport/file/FileFStream.h"
 #include <adios2-perfstubs-interface.h>
 
+#include <algorithm> // max, min
+#include <cstring>   // memcpy
 #include <ctime>
 #include <iomanip> // setw
 #include <iostream>
@@ -103,6 +106,7 @@ StepStatus BP5Writer::BeginStep(StepMode mode, const float timeoutSeconds)
         }
     }
 
+    m_BP5Serializer.m_WriterStep = m_WriterStep;
     if (m_Parameters.BufferVType == (int)BufferVType::MallocVType)
     {
         m_BP5Serializer.InitStep(new MallocV(
@@ -526,7 +530,10 @@ void BP5Writer::EndStep()
     m_AsyncWriteLock.lock();
     m_flagRush = false;
     m_AsyncWriteLock.unlock();
+    const uint64_t stepDataSize = databuf->Size();
+    const TimePoint writeStart = Now();
     WriteData(databuf);
+    const double writeSeconds = Seconds(Now() - writeStart).count();
     m_Profiler.Stop("AWD");
 
     /*
@@ -657,6 +664,11 @@ void BP5Writer::EndStep()
         }
     }
 
+    if (m_Parameters.AdaptiveAggregation && !m_AdaptiveDone)
+    {
+        AdaptAggregation(stepDataSize, writeSeconds);
+    }
+
     m_Profiler.Stop("endstep");
     m_WriterStep++;
     m_EndStepEnd = Now();
@@ -680,6 +692,22 @@ void BP5Writer::InitParameters()
     ParseParams(m_IO, m_Parameters);
     m_WriteToBB = !(m_Parameters.BurstBufferPath.empty());
     m_DrainBB = m_WriteToBB && m_Parameters.BurstBufferDrain;
+    if (m_DrainBB)
+    {
+#ifndef _WIN32
+        if (m_Parameters.BurstBufferDrainThreads > 1 ||
+            m_Parameters.BurstBufferDrainBandwidth > 0.0f)
+        {
+            m_FileDrainer.reset(new burstbuffer::FileDrainerMultiThread(
+                m_Parameters.BurstBufferDrainThreads,
+                m_Parameters.BurstBufferDrainBandwidth * 1048576.0));
+        }
+        else
+#endif
+        {
+            m_FileDrainer.reset(new burstbuffer::FileDrainerSingleThread());
+        }
+    }
 
     unsigned int nproc = (unsigned int)m_Comm.Size();
     m_Parameters.NumAggregators =
@@ -704,6 +732,18 @@ void BP5Writer::InitParameters()
     m_Parameters.NumSubFiles = helper::SetWithinLimit(
         m_Parameters.NumSubFiles, 0U, m_Parameters.NumAggregators);
 
+    // Adaptive aggregation re-partitions between steps, which requires the
+    // data of the previous step to be completely written out and the data
+    // files not to be handed over to a drainer
+    if (m_Parameters.AsyncWrite || m_WriteToBB || nproc == 1)
+    {
+        m_Parameters.AdaptiveAggregation = false;
+    }
+    if (m_Parameters.AdaptiveSteps < 2)
+    {
+        m_Parameters.AdaptiveSteps = 2;
+    }
+
     // Limiting to max 64MB page size
     m_Parameters.StripeSize =
         helper::SetWithinLimit(m_Parameters.StripeSize, 0U, 67108864U);
@@ -736,6 +776,14 @@ void BP5Writer::InitParameters()
     }
 
     m_BP5Serializer.m_StatsLevel = m_Parameters.StatsLevel;
+    m_BP5Serializer.m_MetadataDelta = m_Parameters.MetadataDelta;
+    m_BP5Serializer.m_OperatorChunkSize = m_Parameters.OperatorChunkSize;
+    m_BP5Serializer.m_OperatorChunkThreads =
+        std::max(m_Parameters.OperatorChunkThreads, 1U);
+    m_BP5Serializer.m_RowMajor =
+        (m_IO.m_ArrayOrder != ArrayOrdering::ColumnMajor);
+    m_BP5Serializer.m_KeyframeInterval = m_Parameters.KeyframeInterval;
+    m_BP5Serializer.m_KeyframeDeltaRatio = m_Parameters.KeyframeDeltaRatio;
 }
 
 uint64_t BP5Writer::CountStepsInMetadataIndex(format::BufferSTL &bufferSTL)
@@ -1024,6 +1072,135 @@ void BP5Writer::InitAggregator()
         m_Comm.Split(color, 0, "creating level 2 chain of aggregators at Open");
 }
 
+void BP5Writer::AdaptAggregation(const uint64_t dataSize,
+                                 const double writeSeconds)
+{
+    /* Aggregate bandwidth of this step: all data over the slowest writer.
+     * Every process computes the same value so they all take the same
+     * decision below. */
+    uint64_t totalSize = 0;
+    double maxSeconds = 0.0;
+    m_Comm.Allreduce(&dataSize, &totalSize, 1, helper::Comm::Op::Sum,
+                     "summing data size for adaptive aggregation");
+    m_Comm.Allreduce(&writeSeconds, &maxSeconds, 1, helper::Comm::Op::Max,
+                     "max write time for adaptive aggregation");
+    if (totalSize == 0 || maxSeconds <= 0.0)
+    {
+        // nothing to learn from a step without data
+        return;
+    }
+
+    const unsigned int nproc = static_cast<unsigned int>(m_Comm.Size());
+    const unsigned int current =
+        m_Parameters.NumAggregators
+            ? m_Parameters.NumAggregators
+            : static_cast<unsigned int>(std::max(
+                  m_Aggregator->m_NumAggregators, m_Aggregator->m_SubStreams));
+    const double bandwidth = static_cast<double>(totalSize) / maxSeconds;
+    m_AdaptiveBandwidth[current] = bandwidth;
+
+    unsigned int best = current;
+    for (const auto &probe : m_AdaptiveBandwidth)
+    {
+        if (probe.second > m_AdaptiveBandwidth[best])
+        {
+            best = probe.first;
+        }
+    }
+
+    /* Hill climbing from the fastest count seen so far: try doubling it
+     * first, then halving it. Stop when the target is met, when both
+     * neighbors of the best count have been measured or when the probing
+     * steps are used up. */
+    unsigned int next = 0;
+    if (m_Parameters.AdaptiveTargetBandwidth > 0.0f &&
+        bandwidth >= m_Parameters.AdaptiveTargetBandwidth * 1048576.0)
+    {
+        best = current;
+    }
+    else if (m_AdaptiveBandwidth.size() < m_Parameters.AdaptiveSteps)
+    {
+        if (best * 2 <= nproc && !m_AdaptiveBandwidth.count(best * 2))
+        {
+            next = best * 2;
+        }
+        else if (best / 2 >= 1 && !m_AdaptiveBandwidth.count(best / 2))
+        {
+            next = best / 2;
+        }
+    }
+    if (!next)
+    {
+        next = best;
+        m_AdaptiveDone = true;
+    }
+
+    if (m_Comm.Rank() == 0 && m_Parameters.verbose > 0)
+    {
+        std::cout << "BP5Writer adaptive aggregation: step " << m_WriterStep
+                  << " " << current << " aggregators wrote "
+                  << bandwidth / 1048576.0 << " MB/s, "
+                  << (m_AdaptiveDone ? "settle on " : "probe next ") << next
+                  << " aggregators" << std::endl;
+    }
+
+    if (next != current)
+    {
+        RepartitionAggregation(next);
+    }
+}
+
+void BP5Writer::RepartitionAggregation(const unsigned int numAggregators)
+{
+    /* The previous aggregators must have finished writing into the
+     * subfiles before the new ones open them */
+    if (m_IAmWritingData)
+    {
+        m_FileDataManager.CloseFiles();
+        m_FileDataManager.m_Transports.clear();
+    }
+    m_Comm.Barrier("closing data files for adaptive aggregation");
+
+    m_Aggregator->Close();
+    m_CommAggregators.Free("freeing aggregators chain for adaptive "
+                           "aggregation");
+
+    m_Parameters.NumAggregators = numAggregators;
+    m_Parameters.NumSubFiles =
+        std::min(m_Parameters.NumSubFiles, m_Parameters.NumAggregators);
+    InitAggregator();
+
+    const std::vector<std::string> transportsNames =
+        m_FileDataManager.GetFilesBaseNames(m_BBName,
+                                            m_IO.m_TransportsParameters);
+    m_SubStreamNames =
+        GetBPSubStreamNames(transportsNames, m_Aggregator->m_SubStreamIndex);
+
+    if (m_IAmWritingData)
+    {
+        // rank 0 turned off DirectIO for the metadata files in the IO
+        std::vector<Params> dataTransportParameters =
+            m_IO.m_TransportsParameters;
+        for (auto &parameters : dataTransportParameters)
+        {
+            parameters["DirectIO"] = m_Parameters.DirectIO ? "true" : "false";
+        }
+        AddStripeParameters(dataTransportParameters);
+        // subfiles may already hold data of previous steps
+        m_FileDataManager.OpenFiles(m_SubStreamNames, Mode::Append,
+                                    dataTransportParameters, true,
+                                    *DataWritingComm);
+        if (DataWritingComm->Rank() == 0)
+        {
+            m_DataPos = m_FileDataManager.GetFileSize(0);
+        }
+    }
+
+    // new Writer Map is needed, written with the next step's index record
+    const uint64_t a = static_cast<uint64_t>(m_Aggregator->m_SubStreamIndex);
+    m_WriterSubfileMap = m_Comm.GatherValues(a, 0);
+}
+
 void BP5Writer::InitTransports()
 {
     if (m_IO.m_TransportsParameters.empty())
@@ -1067,10 +1244,10 @@ void BP5Writer::InitTransports()
             m_DrainSubStreamNames = GetBPSubStreamNames(
                 drainTransportNames, m_Aggregator->m_SubStreamIndex);
             /* start up BB thread */
-            //            m_FileDrainer.SetVerbose(
+            //            m_FileDrainer->SetVerbose(
             //				     m_Parameters.BurstBufferVerbose,
             //				     m_Comm.Rank());
-            m_FileDrainer.Start();
+            m_FileDrainer->Start();
         }
     }
 
@@ -1113,6 +1290,8 @@ void BP5Writer::InitTransports()
         }
     }
 
+    AddStripeParameters(m_IO.m_TransportsParameters);
+
     bool useProfiler = true;
 
     if (m_IAmWritingData)
@@ -1122,23 +1301,31 @@ void BP5Writer::InitTransports()
                                     *DataWritingComm);
     }
 
+    if (m_Parameters.AlignToFileStripes)
+    {
+        UseFileStripeSize();
+    }
+
     if (m_IAmDraining)
     {
         if (m_DrainBB)
         {
             for (const auto &name : m_DrainSubStreamNames)
             {
-                m_FileDrainer.AddOperationOpen(name, m_OpenMode);
+                m_FileDrainer->AddOperationOpen(name, m_OpenMode);
             }
         }
     }
 
     if (m_Comm.Rank() == 0)
     {
-        // force turn off directio to metadata files
+        // force turn off directio to metadata files, which also keep the
+        // default layout of the file system
         for (size_t i = 0; i < m_IO.m_TransportsParameters.size(); ++i)
         {
             m_IO.m_TransportsParameters[i]["DirectIO"] = "false";
+            m_IO.m_TransportsParameters[i].erase("StripeCount");
+            m_IO.m_TransportsParameters[i].erase("StripeSize");
         }
         m_FileMetaMetadataManager.OpenFiles(m_MetaMetadataFileNames, m_OpenMode,
                                             m_IO.m_TransportsParameters,
@@ -1164,16 +1351,64 @@ void BP5Writer::InitTransports()
 
             for (const auto &name : m_DrainMetadataFileNames)
             {
-                m_FileDrainer.AddOperationOpen(name, m_OpenMode);
+                m_FileDrainer->AddOperationOpen(name, m_OpenMode);
             }
             for (const auto &name : m_DrainMetadataIndexFileNames)
             {
-                m_FileDrainer.AddOperationOpen(name, m_OpenMode);
+                m_FileDrainer->AddOperationOpen(name, m_OpenMode);
             }
         }
     }
 }
 
+void BP5Writer::AddStripeParameters(
+    std::vector<Params> &transportsParameters) const
+{
+    if (m_Parameters.FileStripeCount == 0 && m_Parameters.FileStripeSize == 0)
+    {
+        return;
+    }
+    for (auto &parameters : transportsParameters)
+    {
+        parameters["StripeCount"] =
+            std::to_string(m_Parameters.FileStripeCount);
+        parameters["StripeSize"] = std::to_string(m_Parameters.FileStripeSize);
+    }
+}
+
+void BP5Writer::UseFileStripeSize()
+{
+    /* Every writer must pad with the same value, take the largest stripe
+     * size of all subfiles. Processes not writing data contribute 0. */
+    uint64_t stripeSize = 0;
+    if (m_IAmWritingData)
+    {
+        stripeSize = static_cast<uint64_t>(m_FileDataManager.GetStripeSize(0));
+    }
+    uint64_t maxStripeSize = 0;
+    m_Comm.Allreduce(&stripeSize, &maxStripeSize, 1, helper::Comm::Op::Max,
+                     "max stripe size of data files in BP5Writer::Open");
+
+    if (maxStripeSize == 0 || maxStripeSize > 67108864U)
+    {
+        // unknown or beyond the limit of StripeSize, keep the parameter
+        return;
+    }
+    if (m_Parameters.DirectIO &&
+        maxStripeSize % m_Parameters.DirectIOAlignOffset)
+    {
+        maxStripeSize = (maxStripeSize / m_Parameters.DirectIOAlignOffset + 1) *
+                        m_Parameters.DirectIOAlignOffset;
+    }
+    m_Parameters.StripeSize = static_cast<unsigned int>(maxStripeSize);
+
+    if (m_Parameters.verbose > 0 && m_Comm.Rank() == 0)
+    {
+        std::cout << "BP5Writer: aligning data writes to the file stripe size "
+                  << m_Parameters.StripeSize << " bytes" << std::endl;
+    }
+}
+
 /*generate the header for the metadata index file*/
 void BP5Writer::MakeHeader(std::vector<char> &buffer, size_t &position,
                            const std::string fileType, const bool isActive)
@@ -1297,8 +1532,19 @@ void BP5Writer::MakeHeader(std::vector<char> &buffer, size_t &position,
         (m_IO.m_ArrayOrder == ArrayOrdering::ColumnMajor) ? 'y' : 'n';
     helper::CopyToBuffer(buffer, position, &columnMajor);
 
-    // byte 41-63: unused
-    position += 23;
+    // byte 41-44: most steps between keyframes, see UpdateKeyframeInterval
+    if (position != m_KeyframeIntervalPosition)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "BP5Writer", "MakeHeader",
+            "ADIOS Coding ERROR in BP5Writer::MakeHeader. Keyframe interval "
+            "position mismatch");
+    }
+    const uint32_t keyframeInterval = m_Parameters.KeyframeInterval;
+    helper::CopyToBuffer(buffer, position, &keyframeInterval);
+
+    // byte 45-63: unused
+    position += 19;
     // absolutePosition = position;
 }
 
@@ -1313,10 +1559,52 @@ void BP5Writer::UpdateActiveFlag(const bool active)
     {
         for (size_t i = 0; i < m_MetadataIndexFileNames.size(); ++i)
         {
-            m_FileDrainer.AddOperationWriteAt(m_DrainMetadataIndexFileNames[i],
-                                              m_ActiveFlagPosition, 1,
-                                              &activeChar);
-            m_FileDrainer.AddOperationSeekEnd(m_DrainMetadataIndexFileNames[i]);
+            m_FileDrainer->AddOperationWriteAt(
+                m_DrainMetadataIndexFileNames[i], m_ActiveFlagPosition, 1,
+                &activeChar);
+            m_FileDrainer->AddOperationSeekEnd(
+                m_DrainMetadataIndexFileNames[i]);
+        }
+    }
+}
+
+void BP5Writer::UpdateKeyframeInterval(const std::vector<char> &index)
+{
+    // readers keep track of the data of as many earlier steps as the
+    // longest keyframe interval of all runs writing to the file
+    if (index.size() < m_IndexHeaderSize)
+    {
+        return;
+    }
+    // the existing header is known to match our endianness, see
+    // MakeHeader for the layout
+    size_t position = m_EndianFlagPosition;
+    const bool isLittleEndian =
+        (helper::ReadValue<uint8_t>(index, position) == 0);
+    position = m_KeyframeIntervalPosition;
+    const uint32_t interval =
+        helper::ReadValue<uint32_t>(index, position, isLittleEndian);
+    if (m_Parameters.KeyframeInterval <= interval)
+    {
+        return;
+    }
+    std::vector<char> buffer(sizeof(uint32_t));
+    position = 0;
+    const uint32_t keyframeInterval = m_Parameters.KeyframeInterval;
+    helper::CopyToBuffer(buffer, position, &keyframeInterval);
+    m_FileMetadataIndexManager.WriteFileAt(buffer.data(), buffer.size(),
+                                           m_KeyframeIntervalPosition);
+    m_FileMetadataIndexManager.FlushFiles();
+    m_FileMetadataIndexManager.SeekToFileEnd();
+    if (m_DrainBB)
+    {
+        for (size_t i = 0; i < m_MetadataIndexFileNames.size(); ++i)
+        {
+            m_FileDrainer->AddOperationWriteAt(
+                m_DrainMetadataIndexFileNames[i], m_KeyframeIntervalPosition,
+                buffer.size(), buffer.data());
+            m_FileDrainer->AddOperationSeekEnd(
+                m_DrainMetadataIndexFileNames[i]);
         }
     }
 }
@@ -1390,6 +1678,7 @@ void BP5Writer::InitBPBuffer()
             // Set the flag in the header of metadata index table to 1 again
             // to indicate a new run begins
             UpdateActiveFlag(true);
+            UpdateKeyframeInterval(preMetadataIndex.m_Buffer);
 
             // Truncate existing index file
             if (m_AppendMetadataIndexPos < MaxSizeT)
@@ -1672,7 +1961,7 @@ void BP5Writer::FlushProfiler()
             {
                 profileFileName = bpTargetNames[0] + "_profiling.json";
             }
-            m_FileDrainer.AddOperationWrite(
+            m_FileDrainer->AddOperationWrite(
                 profileFileName, profilingJSON.size(), profilingJSON.data());
         }
         else
@@ -80,7 +80,7 @@ private:
     /** true if burst buffer is drained to disk  */
     bool m_DrainBB = true;
     /** File drainer thread if burst buffer is used */
-    burstbuffer::FileDrainerSingleThread m_FileDrainer;
+    std::unique_ptr<burstbuffer::FileDrainer> m_FileDrainer;
     /** m_Name modified with burst buffer path if BB is used,
      * == m_Name otherwise.
      * m_Name is a constant of Engine and is the user provided target path
@@ -107,8 +107,22 @@ private:
     void InitParameters() final;
     /** Set up the aggregator */
     void InitAggregator();
+    /** Adaptive aggregation: record the bandwidth of this step's data write
+     * and move to the next aggregator count to probe, or settle on the
+     * fastest one. Collective, called at the end of EndStep. */
+    void AdaptAggregation(const uint64_t dataSize, const double writeSeconds);
+    /** Close the data files, split the writers into numAggregators groups
+     * and reopen the (sub)files for the new groups. A new writer map is
+     * recorded in the index for the next step. Collective. */
+    void RepartitionAggregation(const unsigned int numAggregators);
     /** Complete opening/createing metadata and data files */
     void InitTransports() final;
+    /** Add the requested Lustre layout (FileStripeCount, FileStripeSize) to
+     * the parameters of the data file transports */
+    void AddStripeParameters(std::vector<Params> &transportsParameters) const;
+    /** Set StripeSize to the largest stripe size of the opened data files so
+     * that every write starts on a stripe boundary. Collective. */
+    void UseFileStripeSize();
     /** Allocates memory and starts a PG group */
     void InitBPBuffer();
     void NotifyEngineAttribute(std::string name, DataType type) noexcept;
@@ -174,6 +188,7 @@ private:
     void WriteData_TwoLevelShm_Async(format::BufferV *Data);
 
     void UpdateActiveFlag(const bool active);
+    void UpdateKeyframeInterval(const std::vector<char> &index);
 
     void WriteCollectiveMetadataFile(const bool isFinal = false);
 
@@ -237,6 +252,12 @@ private:
 
     std::vector<uint64_t> m_WriterSubfileMap; // rank => subfile index
 
+    /** Adaptive aggregation: measured aggregate bandwidth (bytes/sec) for
+     * each probed number of aggregators */
+    std::map<unsigned int, double> m_AdaptiveBandwidth;
+    /** Adaptive aggregation: true once the aggregator count is final */
+    bool m_AdaptiveDone = false;
+
     // Append helper data
     std::vector<size_t> m_AppendDataPos;  // each subfile append pos
     size_t m_AppendMetadataPos;           // metadata file append pos
@@ -106,7 +106,13 @@ DataManReader::DataManReader(IO &io, const std::string &name,
                                              "invalid transport mode");
     }
 
-    m_Requester.Request("Ready", 5);
+    // the writer numbers its readers in the reply, so that in reliable mode
+    // each reader is served every step
+    auto ready = m_Requester.Request("Ready", 5);
+    if (ready != nullptr && ready->size() > 2)
+    {
+        m_ReaderId = std::string(ready->begin() + 2, ready->end());
+    }
 
     if (m_TransportMode == "reliable")
     {
@@ -232,9 +238,10 @@ void DataManReader::Flush(const int transportIndex) {}
 
 void DataManReader::RequestThread()
 {
+    const std::string request =
+        m_ReaderId.empty() ? "Step" : "Step " + m_ReaderId;
     while (m_RequesterThreadActive)
     {
-        std::string request = "Step";
         auto buffer = m_Requester.Request(request.data(), request.size());
         if (buffer != nullptr && buffer->size() > 0)
         {
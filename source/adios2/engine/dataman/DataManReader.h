@@ -59,6 +59,7 @@ private:
 
     zmq::ZmqPubSub m_Subscriber;
     zmq::ZmqReqRep m_Requester;
+    std::string m_ReaderId;
 
     DataManMonitor m_Monitor;
 
@@ -10,6 +10,9 @@
 
 #include "DataManWriter.tcc"
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace adios2
 {
 namespace core
@@ -19,7 +22,7 @@ namespace engine
 
 DataManWriter::DataManWriter(IO &io, const std::string &name,
                              const Mode openMode, helper::Comm comm)
-: Engine("DataManWriter", io, name, openMode, std::move(comm)), m_SentSteps(0),
+: Engine("DataManWriter", io, name, openMode, std::move(comm)),
   m_Serializer(m_Comm, (io.m_ArrayOrder == ArrayOrdering::RowMajor)),
   m_ReplyThreadActive(true), m_PublishThreadActive(true)
 {
@@ -44,6 +47,8 @@ DataManWriter::DataManWriter(IO &io, const std::string &name,
     helper::GetParameter(m_IO.m_Parameters, "Monitor", m_MonitorActive);
     helper::GetParameter(m_IO.m_Parameters, "CombiningSteps", m_CombiningSteps);
     helper::GetParameter(m_IO.m_Parameters, "FloatAccuracy", m_FloatAccuracy);
+    helper::GetParameter(m_IO.m_Parameters, "ReplyThreads",
+                         m_ReplyThreadCount);
 
     helper::Log("Engine", "DataManWriter", "Open", m_Name, 0, m_Comm.Rank(), 5,
                 m_Verbosity, helper::LogMode::INFO);
@@ -58,6 +63,14 @@ DataManWriter::DataManWriter(IO &io, const std::string &name,
                                              "IP address not specified");
     }
 
+    if (m_ReplyThreadCount < 1)
+    {
+        helper::Throw<std::invalid_argument>(
+            "Engine", "DataManWriter", "Open",
+            "ReplyThreads must be at least 1, found " +
+                std::to_string(m_ReplyThreadCount));
+    }
+
     if (m_MonitorActive)
     {
         if (m_CombiningSteps < 20)
@@ -80,22 +93,33 @@ DataManWriter::DataManWriter(IO &io, const std::string &name,
         m_Publisher.OpenPublisher(publisherAddress);
     }
 
-    m_Replier.OpenReplier(replierAddress, m_Timeout, 64);
+    // only reliable mode serves steps through the replier
+    const size_t replyThreads =
+        m_TransportMode == "reliable" ? m_ReplyThreadCount : 1;
+    m_Replier.OpenReplier(replierAddress, m_Timeout, 64, replyThreads);
 
-    if (m_RendezvousReaderCount == 0)
+    if (m_TransportMode == "reliable" || m_RendezvousReaderCount == 0)
     {
         m_ReplyThreadActive = true;
-        m_ReplyThread = std::thread(&DataManWriter::ReplyThread, this);
+        for (size_t i = 0; i < replyThreads; ++i)
+        {
+            m_ReplyThreads.emplace_back(&DataManWriter::ReplyThread, this, i);
+        }
     }
-    else
+
+    if (m_TransportMode == "reliable")
     {
-        Handshake();
+        // requests are spread over all reply threads, which also serve the
+        // rendezvous of readers
+        std::unique_lock<std::mutex> l(m_ReaderQueueMutex);
+        m_ReaderQueueCondition.wait(l, [this]() {
+            return m_ReaderPositions.size() >=
+                   static_cast<size_t>(m_RendezvousReaderCount);
+        });
     }
-
-    if (m_TransportMode == "reliable" && m_RendezvousReaderCount > 0)
+    else if (m_RendezvousReaderCount > 0)
     {
-        m_ReplyThreadActive = true;
-        m_ReplyThread = std::thread(&DataManWriter::ReplyThread, this);
+        Handshake();
     }
 
     if (m_TransportMode == "fast")
@@ -171,7 +195,11 @@ void DataManWriter::EndStep()
             m_SerializerBufferSize = buffer->size();
         }
 
-        if (m_Threading || m_TransportMode == "reliable")
+        if (m_TransportMode == "reliable")
+        {
+            PushReaderQueue(buffer);
+        }
+        else if (m_Threading)
         {
             PushBufferQueue(buffer);
         }
@@ -223,7 +251,7 @@ void DataManWriter::DoClose(const int transportIndex)
 
         if (m_TransportMode == "reliable")
         {
-            PushBufferQueue(buffer);
+            PushReaderQueue(buffer);
         }
         else if (m_TransportMode == "fast")
         {
@@ -246,7 +274,7 @@ void DataManWriter::DoClose(const int transportIndex)
 
     if (m_TransportMode == "reliable")
     {
-        PushBufferQueue(cvp);
+        PushReaderQueue(cvp);
     }
     else if (m_TransportMode == "fast")
     {
@@ -273,14 +301,19 @@ void DataManWriter::DoClose(const int transportIndex)
 
     if (m_ReplyThreadActive)
     {
-        while (m_SentSteps < static_cast<size_t>(m_CurrentStep + 2))
+        while (!AreReadersDone())
         {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
         m_ReplyThreadActive = false;
     }
-    if (m_ReplyThread.joinable())
+    m_ReaderQueueCondition.notify_all();
+    for (auto &thread : m_ReplyThreads)
     {
-        m_ReplyThread.join();
+        if (thread.joinable())
+        {
+            thread.join();
+        }
     }
 
     m_PublishThreadActive = false;
@@ -319,6 +352,78 @@ std::shared_ptr<std::vector<char>> DataManWriter::PopBufferQueue()
     }
 }
 
+size_t DataManWriter::AddReader()
+{
+    size_t reader;
+    {
+        std::lock_guard<std::mutex> l(m_ReaderQueueMutex);
+        // a reader joining late starts from the oldest step still queued
+        m_ReaderPositions.push_back(m_ReaderQueueFront);
+        reader = m_ReaderPositions.size() - 1;
+    }
+    m_ReaderQueueCondition.notify_all();
+    return reader;
+}
+
+void DataManWriter::PushReaderQueue(std::shared_ptr<std::vector<char>> buffer)
+{
+    {
+        std::lock_guard<std::mutex> l(m_ReaderQueueMutex);
+        m_ReaderQueue.push_back(buffer);
+    }
+    m_ReaderQueueCondition.notify_all();
+}
+
+std::shared_ptr<std::vector<char>>
+DataManWriter::PopReaderQueue(const size_t reader)
+{
+    std::unique_lock<std::mutex> l(m_ReaderQueueMutex);
+    if (reader >= m_ReaderPositions.size())
+    {
+        return nullptr;
+    }
+    // wait only briefly and let the reader ask again, so that a reply thread
+    // is never held by one reader while others still need to rendezvous
+    if (m_ReaderPositions[reader] >= m_ReaderQueueFront + m_ReaderQueue.size())
+    {
+        m_ReaderQueueCondition.wait_for(l, std::chrono::milliseconds(100));
+        if (m_ReaderPositions[reader] >=
+            m_ReaderQueueFront + m_ReaderQueue.size())
+        {
+            return nullptr;
+        }
+    }
+
+    auto buffer = m_ReaderQueue[m_ReaderPositions[reader] - m_ReaderQueueFront];
+    ++m_ReaderPositions[reader];
+
+    const size_t slowest =
+        *std::min_element(m_ReaderPositions.begin(), m_ReaderPositions.end());
+    while (m_ReaderQueueFront < slowest)
+    {
+        m_ReaderQueue.pop_front();
+        ++m_ReaderQueueFront;
+    }
+    return buffer;
+}
+
+bool DataManWriter::AreReadersDone()
+{
+    std::lock_guard<std::mutex> l(m_ReaderQueueMutex);
+    if (m_ReaderPositions.empty())
+    {
+        return false;
+    }
+    for (const auto position : m_ReaderPositions)
+    {
+        if (position < m_ReaderQueueFront + m_ReaderQueue.size())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 void DataManWriter::PublishThread()
 {
     while (m_PublishThreadActive)
@@ -351,7 +456,8 @@ void DataManWriter::Handshake()
             }
             else if (r == "Ready")
             {
-                m_Replier.SendReply("OK", 2);
+                const std::string reply = "OK" + std::to_string(AddReader());
+                m_Replier.SendReply(reply.data(), reply.size());
                 ++readerCount;
             }
 
@@ -363,42 +469,55 @@ void DataManWriter::Handshake()
     }
 }
 
-void DataManWriter::ReplyThread()
+void DataManWriter::ReplyThread(const size_t thread)
 {
-    int readerCount = 0;
     while (m_ReplyThreadActive)
     {
-        auto request = m_Replier.ReceiveRequest();
+        auto request = m_Replier.ReceiveRequest(thread);
         if (request != nullptr && request->size() > 0)
         {
             std::string r(request->begin(), request->end());
             if (r == "Handshake")
             {
-                m_HandshakeJson["TimeStamp"] =
-                    std::chrono::duration_cast<std::chrono::milliseconds>(
-                        std::chrono::system_clock::now().time_since_epoch())
-                        .count();
-                std::string js = m_HandshakeJson.dump() + '\0';
-                m_Replier.SendReply(js.data(), js.size());
+                nlohmann::json handshake;
+                {
+                    std::lock_guard<std::mutex> l(m_ReaderQueueMutex);
+                    m_HandshakeJson["TimeStamp"] =
+                        std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::system_clock::now()
+                                .time_since_epoch())
+                            .count();
+                    handshake = m_HandshakeJson;
+                }
+                std::string js = handshake.dump() + '\0';
+                m_Replier.SendReply(js.data(), js.size(), thread);
             }
             else if (r == "Ready")
             {
-                m_Replier.SendReply("OK", 2);
-                ++readerCount;
+                const std::string reply = "OK" + std::to_string(AddReader());
+                m_Replier.SendReply(reply.data(), reply.size(), thread);
             }
-            else if (r == "Step")
+            else if (r.compare(0, 4, "Step") == 0)
             {
-                auto buffer = PopBufferQueue();
-                while (buffer == nullptr)
+                // "Step <reader>", the reader number was given in the reply
+                // to its "Ready" request
+                const size_t reader =
+                    r.size() > 5 ? std::strtoull(r.c_str() + 5, nullptr, 10)
+                                 : 0;
+                auto buffer = PopReaderQueue(reader);
+                if (buffer != nullptr && buffer->size() > 0)
                 {
-                    buffer = PopBufferQueue();
+                    m_Replier.SendReply(buffer, thread);
                 }
-                if (buffer->size() > 0)
+                else
                 {
-                    m_Replier.SendReply(buffer);
-                    m_SentSteps = m_SentSteps + m_CombiningSteps;
+                    m_Replier.SendReply("", 0, thread);
                 }
             }
+            else
+            {
+                m_Replier.SendReply("", 0, thread);
+            }
         }
     }
 }
@@ -17,6 +17,8 @@
 #include "adios2/toolkit/zmq/zmqpubsub/ZmqPubSub.h"
 #include "adios2/toolkit/zmq/zmqreqrep/ZmqReqRep.h"
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 
 namespace adios2
 {
@@ -52,12 +54,12 @@ private:
     int m_CombiningSteps = 1;
     int m_CombinedSteps = 0;
     std::string m_FloatAccuracy;
+    int m_ReplyThreadCount = 1;
 
     int m_MpiRank;
     int m_MpiSize;
     size_t m_SerializerBufferSize = 1024 * 1024;
     int64_t m_CurrentStep = -1;
-    std::atomic<size_t> m_SentSteps;
     nlohmann::json m_HandshakeJson;
 
     format::DataManSerializer m_Serializer;
@@ -67,7 +69,7 @@ private:
 
     DataManMonitor m_Monitor;
 
-    std::thread m_ReplyThread;
+    std::vector<std::thread> m_ReplyThreads;
     std::thread m_PublishThread;
     std::atomic<bool> m_ReplyThreadActive;
     bool m_PublishThreadActive;
@@ -79,8 +81,22 @@ private:
     std::shared_ptr<std::vector<char>> PopBufferQueue();
     bool IsBufferQueueEmpty();
 
+    // reliable mode: each serialized step is queued once and shared by all
+    // readers, every reader has its own position in the queue and a step is
+    // released when the slowest reader has taken it
+    std::deque<std::shared_ptr<std::vector<char>>> m_ReaderQueue;
+    size_t m_ReaderQueueFront = 0; // step index of m_ReaderQueue.front()
+    std::vector<size_t> m_ReaderPositions;
+    std::mutex m_ReaderQueueMutex;
+    std::condition_variable m_ReaderQueueCondition;
+
+    size_t AddReader();
+    void PushReaderQueue(std::shared_ptr<std::vector<char>> buffer);
+    std::shared_ptr<std::vector<char>> PopReaderQueue(const size_t reader);
+    bool AreReadersDone();
+
     void Handshake();
-    void ReplyThread();
+    void ReplyThread(const size_t thread);
     void PublishThread();
 
 #define declare_type(T)                                                        \
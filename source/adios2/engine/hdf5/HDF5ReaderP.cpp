@@ -76,6 +76,7 @@ void HDF5ReaderP::Init()
             ", in call to Open");
     }
 
+    m_H5File.ParseFileParameters(m_IO);
     m_H5File.Init(m_Name, m_Comm, false);
     m_H5File.ParseParameters(m_IO);
 
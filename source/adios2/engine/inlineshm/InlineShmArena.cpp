@@ -0,0 +1,360 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * InlineShmArena.cpp
+ */
+
+#include "InlineShmArena.h"
+#include "adios2/helper/adiosLog.h"
+#include "adios2/helper/adiosMemory.h" // PaddingToAlignOffset
+
+#include <cstdio>  // snprintf
+#include <cstdlib> // getenv
+#include <new>     // placement new
+
+#include <limits.h>    //HOST_NAME_MAX
+#include <sys/ipc.h>   //ftok
+#include <sys/shm.h>   //shmget, shmmat
+#include <sys/stat.h>  //stat
+#include <sys/types.h> //key_t
+#include <unistd.h>    //gethostname, getuid
+
+namespace adios2
+{
+namespace core
+{
+namespace engine
+{
+namespace inlineshm
+{
+
+namespace
+{
+constexpr uint64_t alignment = 64;
+constexpr size_t maxFileName = 255; // NAME_MAX of common file systems
+
+size_t Aligned(const size_t offset)
+{
+    return offset + helper::PaddingToAlignOffset(offset, alignment);
+}
+} // end anonymous namespace
+
+constexpr uint64_t InlineShmArena::Magic;
+constexpr uint64_t InlineShmArena::NoStep;
+
+std::string InlineShmArena::KeyFileName(const std::string &streamName)
+{
+    std::string dir = "/dev/shm";
+    struct stat st;
+    if (stat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+    {
+        const char *tmpdir = std::getenv("TMPDIR");
+        dir = tmpdir ? tmpdir : "/tmp";
+    }
+
+    char host[HOST_NAME_MAX + 1] = {};
+    gethostname(host, HOST_NAME_MAX);
+
+    // writers and readers launched within the same batch job agree on it
+    std::string job = "nojob";
+    for (const char *var : {"SLURM_JOB_ID", "PBS_JOBID", "LSB_JOBID",
+                            "COBALT_JOBID", "FLUX_JOB_ID"})
+    {
+        const char *value = std::getenv(var);
+        if (value != nullptr && *value != '\0')
+        {
+            job = value;
+            break;
+        }
+    }
+
+    // the stream name may be a path, keep it unique within one file name
+    std::string name;
+    for (const char c : streamName)
+    {
+        if (c == '/')
+        {
+            name += "%2F";
+        }
+        else if (c == '%')
+        {
+            name += "%25";
+        }
+        else
+        {
+            name += c;
+        }
+    }
+
+    std::string file = "adios2-inlineshm-" + std::string(host) + "-" +
+                       std::to_string(getuid()) + "-" + job + "-" + name;
+
+    // a deep stream path does not fit in one file name, replace its end by
+    // a hash of the whole name (FNV-1a, the same in every process)
+    if (file.size() > maxFileName)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for (const char c : file)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx",
+                      static_cast<unsigned long long>(hash));
+        file = file.substr(0, maxFileName - 17) + "-" + hex;
+    }
+    return dir + "/" + file;
+}
+
+InlineShmArena::~InlineShmArena()
+{
+    if (m_Segment != nullptr)
+    {
+        shmdt(m_Segment);
+    }
+}
+
+void InlineShmArena::ComputeLayout(const uint64_t numWriters,
+                                   const uint64_t queueDepth,
+                                   const uint64_t slotSize,
+                                   const uint64_t maxReaders)
+{
+    m_ReadersOffset = Aligned(sizeof(Header));
+    m_WritersOffset =
+        Aligned(m_ReadersOffset + maxReaders * sizeof(ReaderEntry));
+    m_SlotsOffset = Aligned(m_WritersOffset + numWriters * sizeof(WriterEntry));
+    m_SlotStride = Aligned(Aligned(sizeof(SlotHeader)) + slotSize);
+    m_SegmentSize = m_SlotsOffset + numWriters * queueDepth * m_SlotStride;
+}
+
+void InlineShmArena::Create(const std::string &keyFile,
+                            const uint64_t numWriters,
+                            const uint64_t queueDepth, const uint64_t slotSize,
+                            const uint64_t maxReaders, const bool isRowMajor)
+{
+    ComputeLayout(numWriters, queueDepth, slotSize, maxReaders);
+
+    const key_t key = ftok(keyFile.c_str(), 1);
+    if (key == -1)
+    {
+        helper::Throw<std::ios_base::failure>(
+            "Engine", "InlineShmArena", "Create",
+            "ftok failed on key file " + keyFile);
+    }
+
+    // remove a stale segment left behind by a previous run
+    const int staleID = shmget(key, 0, 0);
+    if (staleID >= 0)
+    {
+        shmctl(staleID, IPC_RMID, NULL);
+    }
+
+    m_ShmID = shmget(key, m_SegmentSize, IPC_CREAT | IPC_EXCL | 0666);
+    if (m_ShmID < 0)
+    {
+        helper::Throw<std::ios_base::failure>(
+            "Engine", "InlineShmArena", "Create",
+            "could not create shared memory segment of size " +
+                std::to_string(m_SegmentSize) + " for " + keyFile);
+    }
+
+    void *data = shmat(m_ShmID, nullptr, 0);
+    if (data == reinterpret_cast<void *>(-1))
+    {
+        helper::Throw<std::ios_base::failure>(
+            "Engine", "InlineShmArena", "Create",
+            "could not attach shared memory segment for " + keyFile);
+    }
+    m_Segment = static_cast<char *>(data);
+
+    Header *header = new (m_Segment) Header();
+    header->NumWriters = numWriters;
+    header->QueueDepth = queueDepth;
+    header->SlotSize = slotSize;
+    header->MaxReaders = maxReaders;
+    header->IsRowMajor = isRowMajor;
+    header->RegisteredReaders.store(0);
+    for (uint64_t r = 0; r < maxReaders; ++r)
+    {
+        ReaderEntry *reader = new (m_Segment + m_ReadersOffset +
+                                   r * sizeof(ReaderEntry)) ReaderEntry();
+        reader->Active.store(0);
+        reader->NextStep.store(0);
+    }
+    for (uint64_t w = 0; w < numWriters; ++w)
+    {
+        WriterEntry *writer = new (m_Segment + m_WritersOffset +
+                                   w * sizeof(WriterEntry)) WriterEntry();
+        writer->PublishedSteps.store(0);
+        writer->OldestRetained.store(0);
+        writer->Closed.store(0);
+    }
+    header->Magic.store(Magic, std::memory_order_release);
+}
+
+bool InlineShmArena::Attach(const std::string &keyFile)
+{
+    const key_t key = ftok(keyFile.c_str(), 1);
+    if (key == -1)
+    {
+        return false;
+    }
+    const int shmID = shmget(key, 0, 0);
+    if (shmID < 0)
+    {
+        return false;
+    }
+    void *data = shmat(shmID, nullptr, 0);
+    if (data == reinterpret_cast<void *>(-1))
+    {
+        return false;
+    }
+    Header *header = static_cast<Header *>(data);
+    if (header->Magic.load(std::memory_order_acquire) != Magic)
+    {
+        shmdt(data);
+        return false;
+    }
+    m_ShmID = shmID;
+    m_Segment = static_cast<char *>(data);
+    ComputeLayout(header->NumWriters, header->QueueDepth, header->SlotSize,
+                  header->MaxReaders);
+    return true;
+}
+
+void InlineShmArena::Detach(const bool remove)
+{
+    if (m_Segment == nullptr)
+    {
+        return;
+    }
+    shmdt(m_Segment);
+    m_Segment = nullptr;
+    if (remove)
+    {
+        shmctl(m_ShmID, IPC_RMID, NULL);
+    }
+    m_ShmID = -1;
+}
+
+bool InlineShmArena::IsAttached() const noexcept
+{
+    return m_Segment != nullptr;
+}
+
+InlineShmArena::Header &InlineShmArena::GetHeader() noexcept
+{
+    return *reinterpret_cast<Header *>(m_Segment);
+}
+
+InlineShmArena::ReaderEntry &
+InlineShmArena::GetReader(const uint64_t readerID) noexcept
+{
+    return *reinterpret_cast<ReaderEntry *>(
+        m_Segment + m_ReadersOffset + readerID * sizeof(ReaderEntry));
+}
+
+InlineShmArena::WriterEntry &
+InlineShmArena::GetWriter(const uint64_t writerID) noexcept
+{
+    return *reinterpret_cast<WriterEntry *>(
+        m_Segment + m_WritersOffset + writerID * sizeof(WriterEntry));
+}
+
+InlineShmArena::SlotHeader &
+InlineShmArena::GetSlot(const uint64_t writerID, const uint64_t step) noexcept
+{
+    const uint64_t queueDepth = GetHeader().QueueDepth;
+    const size_t pos = m_SlotsOffset +
+                       (writerID * queueDepth + step % queueDepth) *
+                           m_SlotStride;
+    return *reinterpret_cast<SlotHeader *>(m_Segment + pos);
+}
+
+char *InlineShmArena::GetSlotPayload(const uint64_t writerID,
+                                     const uint64_t step) noexcept
+{
+    return reinterpret_cast<char *>(&GetSlot(writerID, step)) +
+           Aligned(sizeof(SlotHeader));
+}
+
+uint64_t InlineShmArena::RegisterReader()
+{
+    Header &header = GetHeader();
+    uint64_t readerID = NoStep;
+    header.Lock.lock();
+    for (uint64_t r = 0; r < header.MaxReaders; ++r)
+    {
+        ReaderEntry &reader = GetReader(r);
+        if (reader.Active.load() == 0)
+        {
+            uint64_t oldest = 0;
+            for (uint64_t w = 0; w < header.NumWriters; ++w)
+            {
+                const uint64_t retained = GetWriter(w).OldestRetained.load();
+                oldest = retained > oldest ? retained : oldest;
+            }
+            reader.NextStep.store(oldest);
+            reader.Active.store(1);
+            header.RegisteredReaders.fetch_add(1);
+            readerID = r;
+            break;
+        }
+    }
+    header.Lock.unlock();
+    return readerID;
+}
+
+void InlineShmArena::UnregisterReader(const uint64_t readerID)
+{
+    Header &header = GetHeader();
+    header.Lock.lock();
+    GetReader(readerID).Active.store(0);
+    header.Lock.unlock();
+}
+
+bool InlineShmArena::TryClaimSlot(const uint64_t writerID, const uint64_t step)
+{
+    Header &header = GetHeader();
+    if (step < header.QueueDepth)
+    {
+        return true; // slot was never used
+    }
+    const uint64_t evicted = step - header.QueueDepth;
+    bool claimed = true;
+    header.Lock.lock();
+    for (uint64_t r = 0; r < header.MaxReaders; ++r)
+    {
+        ReaderEntry &reader = GetReader(r);
+        if (reader.Active.load() != 0 &&
+            reader.NextStep.load(std::memory_order_acquire) <= evicted)
+        {
+            claimed = false;
+            break;
+        }
+    }
+    if (claimed)
+    {
+        GetWriter(writerID).OldestRetained.store(evicted + 1);
+    }
+    header.Lock.unlock();
+    return claimed;
+}
+
+uint64_t InlineShmArena::ActiveReaders()
+{
+    Header &header = GetHeader();
+    uint64_t active = 0;
+    for (uint64_t r = 0; r < header.MaxReaders; ++r)
+    {
+        active += GetReader(r).Active.load();
+    }
+    return active;
+}
+
+} // end namespace inlineshm
+} // end namespace engine
+} // end namespace core
+} // end namespace adios2
@@ -0,0 +1,159 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * InlineShmArena.h
+ * Node-local SystemV shared-memory arena shared by the InlineShm writer
+ * processes and any number of local reader processes.
+ *
+ * Layout of the segment (every section is 64-byte aligned):
+ *   Header
+ *   ReaderEntry[MaxReaders]
+ *   WriterEntry[NumWriters]
+ *   for each writer, QueueDepth slots of (SlotHeader + SlotSize bytes)
+ *
+ * Each writer owns a ring of QueueDepth slots, step s goes into slot
+ * s % QueueDepth. A slot holds the data of all Puts of that step followed by
+ * a small index describing the blocks. A writer can only reuse a slot once all
+ * active readers have moved past the step stored in it.
+ */
+
+#ifndef ADIOS2_ENGINE_INLINESHM_INLINESHMARENA_H_
+#define ADIOS2_ENGINE_INLINESHM_INLINESHMARENA_H_
+
+#include "adios2/common/ADIOSConfig.h"
+#include "adios2/toolkit/shm/Spinlock.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace adios2
+{
+namespace core
+{
+namespace engine
+{
+namespace inlineshm
+{
+
+class InlineShmArena
+{
+
+public:
+    static constexpr uint64_t Magic = 0x4d48534c4e4c4e49; // "INLNLSHM"
+    static constexpr uint64_t NoStep = UINT64_MAX;
+
+    /** kind of an entry in the per-step index */
+    enum class IndexEntry : uint8_t
+    {
+        Variable = 0,
+        Attribute = 1
+    };
+
+    struct Header
+    {
+        std::atomic<uint64_t> Magic; // set last by the creator
+        uint64_t NumWriters;
+        uint64_t QueueDepth;
+        uint64_t SlotSize;
+        uint64_t MaxReaders;
+        uint64_t IsRowMajor;
+        shm::Spinlock Lock;                       // reader (de)registration
+        std::atomic<uint64_t> RegisteredReaders; // ever registered
+    };
+
+    struct ReaderEntry
+    {
+        std::atomic<uint64_t> Active;
+        /** next step this reader will consume, i.e. all steps before this one
+         * are acknowledged and their slots can be reused */
+        std::atomic<uint64_t> NextStep;
+    };
+
+    struct WriterEntry
+    {
+        std::atomic<uint64_t> PublishedSteps; // steps [0, Published) are ready
+        std::atomic<uint64_t> OldestRetained; // oldest step still in a slot
+        std::atomic<uint64_t> Closed;
+    };
+
+    struct SlotHeader
+    {
+        uint64_t Step;
+        uint64_t DataSize; // data starts right after the SlotHeader
+        uint64_t IndexSize; // index starts at DataSize (aligned)
+        uint64_t IndexStart;
+    };
+
+    InlineShmArena() = default;
+    ~InlineShmArena();
+
+    /**
+     * Node-local key file of a stream: in /dev/shm (or TMPDIR, /tmp if that
+     * is missing), qualified by host, user and batch job so that streams of
+     * the same name in other jobs or on other nodes do not share a key
+     * @param streamName name passed to Open
+     */
+    static std::string KeyFileName(const std::string &streamName);
+
+    /**
+     * Create (or recreate) the segment. Called by one writer process per node.
+     * @param keyFile existing file used by ftok to create the key
+     */
+    void Create(const std::string &keyFile, const uint64_t numWriters,
+                const uint64_t queueDepth, const uint64_t slotSize,
+                const uint64_t maxReaders, const bool isRowMajor);
+
+    /**
+     * Attach to an existing segment
+     * @return false if the segment does not exist (yet) or is not initialized
+     */
+    bool Attach(const std::string &keyFile);
+
+    /** Detach from the segment, and mark it for removal if remove is true.
+     * The memory is released by the OS after the last process detaches. */
+    void Detach(const bool remove);
+
+    bool IsAttached() const noexcept;
+
+    Header &GetHeader() noexcept;
+    ReaderEntry &GetReader(const uint64_t readerID) noexcept;
+    WriterEntry &GetWriter(const uint64_t writerID) noexcept;
+    SlotHeader &GetSlot(const uint64_t writerID, const uint64_t step) noexcept;
+    char *GetSlotPayload(const uint64_t writerID, const uint64_t step) noexcept;
+
+    /** Register a reader in the first free entry, starting at the oldest step
+     * still available from all writers.
+     * @return reader ID, or NoStep if the reader table is full */
+    uint64_t RegisterReader();
+
+    void UnregisterReader(const uint64_t readerID);
+
+    /** Check (under lock) that no active reader needs the step that currently
+     * occupies the slot of 'step' and claim it for the writer.
+     * @return true if the slot was claimed */
+    bool TryClaimSlot(const uint64_t writerID, const uint64_t step);
+
+    uint64_t ActiveReaders();
+
+private:
+    int m_ShmID = -1;
+    char *m_Segment = nullptr;
+    size_t m_SegmentSize = 0;
+
+    size_t m_ReadersOffset = 0;
+    size_t m_WritersOffset = 0;
+    size_t m_SlotsOffset = 0;
+    size_t m_SlotStride = 0;
+
+    void ComputeLayout(const uint64_t numWriters, const uint64_t queueDepth,
+                       const uint64_t slotSize, const uint64_t maxReaders);
+};
+
+} // end namespace inlineshm
+} // end namespace engine
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_ENGINE_INLINESHM_INLINESHMARENA_H_ */
@@ -0,0 +1,423 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * InlineShmReader.cpp
+ */
+
+#include "InlineShmReader.h"
+#include "InlineShmReader.tcc"
+
+#include "adios2/helper/adiosFunctions.h"
+#include <adios2-perfstubs-interface.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace adios2
+{
+namespace core
+{
+namespace engine
+{
+
+InlineShmReader::InlineShmReader(IO &io, const std::string &name,
+                                 const Mode mode, helper::Comm comm)
+: Engine("InlineShmReader", io, name, mode, std::move(comm))
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmReader::Open");
+    m_ReaderRank = m_Comm.Rank();
+    Init();
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Reader " << m_ReaderRank << " Open(" << m_Name
+                  << ") as reader " << m_ReaderID << std::endl;
+    }
+    m_IsOpen = true;
+}
+
+InlineShmReader::~InlineShmReader()
+{
+    if (m_IsOpen)
+    {
+        DestructorClose(m_FailVerbose);
+    }
+    m_IsOpen = false;
+}
+
+StepStatus InlineShmReader::BeginStep(const StepMode mode,
+                                      const float timeoutSeconds)
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmReader::BeginStep");
+    if (m_InsideStep)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineShmReader", "BeginStep",
+            "InlineShmReader::BeginStep was called but the "
+            "reader is already inside a step");
+    }
+
+    const uint64_t numWriters = m_Arena.GetHeader().NumWriters;
+    const auto start = std::chrono::steady_clock::now();
+    while (true)
+    {
+        bool ready = true;
+        for (uint64_t w = 0; w < numWriters; ++w)
+        {
+            auto &writer = m_Arena.GetWriter(w);
+            // Closed is read first, the last step is published before it
+            const bool closed =
+                writer.Closed.load(std::memory_order_acquire) != 0;
+            if (writer.PublishedSteps.load(std::memory_order_acquire) <=
+                m_NextStep)
+            {
+                if (closed)
+                {
+                    return StepStatus::EndOfStream;
+                }
+                ready = false;
+            }
+        }
+        if (ready)
+        {
+            break;
+        }
+        if (timeoutSeconds >= 0.0)
+        {
+            const std::chrono::duration<float> elapsed =
+                std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= timeoutSeconds)
+            {
+                return StepStatus::NotReady;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+
+    m_CurrentStep = m_NextStep;
+    ParseStep();
+    m_InsideStep = true;
+
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Reader " << m_ReaderRank
+                  << "   BeginStep() new step " << m_CurrentStep << "\n";
+    }
+
+    return StepStatus::OK;
+}
+
+void InlineShmReader::PerformGets()
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmReader::PerformGets");
+    // deferred Gets are served immediately from shared memory
+}
+
+size_t InlineShmReader::CurrentStep() const { return m_CurrentStep; }
+
+void InlineShmReader::EndStep()
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmReader::EndStep");
+    if (!m_InsideStep)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineShmReader", "EndStep",
+            "InlineShmReader::EndStep() cannot be called "
+            "without a call to BeginStep() first");
+    }
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Reader " << m_ReaderRank << " EndStep() Step "
+                  << m_CurrentStep << std::endl;
+    }
+
+    // zero-copy pointers handed out in this step become invalid
+    for (const auto &pair : m_Blocks)
+    {
+        const DataType type = m_BlockTypes[pair.first];
+        if (type == DataType::Struct)
+        {
+        }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetDataType<T>())                                 \
+    {                                                                          \
+        Variable<T> *variable = m_IO.InquireVariable<T>(pair.first);           \
+        if (variable)                                                          \
+        {                                                                      \
+            variable->m_BlocksInfo.clear();                                    \
+        }                                                                      \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+    }
+
+    // acknowledge the step, writers can reuse its slots
+    m_NextStep = m_CurrentStep + 1;
+    m_Arena.GetReader(m_ReaderID)
+        .NextStep.store(m_NextStep, std::memory_order_release);
+    m_InsideStep = false;
+}
+
+// PRIVATE
+
+#define declare_type(T)                                                        \
+    void InlineShmReader::DoGetSync(Variable<T> &variable, T *data)            \
+    {                                                                          \
+        PERFSTUBS_SCOPED_TIMER("InlineShmReader::DoGetSync");                  \
+        GetCommon(variable, data);                                             \
+    }                                                                          \
+    void InlineShmReader::DoGetDeferred(Variable<T> &variable, T *data)        \
+    {                                                                          \
+        PERFSTUBS_SCOPED_TIMER("InlineShmReader::DoGetDeferred");              \
+        GetCommon(variable, data);                                             \
+    }                                                                          \
+    typename Variable<T>::BPInfo *InlineShmReader::DoGetBlockSync(             \
+        Variable<T> &variable)                                                 \
+    {                                                                          \
+        PERFSTUBS_SCOPED_TIMER("InlineShmReader::DoGetBlockSync");             \
+        return GetBlockCommon(variable);                                       \
+    }                                                                          \
+    typename Variable<T>::BPInfo *InlineShmReader::DoGetBlockDeferred(         \
+        Variable<T> &variable)                                                 \
+    {                                                                          \
+        PERFSTUBS_SCOPED_TIMER("InlineShmReader::DoGetBlockDeferred");         \
+        return GetBlockCommon(variable);                                       \
+    }
+
+ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+#define declare_type(T)                                                        \
+    std::map<size_t, std::vector<typename Variable<T>::BPInfo>>                \
+    InlineShmReader::DoAllStepsBlocksInfo(const Variable<T> &variable) const   \
+    {                                                                          \
+        PERFSTUBS_SCOPED_TIMER("InlineShmReader::AllStepsBlockInfo");          \
+        return std::map<size_t, std::vector<typename Variable<T>::BPInfo>>();  \
+    }                                                                          \
+                                                                               \
+    std::vector<typename Variable<T>::BPInfo> InlineShmReader::DoBlocksInfo(   \
+        const Variable<T> &variable, const size_t step) const                  \
+    {                                                                          \
+        PERFSTUBS_SCOPED_TIMER("InlineShmReader::DoBlocksInfo");               \
+        return BlocksInfoCommon(variable);                                     \
+    }
+
+ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+const std::vector<InlineShmReader::BlockRef> &
+InlineShmReader::GetBlocks(const VariableBase &variable) const
+{
+    auto it = m_Blocks.find(variable.m_Name);
+    if (it == m_Blocks.end())
+    {
+        helper::Throw<std::invalid_argument>(
+            "Engine", "InlineShmReader", "GetBlocks",
+            "variable " + variable.m_Name + " was not written in step " +
+                std::to_string(m_CurrentStep));
+    }
+    return it->second;
+}
+
+void InlineShmReader::ParseStep()
+{
+    using IndexEntry = inlineshm::InlineShmArena::IndexEntry;
+
+    std::unordered_map<std::string, DataType> previousTypes;
+    previousTypes.swap(m_BlockTypes);
+    m_Blocks.clear();
+
+    std::vector<char> index;
+    const uint64_t numWriters = m_Arena.GetHeader().NumWriters;
+    for (uint64_t w = 0; w < numWriters; ++w)
+    {
+        const auto &slot = m_Arena.GetSlot(w, m_CurrentStep);
+        if (slot.Step != m_CurrentStep)
+        {
+            helper::Throw<std::runtime_error>(
+                "Engine", "InlineShmReader", "ParseStep",
+                "slot of writer " + std::to_string(w) + " holds step " +
+                    std::to_string(slot.Step) + " instead of step " +
+                    std::to_string(m_CurrentStep));
+        }
+        const char *payload = m_Arena.GetSlotPayload(w, m_CurrentStep);
+        index.assign(payload + slot.IndexStart,
+                     payload + slot.IndexStart + slot.IndexSize);
+
+        size_t position = 0;
+        while (position < index.size())
+        {
+            const auto entry = static_cast<IndexEntry>(
+                helper::ReadValue<uint8_t>(index, position));
+            const uint64_t nameSize =
+                helper::ReadValue<uint64_t>(index, position);
+            const std::string name(index.data() + position, nameSize);
+            position += nameSize;
+            const auto type = static_cast<DataType>(
+                helper::ReadValue<uint8_t>(index, position));
+
+            if (entry == IndexEntry::Attribute)
+            {
+                ParseAttribute(name, type, index, position);
+                continue;
+            }
+
+            BlockRef block;
+            block.WriterID = w;
+            block.Shape = static_cast<ShapeID>(
+                helper::ReadValue<uint8_t>(index, position));
+            for (Dims *dims : {&block.ShapeDims, &block.Start, &block.Count})
+            {
+                dims->resize(helper::ReadValue<uint64_t>(index, position));
+                for (auto &d : *dims)
+                {
+                    d = helper::ReadValue<uint64_t>(index, position);
+                }
+            }
+            block.Data =
+                payload + helper::ReadValue<uint64_t>(index, position);
+            block.Size = helper::ReadValue<uint64_t>(index, position);
+            m_Blocks[name].push_back(block);
+            m_BlockTypes[name] = type;
+        }
+    }
+
+    // variables only exist in the steps they were written in
+    for (const auto &pair : previousTypes)
+    {
+        if (m_Blocks.count(pair.first) == 0)
+        {
+            m_IO.RemoveVariable(pair.first);
+        }
+    }
+
+    for (const auto &pair : m_Blocks)
+    {
+        const DataType type = m_BlockTypes[pair.first];
+        if (type == DataType::Struct)
+        {
+        }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetDataType<T>())                                 \
+    {                                                                          \
+        DefineVariable<T>(pair.first, pair.second);                            \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+    }
+}
+
+void InlineShmReader::ParseAttribute(const std::string &name,
+                                     const DataType type,
+                                     const std::vector<char> &index,
+                                     size_t &position)
+{
+    const bool isSingleValue = helper::ReadValue<uint8_t>(index, position) != 0;
+    const size_t elements = helper::ReadValue<uint64_t>(index, position);
+
+    if (type == DataType::Struct)
+    {
+    }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetDataType<T>())                                 \
+    {                                                                          \
+        DefineAttribute<T>(name, index, position, isSingleValue, elements);    \
+    }
+    ADIOS2_FOREACH_ATTRIBUTE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+}
+
+void InlineShmReader::Init()
+{
+    InitParameters();
+    InitTransports();
+}
+
+void InlineShmReader::InitParameters()
+{
+    for (const auto &pair : m_IO.m_Parameters)
+    {
+        std::string key(pair.first);
+        std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+
+        std::string value(pair.second);
+
+        if (key == "verbose")
+        {
+            m_Verbosity = std::stoi(value);
+            if (m_Verbosity < 0 || m_Verbosity > 5)
+                helper::Throw<std::invalid_argument>(
+                    "Engine", "InlineShmReader", "InitParameters",
+                    "Method verbose argument must be an "
+                    "integer in the range [0,5], in call to "
+                    "Open or Engine constructor");
+        }
+        else if (key == "opentimeoutsecs")
+        {
+            m_OpenTimeoutSecs = std::stof(value);
+        }
+    }
+}
+
+void InlineShmReader::InitTransports()
+{
+    // wait for the writers of this node to create the arena
+    const std::string keyFile =
+        inlineshm::InlineShmArena::KeyFileName(m_Name);
+    const auto start = std::chrono::steady_clock::now();
+    while (!m_Arena.Attach(keyFile))
+    {
+        const std::chrono::duration<float> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= m_OpenTimeoutSecs)
+        {
+            helper::Throw<std::runtime_error>(
+                "Engine", "InlineShmReader", "InitTransports",
+                "no InlineShm writer found for stream " + m_Name +
+                    " on this node after " + std::to_string(m_OpenTimeoutSecs) +
+                    " seconds");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if ((m_Arena.GetHeader().IsRowMajor != 0) !=
+        helper::IsRowMajor(m_IO.m_HostLanguage))
+    {
+        helper::Throw<std::invalid_argument>(
+            "Engine", "InlineShmReader", "InitTransports",
+            "writers and reader of stream " + m_Name +
+                " must use the same array ordering");
+    }
+
+    m_ReaderID = m_Arena.RegisterReader();
+    if (m_ReaderID == inlineshm::InlineShmArena::NoStep)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineShmReader", "InitTransports",
+            "too many readers attached to stream " + m_Name +
+                ", increase the MaxReaders parameter of the writer");
+    }
+    m_NextStep = m_Arena.GetReader(m_ReaderID).NextStep.load();
+}
+
+void InlineShmReader::DoClose(const int transportIndex)
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmReader::DoClose");
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Reader " << m_ReaderRank << " Close(" << m_Name
+                  << ")\n";
+    }
+    m_Arena.UnregisterReader(m_ReaderID);
+    m_Arena.Detach(false);
+}
+
+#define declare_type(T)                                                        \
+    template void InlineShmReader::Get<T>(Variable<T> &, T **) const;
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+} // end namespace engine
+} // end namespace core
+} // end namespace adios2
@@ -0,0 +1,143 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * InlineShmReader.h
+ * A node-local reader which accesses the blocks published by InlineShmWriter
+ * processes directly in the shared-memory arena. Blocks can be retrieved
+ * zero-copy (Get with Info or T**), or copied into a user selection.
+ */
+
+#ifndef ADIOS2_ENGINE_INLINESHMREADER_H_
+#define ADIOS2_ENGINE_INLINESHMREADER_H_
+
+#include "InlineShmArena.h"
+
+#include "adios2/common/ADIOSConfig.h"
+#include "adios2/core/ADIOS.h"
+#include "adios2/core/Engine.h"
+#include "adios2/helper/adiosComm.h"
+#include "adios2/helper/adiosFunctions.h"
+
+#include <unordered_map>
+
+namespace adios2
+{
+namespace core
+{
+namespace engine
+{
+
+class InlineShmReader : public Engine
+{
+public:
+    /**
+     * Constructor for the reader, attaches to the arena created by the writers
+     * of this node
+     * @param name name of the stream used by the writers
+     * @param accessMode
+     * @param comm
+     */
+    InlineShmReader(IO &adios, const std::string &name, const Mode mode,
+                    helper::Comm comm);
+
+    ~InlineShmReader();
+    StepStatus BeginStep(StepMode mode = StepMode::Read,
+                         const float timeoutSeconds = -1.0) final;
+    void PerformGets() final;
+    size_t CurrentStep() const final;
+    void EndStep() final;
+
+    /** zero-copy access to the block selected with SetBlockSelection, the
+     * pointer is valid until EndStep */
+    template <typename T>
+    void Get(Variable<T> &, T **) const;
+
+private:
+    /** A block published by a writer in the current step */
+    struct BlockRef
+    {
+        size_t WriterID;
+        ShapeID Shape;
+        Dims ShapeDims;
+        Dims Start;
+        Dims Count;
+        const char *Data; // in shared memory
+        size_t Size;
+    };
+
+    int m_Verbosity = 0;
+    int m_ReaderRank; // my rank in the readers' comm
+    float m_OpenTimeoutSecs = 60.0;
+
+    inlineshm::InlineShmArena m_Arena;
+    uint64_t m_ReaderID = inlineshm::InlineShmArena::NoStep;
+
+    size_t m_CurrentStep = static_cast<size_t>(-1);
+    size_t m_NextStep = 0;
+    bool m_InsideStep = false;
+
+    /** blocks of the current step, key: variable name */
+    std::unordered_map<std::string, std::vector<BlockRef>> m_Blocks;
+    /** type of each variable in m_Blocks */
+    std::unordered_map<std::string, DataType> m_BlockTypes;
+
+    void Init() final;
+    void InitParameters() final;
+    void InitTransports() final;
+
+#define declare_type(T)                                                        \
+    void DoGetSync(Variable<T> &, T *) final;                                  \
+    void DoGetDeferred(Variable<T> &, T *) final;                              \
+    typename Variable<T>::BPInfo *DoGetBlockSync(Variable<T> &) final;         \
+    typename Variable<T>::BPInfo *DoGetBlockDeferred(Variable<T> &) final;
+    ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+    void DoClose(const int transportIndex = -1) final;
+
+    /** Parse the index of every writer for the current step */
+    void ParseStep();
+
+    void ParseAttribute(const std::string &name, const DataType type,
+                        const std::vector<char> &index, size_t &position);
+
+    template <class T>
+    void DefineVariable(const std::string &name,
+                        const std::vector<BlockRef> &blocks);
+
+    template <class T>
+    void DefineAttribute(const std::string &name,
+                         const std::vector<char> &index, size_t &position,
+                         const bool isSingleValue, const size_t elements);
+
+    const std::vector<BlockRef> &GetBlocks(const VariableBase &variable) const;
+
+    /** Copy the selection of the variable out of the arena. Data is already
+     * resident in shared memory so deferred Gets are served right away. */
+    template <class T>
+    void GetCommon(Variable<T> &variable, T *data);
+
+    template <class T>
+    typename Variable<T>::BPInfo *GetBlockCommon(Variable<T> &variable);
+
+#define declare_type(T)                                                        \
+    std::map<size_t, std::vector<typename Variable<T>::BPInfo>>                \
+    DoAllStepsBlocksInfo(const Variable<T> &variable) const final;             \
+                                                                               \
+    std::vector<typename Variable<T>::BPInfo> DoBlocksInfo(                    \
+        const Variable<T> &variable, const size_t step) const final;
+
+    ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+    template <class T>
+    std::vector<typename Variable<T>::BPInfo>
+    BlocksInfoCommon(const Variable<T> &variable) const;
+};
+
+} // end namespace engine
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_ENGINE_INLINESHMREADER_H_ */
@@ -0,0 +1,355 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * InlineShmReader.tcc
+ */
+
+#ifndef ADIOS2_ENGINE_INLINESHMREADER_TCC_
+#define ADIOS2_ENGINE_INLINESHMREADER_TCC_
+
+#include "InlineShmReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace adios2
+{
+namespace core
+{
+namespace engine
+{
+
+template <class T>
+void InlineShmReader::DefineVariable(const std::string &name,
+                                     const std::vector<BlockRef> &blocks)
+{
+    Variable<T> *variable = m_IO.InquireVariable<T>(name);
+    const bool isNew = (variable == nullptr);
+    if (isNew)
+    {
+        variable = &m_IO.DefineVariable<T>(name);
+        variable->m_Engine = this;
+    }
+    variable->m_AvailableStepsCount = 1;
+    variable->m_FirstStreamingStep = false;
+    variable->m_BlocksInfo.clear();
+
+    const BlockRef &first = blocks.front();
+    switch (first.Shape)
+    {
+    case ShapeID::GlobalValue:
+        break;
+    case ShapeID::LocalValue:
+        // Local single values show up as global arrays on the reader
+        variable->m_Shape = {blocks.size()};
+        if (isNew)
+        {
+            variable->m_Start = {0};
+            variable->m_Count = {blocks.size()};
+        }
+        variable->m_ShapeID = ShapeID::GlobalArray;
+        variable->m_SingleValue = false;
+        break;
+    case ShapeID::GlobalArray:
+        variable->m_Shape = first.ShapeDims;
+        if (isNew)
+        {
+            variable->m_Start = Dims(first.ShapeDims.size(), 0);
+            variable->m_Count = first.ShapeDims;
+        }
+        variable->m_ShapeID = ShapeID::GlobalArray;
+        variable->m_SingleValue = false;
+        break;
+    case ShapeID::LocalArray:
+        variable->m_Shape.clear();
+        if (isNew)
+        {
+            variable->m_Start.clear();
+            variable->m_Count = first.Count;
+        }
+        variable->m_ShapeID = ShapeID::LocalArray;
+        variable->m_SingleValue = false;
+        break;
+    default:
+        helper::Throw<std::invalid_argument>(
+            "Engine", "InlineShmReader", "DefineVariable",
+            "unsupported shape of variable " + name);
+    }
+}
+
+template <class T>
+void InlineShmReader::DefineAttribute(const std::string &name,
+                                      const std::vector<char> &index,
+                                      size_t &position,
+                                      const bool isSingleValue,
+                                      const size_t elements)
+{
+    std::vector<T> values(elements);
+    helper::ReadArray(index, position, values.data(), elements);
+    if (m_IO.InquireAttribute<T>(name) != nullptr)
+    {
+        return;
+    }
+    if (isSingleValue)
+    {
+        m_IO.DefineAttribute<T>(name, values.front());
+    }
+    else
+    {
+        m_IO.DefineAttribute<T>(name, values.data(), values.size());
+    }
+}
+
+template <>
+inline void InlineShmReader::DefineAttribute<std::string>(
+    const std::string &name, const std::vector<char> &index, size_t &position,
+    const bool isSingleValue, const size_t elements)
+{
+    std::vector<std::string> values(elements);
+    for (auto &value : values)
+    {
+        const uint64_t valueSize = helper::ReadValue<uint64_t>(index, position);
+        value.assign(index.data() + position, valueSize);
+        position += valueSize;
+    }
+    if (m_IO.InquireAttribute<std::string>(name) != nullptr)
+    {
+        return;
+    }
+    if (isSingleValue)
+    {
+        m_IO.DefineAttribute<std::string>(name, values.front());
+    }
+    else
+    {
+        m_IO.DefineAttribute<std::string>(name, values.data(), values.size());
+    }
+}
+
+template <>
+inline void InlineShmReader::GetCommon(Variable<std::string> &variable,
+                                       std::string *data)
+{
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Reader " << m_ReaderRank << "     Get("
+                  << variable.m_Name << ")\n";
+    }
+    const BlockRef &block = GetBlocks(variable).front();
+    data->assign(block.Data, block.Size);
+}
+
+template <class T>
+void InlineShmReader::GetCommon(Variable<T> &variable, T *data)
+{
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Reader " << m_ReaderRank << "     Get("
+                  << variable.m_Name << ")\n";
+    }
+    const std::vector<BlockRef> &blocks = GetBlocks(variable);
+    const ShapeID shape = blocks.front().Shape;
+
+    if (shape == ShapeID::GlobalValue)
+    {
+        std::memcpy(data, blocks.front().Data, sizeof(T));
+        return;
+    }
+
+    if (shape == ShapeID::LocalValue)
+    {
+        // one element per block, selected as a 1D global array
+        const size_t start = variable.m_Start.empty() ? 0 : variable.m_Start[0];
+        const size_t count =
+            variable.m_Count.empty() ? blocks.size() : variable.m_Count[0];
+        if (start + count > blocks.size())
+        {
+            helper::Throw<std::invalid_argument>(
+                "Engine", "InlineShmReader", "GetCommon",
+                "selection of local value " + variable.m_Name +
+                    " is out of bounds");
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(data + i, blocks[start + i].Data, sizeof(T));
+        }
+        return;
+    }
+
+    // blocks are in the reader's ordering, Open checks the writers use it;
+    // like BP5, column-major dims are reversed and copied as row-major
+    const bool isRowMajor = helper::IsRowMajor(m_IO.m_HostLanguage);
+    auto rowMajorDims = [isRowMajor](const Dims &dims) {
+        helper::DimsArray ordered(dims);
+        if (!isRowMajor)
+        {
+            std::reverse(ordered.begin(), ordered.end());
+        }
+        return ordered;
+    };
+    if (variable.m_SelectionType == SelectionType::WriteBlock ||
+        variable.m_ShapeID == ShapeID::LocalArray)
+    {
+        if (variable.m_BlockID >= blocks.size())
+        {
+            helper::Throw<std::invalid_argument>(
+                "Engine", "InlineShmReader", "GetCommon",
+                "selected BlockID " + std::to_string(variable.m_BlockID) +
+                    " is above range of available blocks of variable " +
+                    variable.m_Name);
+        }
+        const BlockRef &block = blocks[variable.m_BlockID];
+        if (variable.m_SelectionType == SelectionType::WriteBlock ||
+            variable.m_Start.size() != block.Count.size())
+        {
+            std::memcpy(data, block.Data, block.Size);
+        }
+        else
+        {
+            // a subset of a local block, in block-local coordinates
+            helper::NdCopy(block.Data,
+                           helper::DimsArray(block.Count.size(), size_t(0)),
+                           rowMajorDims(block.Count), true, true,
+                           reinterpret_cast<char *>(data),
+                           rowMajorDims(variable.m_Start),
+                           rowMajorDims(variable.m_Count), true, true,
+                           sizeof(T));
+        }
+        return;
+    }
+
+    const helper::DimsArray selStart = rowMajorDims(variable.m_Start);
+    const helper::DimsArray selCount = rowMajorDims(variable.m_Count);
+    for (const BlockRef &block : blocks)
+    {
+        helper::NdCopy(block.Data, rowMajorDims(block.Start),
+                       rowMajorDims(block.Count), true, true,
+                       reinterpret_cast<char *>(data), selStart, selCount,
+                       true, true, sizeof(T));
+    }
+}
+
+template <class T>
+typename Variable<T>::BPInfo *
+InlineShmReader::GetBlockCommon(Variable<T> &variable)
+{
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Reader " << m_ReaderRank << "     GetBlock("
+                  << variable.m_Name << ")\n";
+    }
+    if (variable.m_BlocksInfo.empty())
+    {
+        variable.m_BlocksInfo = BlocksInfoCommon(variable);
+        for (auto &info : variable.m_BlocksInfo)
+        {
+            if (info.IsValue)
+            {
+                info.Data = &info.Value;
+                info.BufferP = info.Data;
+            }
+        }
+    }
+    if (variable.m_BlockID >= variable.m_BlocksInfo.size())
+    {
+        helper::Throw<std::invalid_argument>(
+            "Engine", "InlineShmReader", "GetBlockCommon",
+            "selected BlockID " + std::to_string(variable.m_BlockID) +
+                " is above range of available blocks in GetBlock");
+    }
+    return &variable.m_BlocksInfo[variable.m_BlockID];
+}
+
+template <class T>
+std::vector<typename Variable<T>::BPInfo>
+InlineShmReader::BlocksInfoCommon(const Variable<T> &variable) const
+{
+    std::vector<typename Variable<T>::BPInfo> blocksInfo;
+    auto it = m_Blocks.find(variable.m_Name);
+    if (it == m_Blocks.end())
+    {
+        return blocksInfo;
+    }
+    blocksInfo.reserve(it->second.size());
+    for (const BlockRef &block : it->second)
+    {
+        blocksInfo.emplace_back();
+        auto &info = blocksInfo.back();
+        info.Shape = block.ShapeDims;
+        info.Start = block.Start;
+        info.Count = block.Count;
+        info.Step = m_CurrentStep;
+        info.StepsStart = m_CurrentStep;
+        info.StepsCount = 1;
+        info.BlockID = blocksInfo.size() - 1;
+        info.WriterID = static_cast<int>(block.WriterID);
+        // zero-copy: the block stays in shared memory until EndStep
+        info.Data = reinterpret_cast<T *>(const_cast<char *>(block.Data));
+        info.BufferP = info.Data;
+        if (block.Shape == ShapeID::GlobalValue ||
+            block.Shape == ShapeID::LocalValue)
+        {
+            info.IsValue = true;
+            std::memcpy(&info.Value, block.Data, sizeof(T));
+        }
+    }
+    return blocksInfo;
+}
+
+template <>
+inline std::vector<typename Variable<std::string>::BPInfo>
+InlineShmReader::BlocksInfoCommon(const Variable<std::string> &variable) const
+{
+    std::vector<typename Variable<std::string>::BPInfo> blocksInfo;
+    auto it = m_Blocks.find(variable.m_Name);
+    if (it == m_Blocks.end())
+    {
+        return blocksInfo;
+    }
+    blocksInfo.reserve(it->second.size());
+    for (const BlockRef &block : it->second)
+    {
+        blocksInfo.emplace_back();
+        auto &info = blocksInfo.back();
+        info.Step = m_CurrentStep;
+        info.StepsStart = m_CurrentStep;
+        info.StepsCount = 1;
+        info.BlockID = blocksInfo.size() - 1;
+        info.WriterID = static_cast<int>(block.WriterID);
+        info.IsValue = true;
+        info.Value.assign(block.Data, block.Size);
+    }
+    return blocksInfo;
+}
+
+template <class T>
+void InlineShmReader::Get(Variable<T> &variable, T **data) const
+{
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Reader " << m_ReaderRank << "     Get("
+                  << variable.m_Name << ", T**)\n";
+    }
+    const std::vector<BlockRef> &blocks = GetBlocks(variable);
+    const size_t blockID =
+        variable.m_SelectionType == SelectionType::WriteBlock
+            ? variable.m_BlockID
+            : 0;
+    if (blockID >= blocks.size())
+    {
+        helper::Throw<std::invalid_argument>(
+            "Engine", "InlineShmReader", "Get",
+            "selected BlockID " + std::to_string(blockID) +
+                " is above range of available blocks of variable " +
+                variable.m_Name);
+    }
+    *data = reinterpret_cast<T *>(const_cast<char *>(blocks[blockID].Data));
+}
+
+} // end namespace engine
+} // end namespace core
+} // end namespace adios2
+
+#endif // ADIOS2_ENGINE_INLINESHMREADER_TCC_
@@ -0,0 +1,386 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * InlineShmWriter.cpp
+ */
+
+#include "InlineShmWriter.h"
+#include "InlineShmWriter.tcc"
+
+#include "adios2/helper/adiosFunctions.h"
+#include <adios2-perfstubs-interface.h>
+
+#include <chrono>
+#include <cstdio>  // std::remove
+#include <fstream> // key file
+#include <iostream>
+#include <thread>
+
+namespace adios2
+{
+namespace core
+{
+namespace engine
+{
+
+InlineShmWriter::InlineShmWriter(IO &io, const std::string &name,
+                                 const Mode mode, helper::Comm comm)
+: Engine("InlineShmWriter", io, name, mode, std::move(comm))
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmWriter::Open");
+    m_NodeComm = m_Comm.GroupByShm("creating per-node comm at Open");
+    m_WriterID = m_NodeComm.Rank();
+    Init();
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Writer " << m_WriterID << " Open(" << m_Name
+                  << ")." << std::endl;
+    }
+    m_IsOpen = true;
+}
+
+InlineShmWriter::~InlineShmWriter()
+{
+    if (m_IsOpen)
+    {
+        DestructorClose(m_FailVerbose);
+    }
+    m_IsOpen = false;
+}
+
+StepStatus InlineShmWriter::BeginStep(StepMode mode,
+                                      const float timeoutSeconds)
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmWriter::BeginStep");
+    if (m_InsideStep)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineShmWriter", "BeginStep",
+            "InlineShmWriter::BeginStep was called but the "
+            "writer is already inside a step");
+    }
+
+    const size_t nextStep =
+        (m_CurrentStep == static_cast<size_t>(-1)) ? 0 : m_CurrentStep + 1;
+    auto &header = m_Arena.GetHeader();
+    const auto start = std::chrono::steady_clock::now();
+    auto lf_TimedOut = [&]() -> bool {
+        if (timeoutSeconds < 0.0)
+        {
+            return false;
+        }
+        const std::chrono::duration<float> elapsed =
+            std::chrono::steady_clock::now() - start;
+        return elapsed.count() >= timeoutSeconds;
+    };
+
+    // the first step waits for the expected readers, later steps wait for the
+    // readers to acknowledge the step that occupies the slot to be reused
+    while (header.RegisteredReaders.load() < m_RendezvousReaderCount ||
+           !m_Arena.TryClaimSlot(m_WriterID, nextStep))
+    {
+        if (lf_TimedOut())
+        {
+            return StepStatus::NotReady;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+
+    m_CurrentStep = nextStep;
+    m_InsideStep = true;
+    m_Payload = m_Arena.GetSlotPayload(m_WriterID, m_CurrentStep);
+    m_DataPosition = 0;
+    m_Index.clear();
+
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Writer " << m_WriterID
+                  << "   BeginStep() new step " << m_CurrentStep << "\n";
+    }
+    return StepStatus::OK;
+}
+
+size_t InlineShmWriter::CurrentStep() const { return m_CurrentStep; }
+
+void InlineShmWriter::PerformPuts()
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmWriter::PerformPuts");
+    // all Puts are copied into the arena immediately
+}
+
+void InlineShmWriter::EndStep()
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmWriter::EndStep");
+    if (!m_InsideStep)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineShmWriter", "EndStep",
+            "InlineShmWriter::EndStep() cannot be called "
+            "without a call to BeginStep() first");
+    }
+
+    if (m_WriterID == 0)
+    {
+        SerializeAttributes();
+    }
+
+    auto &slot = m_Arena.GetSlot(m_WriterID, m_CurrentStep);
+    const size_t indexStart =
+        m_DataPosition + helper::PaddingToAlignOffset(m_DataPosition, 8);
+    if (indexStart + m_Index.size() > m_SlotSize)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineShmWriter", "EndStep",
+            "step " + std::to_string(m_CurrentStep) + " needs " +
+                std::to_string(indexStart + m_Index.size()) +
+                " bytes, which exceeds the SlotSize parameter " +
+                std::to_string(m_SlotSize));
+    }
+    std::memcpy(m_Payload + indexStart, m_Index.data(), m_Index.size());
+    slot.Step = m_CurrentStep;
+    slot.DataSize = m_DataPosition;
+    slot.IndexStart = indexStart;
+    slot.IndexSize = m_Index.size();
+
+    // publish the step to the readers
+    m_Arena.GetWriter(m_WriterID)
+        .PublishedSteps.store(m_CurrentStep + 1, std::memory_order_release);
+
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Writer " << m_WriterID << " EndStep() Step "
+                  << m_CurrentStep << " data size " << m_DataPosition
+                  << " index size " << m_Index.size() << std::endl;
+    }
+    m_Payload = nullptr;
+    m_InsideStep = false;
+}
+
+void InlineShmWriter::Flush(const int)
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmWriter::Flush");
+}
+
+// PRIVATE
+
+#define declare_type(T)                                                        \
+    void InlineShmWriter::DoPutSync(Variable<T> &variable, const T *data)      \
+    {                                                                          \
+        PERFSTUBS_SCOPED_TIMER("InlineShmWriter::DoPutSync");                  \
+        PutCommon(variable, data);                                             \
+    }                                                                          \
+    void InlineShmWriter::DoPutDeferred(Variable<T> &variable, const T *data)  \
+    {                                                                          \
+        PERFSTUBS_SCOPED_TIMER("InlineShmWriter::DoPutDeferred");              \
+        PutCommon(variable, data);                                             \
+    }
+ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+char *InlineShmWriter::ReserveBlock(const VariableBase &variable,
+                                    const size_t size)
+{
+    if (!m_InsideStep)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineShmWriter", "ReserveBlock",
+            "Put of variable " + variable.m_Name +
+                " must be called between BeginStep and EndStep");
+    }
+
+    const size_t offset =
+        m_DataPosition + helper::PaddingToAlignOffset(m_DataPosition, 64);
+    if (offset + size > m_SlotSize)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineShmWriter", "ReserveBlock",
+            "Put of variable " + variable.m_Name + " with " +
+                std::to_string(size) +
+                " bytes exceeds the SlotSize parameter " +
+                std::to_string(m_SlotSize) + " in step " +
+                std::to_string(m_CurrentStep));
+    }
+    m_DataPosition = offset + size;
+
+    const uint8_t entry =
+        static_cast<uint8_t>(inlineshm::InlineShmArena::IndexEntry::Variable);
+    helper::InsertToBuffer(m_Index, &entry);
+    const uint64_t nameSize = variable.m_Name.size();
+    helper::InsertToBuffer(m_Index, &nameSize);
+    helper::InsertToBuffer(m_Index, variable.m_Name.data(), nameSize);
+    const uint8_t type = static_cast<uint8_t>(variable.m_Type);
+    helper::InsertToBuffer(m_Index, &type);
+    const uint8_t shapeID = static_cast<uint8_t>(variable.m_ShapeID);
+    helper::InsertToBuffer(m_Index, &shapeID);
+    for (const Dims *dims :
+         {&variable.m_Shape, &variable.m_Start, &variable.m_Count})
+    {
+        const uint64_t ndim = dims->size();
+        helper::InsertToBuffer(m_Index, &ndim);
+        for (const size_t d : *dims)
+        {
+            const uint64_t d64 = d;
+            helper::InsertToBuffer(m_Index, &d64);
+        }
+    }
+    const uint64_t offset64 = offset;
+    const uint64_t size64 = size;
+    helper::InsertToBuffer(m_Index, &offset64);
+    helper::InsertToBuffer(m_Index, &size64);
+
+    return m_Payload + offset;
+}
+
+void InlineShmWriter::SerializeAttributes()
+{
+    const uint8_t entry =
+        static_cast<uint8_t>(inlineshm::InlineShmArena::IndexEntry::Attribute);
+
+    for (const auto &attributePair : m_IO.GetAttributes())
+    {
+        const AttributeBase &attribute = *attributePair.second;
+        helper::InsertToBuffer(m_Index, &entry);
+        const uint64_t nameSize = attribute.m_Name.size();
+        helper::InsertToBuffer(m_Index, &nameSize);
+        helper::InsertToBuffer(m_Index, attribute.m_Name.data(), nameSize);
+        const uint8_t type = static_cast<uint8_t>(attribute.m_Type);
+        helper::InsertToBuffer(m_Index, &type);
+        const uint8_t isSingleValue = attribute.m_IsSingleValue ? 1 : 0;
+        helper::InsertToBuffer(m_Index, &isSingleValue);
+
+        if (attribute.m_Type == DataType::String)
+        {
+            const auto &a =
+                static_cast<const Attribute<std::string> &>(attribute);
+            const std::vector<std::string> values =
+                a.m_IsSingleValue
+                    ? std::vector<std::string>{a.m_DataSingleValue}
+                    : a.m_DataArray;
+            const uint64_t elements = values.size();
+            helper::InsertToBuffer(m_Index, &elements);
+            for (const auto &value : values)
+            {
+                const uint64_t valueSize = value.size();
+                helper::InsertToBuffer(m_Index, &valueSize);
+                helper::InsertToBuffer(m_Index, value.data(), valueSize);
+            }
+        }
+#define declare_type(T)                                                        \
+    else if (attribute.m_Type == helper::GetDataType<T>())                     \
+    {                                                                          \
+        const auto &a = static_cast<const Attribute<T> &>(attribute);          \
+        const uint64_t elements =                                              \
+            a.m_IsSingleValue ? 1 : a.m_DataArray.size();                      \
+        helper::InsertToBuffer(m_Index, &elements);                            \
+        helper::InsertToBuffer(m_Index,                                        \
+                               a.m_IsSingleValue ? &a.m_DataSingleValue        \
+                                                 : a.m_DataArray.data(),       \
+                               elements);                                      \
+    }
+        ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+    }
+}
+
+void InlineShmWriter::Init()
+{
+    InitParameters();
+    InitTransports();
+}
+
+void InlineShmWriter::InitParameters()
+{
+    for (const auto &pair : m_IO.m_Parameters)
+    {
+        std::string key(pair.first);
+        std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+
+        std::string value(pair.second);
+
+        if (key == "verbose")
+        {
+            m_Verbosity = std::stoi(value);
+            if (m_Verbosity < 0 || m_Verbosity > 5)
+                helper::Throw<std::invalid_argument>(
+                    "Engine", "InlineShmWriter", "InitParameters",
+                    "Method verbose argument must be an "
+                    "integer in the range [0,5], in call to "
+                    "Open or Engine constructor");
+        }
+        else if (key == "queuedepth")
+        {
+            m_QueueDepth = helper::StringToSizeT(value, "for QueueDepth");
+            if (m_QueueDepth == 0)
+            {
+                helper::Throw<std::invalid_argument>(
+                    "Engine", "InlineShmWriter", "InitParameters",
+                    "QueueDepth must be at least 1");
+            }
+        }
+        else if (key == "slotsize")
+        {
+            m_SlotSize = helper::StringToByteUnits(helper::LowerCase(value),
+                                                 "for SlotSize");
+        }
+        else if (key == "maxreaders")
+        {
+            m_MaxReaders = helper::StringToSizeT(value, "for MaxReaders");
+        }
+        else if (key == "rendezvousreadercount")
+        {
+            m_RendezvousReaderCount =
+                helper::StringToSizeT(value, "for RendezvousReaderCount");
+        }
+    }
+}
+
+void InlineShmWriter::InitTransports()
+{
+    m_KeyFile = inlineshm::InlineShmArena::KeyFileName(m_Name);
+    if (m_WriterID == 0)
+    {
+        {
+            std::ofstream keyFile(m_KeyFile);
+            if (!keyFile)
+            {
+                helper::Throw<std::ios_base::failure>(
+                    "Engine", "InlineShmWriter", "InitTransports",
+                    "could not create the key file " + m_KeyFile);
+            }
+            keyFile << "ADIOS2 InlineShm stream " << m_Name << "\n";
+        }
+        m_Arena.Create(m_KeyFile, static_cast<uint64_t>(m_NodeComm.Size()),
+                       m_QueueDepth, m_SlotSize, m_MaxReaders,
+                       helper::IsRowMajor(m_IO.m_HostLanguage));
+    }
+    m_NodeComm.Barrier("waiting for shared-memory arena creation at Open");
+    if (m_WriterID != 0 && !m_Arena.Attach(m_KeyFile))
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "InlineShmWriter", "InitTransports",
+            "could not attach to the shared-memory arena of " + m_Name);
+    }
+}
+
+void InlineShmWriter::DoClose(const int transportIndex)
+{
+    PERFSTUBS_SCOPED_TIMER("InlineShmWriter::DoClose");
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Writer " << m_WriterID << " Close(" << m_Name
+                  << ")\n";
+    }
+    // end of stream, readers still attached keep the segment alive
+    m_Arena.GetWriter(m_WriterID).Closed.store(1, std::memory_order_release);
+    m_NodeComm.Barrier("waiting for writers to close the arena");
+    m_Arena.Detach(m_WriterID == 0);
+    if (m_WriterID == 0)
+    {
+        std::remove(m_KeyFile.c_str());
+    }
+}
+
+} // end namespace engine
+} // end namespace core
+} // end namespace adios2
@@ -0,0 +1,103 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * InlineShmWriter.h
+ * A node-local writer which places each step's blocks in a shared-memory
+ * arena, so that reader processes on the same node can access them without
+ * going through the network or the file system.
+ */
+
+#ifndef ADIOS2_ENGINE_INLINESHMWRITER_H_
+#define ADIOS2_ENGINE_INLINESHMWRITER_H_
+
+#include "InlineShmArena.h"
+
+#include "adios2/common/ADIOSConfig.h"
+#include "adios2/core/Engine.h"
+#include "adios2/helper/adiosComm.h"
+#include "adios2/helper/adiosFunctions.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace engine
+{
+
+class InlineShmWriter : public Engine
+{
+
+public:
+    /**
+     * Constructor for Writer
+     * @param name unique name given to the engine, also used as the key file
+     * of the shared-memory arena
+     * @param accessMode
+     * @param comm
+     */
+    InlineShmWriter(IO &adios, const std::string &name, const Mode mode,
+                    helper::Comm comm);
+
+    ~InlineShmWriter();
+
+    StepStatus BeginStep(StepMode mode,
+                         const float timeoutSeconds = -1.0) final;
+    size_t CurrentStep() const final;
+    void PerformPuts() final;
+    void EndStep() final;
+    void Flush(const int transportIndex = -1) final;
+
+private:
+    int m_Verbosity = 0;
+    /** number of steps each writer keeps in the arena */
+    size_t m_QueueDepth = 2;
+    /** bytes reserved in the arena for one step of one writer */
+    size_t m_SlotSize = 64 * 1024 * 1024;
+    /** maximum number of reader processes that can attach at the same time */
+    size_t m_MaxReaders = 64;
+    /** first step is not produced until this many readers attached */
+    size_t m_RendezvousReaderCount = 1;
+
+    helper::Comm m_NodeComm; // writers of this node sharing the arena
+    int m_WriterID;          // rank in m_NodeComm
+    inlineshm::InlineShmArena m_Arena;
+    std::string m_KeyFile; // node-local file giving the arena its key
+
+    size_t m_CurrentStep = static_cast<size_t>(-1); // steps start from 0
+    bool m_InsideStep = false;
+    char *m_Payload = nullptr; // payload of the slot of the current step
+    size_t m_DataPosition = 0;
+    std::vector<char> m_Index; // index of the current step
+
+    void Init() final;
+    void InitParameters() final;
+    void InitTransports() final;
+
+#define declare_type(T)                                                        \
+    void DoPutSync(Variable<T> &, const T *) final;                            \
+    void DoPutDeferred(Variable<T> &, const T *) final;
+    ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+    void DoClose(const int transportIndex = -1) final;
+
+    /**
+     * Common function for Put: data is copied into the arena right away, so
+     * there is no difference between sync and deferred Puts.
+     */
+    template <class T>
+    void PutCommon(Variable<T> &variable, const T *data);
+
+    /** Reserve size bytes in the current slot and record an index entry
+     * @return pointer to the reserved space in shared memory */
+    char *ReserveBlock(const VariableBase &variable, const size_t size);
+
+    void SerializeAttributes();
+};
+
+} // end namespace engine
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_ENGINE_INLINESHMWRITER_H_ */
@@ -0,0 +1,72 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * InlineShmWriter.tcc implementation of template functions with known type
+ */
+#ifndef ADIOS2_ENGINE_INLINESHMWRITER_TCC_
+#define ADIOS2_ENGINE_INLINESHMWRITER_TCC_
+
+#include "InlineShmWriter.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace adios2
+{
+namespace core
+{
+namespace engine
+{
+
+template <>
+inline void InlineShmWriter::PutCommon(Variable<std::string> &variable,
+                                       const std::string *data)
+{
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Writer " << m_WriterID << "     Put("
+                  << variable.m_Name << ")\n";
+    }
+    char *dest = ReserveBlock(variable, data->size());
+    std::memcpy(dest, data->data(), data->size());
+}
+
+template <class T>
+void InlineShmWriter::PutCommon(Variable<T> &variable, const T *data)
+{
+    if (m_Verbosity == 5)
+    {
+        std::cout << "InlineShm Writer " << m_WriterID << "     Put("
+                  << variable.m_Name << ")\n";
+    }
+
+    if (variable.m_SingleValue || variable.m_ShapeID == ShapeID::GlobalValue ||
+        variable.m_ShapeID == ShapeID::LocalValue)
+    {
+        char *dest = ReserveBlock(variable, sizeof(T));
+        std::memcpy(dest, data, sizeof(T));
+        return;
+    }
+
+    const size_t size = helper::GetTotalSize(variable.m_Count) * sizeof(T);
+    T *dest = reinterpret_cast<T *>(ReserveBlock(variable, size));
+    if (!variable.m_MemoryCount.empty())
+    {
+        const bool sourceRowMajor = helper::IsRowMajor(m_IO.m_HostLanguage);
+        helper::CopyMemoryBlock(
+            dest, variable.m_Start, variable.m_Count, sourceRowMajor, data,
+            variable.m_Start, variable.m_Count, sourceRowMajor, false, Dims(),
+            Dims(), variable.m_MemoryStart, variable.m_MemoryCount);
+    }
+    else
+    {
+        std::memcpy(dest, data, size);
+    }
+}
+
+} // end namespace engine
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_ENGINE_INLINESHMWRITER_TCC_ */
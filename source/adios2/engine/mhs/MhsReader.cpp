@@ -74,14 +74,40 @@ size_t MhsReader::CurrentStep() const { return m_SubEngines[0]->CurrentStep(); }
 
 void MhsReader::PerformGets()
 {
-    for (auto &e : m_SubEngines)
+    // all variables are read from the coarsest tier first and refined tier by
+    // tier, with a single PerformGets of the sub-engine for each tier. A
+    // variable leaves the refinement once Sirius reports it finished.
+    std::vector<DeferredGet> gets;
+    gets.swap(m_DeferredGets);
+    for (size_t tier = 0; tier < m_SubEngines.size() && !gets.empty(); ++tier)
     {
-        e->PerformGets();
+        compress::CompressSirius::ClearReadFinished();
+        std::vector<DeferredGet> tierGets;
+        for (auto &get : gets)
+        {
+            if (get.second(tier))
+            {
+                tierGets.push_back(std::move(get));
+            }
+        }
+        m_SubEngines[tier]->PerformGets();
+        gets.clear();
+        for (auto &get : tierGets)
+        {
+            if (!compress::CompressSirius::IsReadFinished(get.first))
+            {
+                gets.push_back(std::move(get));
+            }
+        }
     }
 }
 
 void MhsReader::EndStep()
 {
+    if (!m_DeferredGets.empty())
+    {
+        PerformGets();
+    }
     for (auto &e : m_SubEngines)
     {
         e->EndStep();
@@ -105,6 +131,10 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 
 void MhsReader::DoClose(const int transportIndex)
 {
+    if (!m_DeferredGets.empty())
+    {
+        PerformGets();
+    }
     for (auto &e : m_SubEngines)
     {
         e->Close();
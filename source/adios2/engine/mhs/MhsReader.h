@@ -14,6 +14,9 @@
 #include "adios2/core/Engine.h"
 #include "adios2/operator/compress/CompressSirius.h"
 
+#include <functional>
+#include <utility>
+
 namespace adios2
 {
 namespace core
@@ -40,6 +43,11 @@ private:
     std::shared_ptr<compress::CompressSirius> m_SiriusCompressor;
     int m_Tiers;
 
+    // deferred Gets by variable name, each issues its Get on the given tier,
+    // false if the variable is not in that tier
+    using DeferredGet = std::pair<std::string, std::function<bool(size_t)>>;
+    std::vector<DeferredGet> m_DeferredGets;
+
 #define declare_type(T)                                                        \
     void DoGetSync(Variable<T> &, T *) final;                                  \
     void DoGetDeferred(Variable<T> &, T *) final;
@@ -37,20 +37,19 @@ inline void MhsReader::GetDeferredCommon(Variable<std::string> &variable,
 template <class T>
 void MhsReader::GetDeferredCommon(Variable<T> &variable, T *data)
 {
-    for (int i = 0; i < m_Tiers; ++i)
-    {
-        auto var = m_SubIOs[i]->InquireVariable<T>(variable.m_Name);
-        if (!var)
-        {
-            break;
-        }
-        var->SetSelection({variable.m_Start, variable.m_Count});
-        m_SubEngines[i]->Get(*var, data, Mode::Sync);
-        if (m_SiriusCompressor->m_CurrentReadFinished)
-        {
-            break;
-        }
-    }
+    const std::string name = variable.m_Name;
+    const Box<Dims> selection = {variable.m_Start, variable.m_Count};
+    m_DeferredGets.emplace_back(
+        name, [this, name, selection, data](const size_t tier) {
+            auto var = m_SubIOs[tier]->InquireVariable<T>(name);
+            if (!var)
+            {
+                return false;
+            }
+            var->SetSelection(selection);
+            m_SubEngines[tier]->Get(*var, data, Mode::Deferred);
+            return true;
+        });
 }
 
 } // end namespace engine
@@ -12,6 +12,10 @@
 #include "adios2/helper/adiosFunctions.h"
 #include "adios2/operator/compress/CompressSirius.h"
 
+#include <algorithm>
+#include <future>
+#include <mutex>
+
 namespace adios2
 {
 namespace core
@@ -24,6 +28,20 @@ MhsWriter::MhsWriter(IO &io, const std::string &name, const Mode mode,
 : Engine("MhsWriter", io, name, mode, std::move(comm))
 {
     helper::GetParameter(io.m_Parameters, "Tiers", m_Tiers);
+    helper::GetParameter(io.m_Parameters, "Threads", m_Threads);
+    // the tiers' sub-engines run their collectives at the same time
+    if (m_Threads > 1 && !m_Comm.IsThreadMultiple())
+    {
+        if (m_Comm.Rank() == 0)
+        {
+            helper::Log("Engine", "MhsWriter", "MhsWriter",
+                        "Threads=" + std::to_string(m_Threads) +
+                            " needs MPI_THREAD_MULTIPLE, writing the tiers "
+                            "one after another",
+                        helper::WARNING);
+        }
+        m_Threads = 1;
+    }
     for (const auto &transportParams : io.m_TransportsParameters)
     {
         auto itVar = transportParams.find("variable");
@@ -39,9 +57,16 @@ MhsWriter::MhsWriter(IO &io, const std::string &name, const Mode mode,
 
         if (itTransport->second == "sirius")
         {
-            m_TransportMap.emplace(
-                itVar->second,
-                std::make_shared<compress::CompressSirius>(io.m_Parameters));
+            // each tier cuts its own part, so tiers can compress in parallel
+            auto &tierOperators = m_TransportMap[itVar->second];
+            for (int i = 0; i < m_Tiers; ++i)
+            {
+                Params params = io.m_Parameters;
+                params["Tier"] = std::to_string(i);
+                params["Variable"] = itVar->second;
+                tierOperators.push_back(
+                    std::make_shared<compress::CompressSirius>(params));
+            }
         }
         else
         {
@@ -56,6 +81,7 @@ MhsWriter::MhsWriter(IO &io, const std::string &name, const Mode mode,
         m_SubEngines.emplace_back(&m_SubIOs.back()->Open(
             m_Name + ".tier" + std::to_string(i), adios2::Mode::Write));
     }
+    m_TierPuts.resize(m_SubEngines.size());
     m_IsOpen = true;
 }
 
@@ -85,29 +111,71 @@ size_t MhsWriter::CurrentStep() const { return m_SubEngines[0]->CurrentStep(); }
 
 void MhsWriter::PerformPuts()
 {
-    for (auto &e : m_SubEngines)
-    {
-        e->PerformPuts();
-    }
+    RunTiers([](Engine &e) { e.PerformPuts(); });
 }
 
 void MhsWriter::EndStep()
 {
-    for (auto &e : m_SubEngines)
-    {
-        e->EndStep();
-    }
+    RunTiers([](Engine &e) { e.EndStep(); });
 }
 
 void MhsWriter::Flush(const int transportIndex)
 {
-    for (auto &e : m_SubEngines)
-    {
-        e->Flush(transportIndex);
-    }
+    RunTiers([transportIndex](Engine &e) { e.Flush(transportIndex); });
 }
 
 // PRIVATE
+void MhsWriter::RunTiers(const std::function<void(Engine &)> &tierOperation)
+{
+    auto lf_RunTier = [&](const size_t tier) {
+        for (auto &put : m_TierPuts[tier])
+        {
+            put();
+        }
+        m_TierPuts[tier].clear();
+        tierOperation(*m_SubEngines[tier]);
+    };
+
+    const size_t threads = std::min(static_cast<size_t>(std::max(m_Threads, 1)),
+                                    m_SubEngines.size());
+    if (threads <= 1)
+    {
+        for (size_t tier = 0; tier < m_SubEngines.size(); ++tier)
+        {
+            lf_RunTier(tier);
+        }
+        return;
+    }
+
+    size_t nextTier = 0;
+    std::mutex nextTierMutex;
+    auto lf_Run = [&]() {
+        while (true)
+        {
+            size_t tier;
+            {
+                std::lock_guard<std::mutex> lock(nextTierMutex);
+                if (nextTier == m_SubEngines.size())
+                {
+                    break;
+                }
+                tier = nextTier++;
+            }
+            lf_RunTier(tier);
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    for (size_t t = 1; t < threads; ++t)
+    {
+        futures.push_back(std::async(std::launch::async, lf_Run));
+    }
+    lf_Run();
+    for (auto &f : futures)
+    {
+        f.get();
+    }
+}
 
 #define declare_type(T)                                                        \
     void MhsWriter::DoPutSync(Variable<T> &variable, const T *data)            \
@@ -123,10 +191,7 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 
 void MhsWriter::DoClose(const int transportIndex)
 {
-    for (auto &e : m_SubEngines)
-    {
-        e->Close();
-    }
+    RunTiers([](Engine &e) { e.Close(); });
 }
 
 } // end namespace engine
@@ -13,6 +13,8 @@
 
 #include "adios2/core/Engine.h"
 
+#include <functional>
+
 namespace adios2
 {
 namespace core
@@ -38,11 +40,22 @@ public:
 private:
     std::vector<IO *> m_SubIOs;
     std::vector<Engine *> m_SubEngines;
-    std::unordered_map<std::string, std::shared_ptr<Operator>> m_TransportMap;
+    // one operator per tier and variable
+    std::unordered_map<std::string, std::vector<std::shared_ptr<Operator>>>
+        m_TransportMap;
     int m_Tiers = 1;
+    int m_Threads = 1;
+
+    // with Threads > 1, Puts are queued per tier and run on the thread of
+    // the tier before its PerformPuts, EndStep, Flush or Close
+    std::vector<std::vector<std::function<void()>>> m_TierPuts;
 
     void PutSubEngine(bool finalPut = false);
 
+    /** runs the queued Puts and then tierOperation for every tier, on up to
+     * Threads threads */
+    void RunTiers(const std::function<void(Engine &)> &tierOperation);
+
 #define declare_type(T)                                                        \
     void DoPutSync(Variable<T> &, const T *) final;                            \
     void DoPutDeferred(Variable<T> &, const T *) final;
@@ -47,39 +47,39 @@ void MhsWriter::PutDeferredCommon(Variable<T> &variable, const T *data)
     auto itVar = m_TransportMap.find(variable.m_Name);
     if (itVar != m_TransportMap.end())
     {
-        if (itVar->second->m_TypeString == "sirius")
+        if (itVar->second[0]->m_TypeString == "sirius")
         {
             putToAll = true;
         }
     }
 
-    auto var0 = m_SubIOs[0]->InquireVariable<T>(variable.m_Name);
-    if (!var0)
+    const size_t tiers = putToAll ? m_SubEngines.size() : 1;
+    for (size_t i = 0; i < tiers; ++i)
     {
-        var0 =
-            &m_SubIOs[0]->DefineVariable<T>(variable.m_Name, variable.m_Shape);
-        itVar = m_TransportMap.find(variable.m_Name);
-        if (itVar != m_TransportMap.end())
+        // variables are defined here, sub-IOs are not used by tier threads
+        auto var = m_SubIOs[i]->InquireVariable<T>(variable.m_Name);
+        if (!var)
         {
-            var0->AddOperation(itVar->second);
+            var = &m_SubIOs[i]->DefineVariable<T>(variable.m_Name,
+                                                  variable.m_Shape);
+            if (itVar != m_TransportMap.end())
+            {
+                var->AddOperation(itVar->second[i]);
+            }
         }
-    }
 
-    var0->SetSelection({variable.m_Start, variable.m_Count});
-    m_SubEngines[0]->Put(*var0, data, Mode::Sync);
-
-    if (putToAll)
-    {
-        for (size_t i = 1; i < m_SubEngines.size(); ++i)
+        const Box<Dims> selection = {variable.m_Start, variable.m_Count};
+        if (m_Threads > 1)
         {
-            auto var = m_SubIOs[i]->InquireVariable<T>(variable.m_Name);
-            if (!var)
-            {
-                var = &m_SubIOs[i]->DefineVariable<T>(variable.m_Name,
-                                                      variable.m_Shape);
-                var->AddOperation(itVar->second);
-            }
-            var->SetSelection({variable.m_Start, variable.m_Count});
+            Engine *engine = m_SubEngines[i];
+            m_TierPuts[i].push_back([engine, var, selection, data]() {
+                var->SetSelection(selection);
+                engine->Put(*var, data, Mode::Sync);
+            });
+        }
+        else
+        {
+            var->SetSelection(selection);
             m_SubEngines[i]->Put(*var, data, Mode::Sync);
         }
     }
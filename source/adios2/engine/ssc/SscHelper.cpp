@@ -9,6 +9,7 @@
  */
 
 #include "SscHelper.h"
+#include <algorithm>
 
 namespace adios2
 {
@@ -102,6 +103,114 @@ RankPosMap CalculateOverlap(BlockVecVec &globalVecVec, const BlockVec &localVec)
     return ret;
 }
 
+TransferVec CalculateTransfer(const BlockVec &writerBlocks,
+                              const BlockVec &readerBlocks,
+                              size_t &messageSize)
+{
+    TransferVec ret;
+    // the message starts with the end of stream flag, byte 0 of the writer
+    // buffer
+    size_t position = 1;
+    for (size_t i = 0; i < writerBlocks.size(); ++i)
+    {
+        const auto &wBlock = writerBlocks[i];
+        if (wBlock.shapeId != ShapeID::GlobalArray)
+        {
+            if (wBlock.bufferCount > 0)
+            {
+                ret.push_back({i, wBlock.start, wBlock.count, position,
+                               wBlock.bufferCount});
+                position += wBlock.bufferCount;
+            }
+            continue;
+        }
+        for (const auto &rBlock : readerBlocks)
+        {
+            if (rBlock.name != wBlock.name ||
+                rBlock.shapeId != ShapeID::GlobalArray ||
+                rBlock.start.size() != wBlock.start.size())
+            {
+                continue;
+            }
+            Dims start(wBlock.start.size());
+            Dims count(wBlock.start.size());
+            bool hasOverlap = true;
+            for (size_t d = 0; d < wBlock.start.size(); ++d)
+            {
+                start[d] = std::max(wBlock.start[d], rBlock.start[d]);
+                const size_t end =
+                    std::min(wBlock.start[d] + wBlock.count[d],
+                             rBlock.start[d] + rBlock.count[d]);
+                if (end <= start[d])
+                {
+                    hasOverlap = false;
+                    break;
+                }
+                count[d] = end - start[d];
+            }
+            if (hasOverlap)
+            {
+                const size_t size =
+                    TotalDataSize(count, wBlock.elementSize, wBlock.shapeId);
+                ret.push_back({i, start, count, position, size});
+                position += size;
+            }
+        }
+    }
+    messageSize = position;
+    return ret;
+}
+
+MPI_Datatype CreateTransferType(const BlockVec &writerBlocks,
+                                const TransferVec &transfer)
+{
+    std::vector<int> lengths = {1};
+    std::vector<MPI_Aint> displacements = {0};
+    std::vector<MPI_Datatype> types = {MPI_CHAR};
+    for (const auto &t : transfer)
+    {
+        const auto &b = writerBlocks[t.writerBlock];
+        displacements.push_back(static_cast<MPI_Aint>(b.bufferStart));
+        if (b.shapeId != ShapeID::GlobalArray)
+        {
+            lengths.push_back(static_cast<int>(t.size));
+            types.push_back(MPI_CHAR);
+            continue;
+        }
+        const int ndims = static_cast<int>(b.count.size());
+        std::vector<int> sizes(ndims), subsizes(ndims), starts(ndims);
+        for (int d = 0; d < ndims; ++d)
+        {
+            sizes[d] = static_cast<int>(b.count[d]);
+            subsizes[d] = static_cast<int>(t.count[d]);
+            starts[d] = static_cast<int>(t.start[d] - b.start[d]);
+        }
+        MPI_Datatype element;
+        MPI_Type_contiguous(static_cast<int>(b.elementSize), MPI_CHAR,
+                            &element);
+        MPI_Datatype subarray;
+        MPI_Type_create_subarray(ndims, sizes.data(), subsizes.data(),
+                                 starts.data(), MPI_ORDER_C, element,
+                                 &subarray);
+        MPI_Type_free(&element);
+        lengths.push_back(1);
+        types.push_back(subarray);
+    }
+
+    MPI_Datatype ret;
+    MPI_Type_create_struct(static_cast<int>(types.size()), lengths.data(),
+                           displacements.data(), types.data(), &ret);
+    MPI_Type_commit(&ret);
+    for (auto &type : types)
+    {
+        if (type != MPI_CHAR)
+        {
+            MPI_Type_free(&type);
+        }
+    }
+    return ret;
+}
+
 void SerializeVariables(const BlockVec &input, Buffer &output, const int rank)
 {
     for (const auto &b : input)
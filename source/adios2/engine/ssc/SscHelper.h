@@ -130,6 +130,19 @@ using BlockVecVec = std::vector<BlockVec>;
 using RankPosMap = std::unordered_map<int, std::pair<size_t, size_t>>;
 using MpiInfo = std::vector<std::vector<int>>;
 
+// part of a writer block sent to a reader once the IO pattern is locked: for
+// global arrays the overlap of the block with one reader selection, for other
+// blocks the whole block
+struct TransferBlock
+{
+    size_t writerBlock; // index in the writer's BlockVec
+    Dims start;
+    Dims count;
+    size_t position; // in the message from the writer to the reader
+    size_t size;
+};
+using TransferVec = std::vector<TransferBlock>;
+
 void PrintDims(const Dims &dims, const std::string &label = std::string());
 void PrintBlock(const BlockInfo &b, const std::string &label = std::string());
 void PrintBlockVec(const BlockVec &bv,
@@ -147,6 +160,12 @@ size_t TotalDataSize(const BlockVec &bv);
 RankPosMap CalculateOverlap(BlockVecVec &globalPattern,
                             const BlockVec &localPattern);
 
+TransferVec CalculateTransfer(const BlockVec &writerBlocks,
+                              const BlockVec &readerBlocks,
+                              size_t &messageSize);
+MPI_Datatype CreateTransferType(const BlockVec &writerBlocks,
+                                const TransferVec &transfer);
+
 void SerializeVariables(const BlockVec &input, Buffer &output, const int rank);
 void SerializeAttributes(IO &input, Buffer &output);
 void SerializeStructDefinitions(
@@ -29,7 +29,6 @@ void SscReaderGeneric::BeginStepConsequentFixed()
 {
     MPI_Waitall(static_cast<int>(m_MpiRequests.size()), m_MpiRequests.data(),
                 MPI_STATUS_IGNORE);
-    m_MpiRequests.clear();
 }
 
 void SscReaderGeneric::BeginStepFlexible(StepStatus &status)
@@ -156,12 +155,23 @@ void SscReaderGeneric::EndStepFixed()
         MPI_Win_free(&m_MpiWin);
         SyncReadPattern();
     }
-    for (const auto &i : m_AllReceivingWriterRanks)
+    // the receives are set up once, as the writers' sends, and restarted
+    // every step
+    if (m_MpiRequests.empty())
+    {
+        CalculateTransfers();
+        for (const auto &i : m_AllReceivingWriterRanks)
+        {
+            m_MpiRequests.emplace_back();
+            MPI_Recv_init(m_Buffer.data() + i.second.first,
+                          static_cast<int>(i.second.second), MPI_CHAR, i.first,
+                          0, m_StreamComm, &m_MpiRequests.back());
+        }
+    }
+    if (!m_MpiRequests.empty())
     {
-        m_MpiRequests.emplace_back();
-        MPI_Irecv(m_Buffer.data() + i.second.first,
-                  static_cast<int>(i.second.second), MPI_CHAR, i.first, 0,
-                  m_StreamComm, &m_MpiRequests.back());
+        MPI_Startall(static_cast<int>(m_MpiRequests.size()),
+                     m_MpiRequests.data());
     }
 }
 
@@ -418,12 +428,52 @@ void SscReaderGeneric::CalculatePosition(ssc::BlockVecVec &bvv,
     }
 }
 
+void SscReaderGeneric::CalculateTransfers()
+{
+    // with the pattern locked, each writer sends only the parts of its blocks
+    // this reader selected, laid out by ssc::CalculateTransfer, and the
+    // messages of the writers follow each other in m_Buffer
+    m_Transfers.clear();
+    size_t bufferPosition = 0;
+    for (int rank = 0; rank < static_cast<int>(m_GlobalWritePattern.size());
+         ++rank)
+    {
+        auto it = m_AllReceivingWriterRanks.find(rank);
+        if (it == m_AllReceivingWriterRanks.end())
+        {
+            continue;
+        }
+        auto &bv = m_GlobalWritePattern[rank];
+        size_t messageSize;
+        auto transfer =
+            ssc::CalculateTransfer(bv, m_LocalReadPattern, messageSize);
+        for (auto &t : transfer)
+        {
+            t.position += bufferPosition;
+            if (bv[t.writerBlock].shapeId != ShapeID::GlobalArray)
+            {
+                bv[t.writerBlock].bufferStart = t.position;
+            }
+        }
+        it->second.first = bufferPosition;
+        it->second.second = messageSize;
+        m_Transfers[rank] = std::move(transfer);
+        bufferPosition += messageSize;
+    }
+    m_Buffer.resize(bufferPosition);
+}
+
 void SscReaderGeneric::Close(const int transportIndex)
 {
     if (!m_StepBegun)
     {
         BeginStep(StepMode::Read, -1.0, m_ReaderSelectionsLocked);
     }
+    for (auto &request : m_MpiRequests)
+    {
+        MPI_Request_free(&request);
+    }
+    m_MpiRequests.clear();
 }
 
 #define declare_type(T)                                                        \
@@ -523,50 +573,37 @@ void SscReaderGeneric::GetDeferred(VariableBase &variable, void *data)
     else
     {
 
-        for (const auto &i : m_AllReceivingWriterRanks)
+        for (const auto &i : m_Transfers)
         {
             const auto &v = m_GlobalWritePattern[i.first];
-            for (const auto &b : v)
+            for (const auto &t : i.second)
             {
-                if (b.name == variable.m_Name)
+                const auto &b = v[t.writerBlock];
+                if (b.name != variable.m_Name)
                 {
-                    bool empty = false;
-                    for (const auto c : b.count)
-                    {
-                        if (c == 0)
-                        {
-                            empty = true;
-                        }
-                    }
-                    if (empty)
-                    {
-                        continue;
-                    }
-
-                    if (b.shapeId == ShapeID::GlobalArray ||
-                        b.shapeId == ShapeID::LocalArray)
-                    {
-                        helper::NdCopy(
-                            m_Buffer.data<char>() + b.bufferStart,
-                            helper::CoreDims(b.start),
-                            helper::CoreDims(b.count), true, true,
-                            reinterpret_cast<char *>(data), vStart, vCount,
-                            true, true,
-                            static_cast<int>(variable.m_ElementSize));
-                    }
-                    else if (b.shapeId == ShapeID::GlobalValue ||
-                             b.shapeId == ShapeID::LocalValue)
-                    {
-                        std::memcpy(data, m_Buffer.data() + b.bufferStart,
-                                    b.bufferCount);
-                    }
-                    else
-                    {
-                        helper::Log("Engine", "SscReaderGeneric",
-                                    "GetDeferredCommon", "unknown ShapeID",
-                                    m_ReaderRank, m_ReaderRank, 0, m_Verbosity,
-                                    helper::LogMode::FATALERROR);
-                    }
+                    continue;
+                }
+                if (b.shapeId == ShapeID::GlobalArray ||
+                    b.shapeId == ShapeID::LocalArray)
+                {
+                    helper::NdCopy(m_Buffer.data<char>() + t.position,
+                                   helper::CoreDims(t.start),
+                                   helper::CoreDims(t.count), true, true,
+                                   reinterpret_cast<char *>(data), vStart,
+                                   vCount, true, true,
+                                   static_cast<int>(variable.m_ElementSize));
+                }
+                else if (b.shapeId == ShapeID::GlobalValue ||
+                         b.shapeId == ShapeID::LocalValue)
+                {
+                    std::memcpy(data, m_Buffer.data() + t.position, t.size);
+                }
+                else
+                {
+                    helper::Log("Engine", "SscReaderGeneric",
+                                "GetDeferredCommon", "unknown ShapeID",
+                                m_ReaderRank, m_ReaderRank, 0, m_Verbosity,
+                                helper::LogMode::FATALERROR);
                 }
             }
         }
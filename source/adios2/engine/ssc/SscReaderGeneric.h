@@ -58,6 +58,7 @@ private:
     StepStatus m_StepStatus;
     std::vector<MPI_Request> m_MpiRequests;
     ssc::RankPosMap m_AllReceivingWriterRanks;
+    std::unordered_map<int, ssc::TransferVec> m_Transfers;
     ssc::BlockVecVec m_GlobalWritePattern;
     ssc::BlockVec m_LocalReadPattern;
     ssc::Buffer m_GlobalWritePatternBuffer;
@@ -72,6 +73,7 @@ private:
     void EndStepConsequentFlexible();
     void CalculatePosition(ssc::BlockVecVec &mapVec,
                            ssc::RankPosMap &allOverlapRanks);
+    void CalculateTransfers();
 
     template <typename T>
     std::vector<typename Variable<T>::BPInfo>
@@ -56,7 +56,6 @@ StepStatus SscWriterGeneric::BeginStep(const StepMode mode,
         {
             MPI_Waitall(static_cast<int>(m_MpiRequests.size()),
                         m_MpiRequests.data(), MPI_STATUSES_IGNORE);
-            m_MpiRequests.clear();
         }
         else
         {
@@ -122,7 +121,16 @@ void SscWriterGeneric::Close(const int transportIndex)
         {
             MPI_Waitall(static_cast<int>(m_MpiRequests.size()),
                         m_MpiRequests.data(), MPI_STATUSES_IGNORE);
+            for (auto &request : m_MpiRequests)
+            {
+                MPI_Request_free(&request);
+            }
             m_MpiRequests.clear();
+            for (auto &type : m_MpiTypes)
+            {
+                MPI_Type_free(&type);
+            }
+            m_MpiTypes.clear();
         }
 
         m_Buffer[0] = 1;
@@ -280,11 +288,28 @@ void SscWriterGeneric::EndStepFirst()
 
 void SscWriterGeneric::EndStepConsequentFixed()
 {
-    for (const auto &i : m_AllSendingReaderRanks)
+    // once locked, m_Buffer and the readers no longer change, so the sends
+    // are set up on the first fixed step and only restarted afterwards; each
+    // reader is sent only the parts of the blocks it selected, picked out of
+    // m_Buffer by a derived datatype
+    if (m_MpiRequests.empty())
+    {
+        const auto &blocks = m_GlobalWritePattern[m_StreamRank];
+        for (const auto &i : m_AllSendingReaderRanks)
+        {
+            size_t messageSize;
+            const auto transfer = ssc::CalculateTransfer(
+                blocks, m_GlobalReadPattern[i.first], messageSize);
+            m_MpiTypes.push_back(ssc::CreateTransferType(blocks, transfer));
+            m_MpiRequests.emplace_back();
+            MPI_Send_init(m_Buffer.data(), 1, m_MpiTypes.back(), i.first, 0,
+                          m_StreamComm, &m_MpiRequests.back());
+        }
+    }
+    if (!m_MpiRequests.empty())
     {
-        m_MpiRequests.emplace_back();
-        MPI_Isend(m_Buffer.data(), static_cast<int>(m_Buffer.size()), MPI_CHAR,
-                  i.first, 0, m_StreamComm, &m_MpiRequests.back());
+        MPI_Startall(static_cast<int>(m_MpiRequests.size()),
+                     m_MpiRequests.data());
     }
 }
 
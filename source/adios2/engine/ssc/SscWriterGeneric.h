@@ -47,6 +47,7 @@ private:
     ssc::BlockVecVec m_GlobalWritePattern;
     ssc::BlockVecVec m_GlobalReadPattern;
     std::vector<MPI_Request> m_MpiRequests;
+    std::vector<MPI_Datatype> m_MpiTypes;
     ssc::RankPosMap m_AllSendingReaderRanks;
 
     bool m_WriterDefinitionsLocked = false;
@@ -669,16 +669,34 @@ void SstReader::BP5PerformGets()
     auto ReadRequests =
         m_BP5Deserializer->GenerateReadRequests(true, &maxReadSize);
     std::vector<void *> sstReadHandlers;
-    for (const auto &Req : ReadRequests)
+    size_t elementSize;
+    Dims blockCount, selStart, selCount;
+    for (auto &Req : ReadRequests)
     {
         void *dp_info = NULL;
         if (m_CurrentStepMetaData->DP_TimestepInfo)
         {
             dp_info = m_CurrentStepMetaData->DP_TimestepInfo[Req.WriterRank];
         }
-        auto ret = SstReadRemoteMemory(m_Input, Req.WriterRank, Req.Timestep,
-                                       Req.StartOffset, Req.ReadLength,
-                                       Req.DestinationAddr, dp_info);
+        void *ret = NULL;
+        if (m_BP5Deserializer->GetSlabRead(Req, elementSize, blockCount,
+                                           selStart, selCount))
+        {
+            // let the writer send only the selected part of the block
+            ret = SstReadRemoteSlab(
+                m_Input, Req.WriterRank, Req.Timestep,
+                Req.StartOffset - Req.OffsetInBlock,
+                static_cast<int>(blockCount.size()), elementSize,
+                blockCount.data(), selStart.data(), selCount.data(),
+                Req.DestinationAddr, dp_info);
+            Req.Packed = (ret != NULL);
+        }
+        if (!Req.Packed)
+        {
+            ret = SstReadRemoteMemory(m_Input, Req.WriterRank, Req.Timestep,
+                                      Req.StartOffset, Req.ReadLength,
+                                      Req.DestinationAddr, dp_info);
+        }
         sstReadHandlers.push_back(ret);
     }
     for (const auto &i : sstReadHandlers)
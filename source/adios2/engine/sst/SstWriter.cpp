@@ -8,9 +8,18 @@
  *      Author: Greg Eisenhauer
  */
 
-#include "adios2/helper/adiosComm.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 
+#include <fcntl.h>
+#include <strings.h> // strcasecmp
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "adios2/helper/adiosComm.h"
+
 #include "SstParamParser.h"
 #include "SstWriter.h"
 #include "SstWriter.tcc"
@@ -282,6 +291,11 @@ void SstWriter::EndStep()
                 reinterpret_cast<BP5DataBlock *>(vBlock);
             //  Free data and metadata blocks here.  BlockToFree is the newblock
             //  value in the enclosing function.
+            if (BlockToFree->SpillBytes)
+            {
+                munmap(BlockToFree->data.block, BlockToFree->SpillBytes);
+            }
+            *BlockToFree->QueuedDataBytes -= BlockToFree->MemoryBytes;
             free(BlockToFree->MetaMetaBlocks);
             delete BlockToFree->TSInfo;
             delete BlockToFree;
@@ -314,6 +328,36 @@ void SstWriter::EndStep()
             newblock->data.DataSize = 0;
             newblock->data.block = nullptr;
         }
+        // keep the data in memory within the budget, timesteps queued
+        // beyond it wait for the readers on disk
+        newblock->QueuedDataBytes = m_QueuedDataBytes;
+        if (Params.QueueFullPolicy == SstQueueFullSpill &&
+            newblock->data.DataSize > 0 &&
+            *m_QueuedDataBytes + newblock->data.DataSize >
+                Params.SpillMemoryLimit)
+        {
+            try
+            {
+                newblock->data.block =
+                    SpillData(newblock->data.block, newblock->data.DataSize);
+            }
+            catch (...)
+            {
+                // SST does not own the step yet
+                free(MetaMetaBlocks);
+                delete TSInfo;
+                delete newblock;
+                throw;
+            }
+            newblock->SpillBytes = newblock->data.DataSize;
+            delete TSInfo->DataBuffer;
+            TSInfo->DataBuffer = nullptr;
+        }
+        else
+        {
+            newblock->MemoryBytes = newblock->data.DataSize;
+            *m_QueuedDataBytes += newblock->MemoryBytes;
+        }
         newblock->TSInfo = TSInfo;
         if (TSInfo->AttributeEncodeBuffer)
         {
@@ -394,6 +438,83 @@ void SstWriter::Init()
             "integer in the range [0,5], in call to "
             "Open or Engine constructor\n");
     }
+    if (Params.QueueFullPolicy == SstQueueFullSpill &&
+        Params.MarshalMethod != SstMarshalBP5)
+    {
+        helper::Throw<std::invalid_argument>(
+            "Engine", "SstWriter", "Init",
+            "QueueFullPolicy=Spill requires MarshalMethod=BP5");
+    }
+    // spilled steps are served from the file mapping, which has only been
+    // verified with the EVPath data plane
+    if (Params.QueueFullPolicy == SstQueueFullSpill)
+    {
+        if (Params.DataTransport == NULL)
+        {
+            Params.DataTransport = strdup("evpath");
+        }
+        else if (strcasecmp(Params.DataTransport, "evpath") != 0)
+        {
+            helper::Throw<std::invalid_argument>(
+                "Engine", "SstWriter", "Init",
+                "QueueFullPolicy=Spill requires DataTransport=evpath, not " +
+                    std::string(Params.DataTransport));
+        }
+    }
+}
+
+char *SstWriter::SpillData(const char *data, const size_t size)
+{
+    std::string dir;
+    if (Params.SpillDirectory)
+    {
+        dir = Params.SpillDirectory;
+    }
+    else
+    {
+        const char *tmpdir = std::getenv("TMPDIR");
+        dir = tmpdir ? tmpdir : "/tmp";
+    }
+    std::string path = dir + "/adios2-sst-spill-XXXXXX";
+    const int fd = mkstemp(&path[0]);
+    if (fd == -1)
+    {
+        helper::Throw<std::runtime_error>(
+            "Engine", "SstWriter", "SpillData",
+            "couldn't create a spill file in " + dir + ": " +
+                std::strerror(errno));
+    }
+    // the mapping keeps the data of the unlinked file until munmap
+    unlink(path.c_str());
+    size_t written = 0;
+    while (written < size)
+    {
+        const ssize_t n = write(fd, data + written, size - written);
+        if (n == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            const std::string err = std::strerror(errno);
+            close(fd);
+            helper::Throw<std::runtime_error>(
+                "Engine", "SstWriter", "SpillData",
+                "couldn't write " + std::to_string(size) +
+                    " bytes to a spill file in " + dir + ": " + err);
+        }
+        written += static_cast<size_t>(n);
+    }
+    void *map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    const std::string err = std::strerror(errno);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        helper::Throw<std::runtime_error>("Engine", "SstWriter", "SpillData",
+                                          "couldn't map a spill file in " +
+                                              dir + ": " + err);
+    }
+    return static_cast<char *>(map);
 }
 
 #define declare_type(T)                                                        \
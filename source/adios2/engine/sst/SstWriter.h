@@ -18,6 +18,7 @@
 #include "adios2/toolkit/format/bp5/BP5Serializer.h"
 #include "adios2/toolkit/sst/sst.h"
 
+#include <atomic>
 #include <memory>
 
 namespace adios2
@@ -77,6 +78,11 @@ private:
         _SstData attribute_data;
         SstMetaMetaList MetaMetaBlocks;
         format::BP5Serializer::TimestepInfo *TSInfo;
+        /** data bytes held in memory, counted in QueuedDataBytes */
+        size_t MemoryBytes = 0;
+        /** size of the mapping of the spill file data.block points to */
+        size_t SpillBytes = 0;
+        std::shared_ptr<std::atomic<size_t>> QueuedDataBytes;
     };
     std::unique_ptr<format::BP3Serializer> m_BP3Serializer;
 
@@ -88,7 +94,22 @@ private:
     size_t m_MarshaledAttributesCount = 0;
     struct _SstParams Params;
 
+    /** BP5 data bytes of this rank's timesteps not yet released by SST */
+    std::shared_ptr<std::atomic<size_t>> m_QueuedDataBytes =
+        std::make_shared<std::atomic<size_t>>(0);
+
     void MarshalAttributes();
+
+    /**
+     * With QueueFullPolicy=Spill, moves the data of a timestep to an
+     * unlinked file in SpillDirectory and maps it back read-only, so the
+     * data planes serve it from the page cache or the file
+     * @param data timestep data
+     * @param size bytes of data
+     * @return read-only mapping of the spilled data, to munmap when SST
+     * releases the timestep
+     */
+    char *SpillData(const char *data, const size_t size);
     void DoClose(const int transportIndex = -1) final;
 };
 
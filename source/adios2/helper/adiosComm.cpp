@@ -81,6 +81,8 @@ int Comm::Size() const { return m_Impl->Size(); }
 
 bool Comm::IsMPI() const { return m_Impl->IsMPI(); }
 
+bool Comm::IsThreadMultiple() const { return m_Impl->IsThreadMultiple(); }
+
 void Comm::Barrier(const std::string &hint) const { m_Impl->Barrier(hint); }
 
 std::string Comm::BroadcastFile(const std::string &fileName,
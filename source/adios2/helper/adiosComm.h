@@ -144,6 +144,13 @@ public:
      */
     bool IsMPI() const;
 
+    /**
+     * @brief Return true if several threads may call communication functions
+     * at the same time (always true without MPI, MPI_THREAD_MULTIPLE with
+     * MPI).
+     */
+    bool IsThreadMultiple() const;
+
     void Barrier(const std::string &hint = std::string()) const;
 
     /**
@@ -457,6 +464,7 @@ public:
     virtual int Rank() const = 0;
     virtual int Size() const = 0;
     virtual bool IsMPI() const = 0;
+    virtual bool IsThreadMultiple() const = 0;
     virtual void Barrier(const std::string &hint) const = 0;
     virtual void Allgather(const void *sendbuf, size_t sendcount,
                            Datatype sendtype, void *recvbuf, size_t recvcount,
@@ -69,6 +69,7 @@ public:
     int Rank() const override;
     int Size() const override;
     bool IsMPI() const override;
+    bool IsThreadMultiple() const override;
     void Barrier(const std::string &hint) const override;
 
     void Allgather(const void *sendbuf, size_t sendcount, Datatype sendtype,
@@ -164,6 +165,8 @@ int CommImplDummy::Size() const { return 1; }
 
 bool CommImplDummy::IsMPI() const { return false; }
 
+bool CommImplDummy::IsThreadMultiple() const { return true; }
+
 void CommImplDummy::Barrier(const std::string &) const {}
 
 void CommImplDummy::Allgather(const void *sendbuf, size_t sendcount,
@@ -11,6 +11,7 @@
 #include "OperatorFactory.h"
 #include "adios2/helper/adiosFunctions.h"
 #include "adios2/operator/compress/CompressNull.h"
+#include "adios2/operator/compress/CompressShuffle.h"
 #include "adios2/operator/plugin/PluginOperator.h"
 #include <numeric>
 
@@ -68,6 +69,8 @@ std::string OperatorTypeToString(const Operator::OperatorType type)
         return "mgardplus";
     case Operator::COMPRESS_PNG:
         return "png";
+    case Operator::COMPRESS_SHUFFLE:
+        return "shuffle";
     case Operator::COMPRESS_SIRIUS:
         return "sirius";
     case Operator::COMPRESS_SZ:
@@ -124,6 +127,10 @@ std::shared_ptr<Operator> MakeOperator(const std::string &type,
         ret = std::make_shared<compress::CompressPNG>(parameters);
 #endif
     }
+    else if (typeLowerCase == "shuffle")
+    {
+        ret = std::make_shared<compress::CompressShuffle>(parameters);
+    }
     else if (typeLowerCase == "sirius")
     {
 #ifdef ADIOS2_HAVE_MHS
@@ -20,6 +20,12 @@ namespace core
 std::shared_ptr<Operator> MakeOperator(const std::string &type,
                                        const Params &parameters);
 
+/**
+ * Decompress a buffer produced by any operator. Without op, a new operator
+ * instance is created for the call, so concurrent calls from several threads
+ * do not share state. Operators backed by a library with global state (SZ,
+ * Sirius, plugins) serialize on their own lock.
+ */
 size_t Decompress(const char *bufferIn, const size_t sizeIn, char *dataOut,
                   std::shared_ptr<Operator> op = nullptr);
 
@@ -69,8 +69,6 @@ size_t CompressBlosc::Operate(const char *dataIn, const Dims &blockStart,
     // input size under this bound will not compress
     size_t thresholdSize = 128;
 
-    blosc_init();
-
     size_t threads = 1; // defaults
     int compressionLevel = 1;
     int doShuffle = BLOSC_SHUFFLE;
@@ -166,16 +164,15 @@ size_t CompressBlosc::Operate(const char *dataIn, const Dims &blockStart,
 
     if (!useMemcpy)
     {
-        const int result = blosc_set_compressor(compressor.c_str());
-        if (result == -1)
+        // the _ctx calls keep no global state, blocks of a step may be
+        // compressed concurrently
+        if (blosc_compname_to_compcode(compressor.c_str()) == -1)
         {
             helper::Throw<std::invalid_argument>(
                 "Operator", "CompressBlosc", "Operate",
                 "blosc library linked does not support compressor " +
                     compressor);
         }
-        blosc_set_nthreads(threads);
-        blosc_set_blocksize(blockSize);
 
         uint32_t chunk = 0;
         for (; inputOffset < sizeIn; ++chunk)
@@ -188,10 +185,11 @@ size_t CompressBlosc::Operate(const char *dataIn, const Dims &blockStart,
 
             bloscSize_t maxChunkSize = maxIntputSize + BLOSC_MAX_OVERHEAD;
 
-            bloscSize_t compressedChunkSize =
-                blosc_compress(compressionLevel, doShuffle, typesize,
-                               maxIntputSize, dataIn + inputOffset,
-                               bufferOut + bufferOutOffset, maxChunkSize);
+            bloscSize_t compressedChunkSize = blosc_compress_ctx(
+                compressionLevel, doShuffle, typesize, maxIntputSize,
+                dataIn + inputOffset, bufferOut + bufferOutOffset,
+                maxChunkSize, compressor.c_str(), blockSize,
+                static_cast<int>(threads));
 
             if (compressedChunkSize > 0)
                 bufferOutOffset += static_cast<size_t>(compressedChunkSize);
@@ -220,7 +218,6 @@ size_t CompressBlosc::Operate(const char *dataIn, const Dims &blockStart,
         headerPtr->SetNumChunks(0u);
     }
 
-    blosc_destroy();
     return bufferOutOffset;
 }
 
@@ -325,8 +322,6 @@ size_t CompressBlosc::DecompressChunkedFormat(const char *bufferIn,
 
     if (isCompressed)
     {
-        blosc_init();
-
         size_t threads = 1; // defaults
         for (const auto &itParameter : m_Parameters)
         {
@@ -338,7 +333,6 @@ size_t CompressBlosc::DecompressChunkedFormat(const char *bufferIn,
                     value, "when setting Blosc nthreads parameter\n"));
             }
         }
-        blosc_set_nthreads(threads);
 
         while (inputOffset < inputDataSize)
         {
@@ -369,8 +363,10 @@ size_t CompressBlosc::DecompressChunkedFormat(const char *bufferIn,
             bloscSize_t max_output_size =
                 static_cast<bloscSize_t>(outputChunkSize);
 
-            bloscSize_t decompressdSize =
-                blosc_decompress(in_ptr, out_ptr, max_output_size);
+            // the context variant keeps no global state, so reader threads
+            // may decompress blocks concurrently
+            bloscSize_t decompressdSize = blosc_decompress_ctx(
+                in_ptr, out_ptr, max_output_size, static_cast<int>(threads));
 
             if (decompressdSize > 0)
                 currentOutputSize += static_cast<size_t>(decompressdSize);
@@ -383,7 +379,6 @@ size_t CompressBlosc::DecompressChunkedFormat(const char *bufferIn,
             }
             inputOffset += static_cast<size_t>(max_inputDataSize);
         }
-        blosc_destroy();
     }
     else
     {
@@ -402,7 +397,6 @@ size_t CompressBlosc::DecompressOldFormat(const char *bufferIn,
                                           const size_t sizeIn, char *dataOut,
                                           const size_t sizeOut) const
 {
-    blosc_init();
     size_t threads = 1; // defaults
     for (const auto &itParameter : m_Parameters)
     {
@@ -414,9 +408,8 @@ size_t CompressBlosc::DecompressOldFormat(const char *bufferIn,
                 value, "when setting Blosc nthreads parameter\n"));
         }
     }
-    blosc_set_nthreads(threads);
-    const int decompressedSize = blosc_decompress(bufferIn, dataOut, sizeOut);
-    blosc_destroy();
+    const int decompressedSize = blosc_decompress_ctx(
+        bufferIn, dataOut, sizeOut, static_cast<int>(threads));
     return static_cast<size_t>(decompressedSize);
 }
 
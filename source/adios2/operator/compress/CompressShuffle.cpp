@@ -0,0 +1,459 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressShuffle.cpp
+ */
+
+#include "CompressShuffle.h"
+#include "adios2/helper/adiosFunctions.h"
+#include "adios2/operator/OperatorFactory.h"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+namespace
+{
+
+#if defined(ADIOS2_HAVE_BZIP2)
+const std::string DefaultCompressor = "bzip2";
+#elif defined(ADIOS2_HAVE_BLOSC)
+const std::string DefaultCompressor = "blosc";
+#else
+const std::string DefaultCompressor = "none";
+#endif
+
+template <class T>
+void PredictWords(const T *in, T *out, const size_t n, const size_t stride,
+                  const CompressShuffle::Predictor predictor)
+{
+    // the first stride values have nothing to be predicted from
+    const size_t head = std::min(stride, n);
+    std::memcpy(out, in, head * sizeof(T));
+    if (predictor == CompressShuffle::PREDICT_DELTA)
+    {
+        for (size_t i = head; i < n; ++i)
+        {
+            out[i] = static_cast<T>(in[i] - in[i - stride]);
+        }
+    }
+    else
+    {
+        for (size_t i = head; i < n; ++i)
+        {
+            out[i] = static_cast<T>(in[i] ^ in[i - stride]);
+        }
+    }
+}
+
+template <class T>
+void UnpredictWords(T *data, const size_t n, const size_t stride,
+                    const CompressShuffle::Predictor predictor)
+{
+    if (predictor == CompressShuffle::PREDICT_DELTA)
+    {
+        for (size_t i = stride; i < n; ++i)
+        {
+            data[i] = static_cast<T>(data[i] + data[i - stride]);
+        }
+    }
+    else
+    {
+        for (size_t i = stride; i < n; ++i)
+        {
+            data[i] = static_cast<T>(data[i] ^ data[i - stride]);
+        }
+    }
+}
+
+#if defined(__SSE2__)
+/* Blocks of 16 values of W bytes are held in W registers. Seen as bits, the
+ * position of a byte is [value | byte] and one round of unpacking register k
+ * with register k + W/2 rotates it left by one bit. After 4 rounds it is
+ * [byte | value]: register b holds byte b of the 16 values. log2(W) rounds
+ * bring the planes back. */
+template <size_t W>
+size_t ShuffleBlocks(const char *in, char *out, const size_t n)
+{
+    __m128i r[W], t[W];
+    const size_t blocks = n / 16;
+    for (size_t j = 0; j < blocks; ++j)
+    {
+        for (size_t k = 0; k < W; ++k)
+        {
+            r[k] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(in + (j * W + k) * 16));
+        }
+        for (int round = 0; round < 4; ++round)
+        {
+            for (size_t k = 0; k < W / 2; ++k)
+            {
+                t[2 * k] = _mm_unpacklo_epi8(r[k], r[k + W / 2]);
+                t[2 * k + 1] = _mm_unpackhi_epi8(r[k], r[k + W / 2]);
+            }
+            std::copy(t, t + W, r);
+        }
+        for (size_t b = 0; b < W; ++b)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + b * n + j * 16),
+                             r[b]);
+        }
+    }
+    return blocks * 16;
+}
+
+template <size_t W>
+size_t UnshuffleBlocks(const char *in, char *out, const size_t n)
+{
+    const int rounds = (W == 2) ? 1 : ((W == 4) ? 2 : 3);
+    __m128i r[W], t[W];
+    const size_t blocks = n / 16;
+    for (size_t j = 0; j < blocks; ++j)
+    {
+        for (size_t b = 0; b < W; ++b)
+        {
+            r[b] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(in + b * n + j * 16));
+        }
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (size_t k = 0; k < W / 2; ++k)
+            {
+                t[2 * k] = _mm_unpacklo_epi8(r[k], r[k + W / 2]);
+                t[2 * k + 1] = _mm_unpackhi_epi8(r[k], r[k + W / 2]);
+            }
+            std::copy(t, t + W, r);
+        }
+        for (size_t k = 0; k < W; ++k)
+        {
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(out + (j * W + k) * 16), r[k]);
+        }
+    }
+    return blocks * 16;
+}
+#endif
+
+} // end anonymous namespace
+
+CompressShuffle::CompressShuffle(const Params &parameters)
+: Operator("shuffle", COMPRESS_SHUFFLE, "compress", parameters)
+{
+}
+
+void CompressShuffle::Shuffle(const char *in, char *out, const size_t n,
+                              const size_t wordSize)
+{
+    size_t done = 0;
+#if defined(__SSE2__)
+    switch (wordSize)
+    {
+    case 2:
+        done = ShuffleBlocks<2>(in, out, n);
+        break;
+    case 4:
+        done = ShuffleBlocks<4>(in, out, n);
+        break;
+    case 8:
+        done = ShuffleBlocks<8>(in, out, n);
+        break;
+    }
+#endif
+    for (size_t b = 0; b < wordSize; ++b)
+    {
+        for (size_t i = done; i < n; ++i)
+        {
+            out[b * n + i] = in[i * wordSize + b];
+        }
+    }
+}
+
+void CompressShuffle::Unshuffle(const char *in, char *out, const size_t n,
+                                const size_t wordSize)
+{
+    size_t done = 0;
+#if defined(__SSE2__)
+    switch (wordSize)
+    {
+    case 2:
+        done = UnshuffleBlocks<2>(in, out, n);
+        break;
+    case 4:
+        done = UnshuffleBlocks<4>(in, out, n);
+        break;
+    case 8:
+        done = UnshuffleBlocks<8>(in, out, n);
+        break;
+    }
+#endif
+    for (size_t i = done; i < n; ++i)
+    {
+        for (size_t b = 0; b < wordSize; ++b)
+        {
+            out[i * wordSize + b] = in[b * n + i];
+        }
+    }
+}
+
+void CompressShuffle::Predict(const char *in, char *out, const size_t n,
+                              const size_t wordSize, const size_t stride,
+                              const Predictor predictor)
+{
+    switch (wordSize)
+    {
+    case 1:
+        PredictWords(reinterpret_cast<const uint8_t *>(in),
+                     reinterpret_cast<uint8_t *>(out), n, stride, predictor);
+        break;
+    case 2:
+        PredictWords(reinterpret_cast<const uint16_t *>(in),
+                     reinterpret_cast<uint16_t *>(out), n, stride, predictor);
+        break;
+    case 4:
+        PredictWords(reinterpret_cast<const uint32_t *>(in),
+                     reinterpret_cast<uint32_t *>(out), n, stride, predictor);
+        break;
+    default:
+        PredictWords(reinterpret_cast<const uint64_t *>(in),
+                     reinterpret_cast<uint64_t *>(out), n, stride, predictor);
+        break;
+    }
+}
+
+void CompressShuffle::Unpredict(char *data, const size_t n,
+                                const size_t wordSize, const size_t stride,
+                                const Predictor predictor)
+{
+    switch (wordSize)
+    {
+    case 1:
+        UnpredictWords(reinterpret_cast<uint8_t *>(data), n, stride,
+                       predictor);
+        break;
+    case 2:
+        UnpredictWords(reinterpret_cast<uint16_t *>(data), n, stride,
+                       predictor);
+        break;
+    case 4:
+        UnpredictWords(reinterpret_cast<uint32_t *>(data), n, stride,
+                       predictor);
+        break;
+    default:
+        UnpredictWords(reinterpret_cast<uint64_t *>(data), n, stride,
+                       predictor);
+        break;
+    }
+}
+
+size_t CompressShuffle::Operate(const char *dataIn, const Dims &blockStart,
+                                const Dims &blockCount, const DataType type,
+                                char *bufferOut)
+{
+    const uint8_t bufferVersion = 1;
+    size_t bufferOutOffset = 0;
+
+    MakeCommonHeader(bufferOut, bufferOutOffset, bufferVersion);
+
+    const size_t typeSize = helper::GetDataTypeSize(type);
+    const size_t sizeIn = helper::GetTotalSize(blockCount, typeSize);
+    // complex numbers are handled as their two parts, long double as halves
+    size_t wordSize = typeSize;
+    if (type == DataType::FloatComplex || type == DataType::DoubleComplex)
+    {
+        wordSize /= 2;
+    }
+    wordSize = std::min(wordSize, sizeof(uint64_t));
+
+    Predictor predictor = PREDICT_XOR;
+    std::string value;
+    if (helper::GetParameter(m_Parameters, "predictor", value))
+    {
+        if (value == "none")
+        {
+            predictor = PREDICT_NONE;
+        }
+        else if (value == "delta")
+        {
+            predictor = PREDICT_DELTA;
+        }
+        else if (value != "xor")
+        {
+            helper::Throw<std::invalid_argument>(
+                "Operator", "CompressShuffle", "Operate",
+                "Parameter predictor must be none, delta or xor (default)");
+        }
+    }
+    uint64_t dimension = blockCount.empty() ? 0 : blockCount.size() - 1;
+    helper::GetParameter(m_Parameters, "dimension", dimension);
+    if (!blockCount.empty() && dimension >= blockCount.size())
+    {
+        helper::Throw<std::invalid_argument>(
+            "Operator", "CompressShuffle", "Operate",
+            "Parameter dimension " + std::to_string(dimension) +
+                " is out of the " + std::to_string(blockCount.size()) +
+                " dimensions of the block");
+    }
+    bool shuffle = true;
+    helper::GetParameter(m_Parameters, "shuffle", shuffle);
+    std::string compressor = DefaultCompressor;
+    helper::GetParameter(m_Parameters, "compressor", compressor);
+    // all other parameters are the compressor's
+    Params compressorParameters = m_Parameters;
+    for (const auto &key : {"predictor", "dimension", "shuffle", "compressor"})
+    {
+        compressorParameters.erase(key);
+    }
+
+    // values predicted from the one a stride of words before
+    uint64_t stride = typeSize / wordSize;
+    for (size_t d = dimension + 1; d < blockCount.size(); ++d)
+    {
+        stride *= blockCount[d];
+    }
+    const size_t n = sizeIn / wordSize;
+
+    // shuffle V1 metadata
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(predictor));
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(shuffle));
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(wordSize));
+    const size_t compressedPos = bufferOutOffset;
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(0));
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint64_t>(sizeIn));
+    PutParameter(bufferOut, bufferOutOffset, stride);
+    // shuffle V1 metadata end
+
+    // large enough for what the compressor makes of incompressible data
+    const size_t workSize = sizeIn + sizeIn / 8 + 4096;
+    std::vector<char> work1, work2;
+    const char *conditioned = dataIn;
+    if (predictor != PREDICT_NONE)
+    {
+        work1.resize(workSize);
+        Predict(conditioned, work1.data(), n, wordSize, stride, predictor);
+        conditioned = work1.data();
+    }
+    if (shuffle && wordSize > 1)
+    {
+        work2.resize(workSize);
+        Shuffle(conditioned, work2.data(), n, wordSize);
+        conditioned = work2.data();
+    }
+
+    if (compressor != "none" && sizeIn > 0)
+    {
+        std::vector<char> &packed = (conditioned == work1.data()) ? work2 : work1;
+        packed.resize(workSize);
+        auto op = MakeOperator(compressor, compressorParameters);
+        if (!op->IsDataTypeValid(DataType::UInt8))
+        {
+            helper::Throw<std::invalid_argument>(
+                "Operator", "CompressShuffle", "Operate",
+                "compressor " + compressor + " does not support bytes");
+        }
+        const size_t packedSize = op->Operate(conditioned, {0}, {sizeIn},
+                                              DataType::UInt8, packed.data());
+        if (packedSize < sizeIn)
+        {
+            bufferOut[compressedPos] = 1;
+            std::memcpy(bufferOut + bufferOutOffset, packed.data(),
+                        packedSize);
+            return bufferOutOffset + packedSize;
+        }
+    }
+    std::memcpy(bufferOut + bufferOutOffset, conditioned, sizeIn);
+    return bufferOutOffset + sizeIn;
+}
+
+size_t CompressShuffle::InverseOperate(const char *bufferIn,
+                                       const size_t sizeIn, char *dataOut)
+{
+    size_t bufferInOffset = 1; // skip operator type
+    const uint8_t bufferVersion =
+        GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    bufferInOffset += 2; // skip two reserved bytes
+
+    if (bufferVersion == 1)
+    {
+        return DecompressV1(bufferIn + bufferInOffset, sizeIn - bufferInOffset,
+                            dataOut);
+    }
+    else
+    {
+        helper::Throw<std::runtime_error>("Operator", "CompressShuffle",
+                                          "InverseOperate",
+                                          "invalid shuffle buffer version");
+    }
+
+    return 0;
+}
+
+bool CompressShuffle::IsDataTypeValid(const DataType type) const
+{
+    return (type != DataType::None) && (type != DataType::String) &&
+           (type != DataType::Struct);
+}
+
+size_t CompressShuffle::DecompressV1(const char *bufferIn, const size_t sizeIn,
+                                     char *dataOut)
+{
+    // Do NOT remove even if the buffer version is updated. Data might be still
+    // in lagacy formats. This function must be kept for backward compatibility.
+    // If a newer buffer format is implemented, create another function, e.g.
+    // DecompressV2 and keep this function for decompressing lagacy data.
+
+    size_t bufferInOffset = 0;
+    const auto predictor =
+        static_cast<Predictor>(GetParameter<uint8_t>(bufferIn, bufferInOffset));
+    const bool shuffle = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    const size_t wordSize = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    const bool compressed = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    const size_t sizeOut = GetParameter<uint64_t>(bufferIn, bufferInOffset);
+    const size_t stride = GetParameter<uint64_t>(bufferIn, bufferInOffset);
+    const size_t n = sizeOut / wordSize;
+    const bool shuffled = shuffle && (wordSize > 1);
+
+    const char *conditioned = bufferIn + bufferInOffset;
+    std::vector<char> unpacked;
+    if (compressed)
+    {
+        char *dest = dataOut;
+        if (shuffled)
+        {
+            unpacked.resize(sizeOut);
+            dest = unpacked.data();
+        }
+        core::Decompress(conditioned, sizeIn - bufferInOffset, dest);
+        conditioned = dest;
+    }
+    if (shuffled)
+    {
+        Unshuffle(conditioned, dataOut, n, wordSize);
+    }
+    else if (conditioned != dataOut)
+    {
+        std::memcpy(dataOut, conditioned, sizeOut);
+    }
+    if (predictor != PREDICT_NONE)
+    {
+        Unpredict(dataOut, n, wordSize, stride, predictor);
+    }
+    return sizeOut;
+}
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
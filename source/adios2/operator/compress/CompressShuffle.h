@@ -0,0 +1,89 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressShuffle.h : lossless preconditioning of numeric data (prediction
+ * from a neighbor value and byte-plane shuffling) ahead of another lossless
+ * compressor
+ */
+
+#ifndef ADIOS2_OPERATOR_COMPRESS_COMPRESSSHUFFLE_H_
+#define ADIOS2_OPERATOR_COMPRESS_COMPRESSSHUFFLE_H_
+
+#include "adios2/core/Operator.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+class CompressShuffle : public Operator
+{
+
+public:
+    /**
+     * Unique constructor
+     */
+    CompressShuffle(const Params &parameters);
+
+    ~CompressShuffle() = default;
+
+    /**
+     * Replaces each value with its difference (predictor=delta) or bitwise
+     * XOR (predictor=xor) to the previous value along dimension, groups the
+     * n-th bytes of all values together (shuffle=true) and passes the result
+     * to the compressor operator
+     * @param dataIn
+     * @param blockStart
+     * @param blockCount
+     * @param type
+     * @param bufferOut
+     * @return size of compressed buffer
+     */
+    size_t Operate(const char *dataIn, const Dims &blockStart,
+                   const Dims &blockCount, const DataType type,
+                   char *bufferOut) final;
+
+    /**
+     * @param bufferIn
+     * @param sizeIn
+     * @param dataOut
+     * @return size of decompressed buffer
+     */
+    size_t InverseOperate(const char *bufferIn, const size_t sizeIn,
+                          char *dataOut) final;
+
+    bool IsDataTypeValid(const DataType type) const final;
+
+    enum Predictor : uint8_t
+    {
+        PREDICT_NONE = 0,
+        PREDICT_DELTA = 1,
+        PREDICT_XOR = 2,
+    };
+
+    /** bytes of value i are at out[b * n + i], b < wordSize */
+    static void Shuffle(const char *in, char *out, const size_t n,
+                        const size_t wordSize);
+    static void Unshuffle(const char *in, char *out, const size_t n,
+                          const size_t wordSize);
+
+    /** out[i] = in[i] (-|^) in[i - stride] for words of wordSize bytes */
+    static void Predict(const char *in, char *out, const size_t n,
+                        const size_t wordSize, const size_t stride,
+                        const Predictor predictor);
+    static void Unpredict(char *data, const size_t n, const size_t wordSize,
+                          const size_t stride, const Predictor predictor);
+
+private:
+    size_t DecompressV1(const char *bufferIn, const size_t sizeIn,
+                        char *dataOut);
+};
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_OPERATOR_COMPRESS_COMPRESSSHUFFLE_H_ */
@@ -25,11 +25,32 @@ int CompressSirius::m_CurrentTier;
 std::vector<std::vector<char>> CompressSirius::m_TierBuffers;
 int CompressSirius::m_Tiers = 0;
 bool CompressSirius::m_CurrentReadFinished = false;
+std::unordered_map<uint64_t, bool> CompressSirius::m_ReadFinishedMap;
+std::mutex CompressSirius::m_Mutex;
+
+namespace
+{
+// FNV-1a, stored in V2 buffers, so it must not depend on the platform
+uint64_t VariableKey(const std::string &variable)
+{
+    uint64_t key = 14695981039346656037ULL;
+    for (const char c : variable)
+    {
+        key ^= static_cast<uint8_t>(c);
+        key *= 1099511628211ULL;
+    }
+    return key;
+}
+} // end anonymous namespace
 
 CompressSirius::CompressSirius(const Params &parameters)
 : Operator("sirius", COMPRESS_SIRIUS, "compress", parameters)
 {
     helper::GetParameter(parameters, "Tiers", m_Tiers);
+    helper::GetParameter(parameters, "Tier", m_Tier);
+    std::string variable;
+    helper::GetParameter(parameters, "Variable", variable);
+    m_VariableKey = VariableKey(variable);
     m_TierBuffersMap.resize(m_Tiers);
     m_TierBuffers.resize(m_Tiers);
 }
@@ -38,7 +59,9 @@ size_t CompressSirius::Operate(const char *dataIn, const Dims &blockStart,
                                const Dims &blockCount, const DataType varType,
                                char *bufferOut)
 {
-    const uint8_t bufferVersion = 1;
+    // per-tier instances tag their blocks with the variable, so that the
+    // reader can hold the tiers of several variables at the same time
+    const uint8_t bufferVersion = (m_Tier >= 0) ? 2 : 1;
     size_t bufferOutOffset = 0;
 
     MakeCommonHeader(bufferOut, bufferOutOffset, bufferVersion);
@@ -57,6 +80,10 @@ size_t CompressSirius::Operate(const char *dataIn, const Dims &blockStart,
     }
     PutParameter(bufferOut, bufferOutOffset, varType);
     // sirius V1 metadata end
+    if (bufferVersion == 2)
+    {
+        PutParameter(bufferOut, bufferOutOffset, m_VariableKey);
+    }
 
     size_t totalInputBytes =
         helper::GetTotalSize(blockCount, helper::GetDataTypeSize(varType));
@@ -64,6 +91,14 @@ size_t CompressSirius::Operate(const char *dataIn, const Dims &blockStart,
     // if called from Tier 0 sub-engine, then compute tier buffers and put into
     // m_TierBuffers
     size_t bytesPerTier = totalInputBytes / m_Tiers;
+    if (m_Tier >= 0)
+    {
+        // stateless, so the tiers of a variable can be compressed at once
+        std::memcpy(bufferOut + bufferOutOffset, dataIn + m_Tier * bytesPerTier,
+                    bytesPerTier);
+        return bufferOutOffset + bytesPerTier;
+    }
+
     if (m_CurrentTier == 0)
     {
         for (size_t i = 0; i < m_TierBuffers.size(); i++)
@@ -90,6 +125,7 @@ size_t CompressSirius::Operate(const char *dataIn, const Dims &blockStart,
 size_t CompressSirius::InverseOperate(const char *bufferIn, const size_t sizeIn,
                                       char *dataOut)
 {
+    std::lock_guard<std::mutex> lockGuard(m_Mutex);
     size_t bufferInOffset = 1; // skip operator type
     const uint8_t bufferVersion =
         GetParameter<uint8_t>(bufferIn, bufferInOffset);
@@ -102,8 +138,8 @@ size_t CompressSirius::InverseOperate(const char *bufferIn, const size_t sizeIn,
     }
     else if (bufferVersion == 2)
     {
-        // TODO: if a Version 2 sirius buffer is being implemented, put it here
-        // and keep the DecompressV1 routine for backward compatibility
+        return DecompressV2(bufferIn + bufferInOffset, sizeIn - bufferInOffset,
+                            dataOut);
     }
     else
     {
@@ -115,6 +151,19 @@ size_t CompressSirius::InverseOperate(const char *bufferIn, const size_t sizeIn,
     return 0;
 }
 
+bool CompressSirius::IsReadFinished(const std::string &variable)
+{
+    std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    auto it = m_ReadFinishedMap.find(VariableKey(variable));
+    return it != m_ReadFinishedMap.end() && it->second;
+}
+
+void CompressSirius::ClearReadFinished()
+{
+    std::lock_guard<std::mutex> lockGuard(m_Mutex);
+    m_ReadFinishedMap.clear();
+}
+
 bool CompressSirius::IsDataTypeValid(const DataType type) const
 {
     if (type == DataType::Float)
@@ -132,6 +181,20 @@ size_t CompressSirius::DecompressV1(const char *bufferIn, const size_t sizeIn,
     // If a newer buffer format is implemented, create another function, e.g.
     // DecompressV2 and keep this function for decompressing lagacy data.
 
+    return DecompressBlock(bufferIn, sizeIn, dataOut, 1);
+}
+
+size_t CompressSirius::DecompressV2(const char *bufferIn, const size_t sizeIn,
+                                    char *dataOut)
+{
+    // V1 metadata followed by the key of the variable
+    return DecompressBlock(bufferIn, sizeIn, dataOut, 2);
+}
+
+size_t CompressSirius::DecompressBlock(const char *bufferIn,
+                                       const size_t sizeIn, char *dataOut,
+                                       const uint8_t bufferVersion)
+{
     size_t bufferInOffset = 0;
     const size_t ndims = GetParameter<size_t, size_t>(bufferIn, bufferInOffset);
     Dims blockStart(ndims);
@@ -151,6 +214,12 @@ size_t CompressSirius::DecompressV1(const char *bufferIn, const size_t sizeIn,
 
     std::string blockId =
         helper::DimsToString(blockStart) + helper::DimsToString(blockCount);
+    uint64_t variableKey = 0;
+    if (bufferVersion >= 2)
+    {
+        variableKey = GetParameter<uint64_t>(bufferIn, bufferInOffset);
+        blockId = std::to_string(variableKey) + blockId;
+    }
 
     // decompress data and copy back to m_TierBuffers
     size_t bytesPerTier = outputBytes / m_Tiers;
@@ -165,11 +234,10 @@ size_t CompressSirius::DecompressV1(const char *bufferIn, const size_t sizeIn,
 
     // TODO: it currently only copies output data back when the final tier is
     // read. However, the real Sirius algorithm should instead decide when to
-    // copy back decompressed data based on required acuracy level. Once it's
-    // done, it should set m_CurrentReadFinished to true to inform the MHS
-    // engine that the current read is finished so that it won't read the next
-    // tier.
-    if (currentTier == m_Tiers - 1)
+    // copy back decompressed data based on required acuracy level, and report
+    // it as finished so that the MHS engine won't read the next tier.
+    const bool finished = (currentTier == m_Tiers - 1);
+    if (finished)
     {
         for (auto &bmap : m_TierBuffersMap)
         {
@@ -177,15 +245,14 @@ size_t CompressSirius::DecompressV1(const char *bufferIn, const size_t sizeIn,
             std::memcpy(dataOut + accumulatedBytes, b.data(), b.size());
             accumulatedBytes += b.size();
         }
-        // set m_CurrentReadFinished to true if after the current call, the
-        // required acuracy is already satisfied, so that the MHS engine knows
-        // it shouldn't continue reading the next tier.
-        m_CurrentReadFinished = true;
     }
-
-    // set m_CurrentReadFinished to false if the current tier does not satisfy
-    // the required acuracy, so the MHS engine will read the next tier.
-    m_CurrentReadFinished = false;
+    m_CurrentReadFinished = finished;
+    if (bufferVersion >= 2)
+    {
+        // a variable is finished once all of its blocks are
+        auto it = m_ReadFinishedMap.emplace(variableKey, true).first;
+        it->second = it->second && finished;
+    }
 
     currentTier++;
     if (currentTier % m_Tiers == 0)
@@ -12,6 +12,7 @@
 #define ADIOS2_OPERATOR_COMPRESS_COMPRESSSIRIUS_H_
 
 #include "adios2/core/Operator.h"
+#include <mutex>
 #include <unordered_map>
 
 namespace adios2
@@ -40,9 +41,24 @@ public:
 
     static bool m_CurrentReadFinished;
 
+    /**
+     * True if every block of the variable decompressed since the last
+     * ClearReadFinished is finished, so its next tier does not need to be
+     * read. Only known for blocks written with the "Variable" parameter.
+     * @param variable : variable name
+     */
+    static bool IsReadFinished(const std::string &variable);
+
+    static void ClearReadFinished();
+
 private:
     static int m_Tiers;
 
+    // tier written by this instance, -1: the next tier of the shared state
+    int m_Tier = -1;
+    // hash of the "Variable" parameter, written to V2 buffers
+    uint64_t m_VariableKey = 0;
+
     // for compress
     static std::vector<std::vector<char>> m_TierBuffers;
     static int m_CurrentTier;
@@ -51,6 +67,10 @@ private:
     static std::vector<std::unordered_map<std::string, std::vector<char>>>
         m_TierBuffersMap;
     static std::unordered_map<std::string, int> m_CurrentTierMap;
+    // finished state of the variables read since ClearReadFinished
+    static std::unordered_map<uint64_t, bool> m_ReadFinishedMap;
+    // tier state is shared by all instances, decompress one at a time
+    static std::mutex m_Mutex;
 
     /**
      * Decompress function for V1 buffer. Do NOT remove even if the buffer
@@ -63,6 +83,17 @@ private:
      */
     size_t DecompressV1(const char *bufferIn, const size_t sizeIn,
                         char *dataOut);
+
+    /**
+     * Decompress function for V2 buffer, V1 metadata followed by the key of
+     * the variable so that variables with the same block geometry are kept
+     * apart
+     */
+    size_t DecompressV2(const char *bufferIn, const size_t sizeIn,
+                        char *dataOut);
+
+    size_t DecompressBlock(const char *bufferIn, const size_t sizeIn,
+                           char *dataOut, const uint8_t bufferVersion);
 };
 
 } // end namespace compress
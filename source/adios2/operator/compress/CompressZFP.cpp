@@ -9,6 +9,9 @@
  */
 #include "CompressZFP.h"
 #include "adios2/helper/adiosFunctions.h"
+#include <algorithm>
+#include <cstring>
+#include <future>
 #include <sstream>
 #include <zfp.h>
 
@@ -52,6 +55,20 @@ zfp_type GetZfpType(DataType type);
 zfp_stream *GetZFPStream(const Dims &dimensions, DataType type,
                          const Params &parameters);
 
+/**
+ * Number of threads requested with the threads parameter, 1 if not set
+ * @param parameters
+ * @return threads >= 1
+ */
+size_t GetZFPThreads(const Params &parameters);
+
+/**
+ * Forces the serial policy on streams set to OpenMP, which zfp does not
+ * support for decompression
+ * @param stream
+ */
+void SetZFPDecompressExecution(zfp_stream *stream);
+
 CompressZFP::CompressZFP(const Params &parameters)
 : Operator("zfp", COMPRESS_ZFP, "compress", parameters)
 {
@@ -61,7 +78,40 @@ size_t CompressZFP::Operate(const char *dataIn, const Dims &blockStart,
                             const Dims &blockCount, const DataType type,
                             char *bufferOut)
 {
-    const uint8_t bufferVersion = 1;
+    Dims convertedDims = ConvertDims(blockCount, type, 3);
+
+    zfp_field *field = GetZFPField(dataIn, convertedDims, type);
+    zfp_stream *stream = GetZFPStream(convertedDims, type, m_Parameters);
+
+    // more than one thread: zfp's OpenMP policy if zfp was built with it,
+    // otherwise independently compressed slabs (buffer version 2)
+    const size_t threads = GetZFPThreads(m_Parameters);
+    bool useSlabs = false;
+#if ZFP_VERSION_RELEASE > 1
+    if (threads > 1 && zfp_stream_execution(stream) != zfp_exec_cuda)
+    {
+        auto itBackend = m_Parameters.find("backend");
+        if ((itBackend == m_Parameters.end() ||
+             itBackend->second != "serial") &&
+            zfp_stream_set_execution(stream, zfp_exec_omp))
+        {
+            zfp_stream_set_omp_threads(stream,
+                                       static_cast<unsigned int>(threads));
+        }
+        else
+        {
+            useSlabs = true;
+        }
+    }
+#else
+    useSlabs = threads > 1;
+#endif
+    // slabs span whole zfp blocks of 4 along the slowest dimension
+    const size_t slabRows =
+        (convertedDims.back() + 4 * threads - 1) / (4 * threads) * 4;
+    useSlabs = useSlabs && slabRows < convertedDims.back();
+
+    const uint8_t bufferVersion = useSlabs ? 2 : 1;
     size_t bufferOutOffset = 0;
 
     MakeCommonHeader(bufferOut, bufferOutOffset, bufferVersion);
@@ -84,10 +134,14 @@ size_t CompressZFP::Operate(const char *dataIn, const Dims &blockStart,
     PutParameters(bufferOut, bufferOutOffset, m_Parameters);
     // zfp V1 metadata end
 
-    Dims convertedDims = ConvertDims(blockCount, type, 3);
-
-    zfp_field *field = GetZFPField(dataIn, convertedDims, type);
-    zfp_stream *stream = GetZFPStream(convertedDims, type, m_Parameters);
+    if (useSlabs)
+    {
+        zfp_field_free(field);
+        zfp_stream_close(stream);
+        return bufferOutOffset +
+               CompressSlabs(dataIn, convertedDims, type, slabRows,
+                             bufferOut + bufferOutOffset);
+    }
 
     size_t maxSize = zfp_stream_maximum_size(stream, field);
     // associate bitstream
@@ -128,8 +182,8 @@ size_t CompressZFP::InverseOperate(const char *bufferIn, const size_t sizeIn,
     }
     else if (bufferVersion == 2)
     {
-        // TODO: if a Version 2 zfp buffer is being implemented, put it here
-        // and keep the DecompressV1 routine for backward compatibility
+        return DecompressV2(bufferIn + bufferInOffset, sizeIn - bufferInOffset,
+                            dataOut);
     }
     else
     {
@@ -186,6 +240,7 @@ size_t CompressZFP::DecompressV1(const char *bufferIn, const size_t sizeIn,
 
     field = GetZFPField(dataOut, convertedDims, type);
     stream = GetZFPStream(convertedDims, type, parameters);
+    SetZFPDecompressExecution(stream);
 
     // associate bitstream
     bitstream *bitstream = stream_open(
@@ -209,6 +264,163 @@ size_t CompressZFP::DecompressV1(const char *bufferIn, const size_t sizeIn,
     return helper::GetTotalSize(convertedDims, helper::GetDataTypeSize(type));
 }
 
+size_t CompressZFP::CompressSlabs(const char *dataIn,
+                                  const Dims &convertedDims,
+                                  const DataType type, const size_t slabRows,
+                                  char *bufferOut)
+{
+    const size_t rows = convertedDims.back();
+    const size_t nSlabs = (rows + slabRows - 1) / slabRows;
+    // bytes of one row of the slowest dimension
+    const size_t rowSize = helper::GetTotalSize(convertedDims) / rows *
+                           zfp_type_size(GetZfpType(type));
+
+    std::vector<std::vector<char>> slabs(nSlabs);
+    std::vector<std::future<size_t>> futures;
+    futures.reserve(nSlabs);
+    for (size_t i = 0; i < nSlabs; ++i)
+    {
+        futures.push_back(std::async(std::launch::async, [&, i]() {
+            Dims slabDims = convertedDims;
+            slabDims.back() = std::min(slabRows, rows - i * slabRows);
+
+            zfp_field *field = GetZFPField(dataIn + i * slabRows * rowSize,
+                                           slabDims, type);
+            zfp_stream *stream = GetZFPStream(slabDims, type, m_Parameters);
+#if ZFP_VERSION_RELEASE > 1
+            zfp_stream_set_execution(stream, zfp_exec_serial);
+#endif
+            slabs[i].resize(zfp_stream_maximum_size(stream, field));
+            bitstream *bitstream =
+                stream_open(slabs[i].data(), slabs[i].size());
+            zfp_stream_set_bit_stream(stream, bitstream);
+            zfp_stream_rewind(stream);
+
+            const size_t sizeOut = zfp_compress(stream, field);
+
+            zfp_field_free(field);
+            zfp_stream_close(stream);
+            stream_close(bitstream);
+            return sizeOut;
+        }));
+    }
+
+    // slab table, then the slab streams in order
+    size_t bufferOutOffset = 0;
+    PutParameter(bufferOut, bufferOutOffset, nSlabs);
+    PutParameter(bufferOut, bufferOutOffset, slabRows);
+    std::vector<size_t> sizes(nSlabs);
+    for (size_t i = 0; i < nSlabs; ++i)
+    {
+        sizes[i] = futures[i].get();
+        if (sizes[i] == 0)
+        {
+            helper::Throw<std::runtime_error>(
+                "Operator", "CompressZFP", "CompressSlabs",
+                "zfp failed, compressed buffer size of slab " +
+                    std::to_string(i) + " is 0");
+        }
+        PutParameter(bufferOut, bufferOutOffset, sizes[i]);
+    }
+    for (size_t i = 0; i < nSlabs; ++i)
+    {
+        std::memcpy(bufferOut + bufferOutOffset, slabs[i].data(), sizes[i]);
+        bufferOutOffset += sizes[i];
+    }
+
+    return bufferOutOffset;
+}
+
+size_t CompressZFP::DecompressV2(const char *bufferIn, const size_t sizeIn,
+                                 char *dataOut)
+{
+    // V1 metadata followed by a table of slabs compressed independently
+    // along the slowest zfp dimension
+
+    size_t bufferInOffset = 0;
+
+    const size_t ndims = GetParameter<size_t, size_t>(bufferIn, bufferInOffset);
+    Dims blockCount(ndims);
+    for (size_t i = 0; i < ndims; ++i)
+    {
+        blockCount[i] = GetParameter<size_t, size_t>(bufferIn, bufferInOffset);
+    }
+    const DataType type = GetParameter<DataType>(bufferIn, bufferInOffset);
+    this->m_VersionInfo =
+        " Data is compressed using ZFP Version " +
+        std::to_string(GetParameter<uint8_t>(bufferIn, bufferInOffset)) + "." +
+        std::to_string(GetParameter<uint8_t>(bufferIn, bufferInOffset)) + "." +
+        std::to_string(GetParameter<uint8_t>(bufferIn, bufferInOffset)) +
+        ". Please make sure a compatible version is used for decompression.";
+    const Params parameters = GetParameters(bufferIn, bufferInOffset);
+
+    const size_t nSlabs =
+        GetParameter<size_t, size_t>(bufferIn, bufferInOffset);
+    const size_t slabRows =
+        GetParameter<size_t, size_t>(bufferIn, bufferInOffset);
+    std::vector<size_t> slabOffsets(nSlabs + 1);
+    slabOffsets[0] = bufferInOffset + nSlabs * sizeof(size_t);
+    for (size_t i = 0; i < nSlabs; ++i)
+    {
+        slabOffsets[i + 1] =
+            slabOffsets[i] +
+            GetParameter<size_t, size_t>(bufferIn, bufferInOffset);
+    }
+    if (slabOffsets[nSlabs] > sizeIn)
+    {
+        helper::Throw<std::runtime_error>(
+            "Operator", "CompressZFP", "DecompressV2",
+            "zfp slabs of " + std::to_string(slabOffsets[nSlabs]) +
+                " bytes exceed the buffer of " + std::to_string(sizeIn) +
+                " bytes");
+    }
+
+    const Dims convertedDims = ConvertDims(blockCount, type, 3);
+    const size_t rows = convertedDims.back();
+    const size_t rowSize = helper::GetTotalSize(convertedDims) / rows *
+                           zfp_type_size(GetZfpType(type));
+
+    std::vector<std::future<int>> futures;
+    futures.reserve(nSlabs);
+    for (size_t i = 0; i < nSlabs; ++i)
+    {
+        futures.push_back(std::async(std::launch::async, [&, i]() {
+            Dims slabDims = convertedDims;
+            slabDims.back() = std::min(slabRows, rows - i * slabRows);
+
+            zfp_field *field = GetZFPField(dataOut + i * slabRows * rowSize,
+                                           slabDims, type);
+            zfp_stream *stream = GetZFPStream(slabDims, type, parameters);
+            SetZFPDecompressExecution(stream);
+            bitstream *bitstream =
+                stream_open(const_cast<char *>(bufferIn + slabOffsets[i]),
+                            slabOffsets[i + 1] - slabOffsets[i]);
+            zfp_stream_set_bit_stream(stream, bitstream);
+            zfp_stream_rewind(stream);
+
+            const int status = static_cast<int>(zfp_decompress(stream, field));
+
+            zfp_field_free(field);
+            zfp_stream_close(stream);
+            stream_close(bitstream);
+            return status;
+        }));
+    }
+    for (size_t i = 0; i < nSlabs; ++i)
+    {
+        const int status = futures[i].get();
+        if (!status)
+        {
+            helper::Throw<std::runtime_error>(
+                "Operator", "CompressZFP", "DecompressV2",
+                "zfp failed on slab " + std::to_string(i) + " with status " +
+                    std::to_string(status));
+        }
+    }
+
+    return helper::GetTotalSize(convertedDims, helper::GetDataTypeSize(type));
+}
+
 zfp_type GetZfpType(DataType type)
 {
     zfp_type zfpType = zfp_type_none;
@@ -378,6 +590,28 @@ zfp_stream *GetZFPStream(const Dims &dimensions, DataType type,
     return stream;
 }
 
+size_t GetZFPThreads(const Params &parameters)
+{
+    auto itThreads = parameters.find("threads");
+    if (itThreads == parameters.end())
+    {
+        return 1;
+    }
+    const size_t threads = helper::StringToSizeT(
+        itThreads->second, "setting 'threads' in call to CompressZfp\n");
+    return threads > 0 ? threads : 1;
+}
+
+void SetZFPDecompressExecution(zfp_stream *stream)
+{
+#if ZFP_VERSION_RELEASE > 1
+    if (zfp_stream_execution(stream) == zfp_exec_omp)
+    {
+        zfp_stream_set_execution(stream, zfp_exec_serial);
+    }
+#endif
+}
+
 } // end namespace compress
 } // end namespace core
 } // end namespace adios2
@@ -68,6 +68,32 @@ private:
     size_t DecompressV1(const char *bufferIn, const size_t sizeIn,
                         char *dataOut);
 
+    /**
+     * Decompress function for V2 buffer: V1 metadata and slabs compressed
+     * independently along the slowest zfp dimension, decompressed in
+     * parallel
+     * @param bufferIn : compressed data buffer (V2 only)
+     * @param sizeIn : number of bytes in bufferIn
+     * @param dataOut : decompressed data buffer
+     * @return : number of bytes in dataOut
+     */
+    size_t DecompressV2(const char *bufferIn, const size_t sizeIn,
+                        char *dataOut);
+
+    /**
+     * Compresses slabs of slabRows along the slowest zfp dimension
+     * concurrently, one thread per slab
+     * @param dataIn : block data
+     * @param convertedDims : block dimensions as passed to zfp
+     * @param type : block data type
+     * @param slabRows : rows of each slab but the last, a multiple of 4
+     * @param bufferOut : receives the slab table and the slab streams
+     * @return : number of bytes in bufferOut
+     */
+    size_t CompressSlabs(const char *dataIn, const Dims &convertedDims,
+                         const DataType type, const size_t slabRows,
+                         char *bufferOut);
+
     std::string m_VersionInfo;
 };
 
@@ -14,6 +14,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <utility>
 
@@ -39,6 +40,10 @@ struct PluginOperator::Impl
     int m_Verbosity = 0;
 };
 
+/* Plugins make no promise of being reentrant, and the plugin manager is
+ * shared by all operator instances, so decompression is serialized */
+static std::mutex PluginInverseMutex;
+
 /******************************************************************************/
 
 PluginOperator::PluginOperator(const Params &parameters)
@@ -102,6 +107,7 @@ size_t PluginOperator::Operate(const char *dataIn, const Dims &blockStart,
 size_t PluginOperator::InverseOperate(const char *bufferIn, const size_t sizeIn,
                                       char *dataOut)
 {
+    std::lock_guard<std::mutex> lockGuard(PluginInverseMutex);
     size_t offset = 4; // skip 4 bytes for the common header
 
     // now handle plugin specific header
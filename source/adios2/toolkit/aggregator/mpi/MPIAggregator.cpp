@@ -74,10 +74,7 @@ void MPIAggregator::InitComm(const size_t subStreams,
     m_Rank = m_Comm.Rank();
     m_Size = m_Comm.Size();
 
-    if (m_Rank != 0)
-    {
-        m_IsAggregator = false;
-    }
+    m_IsAggregator = (m_Rank == 0);
 
     m_IsActive = true;
     m_SubStreams = subStreams;
@@ -89,10 +86,7 @@ void MPIAggregator::InitCommOnePerNode(helper::Comm const &parentComm)
     m_Rank = m_Comm.Rank();
     m_Size = m_Comm.Size();
 
-    if (m_Rank != 0)
-    {
-        m_IsAggregator = false;
-    }
+    m_IsAggregator = (m_Rank == 0);
 
     m_IsActive = true;
 
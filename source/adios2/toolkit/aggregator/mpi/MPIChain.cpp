@@ -12,6 +12,8 @@
 #include "adios2/helper/adiosLog.h"
 #include "adios2/toolkit/format/buffer/heap/BufferSTL.h"
 
+#include <algorithm> // std::min
+
 namespace adios2
 {
 namespace aggregator
@@ -37,6 +39,7 @@ void MPIChain::Init(const size_t numAggregators, const size_t subStreams,
     HandshakeLinks();
 
     // add a receiving buffer except for the last rank (only sends)
+    m_Buffers.clear();
     if (m_Rank < m_Size)
     {
         m_Buffers.emplace_back(new format::BufferSTL()); // just one for now
@@ -227,6 +230,111 @@ format::Buffer &MPIChain::GetConsumerBuffer(format::Buffer &buffer)
     return GetSender(buffer);
 }
 
+void MPIChain::TreeAggregate(
+    format::Buffer &buffer, const size_t fanIn, const size_t numBuffers,
+    const std::function<void(const char *, size_t)> &write,
+    profiling::IOChrono &profiler)
+{
+    // the same positions in the subfile as in the chain
+    const std::vector<size_t> sizes = m_Comm.AllGatherValues(buffer.m_Position);
+    size_t position = m_Comm.BroadcastValue(buffer.m_AbsolutePosition, 0);
+    for (int r = 1; r < m_Size; ++r)
+    {
+        if (r == m_Rank)
+        {
+            buffer.m_AbsolutePosition = position;
+        }
+        position += sizes[r];
+    }
+    if (m_Rank == 0)
+    {
+        buffer.m_AbsolutePosition = position;
+    }
+
+    const int fan = static_cast<int>(fanIn);
+    int parent = -1;
+    int end = m_Size;
+    TreeNode(fan, m_Rank, parent, end);
+
+    helper::Comm::Req ownSend;
+    if (m_Rank == 0)
+    {
+        if (sizes[0] > 0)
+        {
+            profiler.Start("aggregation_write");
+            write(buffer.Data(), sizes[0]);
+            profiler.Stop("aggregation_write");
+        }
+    }
+    else if (sizes[m_Rank] > 0)
+    {
+        ownSend = m_Comm.Isend(buffer.Data(), sizes[m_Rank], parent, 1,
+                               ", tree aggregation Isend data of rank " +
+                                   std::to_string(m_Rank));
+    }
+
+    // non-empty buffers of the subtree after this rank, in file order
+    std::vector<int> items;
+    for (int r = m_Rank + 1; r < end; ++r)
+    {
+        if (sizes[r] > 0)
+        {
+            items.push_back(r);
+        }
+    }
+    const int piece = (end - m_Rank - 2 + fan) / fan;
+    auto lf_Child = [&](const int r) -> int {
+        return m_Rank + 1 + ((r - m_Rank - 1) / piece) * piece;
+    };
+
+    const size_t slots = std::min(numBuffers, items.size());
+    std::vector<std::vector<char>> receiveBuffers(slots);
+    std::vector<helper::Comm::Req> receives(slots);
+    auto lf_PostReceive = [&](const size_t i) {
+        const size_t slot = i % slots;
+        const int r = items[i];
+        receiveBuffers[slot].resize(sizes[r]);
+        receives[slot] = m_Comm.Irecv(
+            receiveBuffers[slot].data(), sizes[r], lf_Child(r), 1,
+            ", tree aggregation Irecv data of rank " + std::to_string(r));
+    };
+
+    for (size_t i = 0; i < slots; ++i)
+    {
+        lf_PostReceive(i);
+    }
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        const size_t slot = i % slots;
+        const std::vector<char> &data = receiveBuffers[slot];
+        const std::string hint = ", tree aggregation of data of rank " +
+                                 std::to_string(items[i]) + "\n";
+        profiler.Start("aggregation_wait");
+        receives[slot].Wait(hint);
+        profiler.Stop("aggregation_wait");
+        if (m_Rank == 0)
+        {
+            profiler.Start("aggregation_write");
+            write(data.data(), data.size());
+            profiler.Stop("aggregation_write");
+        }
+        else
+        {
+            // the other slots keep receiving meanwhile
+            profiler.Start("aggregation_wait");
+            m_Comm.Isend(data.data(), data.size(), parent, 1, hint).Wait(hint);
+            profiler.Stop("aggregation_wait");
+        }
+        if (i + slots < items.size())
+        {
+            lf_PostReceive(i + slots);
+        }
+    }
+
+    ownSend.Wait(", tree aggregation waiting for Isend of rank " +
+                 std::to_string(m_Rank) + "\n");
+}
+
 // PRIVATE
 void MPIChain::HandshakeLinks()
 {
@@ -257,6 +365,22 @@ void MPIChain::HandshakeLinks()
     }
 }
 
+void MPIChain::TreeNode(const int fanIn, const int rank, int &parent,
+                        int &end) const
+{
+    int first = 0;
+    parent = -1;
+    end = m_Size;
+    while (first != rank)
+    {
+        const int piece = (end - first - 2 + fanIn) / fanIn;
+        const int child = first + 1 + ((rank - first - 1) / piece) * piece;
+        parent = first;
+        end = std::min(child + piece, end);
+        first = child;
+    }
+}
+
 format::Buffer &MPIChain::GetSender(format::Buffer &buffer)
 {
     if (m_CurrentBufferOrder == 0)
@@ -11,7 +11,11 @@
 #ifndef ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPICHAIN_H_
 #define ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPICHAIN_H_
 
+#include <functional>
+#include <vector>
+
 #include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
+#include "adios2/toolkit/profiling/iochrono/IOChrono.h"
 
 namespace adios2
 {
@@ -61,6 +65,24 @@ public:
 
     format::Buffer &GetConsumerBuffer(format::Buffer &buffer);
 
+    /**
+     * Alternative to the IExchange/Wait iterations. The data of all ranks
+     * reaches the aggregator (rank 0) in rank order through a tree with up
+     * to fanIn children per process, each process relaying the buffers of
+     * its subtree as they arrive. Up to numBuffers receives are posted
+     * ahead, so they overlap with the relays and with the writes of the
+     * aggregator. Sets m_AbsolutePosition as IExchangeAbsolutePosition does.
+     * @param buffer serialized data of this rank
+     * @param fanIn maximum number of children per process (> 0)
+     * @param numBuffers receive buffers per process (>= 2)
+     * @param write called by the aggregator with each buffer in file order
+     * @param profiler times aggregation_wait and aggregation_write
+     */
+    void TreeAggregate(format::Buffer &buffer, const size_t fanIn,
+                       const size_t numBuffers,
+                       const std::function<void(const char *, size_t)> &write,
+                       profiling::IOChrono &profiler);
+
 private:
     bool m_IsInExchangeAbsolutePosition = false;
     size_t m_SizeSend = 0;
@@ -73,6 +95,14 @@ private:
 
     void HandshakeLinks();
 
+    /**
+     * Subtree [rank, end) and parent of rank in the tree of TreeAggregate,
+     * in which the ranks after a process in its subtree are split in up to
+     * fanIn contiguous subtrees of its children
+     */
+    void TreeNode(const int fanIn, const int rank, int &parent,
+                  int &end) const;
+
     /**
      * Returns a reference to the sender buffer depending on
      * m_CurrentBufferOrder
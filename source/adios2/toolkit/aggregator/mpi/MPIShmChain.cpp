@@ -32,6 +32,8 @@ void MPIShmChain::Close()
             "free comm of all aggregators in ~MPIShmChain()");
         m_AggregatorChainComm.Free(
             "free chains of aggregators in ~MPIShmChain()");
+        // a new Init after Close has to split the node comm again
+        PreInitCalled = false;
     }
     MPIAggregator::Close();
 }
@@ -93,11 +95,8 @@ void MPIShmChain::Init(const size_t numAggregators, const size_t subStreams,
     m_Comm = m_NodeComm.Split(color, 0, "creating aggregator groups at Open");
     m_Rank = m_Comm.Rank();
     m_Size = m_Comm.Size();
-    if (m_Rank != 0)
-    {
-        m_IsAggregator = false;
-        m_IsMasterAggregator = false;
-    }
+    m_IsAggregator = (m_Rank == 0);
+    m_IsMasterAggregator = m_IsAggregator;
 
     /* Identify parent rank of aggregator process within each chain */
     if (!m_Rank)
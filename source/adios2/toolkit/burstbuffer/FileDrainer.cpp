@@ -31,7 +31,8 @@ FileDrainOperation::FileDrainOperation(DrainOperation op,
                                        size_t countBytes, size_t fromOffset,
                                        size_t toOffset, const void *data)
 : op(op), fromFileName(fromFileName), toFileName(toFileName),
-  countBytes(countBytes), fromOffset(fromOffset), toOffset(toOffset)
+  countBytes(countBytes), fromOffset(fromOffset), toOffset(toOffset),
+  queuedTime(std::chrono::steady_clock::now())
 {
     if (data)
     {
@@ -40,8 +41,19 @@ FileDrainOperation::FileDrainOperation(DrainOperation op,
     };
 }
 
+static bool IsDataOperation(const DrainOperation op)
+{
+    return (op == DrainOperation::CopyAt || op == DrainOperation::Copy ||
+            op == DrainOperation::WriteAt || op == DrainOperation::Write);
+}
+
 void FileDrainer::AddOperation(FileDrainOperation &operation)
 {
+    if (IsDataOperation(operation.op))
+    {
+        std::lock_guard<std::mutex> lockGuard(m_StatisticsMutex);
+        m_Statistics.bytesQueued += operation.countBytes;
+    }
     std::lock_guard<std::mutex> lockGuard(operationsMutex);
     operations.push(operation);
 }
@@ -54,8 +66,7 @@ void FileDrainer::AddOperation(DrainOperation op,
 {
     FileDrainOperation operation(op, fromFileName, toFileName, countBytes,
                                  fromOffset, toOffset, data);
-    std::lock_guard<std::mutex> lockGuard(operationsMutex);
-    operations.push(operation);
+    AddOperation(operation);
 }
 
 void FileDrainer::AddOperationSeekEnd(const std::string &toFileName)
@@ -290,5 +301,45 @@ void FileDrainer::SetVerbose(int verboseLevel, int rank)
     m_Rank = rank;
 }
 
+DrainStatistics FileDrainer::GetStatistics()
+{
+    std::lock_guard<std::mutex> lockGuard(m_StatisticsMutex);
+    return m_Statistics;
+}
+
+void FileDrainer::OperationDone(const FileDrainOperation &operation,
+                                size_t bytes)
+{
+    const std::chrono::duration<double> lag =
+        std::chrono::steady_clock::now() - operation.queuedTime;
+    std::lock_guard<std::mutex> lockGuard(m_StatisticsMutex);
+    if (IsDataOperation(operation.op))
+    {
+        m_Statistics.bytesDrained += bytes;
+    }
+    ++m_Statistics.operationsDrained;
+    m_Statistics.totalLagSeconds += lag.count();
+    if (lag.count() > m_Statistics.maxLagSeconds)
+    {
+        m_Statistics.maxLagSeconds = lag.count();
+    }
+}
+
+void FileDrainer::PrintStatistics()
+{
+    const DrainStatistics stats = GetStatistics();
+    const double avgLag =
+        stats.operationsDrained
+            ? stats.totalLagSeconds /
+                  static_cast<double>(stats.operationsDrained)
+            : 0.0;
+    std::cout << "Drain " << m_Rank << ": Drained " << stats.bytesDrained
+              << " of " << stats.bytesQueued << " bytes in "
+              << stats.operationsDrained
+              << " operations. Lag behind application max = "
+              << stats.maxLagSeconds << " avg = " << avgLag << " seconds"
+              << std::endl;
+}
+
 } // end namespace burstbuffer
 } // end namespace adios2
@@ -11,6 +11,7 @@
 #ifndef ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINER_H_
 #define ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINER_H_
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <locale>
@@ -52,12 +53,27 @@ struct FileDrainOperation
     size_t fromOffset;
     size_t toOffset;
     std::vector<char> dataToWrite; // memory to write with Write operation
+    /** time of AddOperation, to measure the lag of draining */
+    std::chrono::steady_clock::time_point queuedTime;
 
     FileDrainOperation(DrainOperation op, const std::string &fromFileName,
                        const std::string &toFileName, size_t countBytes,
                        size_t fromOffset, size_t toOffset, const void *data);
 };
 
+/** Progress of draining, how far the drainer lags behind the application */
+struct DrainStatistics
+{
+    /** bytes of Copy and Write operations added so far */
+    size_t bytesQueued = 0;
+    /** bytes of Copy and Write operations completed so far */
+    size_t bytesDrained = 0;
+    size_t operationsDrained = 0;
+    /** time from AddOperation to completion of an operation */
+    double maxLagSeconds = 0.0;
+    double totalLagSeconds = 0.0;
+};
+
 typedef std::map<std::string, std::shared_ptr<std::ifstream>> InputFileMap;
 typedef std::map<std::string, std::shared_ptr<std::ofstream>> OutputFileMap;
 typedef std::shared_ptr<std::ifstream> InputFile;
@@ -103,6 +119,10 @@ public:
      * processes */
     void SetVerbose(int verboseLevel, int rank);
 
+    /** Snapshot of the draining progress, can be called any time from the
+     * thread adding the operations */
+    DrainStatistics GetStatistics();
+
 protected:
     std::queue<FileDrainOperation> operations;
     std::mutex operationsMutex;
@@ -112,6 +132,15 @@ protected:
     int m_Verbose = 0;
     static const int errorState = -1;
 
+    /** Record the completion of an operation in the statistics.
+     * Thread-safe, to be called by the draining thread(s).
+     * @param bytes number of bytes copied or written by the operation
+     */
+    void OperationDone(const FileDrainOperation &operation, size_t bytes);
+
+    /** Print statistics in one line, as the end of run report */
+    void PrintStatistics();
+
     /** instead for Open, use this function */
     InputFile GetFileForRead(const std::string &path);
     OutputFile GetFileForWrite(const std::string &path, bool append = false);
@@ -139,6 +168,8 @@ protected:
     void Delete(OutputFile &f, const std::string &path);
 
 private:
+    DrainStatistics m_Statistics;
+    std::mutex m_StatisticsMutex;
     InputFileMap m_InputFileMap;
     OutputFileMap m_OutputFileMap;
     void Open(InputFile &f, const std::string &path);
@@ -0,0 +1,618 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileDrainerMultiThread.cpp
+ */
+
+#include "FileDrainerMultiThread.h"
+#include "adios2/helper/adiosLog.h"
+
+#include <algorithm> // std::min
+#include <cerrno>
+#include <cstdio>  // std::remove
+#include <cstring> // strerror
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>     // open
+#include <sys/stat.h>  // fstat
+#include <sys/types.h> // loff_t
+#include <unistd.h>    // pread, pwrite, close, copy_file_range
+
+#ifdef ADIOS2_HAVE_SENDFILE
+#include <sys/sendfile.h>
+#endif
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <ios> //std::ios_base::failure
+/// \endcond
+
+#if defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define NO_SANITIZE_THREAD __attribute__((no_sanitize("thread")))
+#endif
+#endif
+
+namespace adios2
+{
+namespace burstbuffer
+{
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(const Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/** errno values of copy_file_range/sendfile meaning "not between these
+ * files", the copy can still be done through a buffer */
+bool CopyNotSupported(const int err)
+{
+    return (err == EXDEV || err == EINVAL || err == ENOSYS ||
+            err == EOPNOTSUPP || err == EBADF);
+}
+}
+
+FileDrainerMultiThread::FileDrainerMultiThread(const size_t nThreads,
+                                               const double maxBandwidth)
+: FileDrainer(), m_NumThreads(std::max(nThreads, size_t(1))),
+  m_MaxBandwidth(maxBandwidth)
+{
+}
+
+FileDrainerMultiThread::~FileDrainerMultiThread() { Join(); }
+
+void FileDrainerMultiThread::SetBufferSize(size_t bufferSizeBytes)
+{
+    bufferSize = bufferSizeBytes;
+}
+
+void FileDrainerMultiThread::Start()
+{
+    m_Workers.clear();
+    for (size_t i = 0; i < m_NumThreads; ++i)
+    {
+        m_Workers.emplace_back(new Worker());
+        Worker &w = *m_Workers.back();
+        w.id = i;
+#ifndef ADIOS2_HAVE_COPY_FILE_RANGE
+        w.useCopyFileRange = false;
+#endif
+#ifndef ADIOS2_HAVE_SENDFILE
+        w.useSendfile = false;
+#endif
+        w.th = std::thread(&FileDrainerMultiThread::DrainThread, this,
+                           std::ref(w));
+    }
+    th = std::thread(&FileDrainerMultiThread::DispatchThread, this);
+}
+
+void FileDrainerMultiThread::Finish()
+{
+    finishMutex.lock();
+    finish = true;
+    finishMutex.unlock();
+}
+
+void FileDrainerMultiThread::Join()
+{
+    if (!th.joinable())
+    {
+        return;
+    }
+
+    const auto tTotalStart = Clock::now();
+    Finish();
+    th.join(); // dispatcher joins the draining threads
+    const double timeTotal = SecondsSince(tTotalStart);
+
+    double timeRead = 0.0, timeWrite = 0.0, timeThrottle = 0.0;
+    double sleptForWaitingOnRead = 0.0;
+    size_t nBytesTasked = 0, nBytesSucc = 0;
+    for (const auto &w : m_Workers)
+    {
+        timeRead = std::max(timeRead, w->timeRead);
+        timeWrite = std::max(timeWrite, w->timeWrite);
+        timeThrottle = std::max(timeThrottle, w->timeThrottle);
+        sleptForWaitingOnRead += w->sleptForWaitingOnRead;
+        nBytesTasked += w->nBytesTasked;
+        nBytesSucc += w->nBytesSucc;
+    }
+
+    const bool shouldReport = (m_Verbose || (nBytesTasked != nBytesSucc) ||
+                               (sleptForWaitingOnRead > 0.0));
+    if (shouldReport)
+    {
+#ifndef NO_SANITIZE_THREAD
+        std::cout << "Drain " << m_Rank << ": " << m_NumThreads
+                  << " threads. Waited for threads to join = " << timeTotal
+                  << " seconds. Max per thread: copy/read = " << timeRead
+                  << " write = " << timeWrite
+                  << " throttled = " << timeThrottle << " seconds.";
+        if (nBytesTasked == nBytesSucc)
+        {
+            std::cout << " Drained " << nBytesSucc << " bytes";
+        }
+        else
+        {
+            std::cout << " WARNING Drain wanted = " << nBytesTasked
+                      << " but successfully drained = " << nBytesSucc
+                      << " bytes.";
+        }
+        if (sleptForWaitingOnRead > 0.0)
+        {
+            std::cout << " WARNING Read had to wait " << sleptForWaitingOnRead
+                      << " seconds for the data to arrive on disk.";
+        }
+        std::cout << std::endl;
+        if (m_Verbose)
+        {
+            PrintStatistics();
+        }
+#endif
+    }
+}
+
+/*
+ * Routes the operations added by the application to the draining threads.
+ * Runs in a separate thread from all other member function calls.
+ */
+void FileDrainerMultiThread::DispatchThread()
+{
+    std::chrono::duration<double> d(0.010);
+
+    while (true)
+    {
+        // read finish first: every operation was added before Finish()
+        finishMutex.lock();
+        const bool done = finish;
+        finishMutex.unlock();
+
+        std::queue<FileDrainOperation> batch;
+        operationsMutex.lock();
+        std::swap(batch, operations);
+        operationsMutex.unlock();
+
+        if (batch.empty())
+        {
+            if (done)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(d);
+            continue;
+        }
+
+        while (!batch.empty())
+        {
+            FileDrainOperation &fdo = batch.front();
+            if (fdo.op == DrainOperation::Delete)
+            {
+                /* the source files of other threads' copies are deleted,
+                 * wait until everything else has been drained */
+                m_Deletes.push_back(std::move(fdo));
+                batch.pop();
+                continue;
+            }
+            if (fdo.op != DrainOperation::Copy &&
+                fdo.op != DrainOperation::CopyAt)
+            {
+                /* writes from memory are metadata (index) updates, which
+                 * must not land on the target before the data they point to
+                 */
+                WaitForWorkers();
+            }
+            size_t wi;
+            auto it = m_FileToWorker.find(fdo.toFileName);
+            if (it == m_FileToWorker.end())
+            {
+                wi = m_NextWorker;
+                m_NextWorker = (m_NextWorker + 1) % m_NumThreads;
+                m_FileToWorker.emplace(fdo.toFileName, wi);
+            }
+            else
+            {
+                wi = it->second;
+            }
+            Worker &w = *m_Workers[wi];
+            {
+                std::lock_guard<std::mutex> lockGuard(w.mutex);
+                w.queue.push(std::move(fdo));
+            }
+            w.cv.notify_one();
+            batch.pop();
+        }
+    }
+
+    for (auto &w : m_Workers)
+    {
+        {
+            std::lock_guard<std::mutex> lockGuard(w->mutex);
+            w->finish = true;
+        }
+        w->cv.notify_one();
+    }
+    for (auto &w : m_Workers)
+    {
+        w->th.join();
+    }
+
+    for (const auto &fdo : m_Deletes)
+    {
+        if (m_Verbose >= 2)
+        {
+#ifndef NO_SANITIZE_THREAD
+            std::cout << "Drain " << m_Rank << ": Delete file "
+                      << fdo.toFileName << std::endl;
+#endif
+        }
+        std::remove(fdo.toFileName.c_str());
+        OperationDone(fdo, 0);
+    }
+    m_Deletes.clear();
+}
+
+void FileDrainerMultiThread::WaitForWorkers()
+{
+    std::chrono::duration<double> d(0.001);
+    for (auto &w : m_Workers)
+    {
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lockGuard(w->mutex);
+                if (w->queue.empty() && !w->busy)
+                {
+                    break;
+                }
+            }
+            std::this_thread::sleep_for(d);
+        }
+    }
+}
+
+void FileDrainerMultiThread::DrainThread(Worker &w)
+{
+    w.throttleStart = Clock::now();
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(w.mutex);
+        if (w.queue.empty())
+        {
+            if (w.finish)
+            {
+                break;
+            }
+            w.cv.wait(lock, [&w]() { return !w.queue.empty() || w.finish; });
+            // idle time does not count as bandwidth credit
+            w.throttleStart = Clock::now();
+            w.throttleBytes = 0;
+            continue;
+        }
+        FileDrainOperation fdo = std::move(w.queue.front());
+        w.queue.pop();
+        w.busy = true;
+        lock.unlock();
+
+        size_t bytes = 0;
+        try
+        {
+            bytes = Execute(w, fdo);
+        }
+        catch (std::ios_base::failure &e)
+        {
+            helper::Log("BurstBuffer", "FileDrainerMultiThread", "DrainThread",
+                        std::string(e.what()), helper::FATALERROR);
+        }
+        OperationDone(fdo, bytes);
+        lock.lock();
+        w.busy = false;
+    }
+
+    if (m_Verbose > 1)
+    {
+#ifndef NO_SANITIZE_THREAD
+        std::cout << "Drain " << m_Rank << "." << w.id
+                  << " finished operations. Closing all files" << std::endl;
+#endif
+    }
+    CloseFiles(w);
+}
+
+size_t FileDrainerMultiThread::Execute(Worker &w, FileDrainOperation &fdo)
+{
+    if (m_Verbose >= 2)
+    {
+#ifndef NO_SANITIZE_THREAD
+        std::cout << "Drain " << m_Rank << "." << w.id << ": operation "
+                  << static_cast<int>(fdo.op) << " " << fdo.fromFileName
+                  << " -> " << fdo.toFileName << " " << fdo.countBytes
+                  << " bytes, offsets: from " << fdo.fromOffset << " to "
+                  << fdo.toOffset << std::endl;
+#endif
+    }
+
+    size_t n = 0;
+    switch (fdo.op)
+    {
+    case DrainOperation::CopyAt:
+    case DrainOperation::Copy:
+    {
+        DrainFile &from = GetInput(w, fdo.fromFileName);
+        DrainFile &to =
+            GetOutput(w, fdo.toFileName, (fdo.op == DrainOperation::Copy));
+        if (from.fd == -1 || to.fd == -1)
+        {
+            // skip because of previous error
+            break;
+        }
+        if (fdo.op == DrainOperation::CopyAt)
+        {
+            from.offset = fdo.fromOffset;
+            to.offset = fdo.toOffset;
+        }
+        w.nBytesTasked += fdo.countBytes;
+        n = CopyData(w, from, to, fdo.countBytes, fdo.fromFileName,
+                     fdo.toFileName);
+        w.nBytesSucc += n;
+        break;
+    }
+    case DrainOperation::SeekEnd:
+    {
+        DrainFile &to = GetOutput(w, fdo.toFileName, false);
+        struct stat fileStat;
+        if (to.fd != -1 && fstat(to.fd, &fileStat) == 0)
+        {
+            to.offset = static_cast<size_t>(fileStat.st_size);
+        }
+        break;
+    }
+    case DrainOperation::WriteAt:
+    case DrainOperation::Write:
+    {
+        DrainFile &to = GetOutput(w, fdo.toFileName, false);
+        if (to.fd == -1)
+        {
+            break;
+        }
+        if (fdo.op == DrainOperation::WriteAt)
+        {
+            to.offset = fdo.toOffset;
+        }
+        w.nBytesTasked += fdo.countBytes;
+        n = WriteData(w, to, fdo.dataToWrite.data(), fdo.countBytes,
+                      fdo.toFileName);
+        w.nBytesSucc += n;
+        Throttle(w, n);
+        break;
+    }
+    case DrainOperation::Create:
+        GetOutput(w, fdo.toFileName, false);
+        break;
+    case DrainOperation::Open:
+        GetOutput(w, fdo.toFileName, true);
+        break;
+    default:
+        break;
+    }
+    return n;
+}
+
+FileDrainerMultiThread::DrainFile &
+FileDrainerMultiThread::GetInput(Worker &w, const std::string &path)
+{
+    auto it = w.inputFiles.find(path);
+    if (it != w.inputFiles.end())
+    {
+        return it->second;
+    }
+    DrainFile &f = w.inputFiles[path];
+    f.fd = open(path.c_str(), O_RDONLY);
+    if (f.fd == -1)
+    {
+        helper::Log("BurstBuffer", "FileDrainerMultiThread", "GetInput",
+                    "couldn't open file " + path +
+                        " for draining: " + strerror(errno),
+                    helper::WARNING);
+    }
+    return f;
+}
+
+FileDrainerMultiThread::DrainFile &
+FileDrainerMultiThread::GetOutput(Worker &w, const std::string &path,
+                                  bool append)
+{
+    auto it = w.outputFiles.find(path);
+    if (it != w.outputFiles.end())
+    {
+        return it->second;
+    }
+    DrainFile &f = w.outputFiles[path];
+    const int flag = O_WRONLY | O_CREAT | (append ? 0 : O_TRUNC);
+    f.fd = open(path.c_str(), flag, 0666);
+    if (f.fd == -1)
+    {
+        helper::Log("BurstBuffer", "FileDrainerMultiThread", "GetOutput",
+                    "couldn't open file " + path +
+                        " for draining: " + strerror(errno),
+                    helper::WARNING);
+        return f;
+    }
+    struct stat fileStat;
+    if (append && fstat(f.fd, &fileStat) == 0)
+    {
+        f.offset = static_cast<size_t>(fileStat.st_size);
+    }
+    return f;
+}
+
+void FileDrainerMultiThread::CloseFiles(Worker &w)
+{
+    for (auto &file : w.outputFiles)
+    {
+        if (file.second.fd != -1)
+        {
+            close(file.second.fd);
+        }
+    }
+    w.outputFiles.clear();
+    for (auto &file : w.inputFiles)
+    {
+        if (file.second.fd != -1)
+        {
+            close(file.second.fd);
+        }
+    }
+    w.inputFiles.clear();
+}
+
+size_t FileDrainerMultiThread::CopyData(Worker &w, DrainFile &from,
+                                        DrainFile &to, size_t count,
+                                        const std::string &fromPath,
+                                        const std::string &toPath)
+{
+    const double sleepUnit = 0.01; // seconds
+    size_t total = 0;
+    while (total < count)
+    {
+        const size_t chunk = std::min(bufferSize, count - total);
+        ssize_t n = -1;
+        const auto ts = Clock::now();
+        errno = 0;
+        if (w.useCopyFileRange)
+        {
+#ifdef ADIOS2_HAVE_COPY_FILE_RANGE
+            // the file offsets are left alone, positions are explicit
+            loff_t inOffset = static_cast<loff_t>(from.offset);
+            loff_t outOffset = static_cast<loff_t>(to.offset);
+            n = copy_file_range(from.fd, &inOffset, to.fd, &outOffset, chunk,
+                                0);
+            if (n == -1 && CopyNotSupported(errno))
+            {
+                w.useCopyFileRange = false;
+                continue;
+            }
+#endif
+            w.timeRead += SecondsSince(ts);
+        }
+        else if (w.useSendfile)
+        {
+#ifdef ADIOS2_HAVE_SENDFILE
+            off_t inOffset = static_cast<off_t>(from.offset);
+            if (lseek(to.fd, static_cast<off_t>(to.offset), SEEK_SET) != -1)
+            {
+                n = sendfile(to.fd, from.fd, &inOffset, chunk);
+            }
+            if (n == -1 && CopyNotSupported(errno))
+            {
+                w.useSendfile = false;
+                continue;
+            }
+#endif
+            w.timeRead += SecondsSince(ts);
+        }
+        else
+        {
+            if (w.buffer.size() < chunk)
+            {
+                w.buffer.resize(bufferSize);
+            }
+            n = pread(from.fd, w.buffer.data(), chunk,
+                      static_cast<off_t>(from.offset));
+            w.timeRead += SecondsSince(ts);
+            if (n > 0)
+            {
+                // WriteData advances the target offset
+                WriteData(w, to, w.buffer.data(), static_cast<size_t>(n),
+                          toPath);
+                from.offset += static_cast<size_t>(n);
+                total += static_cast<size_t>(n);
+                Throttle(w, static_cast<size_t>(n));
+                continue;
+            }
+        }
+
+        if (n == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            helper::Throw<std::ios_base::failure>(
+                "Toolkit", "BurstBuffer::FileDrainerMultiThread", "CopyData",
+                "couldn't copy from file " + fromPath + " offset = " +
+                    std::to_string(from.offset) + " to file " + toPath +
+                    " offset = " + std::to_string(to.offset) + ": " +
+                    strerror(errno));
+        }
+        if (n == 0)
+        {
+            // the data has not arrived on disk yet
+            std::chrono::duration<double> d(sleepUnit);
+            std::this_thread::sleep_for(d);
+            w.sleptForWaitingOnRead += sleepUnit;
+            continue;
+        }
+
+        from.offset += static_cast<size_t>(n);
+        to.offset += static_cast<size_t>(n);
+        total += static_cast<size_t>(n);
+        Throttle(w, static_cast<size_t>(n));
+    }
+    return total;
+}
+
+size_t FileDrainerMultiThread::WriteData(Worker &w, DrainFile &to,
+                                         const char *data, size_t count,
+                                         const std::string &toPath)
+{
+    const auto ts = Clock::now();
+    size_t total = 0;
+    while (total < count)
+    {
+        errno = 0;
+        const ssize_t n = pwrite(to.fd, data + total, count - total,
+                                 static_cast<off_t>(to.offset));
+        if (n == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            helper::Throw<std::ios_base::failure>(
+                "Toolkit", "BurstBuffer::FileDrainerMultiThread", "WriteData",
+                "FileDrainer couldn't write to file " + toPath +
+                    " count = " + std::to_string(count) +
+                    " bytes: " + strerror(errno));
+        }
+        to.offset += static_cast<size_t>(n);
+        total += static_cast<size_t>(n);
+    }
+    w.timeWrite += SecondsSince(ts);
+    return total;
+}
+
+void FileDrainerMultiThread::Throttle(Worker &w, size_t bytes)
+{
+    if (m_MaxBandwidth <= 0.0)
+    {
+        return;
+    }
+    w.throttleBytes += bytes;
+    const double share = m_MaxBandwidth / static_cast<double>(m_NumThreads);
+    const double expected = static_cast<double>(w.throttleBytes) / share;
+    const double elapsed = SecondsSince(w.throttleStart);
+    if (expected > elapsed)
+    {
+        std::chrono::duration<double> d(expected - elapsed);
+        std::this_thread::sleep_for(d);
+        w.timeThrottle += expected - elapsed;
+    }
+}
+
+} // end namespace burstbuffer
+} // end namespace adios2
@@ -0,0 +1,134 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileDrainerMultiThread.h
+ *
+ * Drainer running several threads, each draining its own set of files, so
+ * that the subfiles of a node are copied to the target concurrently
+ */
+
+#ifndef ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINERMULTITHREAD_H_
+#define ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINERMULTITHREAD_H_
+
+#include "adios2/toolkit/burstbuffer/FileDrainer.h"
+
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace adios2
+{
+namespace burstbuffer
+{
+
+class FileDrainerMultiThread : public FileDrainer
+{
+
+public:
+    static const size_t defaultBufferSize = 4194304; // 4MB
+
+    /**
+     * @param nThreads number of draining threads, at least 1
+     * @param maxBandwidth limit of the total draining bandwidth in bytes per
+     * second, shared equally among the threads, 0 means no limit
+     */
+    FileDrainerMultiThread(const size_t nThreads,
+                           const double maxBandwidth = 0.0);
+
+    ~FileDrainerMultiThread();
+
+    /** Size of the copy unit, also the granularity of throttling */
+    void SetBufferSize(size_t bufferSizeBytes);
+
+    /** Create the dispatcher and the draining threads.
+     *  Operations are assigned to threads by their target file, in the order
+     *  of the first appearance of the files, so all operations on a file are
+     *  executed in order by the same thread. Deletions are executed last.
+     */
+    void Start() final;
+
+    /** Tell threads to terminate when all draining has finished. */
+    void Finish() final;
+
+    /** Join the threads. Main thread will block until they terminate */
+    void Join() final;
+
+private:
+    /** POSIX file and the position of the next read/write without offset */
+    struct DrainFile
+    {
+        int fd = -1;
+        size_t offset = 0;
+    };
+
+    struct Worker
+    {
+        size_t id = 0;
+        std::thread th;
+        std::queue<FileDrainOperation> queue;
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool finish = false;
+        bool busy = false; // executing an operation taken from the queue
+
+        std::map<std::string, DrainFile> inputFiles;
+        std::map<std::string, DrainFile> outputFiles;
+
+        /** fall back to the next copy method when the file systems refuse */
+        bool useCopyFileRange = true;
+        bool useSendfile = true;
+        std::vector<char> buffer;
+
+        /** bandwidth throttling: bytes moved since throttleStart */
+        std::chrono::steady_clock::time_point throttleStart;
+        size_t throttleBytes = 0;
+
+        double timeRead = 0.0; // also includes the in-kernel copies
+        double timeWrite = 0.0;
+        double timeThrottle = 0.0;
+        double sleptForWaitingOnRead = 0.0;
+        size_t nBytesTasked = 0;
+        size_t nBytesSucc = 0;
+    };
+
+    size_t m_NumThreads;
+    double m_MaxBandwidth;
+    size_t bufferSize = defaultBufferSize;
+
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+    /** target file -> worker, used by the dispatcher thread only */
+    std::map<std::string, size_t> m_FileToWorker;
+    size_t m_NextWorker = 0;
+    /** Delete operations, executed after all draining threads finished */
+    std::vector<FileDrainOperation> m_Deletes;
+
+    std::thread th; // dispatcher
+    bool finish = false;
+    std::mutex finishMutex;
+
+    void DispatchThread();
+    void DrainThread(Worker &w);
+    /** Block until all threads have executed all their operations */
+    void WaitForWorkers();
+    /** Run one operation, return the number of bytes copied/written */
+    size_t Execute(Worker &w, FileDrainOperation &fdo);
+
+    DrainFile &GetInput(Worker &w, const std::string &path);
+    DrainFile &GetOutput(Worker &w, const std::string &path, bool append);
+    void CloseFiles(Worker &w);
+
+    /** Copy count bytes between the current offsets of the files, waiting
+     * for the data to arrive in the source file if needed */
+    size_t CopyData(Worker &w, DrainFile &from, DrainFile &to, size_t count,
+                    const std::string &fromPath, const std::string &toPath);
+    size_t WriteData(Worker &w, DrainFile &to, const char *data, size_t count,
+                     const std::string &toPath);
+    /** Sleep if the thread moved data faster than its bandwidth share */
+    void Throttle(Worker &w, size_t bytes);
+};
+
+} // end namespace burstbuffer
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_BURSTBUFFER_FILEDRAINERMULTITHREAD_H_ */
@@ -101,6 +101,7 @@ void FileDrainerSingleThread::DrainThread()
     size_t nWriteBytesTasked = 0;
     size_t nWriteBytesSucc = 0;
     double sleptForWaitingOnRead = 0.0;
+    size_t opBytes = 0; // bytes copied/written by the current operation
 
     /* Copy a block of data from one file to another at the same offset */
     auto lf_Copy = [&](FileDrainOperation &fdo, InputFile fdr, OutputFile fdw,
@@ -120,6 +121,7 @@ void FileDrainerSingleThread::DrainThread()
         te = core::Now();
         timeWrite += te - ts;
         nWriteBytesSucc += n;
+        opBytes += n;
     };
 
     std::chrono::duration<double> d(0.100);
@@ -152,6 +154,7 @@ void FileDrainerSingleThread::DrainThread()
         }
         operationsMutex.unlock();
 
+        opBytes = 0;
         switch (fdo.op)
         {
 
@@ -260,6 +263,7 @@ void FileDrainerSingleThread::DrainThread()
             te = core::Now();
             timeWrite += te - ts;
             nWriteBytesSucc += n;
+            opBytes = n;
             break;
         }
         case DrainOperation::Write:
@@ -281,6 +285,7 @@ void FileDrainerSingleThread::DrainThread()
             te = core::Now();
             timeWrite += te - ts;
             nWriteBytesSucc += n;
+            opBytes = n;
             break;
         }
         case DrainOperation::Create:
@@ -333,6 +338,7 @@ void FileDrainerSingleThread::DrainThread()
         default:
             break;
         }
+        OperationDone(fdo, opBytes);
         operationsMutex.lock();
         operations.pop();
         operationsMutex.unlock();
@@ -393,6 +399,12 @@ void FileDrainerSingleThread::DrainThread()
                       << " seconds for the data to arrive on disk.";
         }
         std::cout << std::endl;
+#endif
+    }
+    if (m_Verbose)
+    {
+#ifndef NO_SANITIZE_THREAD
+        PrintStatistics();
 #endif
     }
 }
@@ -193,6 +193,40 @@ void BPBase::Init(const Params &parameters, const std::string hint,
                 parsedParameters.NumAggregators = n;
             }
         }
+        else if (key == "aggregationfanin")
+        {
+            parsedParameters.AggregationFanIn =
+                static_cast<unsigned int>(helper::StringTo<uint32_t>(
+                    value, " in Parameter key=AggregationFanIn " + hint));
+        }
+        else if (key == "aggregationbuffers")
+        {
+            const unsigned int buffers =
+                static_cast<unsigned int>(helper::StringTo<uint32_t>(
+                    value, " in Parameter key=AggregationBuffers " + hint));
+            if (buffers < 2)
+            {
+                helper::Throw<std::invalid_argument>(
+                    "Toolkit", "format::bp::BPBase", "Init",
+                    "value for Parameter key=AggregationBuffers=" + value +
+                        " must be at least 2 " + hint);
+            }
+            parsedParameters.AggregationBuffers = buffers;
+        }
+        else if (key == "metadatafanin")
+        {
+            const unsigned int fanIn =
+                static_cast<unsigned int>(helper::StringTo<uint32_t>(
+                    value, " in Parameter key=MetadataFanIn " + hint));
+            if (fanIn == 1)
+            {
+                helper::Throw<std::invalid_argument>(
+                    "Toolkit", "format::bp::BPBase", "Init",
+                    "value for Parameter key=MetadataFanIn=" + value +
+                        " must be 0 or at least 2 " + hint);
+            }
+            parsedParameters.MetadataFanIn = fanIn;
+        }
         else if (key == "node-local" || key == "nodelocal")
         {
             parsedParameters.NodeLocal = helper::StringTo<bool>(
@@ -214,6 +248,20 @@ void BPBase::Init(const Params &parameters, const std::string hint,
                 static_cast<int>(helper::StringTo<int32_t>(
                     value, " in Parameter key=BurstBufferVerbose " + hint));
         }
+        else if (key == "burstbufferdrainthreads")
+        {
+            parsedParameters.BurstBufferDrainThreads =
+                static_cast<unsigned int>(helper::StringTo<uint32_t>(
+                    value, " in Parameter key=BurstBufferDrainThreads " +
+                               hint));
+        }
+        else if (key == "burstbufferdrainbandwidth")
+        {
+            parsedParameters.BurstBufferDrainBandwidth =
+                helper::StringTo<double>(
+                    value, " in Parameter key=BurstBufferDrainBandwidth " +
+                               hint);
+        }
         else if (key == "streamreader")
         {
             parsedParameters.StreamReader = helper::StringTo<bool>(
@@ -274,6 +322,11 @@ void BPBase::Init(const Params &parameters, const std::string hint,
             "meta_sort_merge", profiling::Timer("meta_sort_merge", timeUnit));
         m_Profiler.m_Timers.emplace("aggregation",
                                     profiling::Timer("aggregation", timeUnit));
+        m_Profiler.m_Timers.emplace(
+            "aggregation_wait", profiling::Timer("aggregation_wait", timeUnit));
+        m_Profiler.m_Timers.emplace(
+            "aggregation_write",
+            profiling::Timer("aggregation_write", timeUnit));
         m_Profiler.m_Timers.emplace("mkdir",
                                     profiling::Timer("mkdir", timeUnit));
         m_Profiler.m_Bytes.emplace("buffering", 0);
@@ -446,7 +499,7 @@ std::string BPBase::ReadBPString(const std::vector<char> &buffer,
 // static members
 const std::set<std::string> BPBase::m_TransformTypes = {
     {"unknown", "none", "identity", "bzip2", "sz", "zfp", "mgard", "png",
-     "blosc", "sirius", "mgardplus", "plugin"}};
+     "blosc", "sirius", "mgardplus", "plugin", "shuffle"}};
 
 const std::map<int, std::string> BPBase::m_TransformTypesToNames = {
     {transform_unknown, "unknown"},
@@ -460,7 +513,8 @@ const std::map<int, std::string> BPBase::m_TransformTypesToNames = {
     {transform_blosc, "blosc"},
     {transform_sirius, "sirius"},
     {transform_mgardplus, "mgardplus"},
-    {transform_plugin, "plugin"}};
+    {transform_plugin, "plugin"},
+    {transform_shuffle, "shuffle"}};
 
 BPBase::TransformTypes
 BPBase::TransformTypeEnum(const std::string transformType) const noexcept
@@ -215,6 +215,11 @@ public:
         bool BurstBufferDrain = true;
         /** Verbose level for burst buffer draining thread */
         int BurstBufferVerbose = 0;
+        /** Number of threads draining files concurrently, each thread
+         * drains its own set of subfiles */
+        unsigned int BurstBufferDrainThreads = 1;
+        /** Limit of the draining bandwidth in MB/s, 0 is unlimited */
+        double BurstBufferDrainBandwidth = 0.0;
 
         /** Stream reader flag: process metadata step-by-step
          * instead of parsing everything available
@@ -227,6 +232,19 @@ public:
          * aggregators
          */
         unsigned int NumAggregators = 0;
+
+        /** BP4 only, 0: the aggregator chain passes data one hop per
+         * iteration, > 0: tree aggregation with up to this many children
+         * per process, overlapping receives with writes */
+        unsigned int AggregationFanIn = 0;
+
+        /** receive buffers per process in tree aggregation, >= 2 */
+        unsigned int AggregationBuffers = 2;
+
+        /** BP4 only, 0: rank 0 gathers and merges the metadata indices of
+         * all ranks, > 1: groups of this many ranks merge them level by
+         * level on the way to rank 0 */
+        unsigned int MetadataFanIn = 0;
     };
 
     /** Return type of the ResizeBuffer function. */
@@ -320,7 +338,8 @@ public:
      * @param hint extra messaging for exception handling
      * @return Failure, Unchanged, Success, Flush
      */
-    ResizeResult ResizeBuffer(const size_t dataIn, const std::string hint);
+    virtual ResizeResult ResizeBuffer(const size_t dataIn,
+                                      const std::string hint);
 
     /**
      * Sets buffer's positions to zero and fill buffer with zero char
@@ -336,7 +355,7 @@ public:
     /** Delete buffer memory manually */
     void DeleteBuffers();
 
-    size_t DebugGetDataBufferSize() const;
+    virtual size_t DebugGetDataBufferSize() const;
 
 protected:
     /** file I/O method type, adios1 legacy, only POSIX and MPI_AGG are used */
@@ -459,7 +478,8 @@ protected:
         transform_png = 13,
         transform_sirius = 14,
         transform_mgardplus = 15,
-        transform_plugin = 16
+        transform_plugin = 16,
+        transform_shuffle = 17
     };
 
     /** Supported transform types */
@@ -199,6 +199,24 @@ const helper::BlockOperationInfo &BP4Deserializer::InitPostOperatorBlockData(
     return blockOperationsInfo.at(index);
 }
 
+void BP4Deserializer::DataReadRange(
+    const helper::SubStreamBoxInfo &subStreamBoxInfo, size_t &payloadSize,
+    size_t &payloadOffset) const
+{
+    if (subStreamBoxInfo.OperationsInfo.size() > 0)
+    {
+        const helper::BlockOperationInfo &blockOperationInfo =
+            InitPostOperatorBlockData(subStreamBoxInfo.OperationsInfo);
+        payloadSize = blockOperationInfo.PayloadSize;
+        payloadOffset = blockOperationInfo.PayloadOffset;
+    }
+    else
+    {
+        payloadOffset = subStreamBoxInfo.Seeks.first;
+        payloadSize = subStreamBoxInfo.Seeks.second - payloadOffset;
+    }
+}
+
 /* void BP4Deserializer::GetPreOperatorBlockData(
     const std::vector<char> &postOpData,
     const helper::BlockOperationInfo &blockOperationInfo,
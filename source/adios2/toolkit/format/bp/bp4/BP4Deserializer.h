@@ -112,6 +112,16 @@ public:
                      char *&buffer, size_t &payloadSize, size_t &payloadOffset,
                      const size_t threadID = 0);
 
+    /**
+     * Position and size in the subfile of the payload PreDataRead gives for
+     * a box, without preparing a buffer for it
+     * @param subStreamBoxInfo box (block) to be accessed
+     * @param payloadSize output
+     * @param payloadOffset output
+     */
+    void DataReadRange(const helper::SubStreamBoxInfo &subStreamBoxInfo,
+                       size_t &payloadSize, size_t &payloadOffset) const;
+
     template <class T>
     void PostDataRead(core::Variable<T> &variable,
                       typename core::Variable<T>::BPInfo &blockInfo,
@@ -511,25 +511,15 @@ void BP4Deserializer::PreDataRead(
     const helper::SubStreamBoxInfo &subStreamBoxInfo, char *&buffer,
     size_t &payloadSize, size_t &payloadOffset, const size_t threadID)
 {
+    DataReadRange(subStreamBoxInfo, payloadSize, payloadOffset);
     if (subStreamBoxInfo.OperationsInfo.size() > 0)
     {
-        const helper::BlockOperationInfo &blockOperationInfo =
-            InitPostOperatorBlockData(subStreamBoxInfo.OperationsInfo);
-
-        m_ThreadBuffers[threadID][1].resize(blockOperationInfo.PayloadSize,
-                                            '\0');
-
+        m_ThreadBuffers[threadID][1].resize(payloadSize, '\0');
         buffer = m_ThreadBuffers[threadID][1].data();
-
-        payloadSize = blockOperationInfo.PayloadSize;
-        payloadOffset = blockOperationInfo.PayloadOffset;
     }
     else
     {
-        payloadOffset = subStreamBoxInfo.Seeks.first;
-        payloadSize = subStreamBoxInfo.Seeks.second - payloadOffset;
         m_ThreadBuffers[threadID][0].resize(payloadSize);
-
         buffer = m_ThreadBuffers[threadID][0].data();
     }
 }
@@ -561,7 +551,12 @@ void BP4Deserializer::PostDataRead(
             {
                 if (o->m_Category == "compress" || o->m_Category == "plugin")
                 {
-                    op = o;
+                    // worker threads of ReadBlocks must not share the
+                    // variable's operator, which changes its own members
+                    op = threadID == 0
+                             ? o
+                             : core::MakeOperator(o->m_TypeString,
+                                                  o->GetParameters());
                     break;
                 }
             }
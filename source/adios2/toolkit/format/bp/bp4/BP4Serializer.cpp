@@ -13,7 +13,9 @@
 #include "BP4Serializer.h"
 #include "BP4Serializer.tcc"
 
+#include <algorithm> // std::fill_n, std::max, std::min
 #include <chrono>
+#include <cstring> // std::memcpy
 #include <future>
 #include <string>
 #include <tuple>
@@ -164,7 +166,7 @@ void BP4Serializer::PutProcessGroupIndex(
     const char pgi[] = "[PGI"; //  don't write \0!
     helper::CopyToBuffer(dataBuffer, dataPosition, pgi, sizeof(pgi) - 1);
 
-    m_MetadataSet.DataPGLengthPosition = dataPosition;
+    m_MetadataSet.DataPGLengthPosition = DataPosition();
     dataPosition += 8; // skip pg length (8)
 
     const std::size_t metadataPGLengthPosition = metadataBuffer.size();
@@ -228,7 +230,7 @@ void BP4Serializer::PutProcessGroupIndex(
     m_Data.m_AbsolutePosition += dataPosition - pgBeginPosition;
     // pg vars count and position
     m_MetadataSet.DataPGVarsCount = 0;
-    m_MetadataSet.DataPGVarsCountPosition = dataPosition;
+    m_MetadataSet.DataPGVarsCountPosition = DataPosition();
     // add vars count and length
     dataPosition += 12;
     m_Data.m_AbsolutePosition += 12; // add vars count and length
@@ -242,14 +244,14 @@ void BP4Serializer::PutProcessGroupIndex(
 size_t BP4Serializer::CloseData(core::IO &io)
 {
     m_Profiler.Start("buffering");
-    size_t dataEndsAt = m_Data.m_Position;
+    size_t dataEndsAt = DataPosition();
     if (!m_IsClosed)
     {
         if (m_MetadataSet.DataPGIsOpen)
         {
             SerializeDataBuffer(io);
         }
-        dataEndsAt = m_Data.m_Position;
+        dataEndsAt = DataPosition();
 
         SerializeMetadataInData(false, false);
 
@@ -273,18 +275,154 @@ size_t BP4Serializer::CloseStream(core::IO &io, const bool addMetadata)
     {
         SerializeDataBuffer(io);
     }
-    size_t dataEndsAt = m_Data.m_Position;
+    size_t dataEndsAt = DataPosition();
     SerializeMetadataInData(false, addMetadata);
 
     if (m_Profiler.m_IsActive)
     {
-        m_Profiler.m_Bytes.at("buffering") += m_Data.m_Position;
+        m_Profiler.m_Bytes.at("buffering") += DataPosition();
     }
     m_Profiler.Stop("buffering");
 
     return dataEndsAt;
 }
 
+BP4Serializer::ResizeResult BP4Serializer::ResizeBuffer(const size_t dataIn,
+                                                        const std::string hint)
+{
+    // room for a process group header in front of the data of a new chunk
+    constexpr size_t chunkMargin = 16 * 1024;
+
+    m_Profiler.Start("buffering");
+    const size_t position = DataPosition();
+    const size_t requiredSize = position + dataIn;
+    const size_t maxBufferSize = m_Parameters.MaxBufferSize;
+
+    if (dataIn > maxBufferSize)
+    {
+        helper::Throw<std::runtime_error>(
+            "Toolkit", "format::bp::BP4Serializer", "ResizeBuffer",
+            "data size: " +
+                std::to_string(static_cast<float>(dataIn) / (1024. * 1024.)) +
+                " Mb is too large for adios2 bp MaxBufferSize=" +
+                std::to_string(static_cast<float>(maxBufferSize) /
+                               (1024. * 1024.)) +
+                "Mb, try increasing MaxBufferSize in call to IO "
+                "SetParameters " +
+                hint);
+    }
+
+    ResizeResult result = ResizeResult::Unchanged;
+    if (dataIn <= m_Data.GetAvailableSize())
+    {
+        // do nothing, unchanged is default
+    }
+    else if (requiredSize > maxBufferSize)
+    {
+        // the writer flushes, then asks again with an empty buffer
+        NewDataChunk(dataIn + chunkMargin, hint);
+        result = ResizeResult::Flush;
+    }
+    else
+    {
+        // the chunks add up to the size a single buffer would grow to
+        size_t capacity = m_Data.m_Buffer.size();
+        for (const DataChunk &chunk : m_DataChunks)
+        {
+            capacity += chunk.Buffer.size();
+        }
+        const size_t nextSize =
+            std::min(maxBufferSize,
+                     helper::NextExponentialSize(requiredSize, capacity,
+                                                 m_Parameters.GrowthFactor));
+        const size_t chunkSize =
+            nextSize > capacity ? nextSize - capacity : 0;
+        NewDataChunk(std::max(chunkSize, dataIn + chunkMargin),
+                     " when adding a data chunk, " + hint);
+        result = ResizeResult::Success;
+    }
+
+    m_Profiler.Stop("buffering");
+    return result;
+}
+
+size_t BP4Serializer::DataPosition() const noexcept
+{
+    return m_DataChunksSize + m_Data.m_Position;
+}
+
+char *BP4Serializer::DataAt(const size_t position) noexcept
+{
+    size_t chunkStart = 0;
+    for (DataChunk &chunk : m_DataChunks)
+    {
+        if (position < chunkStart + chunk.Size)
+        {
+            return chunk.Buffer.data() + position - chunkStart;
+        }
+        chunkStart += chunk.Size;
+    }
+    return m_Data.m_Buffer.data() + position - chunkStart;
+}
+
+std::vector<core::iovec> BP4Serializer::DataVec() const
+{
+    std::vector<core::iovec> dataVec;
+    dataVec.reserve(m_DataChunks.size() + 1);
+    for (const DataChunk &chunk : m_DataChunks)
+    {
+        dataVec.push_back({chunk.Buffer.data(), chunk.Size});
+    }
+    dataVec.push_back({m_Data.m_Buffer.data(), m_Data.m_Position});
+    return dataVec;
+}
+
+void BP4Serializer::JoinDataChunks()
+{
+    if (m_DataChunks.empty())
+    {
+        return;
+    }
+    m_Profiler.Start("buffering");
+    std::vector<char> joined;
+    joined.reserve(m_DataChunksSize + m_Data.m_Buffer.size());
+    for (const DataChunk &chunk : m_DataChunks)
+    {
+        joined.insert(joined.end(), chunk.Buffer.begin(),
+                      chunk.Buffer.begin() + chunk.Size);
+    }
+    joined.insert(joined.end(), m_Data.m_Buffer.begin(), m_Data.m_Buffer.end());
+    m_Data.m_Position = DataPosition();
+    m_Data.m_Buffer.swap(joined);
+    m_FreeDataChunks.push_back(std::move(joined));
+    ReleaseDataChunks();
+    m_Profiler.Stop("buffering");
+}
+
+void BP4Serializer::ReleaseDataChunks()
+{
+    for (DataChunk &chunk : m_DataChunks)
+    {
+        m_FreeDataChunks.push_back(std::move(chunk.Buffer));
+    }
+    m_DataChunks.clear();
+    m_DataChunksSize = 0;
+}
+
+size_t BP4Serializer::DebugGetDataBufferSize() const
+{
+    size_t size = m_Data.m_Buffer.size();
+    for (const DataChunk &chunk : m_DataChunks)
+    {
+        size += chunk.Buffer.size();
+    }
+    for (const std::vector<char> &buffer : m_FreeDataChunks)
+    {
+        size += buffer.size();
+    }
+    return size;
+}
+
 /* Reset the local metadata indices */
 void BP4Serializer::ResetAllIndices()
 {
@@ -355,48 +493,81 @@ void BP4Serializer::AggregateCollectiveMetadata(helper::Comm const &comm,
 }
 
 // PRIVATE FUNCTIONS
+void BP4Serializer::NewDataChunk(const size_t size, const std::string &hint)
+{
+    if (m_Data.m_Position > 0)
+    {
+        m_DataChunks.push_back({std::move(m_Data.m_Buffer), m_Data.m_Position});
+        m_DataChunksSize += m_Data.m_Position;
+    }
+    else if (!m_Data.m_Buffer.empty())
+    {
+        m_FreeDataChunks.push_back(std::move(m_Data.m_Buffer));
+    }
+    m_Data.m_Buffer = std::vector<char>();
+    m_Data.m_Position = 0;
+
+    // smallest free buffer that is large enough
+    auto itFit = m_FreeDataChunks.end();
+    for (auto it = m_FreeDataChunks.begin(); it != m_FreeDataChunks.end(); ++it)
+    {
+        if (it->size() >= size &&
+            (itFit == m_FreeDataChunks.end() || it->size() < itFit->size()))
+        {
+            itFit = it;
+        }
+    }
+    if (itFit != m_FreeDataChunks.end())
+    {
+        m_Data.m_Buffer = std::move(*itFit);
+        m_FreeDataChunks.erase(itFit);
+    }
+    else
+    {
+        // the step grew beyond the free buffers, do not keep them
+        m_FreeDataChunks.clear();
+        m_Data.Resize(size, hint);
+    }
+}
+
+void BP4Serializer::ReserveData(const size_t size, const std::string &hint)
+{
+    if (size > m_Data.GetAvailableSize())
+    {
+        NewDataChunk(size, hint);
+    }
+}
+
 void BP4Serializer::SerializeDataBuffer(core::IO &io) noexcept
 {
     auto &buffer = m_Data.m_Buffer;
     auto &position = m_Data.m_Position;
     auto &absolutePosition = m_Data.m_AbsolutePosition;
 
-    // vars count and Length (only for PG)
-    helper::CopyToBuffer(buffer, m_MetadataSet.DataPGVarsCountPosition,
-                         &m_MetadataSet.DataPGVarsCount);
+    // vars count and Length (only for PG), in the chunk of the PG header
+    char *varsCountAndLength = DataAt(m_MetadataSet.DataPGVarsCountPosition);
+    std::memcpy(varsCountAndLength, &m_MetadataSet.DataPGVarsCount,
+                sizeof(uint32_t));
     // without record itself and vars count
-    // Note: m_MetadataSet.DataPGVarsCount has been incremented by 4
-    // in previous CopyToBuffer operation!
     const uint64_t varsLength =
-        position - m_MetadataSet.DataPGVarsCountPosition - 8;
-    helper::CopyToBuffer(buffer, m_MetadataSet.DataPGVarsCountPosition,
-                         &varsLength);
+        DataPosition() - m_MetadataSet.DataPGVarsCountPosition - 12;
+    std::memcpy(varsCountAndLength + sizeof(uint32_t), &varsLength,
+                sizeof(uint64_t));
 
     // each attribute is only written to output once
     size_t attributesSizeInData = GetAttributesSizeInData(io);
     if (attributesSizeInData)
     {
         attributesSizeInData += 12; // count + length + end ID
-        // Take care not to shrink the buffer size in this.
-        // Otherwise, growing the buffer again later on is expensive
-        // - not because of reallocation, but because of (re)initialization
-        // with zeros by BufferSTL::Resize.
-        const size_t minSize = position + attributesSizeInData + 4;
-        if (m_Data.m_Buffer.size() < minSize)
-        {
-            m_Data.Resize(minSize, "when writing Attributes in rank=0\n");
-        }
+        ReserveData(attributesSizeInData + 4,
+                    "when writing Attributes in rank=0\n");
         PutAttributes(io);
     }
     else
     {
-        const size_t minSize = position + 12 + 4;
-        if (m_Data.m_Buffer.size() < minSize)
-        {
-            m_Data.Resize(minSize, "for empty Attributes\n");
-        }
+        ReserveData(12 + 4, "for empty Attributes\n");
         // Attribute index header for zero attributes: 0, 0LL
-        // Resize() already takes care of this
+        std::fill_n(buffer.begin() + position, 12, '\0');
         position += 12;
         absolutePosition += 12;
     }
@@ -408,9 +579,10 @@ void BP4Serializer::SerializeDataBuffer(core::IO &io) noexcept
 
     // Finish writing pg group length INCLUDING the record itself and
     // including the closing padding but NOT the opening [PGI
-    const uint64_t dataPGLength = position - m_MetadataSet.DataPGLengthPosition;
-    helper::CopyToBuffer(buffer, m_MetadataSet.DataPGLengthPosition,
-                         &dataPGLength);
+    const uint64_t dataPGLength =
+        DataPosition() - m_MetadataSet.DataPGLengthPosition;
+    std::memcpy(DataAt(m_MetadataSet.DataPGLengthPosition), &dataPGLength,
+                sizeof(uint64_t));
 
     m_MetadataSet.DataPGIsOpen = false;
 }
@@ -480,10 +652,8 @@ void BP4Serializer::SerializeMetadataInData(const bool updateAbsolutePosition,
     auto &position = m_Data.m_Position;
     auto &absolutePosition = m_Data.m_AbsolutePosition;
 
-    // reserve data to fit metadata,
-    // must replace with growth buffer strategy?
-    m_Data.Resize(position + footerSize,
-                  " when writing metadata in bp data buffer");
+    // reserve data to fit metadata
+    ReserveData(footerSize, " when writing metadata in bp data buffer");
 
     // write pg index
     helper::CopyToBuffer(buffer, position, &pgCount);
@@ -526,21 +696,6 @@ void BP4Serializer::AggregateCollectiveMetadataIndices(helper::Comm const &comm,
 
     BufferSTL inBufferSTL;
 
-    // pre-allocate with rank 0 data
-    // size_t pgCount = 0; //< tracks global PG count
-    if (rank == 0)
-    {
-        // assumes that things are more or less balanced
-        m_PGIndicesInfo.clear();
-        // m_PGRankIndices.reserve(m_MetadataSet.PGIndex.Buffer.size());
-
-        m_VariableIndicesInfo.clear();
-        // m_VariableRankIndices.reserve(m_MetadataSet.VarsIndices.size());
-
-        m_AttributesIndicesInfo.clear();
-        // m_AttributesRankIndices.reserve(m_MetadataSet.AttributesIndices.size());
-    }
-
     auto lf_IndicesSize =
         [&](const std::unordered_map<std::string, SerialElementIndex> &indices)
         -> size_t
@@ -917,6 +1072,149 @@ void BP4Serializer::AggregateCollectiveMetadataIndices(helper::Comm const &comm,
                              localPosition, endPosition);
     };
 
+    auto lf_LocateSerializedIndices = [&](const std::vector<char> &serialized,
+                                          const size_t serializedSize) {
+        m_PGIndicesInfo.clear();
+        m_VariableIndicesInfo.clear();
+        m_AttributesIndicesInfo.clear();
+
+        size_t serializedPosition = 0;
+        std::vector<size_t> headerInfo(4);
+        const bool isLittleEndian = helper::IsLittleEndian();
+
+        while (serializedPosition < serializedSize)
+        {
+            size_t localPosition = serializedPosition;
+
+            const int rankSource = static_cast<int>(helper::ReadValue<uint32_t>(
+                serialized, localPosition, isLittleEndian));
+
+            for (auto i = 0; i < 4; ++i)
+            {
+                headerInfo[i] = static_cast<size_t>(helper::ReadValue<uint64_t>(
+                    serialized, localPosition, isLittleEndian));
+            }
+
+            lf_LocateAllIndices(rankSource, headerInfo, serialized,
+                                serializedPosition);
+            serializedPosition += headerInfo[0] + 4;
+        }
+    };
+
+    // one index entry with the characteristics sets of all items
+    auto lf_MergeElementIndex =
+        [&](const std::vector<std::tuple<size_t, size_t>> &items,
+            const std::vector<char> &serialized, std::vector<char> &buffer,
+            size_t &position) {
+            const size_t entryLengthPosition = position;
+            const size_t headerStartPosition = std::get<0>(items[0]);
+            size_t localPosition = headerStartPosition;
+            ReadElementIndexHeader(serialized, localPosition);
+            const size_t headerSize = localPosition - headerStartPosition;
+
+            position += headerSize; // skip the header
+            uint64_t setsCount = 0;
+            for (auto &item : items)
+            {
+                size_t start = std::get<0>(item);
+                size_t length = std::get<1>(item);
+                // items merged in a subtree carry their own sets count
+                size_t itemPosition = start;
+                const ElementIndexHeader header =
+                    ReadElementIndexHeader(serialized, itemPosition);
+                const size_t itemHeaderSize = itemPosition - start;
+                std::copy(serialized.begin() + start + itemHeaderSize,
+                          serialized.begin() + start + length,
+                          buffer.begin() + position);
+                position += length - itemHeaderSize;
+                setsCount += header.CharacteristicsSetsCount;
+            }
+            const uint32_t entryLength =
+                static_cast<uint32_t>(position - entryLengthPosition - 4);
+            size_t backPosition = entryLengthPosition;
+            helper::CopyToBuffer(buffer, backPosition, &entryLength);
+            helper::CopyToBuffer(buffer, backPosition,
+                                 &serialized[headerStartPosition + 4],
+                                 headerSize - 8 - 4);
+            helper::CopyToBuffer(buffer, backPosition, &setsCount);
+        };
+
+    // the located indices of a subtree as one rank's serialized indices
+    auto lf_MergeSubtreeIndices = [&](const std::vector<char> &serialized) {
+        std::vector<size_t> timeSteps;
+        timeSteps.reserve(m_PGIndicesInfo.size());
+        for (auto const &pair : m_PGIndicesInfo)
+        {
+            timeSteps.push_back(pair.first);
+        }
+        std::sort(timeSteps.begin(), timeSteps.end());
+
+        // merged indices are never larger than their sources
+        std::vector<char> &buffer = m_SerializedIndices;
+        buffer.resize(serialized.size());
+        size_t position = 36;
+
+        uint64_t pgCount = 0;
+        for (auto t : timeSteps)
+        {
+            for (auto &item : m_PGIndicesInfo.at(t))
+            {
+                const size_t start = std::get<1>(item);
+                const size_t length = std::get<2>(item);
+                std::copy(serialized.begin() + start,
+                          serialized.begin() + start + length,
+                          buffer.begin() + position);
+                position += length;
+                pgCount += std::get<0>(item);
+            }
+        }
+
+        const uint64_t variablesIndexOffset = position;
+        for (auto t : timeSteps)
+        {
+            const auto itvars = m_VariableIndicesInfo.find(t);
+            if (itvars != m_VariableIndicesInfo.end())
+            {
+                for (auto const &pair : itvars->second)
+                {
+                    lf_MergeElementIndex(pair.second, serialized, buffer,
+                                         position);
+                }
+            }
+        }
+
+        const uint64_t attributesIndexOffset = position;
+        for (auto t : timeSteps)
+        {
+            const auto itattrs = m_AttributesIndicesInfo.find(t);
+            if (itattrs != m_AttributesIndicesInfo.end())
+            {
+                for (auto const &pair : itattrs->second)
+                {
+                    for (auto &item : pair.second)
+                    {
+                        const size_t start = std::get<0>(item);
+                        const size_t length = std::get<1>(item);
+                        std::copy(serialized.begin() + start,
+                                  serialized.begin() + start + length,
+                                  buffer.begin() + position);
+                        position += length;
+                    }
+                }
+            }
+        }
+
+        const uint32_t rank32 = static_cast<uint32_t>(rank);
+        const uint64_t size64 = static_cast<uint64_t>(position - 4);
+        size_t headerPosition = 0;
+        helper::CopyToBuffer(buffer, headerPosition, &rank32);
+        helper::CopyToBuffer(buffer, headerPosition, &size64);
+        helper::CopyToBuffer(buffer, headerPosition, &variablesIndexOffset);
+        helper::CopyToBuffer(buffer, headerPosition, &attributesIndexOffset);
+        helper::CopyToBuffer(buffer, headerPosition, &pgCount);
+        buffer.resize(position);
+    };
+
     auto lf_SortMergeIndices =
         [&](const std::unordered_map<
                 size_t, std::vector<std::tuple<size_t, size_t, size_t>>>
@@ -987,36 +1285,8 @@ void BP4Serializer::AggregateCollectiveMetadataIndices(helper::Comm const &comm,
 
                     for (auto const &pair : perStepVarIndicesInfo)
                     {
-                        const size_t entryLengthPosition = position;
-                        size_t headerStartPosition =
-                            std::get<0>(pair.second[0]);
-                        size_t localPosition = headerStartPosition;
-                        ElementIndexHeader header =
-                            ReadElementIndexHeader(serialized, localPosition);
-                        size_t headerSize = localPosition - headerStartPosition;
-
-                        position += headerSize; // skip the header
-                        uint64_t setsCount = 0;
-                        for (auto &item : pair.second)
-                        {
-                            size_t start = std::get<0>(item);
-                            size_t length = std::get<1>(item);
-                            std::copy(serialized.begin() + start + headerSize,
-                                      serialized.begin() + start + length,
-                                      buffer.begin() + position);
-                            position += length - headerSize;
-                            setsCount += header.CharacteristicsSetsCount;
-                        }
-                        const uint32_t entryLength = static_cast<uint32_t>(
-                            position - entryLengthPosition - 4);
-                        size_t backPosition = entryLengthPosition;
-                        helper::CopyToBuffer(buffer, backPosition,
-                                             &entryLength);
-                        helper::CopyToBuffer(
-                            buffer, backPosition,
-                            &serialized[headerStartPosition + 4],
-                            headerSize - 8 - 4);
-                        helper::CopyToBuffer(buffer, backPosition, &setsCount);
+                        lf_MergeElementIndex(pair.second, serialized, buffer,
+                                             position);
                     }
                     const uint64_t perStepVarLengthU64 = static_cast<uint64_t>(
                         position - perStepVarCountPosition - 8);
@@ -1091,35 +1361,53 @@ void BP4Serializer::AggregateCollectiveMetadataIndices(helper::Comm const &comm,
     // BODY of function starts here
     lf_SerializeAllIndices(comm, rank); // Set m_SerializedIndices
 
+    // With MetadataFanIn, groups of ranks merge their indices on the way to
+    // rank 0, which then gathers and merges at most MetadataFanIn of them
+    const int fanIn = static_cast<int>(m_Parameters.MetadataFanIn);
+    const int size = comm.Size();
+    for (int stride = 1; fanIn > 1 && stride * fanIn < size; stride *= fanIn)
+    {
+        if (rank % stride != 0)
+        {
+            break;
+        }
+        const std::string hint =
+            "in metadata merge of rank " + std::to_string(rank);
+        const int leader = rank - rank % (stride * fanIn);
+        if (rank != leader)
+        {
+            const uint64_t size64 = m_SerializedIndices.size();
+            comm.Send(&size64, 1, leader, 0, hint);
+            comm.Send(m_SerializedIndices.data(), m_SerializedIndices.size(),
+                      leader, 1, hint);
+            m_SerializedIndices.clear();
+            break;
+        }
+
+        std::vector<char> &subtree = m_GatheredSerializedIndices;
+        subtree = m_SerializedIndices;
+        const int end = std::min(rank + stride * fanIn, size);
+        for (int r = rank + stride; r < end; r += stride)
+        {
+            uint64_t size64 = 0;
+            comm.Recv(&size64, 1, r, 0, hint);
+            const size_t position = subtree.size();
+            subtree.resize(position + static_cast<size_t>(size64));
+            comm.Recv(subtree.data() + position, static_cast<size_t>(size64),
+                      r, 1, hint);
+        }
+        lf_LocateSerializedIndices(subtree, subtree.size());
+        lf_MergeSubtreeIndices(subtree);
+    }
+
     comm.GathervVectors(m_SerializedIndices, inBufferSTL.m_Buffer,
                         inBufferSTL.m_Position, 0);
 
     // deserialize, it's all local inside rank 0
     if (rank == 0)
     {
-        const size_t serializedSize = inBufferSTL.m_Position;
-        const std::vector<char> &serialized = inBufferSTL.m_Buffer;
-        size_t serializedPosition = 0;
-        std::vector<size_t> headerInfo(4);
-        const bool isLittleEndian = helper::IsLittleEndian();
-
-        while (serializedPosition < serializedSize)
-        {
-            size_t localPosition = serializedPosition;
-
-            const int rankSource = static_cast<int>(helper::ReadValue<uint32_t>(
-                serialized, localPosition, isLittleEndian));
-
-            for (auto i = 0; i < 4; ++i)
-            {
-                headerInfo[i] = static_cast<size_t>(helper::ReadValue<uint64_t>(
-                    serialized, localPosition, isLittleEndian));
-            }
-
-            lf_LocateAllIndices(rankSource, headerInfo, serialized,
-                                serializedPosition);
-            serializedPosition += headerInfo[0] + 4;
-        }
+        lf_LocateSerializedIndices(inBufferSTL.m_Buffer,
+                                   inBufferSTL.m_Position);
     }
 
     // now merge (and sort variables and attributes) indices
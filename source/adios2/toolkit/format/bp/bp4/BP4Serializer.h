@@ -16,6 +16,7 @@
 #include "BP4Base.h"
 
 #include "adios2/core/Attribute.h"
+#include "adios2/core/CoreTypes.h"
 #include "adios2/core/IO.h"
 
 #include "adios2/toolkit/format/bp/BPSerializer.h"
@@ -119,6 +120,37 @@ public:
      */
     size_t CloseStream(core::IO &io, const bool addMetadata = true);
 
+    /**
+     * Makes room in m_Data for dataIn bytes. When they do not fit, the data
+     * serialized so far are kept as a chunk and m_Data continues in a new
+     * chunk, so growing the buffer never copies serialized data.
+     * @param dataIn input size for new data
+     * @param hint extra messaging for exception handling
+     * @return Unchanged, Success or Flush (MaxBufferSize is reached)
+     */
+    ResizeResult ResizeBuffer(const size_t dataIn,
+                              const std::string hint) final;
+
+    /** @return bytes serialized in the data chunks and in m_Data */
+    size_t DataPosition() const noexcept;
+
+    /** @return pointer to a position returned by DataPosition */
+    char *DataAt(const size_t position) noexcept;
+
+    /** @return the data chunks and m_Data up to m_Position, in order */
+    std::vector<core::iovec> DataVec() const;
+
+    /**
+     * Copies the data chunks in front of m_Data, for the aggregators that
+     * send m_Data as a single buffer
+     */
+    void JoinDataChunks();
+
+    /** Keeps the chunks of written data for reuse by ResizeBuffer */
+    void ReleaseDataChunks();
+
+    size_t DebugGetDataBufferSize() const final;
+
     /* Reset all metadata indices at the end of each step */
     void ResetAllIndices();
 
@@ -137,6 +169,29 @@ public:
                                      const bool inMetadataBuffer);
 
 private:
+    /** data serialized before m_Data, Size bytes of Buffer */
+    struct DataChunk
+    {
+        std::vector<char> Buffer;
+        size_t Size;
+    };
+    std::vector<DataChunk> m_DataChunks;
+
+    /** sum of the Size of m_DataChunks */
+    size_t m_DataChunksSize = 0;
+
+    /** buffers of released chunks */
+    std::vector<std::vector<char>> m_FreeDataChunks;
+
+    /**
+     * Keeps m_Data as a chunk, if not empty, and continues in a free or new
+     * buffer of at least size bytes
+     */
+    void NewDataChunk(const size_t size, const std::string &hint);
+
+    /** Makes room for size bytes at the end of m_Data */
+    void ReserveData(const size_t size, const std::string &hint);
+
     std::vector<char> m_SerializedIndices;
     std::vector<char> m_GatheredSerializedIndices;
 
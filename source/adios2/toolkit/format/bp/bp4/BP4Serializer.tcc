@@ -40,7 +40,7 @@ inline void BP4Serializer::PutVariableMetadata(
         if (m_Aggregator.m_IsActive && !m_Aggregator.m_IsAggregator)
         {
             offset =
-                static_cast<uint64_t>(m_Data.m_Position + m_PreDataFileLength);
+                static_cast<uint64_t>(DataPosition() + m_PreDataFileLength);
         }
         else
         {
@@ -68,7 +68,7 @@ inline void BP4Serializer::PutVariableMetadata(
     lf_SetOffset(stats.PayloadOffset);
     if (span != nullptr)
     {
-        span->m_PayloadPosition = m_Data.m_Position;
+        span->m_PayloadPosition = DataPosition();
     }
 
     // write to metadata  index
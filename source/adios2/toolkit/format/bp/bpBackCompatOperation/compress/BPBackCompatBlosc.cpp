@@ -115,7 +115,6 @@ size_t BPBackCompatBlosc::DecompressChunkedFormat(const void *bufferIn,
 
     if (isCompressed)
     {
-        blosc_init();
         uint8_t *outputBuff = reinterpret_cast<uint8_t *>(dataOut);
 
         while (inputOffset < inputDataSize)
@@ -147,8 +146,10 @@ size_t BPBackCompatBlosc::DecompressChunkedFormat(const void *bufferIn,
             bloscSize_t max_output_size =
                 static_cast<bloscSize_t>(outputChunkSize);
 
+            // the context variant keeps no global state, so reader threads
+            // may decompress blocks concurrently
             bloscSize_t decompressdSize =
-                blosc_decompress(in_ptr, out_ptr, max_output_size);
+                blosc_decompress_ctx(in_ptr, out_ptr, max_output_size, 1);
 
             if (decompressdSize > 0)
                 currentOutputSize += static_cast<size_t>(decompressdSize);
@@ -160,7 +161,6 @@ size_t BPBackCompatBlosc::DecompressChunkedFormat(const void *bufferIn,
             }
             inputOffset += static_cast<size_t>(max_inputDataSize);
         }
-        blosc_destroy();
     }
     else
     {
@@ -181,9 +181,8 @@ size_t BPBackCompatBlosc::DecompressOldFormat(const void *bufferIn,
                                               const size_t sizeOut,
                                               Params &info) const
 {
-    blosc_init();
-    const int decompressedSize = blosc_decompress(bufferIn, dataOut, sizeOut);
-    blosc_destroy();
+    const int decompressedSize =
+        blosc_decompress_ctx(bufferIn, dataOut, sizeOut, 1);
     return static_cast<size_t>(decompressedSize);
 }
 
@@ -9,6 +9,7 @@
 #include "adios2/core/Attribute.h"
 #include "adios2/core/Engine.h"
 #include "adios2/core/IO.h"
+#include "adios2/helper/adiosLog.h"
 
 #include "BP5Base.h"
 
@@ -49,6 +50,69 @@ int BP5Base::BP5BitfieldTest(struct BP5MetadataInfoStruct *MBase, int Bit) const
     return ((MBase->BitField[Element] & ((size_t)1 << ElementBit)) ==
             ((size_t)1 << ElementBit));
 }
+size_t BP5Base::OperatorChunksTableSize(const size_t ChunkCount) const
+{
+    return sizeof(OperatorChunksHeader) + ChunkCount * sizeof(uint64_t);
+}
+
+bool BP5Base::GetOperatorChunks(const char *Block,
+                                OperatorChunksHeader &Header,
+                                std::vector<uint64_t> &ChunkEnd) const
+{
+    if (static_cast<uint8_t>(Block[0]) != OperatorChunksTag)
+    {
+        return false;
+    }
+    memcpy(&Header, Block, sizeof(Header));
+    if (Header.Version != OperatorChunksVersion)
+    {
+        helper::Throw<std::runtime_error>(
+            "Toolkit", "format::BP5Base", "GetOperatorChunks",
+            "unknown version " + std::to_string(Header.Version) +
+                " of chunked operator data");
+    }
+    ChunkEnd.resize(Header.ChunkCount);
+    memcpy(ChunkEnd.data(), Block + sizeof(Header),
+           Header.ChunkCount * sizeof(uint64_t));
+    return true;
+}
+
+bool BP5Base::GetOperatorDelta(const char *Block,
+                               OperatorDeltaHeader &Header) const
+{
+    if (static_cast<uint8_t>(Block[0]) != OperatorDeltaTag)
+    {
+        return false;
+    }
+    memcpy(&Header, Block, sizeof(Header));
+    if (Header.Version != OperatorDeltaVersion)
+    {
+        helper::Throw<std::runtime_error>(
+            "Toolkit", "format::BP5Base", "GetOperatorDelta",
+            "unknown version " + std::to_string(Header.Version) +
+                " of delta operator data");
+    }
+    return true;
+}
+
+void BP5Base::XorBytes(const char *A, const char *B, char *Out,
+                       const size_t Size)
+{
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= Size; i += sizeof(uint64_t))
+    {
+        uint64_t a, b;
+        memcpy(&a, A + i, sizeof(a));
+        memcpy(&b, B + i, sizeof(b));
+        a ^= b;
+        memcpy(Out + i, &a, sizeof(a));
+    }
+    for (; i < Size; i++)
+    {
+        Out[i] = A[i] ^ B[i];
+    }
+}
+
 #define BASE_FIELD_ENTRIES                                                     \
     {"Dims", "integer", sizeof(size_t),                                        \
      FMOffset(BP5Base::MetaArrayRec *, Dims)},                                 \
@@ -73,6 +73,52 @@ public:
 
 #undef BASE_FIELDS
 
+    /* An operator block written with OperatorChunkSize holds slabs of whole
+     * rows of its slowest dimension, each compressed on its own. They follow
+     * this header and a uint64_t ChunkEnd[ChunkCount] table of where each
+     * compressed chunk ends, counted from the end of the table. */
+    struct OperatorChunksHeader
+    {
+        uint8_t Tag; // OperatorChunksTag, where an operator type would be
+        uint8_t Version;
+        uint16_t Unused;
+        uint32_t ChunkCount;
+        uint64_t RowsPerChunk;
+    };
+    static constexpr uint8_t OperatorChunksTag = 126;
+    static constexpr uint8_t OperatorChunksVersion = 1;
+    static constexpr size_t MaxOperatorChunks = 256;
+    /* first bytes of a block to read to get the chunk table, if any */
+    static constexpr size_t OperatorChunksPeekSize = 4096;
+
+    size_t OperatorChunksTableSize(const size_t ChunkCount) const;
+    /* false if Block is not chunked, otherwise Header and ChunkEnd are set */
+    bool GetOperatorChunks(const char *Block, OperatorChunksHeader &Header,
+                           std::vector<uint64_t> &ChunkEnd) const;
+
+    /* An operator block written with KeyframeInterval may hold, behind this
+     * header, the operator output of its bitwise XOR with the same block of
+     * an earlier keyframe step of the same writer. KeyframeOffset and
+     * KeyframeLength locate the keyframe block in the data of that step. */
+    struct OperatorDeltaHeader
+    {
+        uint8_t Tag; // OperatorDeltaTag, where an operator type would be
+        uint8_t Version;
+        uint8_t Unused[6];
+        uint64_t KeyframeStep; // absolute step in the file
+        uint64_t KeyframeOffset;
+        uint64_t KeyframeLength;
+    };
+    static constexpr uint8_t OperatorDeltaTag = 125;
+    static constexpr uint8_t OperatorDeltaVersion = 1;
+
+    /* false if Block is not a delta, otherwise Header is set */
+    bool GetOperatorDelta(const char *Block,
+                          OperatorDeltaHeader &Header) const;
+    /* Out = A ^ B, byte for byte */
+    static void XorBytes(const char *A, const char *B, char *Out,
+                         const size_t Size);
+
     struct BP5MetadataInfoStruct
     {
         size_t BitFieldCount;
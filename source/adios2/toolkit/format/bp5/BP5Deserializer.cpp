@@ -31,8 +31,10 @@
 
 #include "adios2/operator/OperatorFactory.h"
 
+#include <algorithm>
 #include <array>
 #include <float.h>
+#include <future>
 #include <limits.h>
 #include <math.h>
 #include <string.h>
@@ -514,6 +516,7 @@ void BP5Deserializer::SetupForStep(size_t Step, size_t WriterCount)
     else
     {
         PendingRequests.clear();
+        m_DeltaLayouts.clear();
 
         for (auto RecPair : VarByKey)
         {
@@ -545,10 +548,53 @@ size_t BP5Deserializer::WriterCohortSize(size_t Step) const
 
 void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
                                       size_t WriterRank, size_t Step)
+{
+    void *BaseData;
+    const ControlInfo *Control =
+        DecodeMetaData(MetadataBlock, BlockLen, WriterRank, Step, BaseData);
+    InstallVarMetaData(Control, BaseData, WriterRank, Step, 0, 1);
+}
+
+void BP5Deserializer::InstallMetaData(const std::vector<MetaDataBlock> &Blocks,
+                                      const size_t Threads)
+{
+    std::vector<const ControlInfo *> Controls(Blocks.size());
+    std::vector<void *> BaseData(Blocks.size());
+    for (size_t i = 0; i < Blocks.size(); i++)
+    {
+        Controls[i] =
+            DecodeMetaData(Blocks[i].Block, Blocks[i].BlockLen,
+                           Blocks[i].WriterRank, Blocks[i].Step, BaseData[i]);
+    }
+    // every thread goes through all blocks in order, for its own variables
+    auto lf_Install = [&](const size_t FirstVar, const size_t VarStride) {
+        for (size_t i = 0; i < Blocks.size(); i++)
+        {
+            InstallVarMetaData(Controls[i], BaseData[i], Blocks[i].WriterRank,
+                               Blocks[i].Step, FirstVar, VarStride);
+        }
+    };
+    const size_t nThreads = std::max<size_t>(std::min(Threads, m_VarCount), 1);
+    std::vector<std::future<void>> Futures;
+    for (size_t t = 1; t < nThreads; t++)
+    {
+        Futures.push_back(
+            std::async(std::launch::async, lf_Install, t, nThreads));
+    }
+    lf_Install(0, nThreads);
+    for (auto &F : Futures)
+    {
+        F.get();
+    }
+}
+
+BP5Deserializer::ControlInfo *
+BP5Deserializer::DecodeMetaData(void *MetadataBlock, size_t BlockLen,
+                                size_t WriterRank, size_t Step,
+                                void *&BaseData)
 {
     const size_t writerCohortSize = WriterCohortSize(Step);
     FFSTypeHandle FFSformat;
-    void *BaseData;
     static int DumpMetadata = -1;
     FFSformat =
         FFSTypeHandle_from_encode(ReaderFFSContext, (char *)MetadataBlock);
@@ -579,6 +625,10 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
             ReaderFFSContext, (char *)MetadataBlock, BlockLen);
         BaseData = malloc(DecodedLength);
         FFSdecode_to_buffer(ReaderFFSContext, (char *)MetadataBlock, BaseData);
+        if (m_StepMetaDataAccess)
+        {
+            m_DecodedMetaData[Step].push_back(BaseData);
+        }
     }
     if (DumpMetadata == -1)
     {
@@ -592,13 +642,11 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
         printf("\n\n");
     }
     struct ControlInfo *Control;
-    struct ControlStruct *ControlFields;
     Control = GetPriorControl(FMFormat_of_original(FFSformat));
     if (!Control)
     {
         Control = BuildControl(FMFormat_of_original(FFSformat));
     }
-    ControlFields = &Control->Controls[0];
 
     if (m_RandomAccessMode)
     {
@@ -620,6 +668,8 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
             MetadataBaseArray[Step] = m_MetadataBaseAddrs;
             m_FreeableMBA = nullptr;
         }
+        // the step may be installed again after ReleaseMetaData()
+        m_MetadataBaseAddrs = MetadataBaseArray[Step];
     }
     else
     {
@@ -634,13 +684,23 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
         }
     }
     (*m_MetadataBaseAddrs)[WriterRank] = BaseData;
+    return Control;
+}
 
+void BP5Deserializer::InstallVarMetaData(const ControlInfo *Control,
+                                         void *BaseData, size_t WriterRank,
+                                         size_t Step, const size_t FirstVar,
+                                         const size_t VarStride)
+{
+    const size_t writerCohortSize = WriterCohortSize(Step);
+    const struct ControlStruct *ControlFields = &Control->Controls[0];
     for (int i = 0; i < Control->ControlCount; i++)
     {
         size_t FieldOffset = ControlFields[i].FieldOffset;
         BP5VarRec *VarRec = ControlFields[i].VarRec;
         void *field_data = (char *)BaseData + FieldOffset;
-        if (!BP5BitfieldTest((BP5MetadataInfoStruct *)BaseData, i))
+        if ((VarRec->VarNum % VarStride != FirstVar) ||
+            !BP5BitfieldTest((BP5MetadataInfoStruct *)BaseData, i))
         {
             continue;
         }
@@ -665,26 +725,50 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
             (ControlFields[i].OrigShapeID == ShapeID::LocalArray))
         {
             MetaArrayRec *meta_base = (MetaArrayRec *)field_data;
-            size_t BlockCount =
-                meta_base->Dims ? meta_base->DBCount / meta_base->Dims : 1;
-            if ((meta_base->Dims > 1) &&
-                (m_WriterIsRowMajor != m_ReaderIsRowMajor))
+            const bool DeltaEntry = (meta_base->Dims == 0);
+            if (DeltaEntry)
             {
-                /* if we're getting data from someone of the other array gender,
-                 * switcheroo */
-                ReverseDimensions(meta_base->Shape, meta_base->Dims, 1);
-                ReverseDimensions(meta_base->Count, meta_base->Dims,
-                                  BlockCount);
-                ReverseDimensions(meta_base->Offsets, meta_base->Dims,
-                                  BlockCount);
+                // same layout as the last full entry of this writer
+                ApplyArrayLayout(VarRec, WriterRank, meta_base);
+                if (m_StepMetaDataAccess)
+                {
+                    std::lock_guard<std::mutex> Lock(m_InstallMutex);
+                    m_InstalledDeltaLayouts[std::make_tuple(
+                        Step, WriterRank, VarRec->VarNum)] =
+                        VarRec->PerWriterLayout[WriterRank];
+                }
+            }
+            size_t BlockCount = meta_base->DBCount / meta_base->Dims;
+            if (!DeltaEntry)
+            {
+                if ((meta_base->Dims > 1) &&
+                    (m_WriterIsRowMajor != m_ReaderIsRowMajor))
+                {
+                    /* if we're getting data from someone of the other array
+                     * gender, switcheroo */
+                    ReverseDimensions(meta_base->Shape, meta_base->Dims, 1);
+                    ReverseDimensions(meta_base->Count, meta_base->Dims,
+                                      BlockCount);
+                    ReverseDimensions(meta_base->Offsets, meta_base->Dims,
+                                      BlockCount);
+                }
+                SaveArrayLayout(VarRec, WriterRank, meta_base);
             }
             if ((WriterRank == 0) || (VarRec->GlobalDims == NULL))
             {
                 // use the shape from rank 0 (or first non-NULL)
                 VarRec->GlobalDims = meta_base->Shape;
+                if (m_StepMetaDataAccess && meta_base->Shape)
+                {
+                    // the metadata may be released
+                    VarRec->GlobalDimsCopy.assign(
+                        meta_base->Shape, meta_base->Shape + meta_base->Dims);
+                    VarRec->GlobalDims = VarRec->GlobalDimsCopy.data();
+                }
             }
             if (!VarRec->Variable)
             {
+                std::lock_guard<std::mutex> Lock(m_InstallMutex);
                 VarRec->Variable = ArrayVarSetup(
                     m_Engine, VarRec->VarName, VarRec->Type, meta_base->Dims,
                     meta_base->Shape, meta_base->Offsets, meta_base->Count);
@@ -720,6 +804,7 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
         {
             if (!VarRec->Variable)
             {
+                std::lock_guard<std::mutex> Lock(m_InstallMutex);
                 if (ControlFields[i].OrigShapeID == ShapeID::LocalValue)
                 {
                     // Local single values show up as global arrays on the
@@ -759,6 +844,132 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen,
     }
 }
 
+void BP5Deserializer::SaveArrayLayout(BP5VarRec *VarRec, size_t WriterRank,
+                                      const MetaArrayRec *MetaEntry)
+{
+    if (VarRec->PerWriterLayout.size() <= WriterRank)
+    {
+        VarRec->PerWriterLayout.resize(WriterRank + 1);
+    }
+    std::shared_ptr<ArrayLayout> &Layout = VarRec->PerWriterLayout[WriterRank];
+    if (!Layout || (Layout.use_count() > 1))
+    {
+        // the prior layout is still referenced by installed delta entries
+        Layout = std::make_shared<ArrayLayout>();
+    }
+    Layout->Dims = MetaEntry->Dims;
+    Layout->HasShape = (MetaEntry->Shape != NULL);
+    Layout->HasOffsets = (MetaEntry->Offsets != NULL);
+    if (MetaEntry->Shape)
+        Layout->Shape.assign(MetaEntry->Shape,
+                             MetaEntry->Shape + MetaEntry->Dims);
+    Layout->Count.assign(MetaEntry->Count,
+                         MetaEntry->Count + MetaEntry->DBCount);
+    if (MetaEntry->Offsets)
+        Layout->Offsets.assign(MetaEntry->Offsets,
+                               MetaEntry->Offsets + MetaEntry->DBCount);
+}
+
+void BP5Deserializer::ApplyArrayLayout(BP5VarRec *VarRec, size_t WriterRank,
+                                       MetaArrayRec *MetaEntry)
+{
+    if ((VarRec->PerWriterLayout.size() <= WriterRank) ||
+        !VarRec->PerWriterLayout[WriterRank])
+    {
+        helper::Throw<std::runtime_error>(
+            "Toolkit", "format::BP5Deserializer", "InstallMetaData",
+            "Metadata of variable " + std::string(VarRec->VarName) +
+                " from writer " + std::to_string(WriterRank) +
+                " refers to a step that was not read, steps of output written "
+                "with MetadataDelta cannot be skipped");
+    }
+    std::shared_ptr<ArrayLayout> &Layout = VarRec->PerWriterLayout[WriterRank];
+    if (Layout.use_count() == 1)
+    {
+        std::lock_guard<std::mutex> Lock(m_InstallMutex);
+        m_DeltaLayouts.push_back(Layout);
+    }
+    UseArrayLayout(*Layout, MetaEntry);
+}
+
+void BP5Deserializer::UseArrayLayout(ArrayLayout &Layout,
+                                     MetaArrayRec *MetaEntry)
+{
+    MetaEntry->Dims = Layout.Dims;
+    MetaEntry->DBCount = Layout.Count.size();
+    MetaEntry->Shape = Layout.HasShape ? Layout.Shape.data() : NULL;
+    MetaEntry->Count = Layout.Count.data();
+    MetaEntry->Offsets = Layout.HasOffsets ? Layout.Offsets.data() : NULL;
+}
+
+void BP5Deserializer::ReleaseMetaData(size_t Step)
+{
+    if ((Step < MetadataBaseArray.size()) && MetadataBaseArray[Step])
+    {
+        std::fill(MetadataBaseArray[Step]->begin(),
+                  MetadataBaseArray[Step]->end(), nullptr);
+    }
+    auto it = m_DecodedMetaData.find(Step);
+    if (it != m_DecodedMetaData.end())
+    {
+        for (void *BaseData : it->second)
+        {
+            free(BaseData);
+        }
+        m_DecodedMetaData.erase(it);
+    }
+}
+
+void BP5Deserializer::ReinstallMetaData(void *MetadataBlock, size_t BlockLen,
+                                        size_t WriterRank, size_t Step)
+{
+    void *BaseData;
+    const ControlInfo *Control =
+        DecodeMetaData(MetadataBlock, BlockLen, WriterRank, Step, BaseData);
+    // the variables are known, only redo the changes to the array entries
+    const struct ControlStruct *ControlFields = &Control->Controls[0];
+    for (int i = 0; i < Control->ControlCount; i++)
+    {
+        if (((ControlFields[i].OrigShapeID != ShapeID::GlobalArray) &&
+             (ControlFields[i].OrigShapeID != ShapeID::LocalArray)) ||
+            !BP5BitfieldTest((BP5MetadataInfoStruct *)BaseData, i))
+        {
+            continue;
+        }
+        MetaArrayRec *meta_base =
+            (MetaArrayRec *)((char *)BaseData + ControlFields[i].FieldOffset);
+        if (meta_base->Dims == 0)
+        {
+            auto it = m_InstalledDeltaLayouts.find(std::make_tuple(
+                Step, WriterRank, ControlFields[i].VarRec->VarNum));
+            if (it != m_InstalledDeltaLayouts.end())
+            {
+                UseArrayLayout(*it->second, meta_base);
+            }
+        }
+        else if ((meta_base->Dims > 1) &&
+                 (m_WriterIsRowMajor != m_ReaderIsRowMajor))
+        {
+            size_t BlockCount = meta_base->DBCount / meta_base->Dims;
+            ReverseDimensions(meta_base->Shape, meta_base->Dims, 1);
+            ReverseDimensions(meta_base->Count, meta_base->Dims, BlockCount);
+            ReverseDimensions(meta_base->Offsets, meta_base->Dims, BlockCount);
+        }
+    }
+}
+
+bool BP5Deserializer::MetaDataInUse(size_t Step) const
+{
+    for (const auto &Req : PendingRequests)
+    {
+        if (Req.Step == Step)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void BP5Deserializer::InstallAttributeData(void *AttributeBlock,
                                            size_t BlockLen, size_t Step)
 {
@@ -1045,6 +1256,7 @@ bool BP5Deserializer::QueueGetSingle(core::VariableBase &variable,
         }
         Req.Data = DestData;
         Req.Step = Step;
+        Req.MemSpace = MemSpace;
         PendingRequests.push_back(Req);
     }
     else
@@ -1123,6 +1335,47 @@ static size_t CalcBlockLength(const size_t dimensionsSize, const size_t *count)
     return len;
 }
 
+void BP5Deserializer::SelectedRows(const BP5ArrayRequest &Req,
+                                   const MetaArrayRec *Meta,
+                                   const size_t BlockID, size_t &FirstRow,
+                                   size_t &EndRow) const
+{
+    const size_t Dim = m_ReaderIsRowMajor ? 0 : Meta->Dims - 1;
+    const size_t BlockDim = BlockID * Meta->Dims + Dim;
+    FirstRow = 0;
+    EndRow = Meta->Count[BlockDim];
+    if (!Req.Start.size() || !Req.Count.size())
+    {
+        return;
+    }
+    if (Req.RequestType == Local)
+    {
+        FirstRow = Req.Start[Dim];
+        EndRow = Req.Start[Dim] + Req.Count[Dim];
+        return;
+    }
+    const size_t BlockStart = Meta->Offsets[BlockDim];
+    FirstRow = std::max(Req.Start[Dim], BlockStart) - BlockStart;
+    EndRow = std::min(Req.Start[Dim] + Req.Count[Dim], BlockStart + EndRow) -
+             BlockStart;
+}
+
+bool BP5Deserializer::PeekOperatorBlock(const BP5ArrayRequest &Req,
+                                        const MetaArrayRecOperator *Meta,
+                                        const size_t BlockID) const
+{
+    // below this, an extra read costs more than reading all chunks
+    const size_t MinPeekBlockSize = 1024 * 1024;
+    if (Meta->DataBlockSize[BlockID] < MinPeekBlockSize)
+    {
+        return false;
+    }
+    size_t FirstRow, EndRow;
+    SelectedRows(Req, (const MetaArrayRec *)Meta, BlockID, FirstRow, EndRow);
+    const size_t Dim = m_ReaderIsRowMajor ? 0 : Meta->Dims - 1;
+    return (FirstRow > 0) || (EndRow < Meta->Count[BlockID * Meta->Dims + Dim]);
+}
+
 std::vector<BP5Deserializer::ReadRequest>
 BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers,
                                       size_t *maxReadSize)
@@ -1161,18 +1414,36 @@ BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers,
                     RR.StartOffset =
                         writer_meta_base->DataBlockLocation[NeededBlock];
 
-                    RR.ReadLength =
-                        helper::GetDataTypeSize(Req->VarRec->Type) *
-                        CalcBlockLength(Req->VarRec->DimCount,
-                                        &writer_meta_base->Count[StartDim]);
+                    size_t BufferSize;
+                    if (Req->VarRec->Operator != NULL)
+                    {
+                        RR.ReadLength =
+                            writer_meta_base->DataBlockSize[NeededBlock];
+                        BufferSize = RR.ReadLength;
+                        if (!doAllocTempBuffers &&
+                            PeekOperatorBlock(*Req, writer_meta_base,
+                                              NeededBlock))
+                        {
+                            RR.ReadLength = OperatorChunksPeekSize;
+                            BufferSize += OperatorChunksPeekSize;
+                        }
+                    }
+                    else
+                    {
+                        RR.ReadLength =
+                            helper::GetDataTypeSize(Req->VarRec->Type) *
+                            CalcBlockLength(Req->VarRec->DimCount,
+                                            &writer_meta_base->Count[StartDim]);
+                        BufferSize = RR.ReadLength;
+                    }
                     RR.DestinationAddr = nullptr;
                     if (doAllocTempBuffers)
                     {
                         RR.DestinationAddr = (char *)malloc(RR.ReadLength);
                     }
                     *maxReadSize =
-                        (*maxReadSize < RR.ReadLength ? RR.ReadLength
-                                                      : *maxReadSize);
+                        (*maxReadSize < BufferSize ? BufferSize
+                                                   : *maxReadSize);
                     RR.Internal = NULL;
                     RR.OffsetInBlock = 0;
                     RR.ReqIndex = ReqIndex;
@@ -1220,6 +1491,15 @@ BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers,
                                 writer_meta_base->DataBlockLocation[Block];
                             RR.ReadLength =
                                 writer_meta_base->DataBlockSize[Block];
+                            size_t BufferSize = RR.ReadLength;
+                            if (!doAllocTempBuffers &&
+                                PeekOperatorBlock(*Req, writer_meta_base,
+                                                  Block))
+                            {
+                                // read the chunk table first
+                                RR.ReadLength = OperatorChunksPeekSize;
+                                BufferSize += OperatorChunksPeekSize;
+                            }
                             RR.DestinationAddr = nullptr;
                             if (doAllocTempBuffers)
                             {
@@ -1227,8 +1507,8 @@ BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers,
                                     (char *)malloc(RR.ReadLength);
                             }
                             *maxReadSize =
-                                (*maxReadSize < RR.ReadLength ? RR.ReadLength
-                                                              : *maxReadSize);
+                                (*maxReadSize < BufferSize ? BufferSize
+                                                           : *maxReadSize);
                             RR.Internal = NULL;
                             RR.ReqIndex = ReqIndex;
                             RR.BlockID = Block;
@@ -1316,6 +1596,8 @@ void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr)
     char *IncomingData = Read.DestinationAddr;
     char *VirtualIncomingData = Read.DestinationAddr - Read.OffsetInBlock;
     std::vector<char> decompressBuffer;
+    size_t SlabFirstRow = 0, SlabRows = 0; // of a block compressed in chunks
+    const size_t SlabDim = m_ReaderIsRowMajor ? 0 : DimCount - 1;
     if (Req.VarRec->Operator != NULL)
     {
         size_t DestSize = Req.VarRec->ElementSize;
@@ -1325,12 +1607,109 @@ void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr)
                 writer_meta_base
                     ->Count[dim + Read.BlockID * writer_meta_base->Dims];
         }
-        decompressBuffer.resize(DestSize);
+        const size_t CompressedSize =
+            ((MetaArrayRecOperator *)writer_meta_base)
+                ->DataBlockSize[Read.BlockID];
+
+        // A selection of exactly this block has the same layout in memory,
+        // so decompress straight into it and skip the copy
+        bool WholeBlock = (Req.MemSpace == MemorySpace::Host);
+        for (int i = 0; WholeBlock && (i < DimCount); i++)
+        {
+            const size_t BlockStart =
+                (Req.RequestType == Local) ? 0 : RankOffset[i];
+            if ((Req.Start.size() && (Req.Start[i] != BlockStart)) ||
+                (Req.Count.size() && (Req.Count[i] != RankSize[i])))
+            {
+                WholeBlock = false;
+            }
+        }
+
+        OperatorDeltaHeader Delta;
+        OperatorChunksHeader Header;
+        std::vector<uint64_t> ChunkEnd;
+        if (GetOperatorDelta(IncomingData, Delta))
+        {
+            if (!Read.KeyframeAddr)
+            {
+                helper::Throw<std::runtime_error>(
+                    "Toolkit", "format::BP5Deserializer", "FinalizeGet",
+                    "block of variable " + std::string(Req.VarRec->VarName) +
+                        " is a difference to step " +
+                        std::to_string(Delta.KeyframeStep) +
+                        ", which was not read");
+            }
+            std::vector<char> Keyframe = AcquireDecompressBuffer(DestSize);
+            DecompressBlock(Read.KeyframeAddr, Delta.KeyframeLength,
+                            Keyframe.data(), DestSize, RankSize[SlabDim]);
+            char *Dest = (char *)Req.Data;
+            if (!WholeBlock)
+            {
+                decompressBuffer = AcquireDecompressBuffer(DestSize);
+                Dest = decompressBuffer.data();
+            }
+            core::Decompress(IncomingData + sizeof(Delta),
+                             CompressedSize - sizeof(Delta), Dest);
+            XorBytes(Dest, Keyframe.data(), Dest, DestSize);
+            ReleaseDecompressBuffer(std::move(Keyframe));
+            if (WholeBlock)
+            {
+                if (freeAddr)
+                {
+                    free((char *)Read.DestinationAddr);
+                }
+                return;
+            }
+        }
+        else if (GetOperatorChunks(IncomingData, Header, ChunkEnd))
+        {
+            const size_t Rows = RankSize[SlabDim];
+            const size_t RowSize = DestSize / Rows;
+            const size_t R = Header.RowsPerChunk;
+            size_t FirstRow, EndRow;
+            SelectedRows(Req, writer_meta_base, Read.BlockID, FirstRow,
+                         EndRow);
+            const size_t FirstChunk = FirstRow / R;
+            const size_t EndChunk = (EndRow + R - 1) / R;
+            // only the needed chunks follow the table read first, if that
+            const char *Chunks =
+                IncomingData + OperatorChunksTableSize(Header.ChunkCount);
+            uint64_t ChunksStart = 0;
+            if (Read.ReadLength < CompressedSize)
+            {
+                Chunks = IncomingData + Read.ReadLength;
+                ChunksStart = FirstChunk ? ChunkEnd[FirstChunk - 1] : 0;
+            }
+            if (WholeBlock)
+            {
+                DecompressChunks(Chunks, ChunksStart, ChunkEnd, R, 0,
+                                 Header.ChunkCount, (char *)Req.Data, RowSize);
+                if (freeAddr)
+                {
+                    free((char *)Read.DestinationAddr);
+                }
+                return;
+            }
+            SlabFirstRow = FirstChunk * R;
+            SlabRows = std::min(EndChunk * R, Rows) - SlabFirstRow;
+            decompressBuffer = AcquireDecompressBuffer(SlabRows * RowSize);
+            DecompressChunks(Chunks, ChunksStart, ChunkEnd, R, FirstChunk,
+                             EndChunk, decompressBuffer.data(), RowSize);
+        }
+        else if (WholeBlock)
+        {
+            // Decompress() is reentrant, reader threads run it concurrently
+            core::Decompress(IncomingData, CompressedSize, (char *)Req.Data);
+            if (freeAddr)
+            {
+                free((char *)Read.DestinationAddr);
+            }
+            return;
+        }
+        else
         {
-            std::lock_guard<std::mutex> lockGuard(mutexDecompress);
-            core::Decompress(IncomingData,
-                             ((MetaArrayRecOperator *)writer_meta_base)
-                                 ->DataBlockSize[Read.BlockID],
+            decompressBuffer = AcquireDecompressBuffer(DestSize);
+            core::Decompress(IncomingData, CompressedSize,
                              decompressBuffer.data());
         }
         IncomingData = decompressBuffer.data();
@@ -1366,6 +1745,19 @@ void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr)
     DimsArray inCount(DimCount, RankSize);
     DimsArray outStart(DimCount, SelOffset);
     DimsArray outCount(DimCount, SelSize);
+    if (SlabRows)
+    {
+        // only these rows of the block were decompressed
+        inStart[SlabDim] += SlabFirstRow;
+        inCount[SlabDim] = SlabRows;
+    }
+    if (Read.Packed)
+    {
+        // only the intersection with the selection was sent
+        IntersectionStartCount(DimCount, SelOffset, SelSize, RankOffset,
+                               RankSize, &inStart[0], &inCount[0]);
+        VirtualIncomingData = IncomingData;
+    }
     if (!m_ReaderIsRowMajor)
     {
         std::reverse(inStart.begin(), inStart.end());
@@ -1378,12 +1770,168 @@ void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr)
                    (char *)Req.Data, outStart, outCount, true, true,
                    ElementSize, CoreDims(), CoreDims(), CoreDims(), CoreDims(),
                    false, Req.MemSpace);
+    if (Req.VarRec->Operator != NULL)
+    {
+        ReleaseDecompressBuffer(std::move(decompressBuffer));
+    }
     if (freeAddr)
     {
         free((char *)Read.DestinationAddr);
     }
 }
 
+bool BP5Deserializer::GetFollowUpRead(const ReadRequest &Read,
+                                      size_t &StartOffset,
+                                      size_t &ReadLength) const
+{
+    auto &Req = PendingRequests[Read.ReqIndex];
+    if (Req.VarRec->Operator == NULL)
+    {
+        return false;
+    }
+    MetaArrayRecOperator *writer_meta_base =
+        (MetaArrayRecOperator *)GetMetadataBase(Req.VarRec, Req.Step,
+                                                Read.WriterRank);
+    const size_t BlockSize = writer_meta_base->DataBlockSize[Read.BlockID];
+    if (Read.ReadLength >= BlockSize)
+    {
+        return false;
+    }
+    OperatorChunksHeader Header;
+    std::vector<uint64_t> ChunkEnd;
+    if (!GetOperatorChunks(Read.DestinationAddr, Header, ChunkEnd))
+    {
+        // the rest of a block compressed as a whole
+        StartOffset = Read.StartOffset + Read.ReadLength;
+        ReadLength = BlockSize - Read.ReadLength;
+        return true;
+    }
+    size_t FirstRow, EndRow;
+    SelectedRows(Req, (const MetaArrayRec *)writer_meta_base, Read.BlockID,
+                 FirstRow, EndRow);
+    const size_t R = Header.RowsPerChunk;
+    const size_t FirstChunk = FirstRow / R;
+    const size_t EndChunk = (EndRow + R - 1) / R;
+    const uint64_t ChunksStart = FirstChunk ? ChunkEnd[FirstChunk - 1] : 0;
+    StartOffset = Read.StartOffset +
+                  OperatorChunksTableSize(Header.ChunkCount) + ChunksStart;
+    ReadLength = ChunkEnd[EndChunk - 1] - ChunksStart;
+    return true;
+}
+
+bool BP5Deserializer::GetKeyframeRead(const ReadRequest &Read, size_t &Step,
+                                      size_t &StartOffset,
+                                      size_t &ReadLength) const
+{
+    OperatorDeltaHeader Delta;
+    if ((PendingRequests[Read.ReqIndex].VarRec->Operator == NULL) ||
+        !GetOperatorDelta(Read.DestinationAddr, Delta))
+    {
+        return false;
+    }
+    Step = Delta.KeyframeStep;
+    StartOffset = Delta.KeyframeOffset;
+    ReadLength = Delta.KeyframeLength;
+    return true;
+}
+
+bool BP5Deserializer::GetSlabRead(const ReadRequest &Read, size_t &ElementSize,
+                                  Dims &BlockCount, Dims &SelStart,
+                                  Dims &SelCount) const
+{
+    auto &Req = PendingRequests[Read.ReqIndex];
+    if ((Req.VarRec->Operator != NULL) || (Req.RequestType == Local))
+    {
+        return false;
+    }
+    const MetaArrayRec *writer_meta_base = (const MetaArrayRec *)
+        GetMetadataBase(Req.VarRec, Req.Step, Read.WriterRank);
+    const size_t DimCount = writer_meta_base->Dims;
+    const size_t *RankOffset =
+        &writer_meta_base->Offsets[DimCount * Read.BlockID];
+    const size_t *RankSize = &writer_meta_base->Count[DimCount * Read.BlockID];
+    BlockCount.assign(RankSize, RankSize + DimCount);
+    SelStart.resize(DimCount);
+    SelCount.resize(DimCount);
+    IntersectionStartCount(DimCount, Req.Start.data(), Req.Count.data(),
+                           RankOffset, RankSize, SelStart.data(),
+                           SelCount.data());
+    ElementSize = Req.VarRec->ElementSize;
+    size_t Length = ElementSize;
+    for (size_t Dim = 0; Dim < DimCount; Dim++)
+    {
+        SelStart[Dim] -= RankOffset[Dim];
+        Length *= SelCount[Dim];
+    }
+    if (Length == Read.ReadLength)
+    {
+        return false;
+    }
+    if (!m_ReaderIsRowMajor)
+    {
+        std::reverse(BlockCount.begin(), BlockCount.end());
+        std::reverse(SelStart.begin(), SelStart.end());
+        std::reverse(SelCount.begin(), SelCount.end());
+    }
+    return true;
+}
+
+void BP5Deserializer::DecompressBlock(const char *Data, const size_t Size,
+                                      char *Dest, const size_t DestSize,
+                                      const size_t Rows)
+{
+    OperatorChunksHeader Header;
+    std::vector<uint64_t> ChunkEnd;
+    if (GetOperatorChunks(Data, Header, ChunkEnd))
+    {
+        DecompressChunks(Data + OperatorChunksTableSize(Header.ChunkCount), 0,
+                         ChunkEnd, Header.RowsPerChunk, 0, Header.ChunkCount,
+                         Dest, DestSize / Rows);
+    }
+    else
+    {
+        core::Decompress(Data, Size, Dest);
+    }
+}
+
+void BP5Deserializer::DecompressChunks(const char *Data,
+                                       const uint64_t DataStart,
+                                       const std::vector<uint64_t> &ChunkEnd,
+                                       const size_t RowsPerChunk,
+                                       const size_t FirstChunk,
+                                       const size_t EndChunk, char *Dest,
+                                       const size_t RowSize)
+{
+    auto lf_Decompress = [&](const size_t First, const size_t Stride) {
+        for (size_t c = First; c < EndChunk; c += Stride)
+        {
+            const uint64_t Start = c ? ChunkEnd[c - 1] : 0;
+            core::Decompress(Data + (Start - DataStart), ChunkEnd[c] - Start,
+                             Dest + (c - FirstChunk) * RowsPerChunk * RowSize);
+        }
+    };
+    const size_t Threads =
+        std::min(m_DecompressThreads, EndChunk - FirstChunk);
+    if (Threads > 1)
+    {
+        std::vector<std::future<void>> Futures;
+        for (size_t t = 1; t < Threads; t++)
+        {
+            Futures.push_back(std::async(std::launch::async, lf_Decompress,
+                                         FirstChunk + t, Threads));
+        }
+        lf_Decompress(FirstChunk, Threads);
+        for (auto &f : Futures)
+        {
+            f.get();
+        }
+    }
+    else
+    {
+        lf_Decompress(FirstChunk, 1);
+    }
+}
+
 void BP5Deserializer::FinalizeGets(std::vector<ReadRequest> &Reads)
 {
     for (const auto &Read : Reads)
@@ -1391,6 +1939,30 @@ void BP5Deserializer::FinalizeGets(std::vector<ReadRequest> &Reads)
         FinalizeGet(Read, true);
     }
     PendingRequests.clear();
+    // don't hold on to the largest decompressed blocks between steps
+    std::lock_guard<std::mutex> lockGuard(m_DecompressBuffersMutex);
+    m_DecompressBuffers.clear();
+}
+
+std::vector<char> BP5Deserializer::AcquireDecompressBuffer(const size_t Size)
+{
+    std::vector<char> Buffer;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_DecompressBuffersMutex);
+        if (!m_DecompressBuffers.empty())
+        {
+            Buffer = std::move(m_DecompressBuffers.back());
+            m_DecompressBuffers.pop_back();
+        }
+    }
+    Buffer.resize(Size);
+    return Buffer;
+}
+
+void BP5Deserializer::ReleaseDecompressBuffer(std::vector<char> &&Buffer)
+{
+    std::lock_guard<std::mutex> lockGuard(m_DecompressBuffersMutex);
+    m_DecompressBuffers.push_back(std::move(Buffer));
 }
 
 void BP5Deserializer::MapGlobalToLocalIndex(size_t Dims,
@@ -1483,6 +2055,13 @@ BP5Deserializer::~BP5Deserializer()
     }
     if (m_FreeableMBA)
         delete m_FreeableMBA;
+    for (auto &Decoded : m_DecodedMetaData)
+    {
+        for (void *BaseData : Decoded.second)
+        {
+            free(BaseData);
+        }
+    }
     for (auto &step : MetadataBaseArray)
     {
         delete step;
@@ -1495,6 +2074,10 @@ void *BP5Deserializer::GetMetadataBase(BP5VarRec *VarRec, size_t Step,
     MetaArrayRec *writer_meta_base = NULL;
     if (m_RandomAccessMode)
     {
+        if (m_StepMetaDataAccess)
+        {
+            m_StepMetaDataAccess(Step);
+        }
         ControlInfo *CI =
             m_ControlArray[Step][WriterRank]; // writer control array
         if (((*CI->MetaFieldOffset).size() <= VarRec->VarNum) ||
@@ -1755,6 +2338,10 @@ size_t BP5Deserializer::RelativeToAbsoluteStep(const BP5VarRec *VarRec,
     {
         size_t WriterRank = 0;
         const size_t writerCohortSize = WriterCohortSize(AbsStep);
+        if (m_StepMetaDataAccess)
+        {
+            m_StepMetaDataAccess(AbsStep);
+        }
         while (WriterRank < writerCohortSize)
         {
             BP5MetadataInfoStruct *BaseData;
@@ -18,7 +18,11 @@
 #include "ffs.h"
 #include "fm.h"
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <tuple>
 
 #ifdef _WIN32
 #pragma warning(disable : 4250)
@@ -51,12 +55,37 @@ public:
         size_t ReqIndex;
         size_t OffsetInBlock;
         size_t BlockID;
+        char *KeyframeAddr = nullptr; // see GetKeyframeRead()
+        bool Packed = false;          // see GetSlabRead()
     };
     void InstallMetaMetaData(MetaMetaInfoBlock &MMList);
     void InstallMetaData(void *MetadataBlock, size_t BlockLen,
                          size_t WriterRank, size_t Step = SIZE_MAX);
+    struct MetaDataBlock
+    {
+        void *Block;
+        size_t BlockLen;
+        size_t WriterRank;
+        size_t Step;
+    };
+    /* Install many metadata blocks, with the same result as calling
+     * InstallMetaData() for each in order. The blocks are decoded first,
+     * then the variables are split among up to Threads threads. */
+    void InstallMetaData(const std::vector<MetaDataBlock> &Blocks,
+                         const size_t Threads);
     void InstallAttributeData(void *AttributeBlock, size_t BlockLen,
                               size_t Step = SIZE_MAX);
+    /* In random access mode, the engine may take back the metadata of a
+     * step with ReleaseMetaData() when it is not MetaDataInUse(). If this
+     * is set, it is called before each use of the metadata of a step, for
+     * the engine to give released metadata again with ReinstallMetaData()
+     * for each writer. It must be set before metadata is installed. */
+    std::function<void(size_t Step)> m_StepMetaDataAccess;
+    void ReleaseMetaData(size_t Step);
+    void ReinstallMetaData(void *MetadataBlock, size_t BlockLen,
+                           size_t WriterRank, size_t Step);
+    // true if the requests pending for the next reads use Step
+    bool MetaDataInUse(size_t Step) const;
     void SetupForStep(size_t Step, size_t WriterCount);
     // return from QueueGet is true if a sync is needed to fill the data
     bool QueueGet(core::VariableBase &variable, void *DestData);
@@ -73,9 +102,34 @@ public:
      */
     std::vector<ReadRequest> GenerateReadRequests(const bool doAllocTempBuffers,
                                                   size_t *maxReadSize);
+    /* A request of a block compressed in chunks may first read only the
+     * chunk table. Then, this gives the part of the block that still has to
+     * be read, to be placed after the data already read, before calling
+     * FinalizeGet(). Returns false if the request is complete. */
+    bool GetFollowUpRead(const ReadRequest &Read, size_t &StartOffset,
+                         size_t &ReadLength) const;
+    /* A block written with KeyframeInterval may be the difference to the
+     * same block of an earlier step. Then, this gives the absolute step and
+     * the part of the data of that step to read into Read.KeyframeAddr
+     * before calling FinalizeGet(). Returns false for a keyframe block. */
+    bool GetKeyframeRead(const ReadRequest &Read, size_t &Step,
+                         size_t &StartOffset, size_t &ReadLength) const;
+    /* A request of a part of an uncompressed block may be served by
+     * sending only the selected elements. Then, this gives the element
+     * size, the count of the block and the start and count of the
+     * selection in it, slowest dimension first. The data read that way is
+     * packed and the request must be marked Packed before calling
+     * FinalizeGet(). Returns false if the span of the request is already
+     * contiguous. */
+    bool GetSlabRead(const ReadRequest &Read, size_t &ElementSize,
+                     Dims &BlockCount, Dims &SelStart,
+                     Dims &SelCount) const;
     void FinalizeGet(const ReadRequest &, const bool freeAddr);
     void FinalizeGets(std::vector<ReadRequest> &);
 
+    // threads FinalizeGet() may use for the chunks of one block
+    size_t m_DecompressThreads = 1;
+
     MinVarInfo *AllRelativeStepsMinBlocksInfo(const VariableBase &var);
     MinVarInfo *AllStepsMinBlocksInfo(const VariableBase &var);
     MinVarInfo *MinBlocksInfo(const VariableBase &Var, const size_t Step);
@@ -91,6 +145,20 @@ public:
 
 private:
     size_t m_VarCount = 0;
+
+    /* Shape, Count and Offsets of the last full metadata entry of an array
+     * from a writer, referenced by the following delta entries (MetadataDelta
+     * writer parameter) */
+    struct ArrayLayout
+    {
+        size_t Dims = 0;
+        bool HasShape = false;
+        bool HasOffsets = false;
+        std::vector<size_t> Shape;
+        std::vector<size_t> Count;
+        std::vector<size_t> Offsets;
+    };
+
     struct BP5VarRec
     {
         size_t VarNum;
@@ -103,12 +171,14 @@ private:
         int ElementSize = 0;
         size_t MinMaxOffset = SIZE_MAX;
         size_t *GlobalDims = NULL;
+        std::vector<size_t> GlobalDimsCopy; // with m_StepMetaDataAccess
         size_t LastTSAdded = SIZE_MAX;
         size_t FirstTSSeen = SIZE_MAX;
         size_t LastStepAdded = SIZE_MAX;
         std::vector<size_t> AbsStepFromRel; // per relative step vector
         std::vector<size_t> PerWriterMetaFieldOffset;
         std::vector<size_t> PerWriterBlockStart;
+        std::vector<std::shared_ptr<ArrayLayout>> PerWriterLayout;
     };
 
     struct ControlStruct
@@ -169,8 +239,30 @@ private:
     // for random access mode, for each timestep, for each writerrank, base
     // address of the metadata
     std::vector<std::vector<void *> *> MetadataBaseArray;
+    // layouts that delta entries of installed metadata point into
+    std::vector<std::shared_ptr<ArrayLayout>> m_DeltaLayouts;
+    /* with m_StepMetaDataAccess: the layout of each delta entry by (Step,
+     * WriterRank, VarNum) and the metadata decoded into allocated memory by
+     * step, to reinstall and to release the metadata of a step */
+    std::map<std::tuple<size_t, size_t, size_t>, std::shared_ptr<ArrayLayout>>
+        m_InstalledDeltaLayouts;
+    std::unordered_map<size_t, std::vector<void *>> m_DecodedMetaData;
+    // scratch buffers for decompressed blocks that are copied into a
+    // selection, shared by the threads calling FinalizeGet()
+    std::vector<std::vector<char>> m_DecompressBuffers;
+    std::mutex m_DecompressBuffersMutex;
+
+    // variable creation and m_DeltaLayouts when installing in threads
+    std::mutex m_InstallMutex;
 
     ControlInfo *ControlBlocks = nullptr;
+    ControlInfo *DecodeMetaData(void *MetadataBlock, size_t BlockLen,
+                                size_t WriterRank, size_t Step,
+                                void *&BaseData);
+    // of the variables with VarNum % VarStride == FirstVar only
+    void InstallVarMetaData(const ControlInfo *Control, void *BaseData,
+                            size_t WriterRank, size_t Step,
+                            const size_t FirstVar, const size_t VarStride);
     ControlInfo *GetPriorControl(FMFormat Format);
     ControlInfo *BuildControl(FMFormat Format);
     bool NameIndicatesArray(const char *Name);
@@ -179,7 +271,22 @@ private:
     BP5VarRec *LookupVarByKey(void *Key) const;
     BP5VarRec *LookupVarByName(const char *Name);
     BP5VarRec *CreateVarRec(const char *ArrayName);
+    void DecompressChunks(const char *Data, const uint64_t DataStart,
+                          const std::vector<uint64_t> &ChunkEnd,
+                          const size_t RowsPerChunk, const size_t FirstChunk,
+                          const size_t EndChunk, char *Dest,
+                          const size_t RowSize);
+    // a whole block, compressed in chunks or not
+    void DecompressBlock(const char *Data, const size_t Size, char *Dest,
+                         const size_t DestSize, const size_t Rows);
+    std::vector<char> AcquireDecompressBuffer(const size_t Size);
+    void ReleaseDecompressBuffer(std::vector<char> &&Buffer);
     void ReverseDimensions(size_t *Dimensions, int count, int times);
+    void SaveArrayLayout(BP5VarRec *VarRec, size_t WriterRank,
+                         const MetaArrayRec *MetaEntry);
+    void ApplyArrayLayout(BP5VarRec *VarRec, size_t WriterRank,
+                          MetaArrayRec *MetaEntry);
+    static void UseArrayLayout(ArrayLayout &Layout, MetaArrayRec *MetaEntry);
     void BreakdownVarName(const char *Name, char **base_name_p,
                           DataType *type_p, int *element_size_p);
     void BreakdownFieldType(const char *FieldType, bool &Operator,
@@ -220,13 +327,15 @@ private:
         void *Data;
     };
     std::vector<BP5ArrayRequest> PendingRequests;
+    void SelectedRows(const BP5ArrayRequest &Req, const MetaArrayRec *Meta,
+                      const size_t BlockID, size_t &FirstRow,
+                      size_t &EndRow) const;
+    bool PeekOperatorBlock(const BP5ArrayRequest &Req,
+                           const MetaArrayRecOperator *Meta,
+                           const size_t BlockID) const;
     void *GetMetadataBase(BP5VarRec *VarRec, size_t Step,
                           size_t WriterRank) const;
     size_t CurTimestep = 0;
-
-    /* We assume operators are not thread-safe, call Decompress() one at a time
-     */
-    std::mutex mutexDecompress;
 };
 
 } // end namespace format
@@ -12,11 +12,14 @@
 #include "adios2/core/VariableBase.h"
 #include "adios2/helper/adiosFunctions.h"
 #include "adios2/helper/adiosMemory.h"
+#include "adios2/operator/OperatorFactory.h"
 #include "adios2/toolkit/format/buffer/ffs/BufferFFS.h"
 
 #include <stddef.h> // max_align_t
 
 #include <cstring>
+#include <functional> // std::ref
+#include <future>
 
 #include "BP5Serializer.h"
 
@@ -513,6 +516,180 @@ void BP5Serializer::PerformPuts(bool forceCopyDeferred)
     DumpDeferredBlocks(true);
 }
 
+size_t BP5Serializer::OperateChunks(core::Operator &Op, const char *Data,
+                                    const Dims &Offsets, const Dims &Count,
+                                    const DataType Type, const size_t ElemSize,
+                                    size_t &DataOffset)
+{
+    // slabs of whole rows of the slowest dimension are contiguous in memory
+    const size_t ChunkDim = m_RowMajor ? 0 : Count.size() - 1;
+    const size_t Rows = Count[ChunkDim];
+    const size_t RowSize = helper::GetTotalSize(Count, ElemSize) / Rows;
+    size_t RowsPerChunk = m_OperatorChunkSize / RowSize;
+    if (RowsPerChunk * MaxOperatorChunks < Rows)
+    {
+        RowsPerChunk = (Rows + MaxOperatorChunks - 1) / MaxOperatorChunks;
+    }
+    if (RowsPerChunk == 0)
+    {
+        RowsPerChunk = 1;
+    }
+    const size_t ChunkCount = (Rows + RowsPerChunk - 1) / RowsPerChunk;
+    const size_t TableSize = OperatorChunksTableSize(ChunkCount);
+
+    // compress each chunk into its own slot, then pack them behind the table
+    const size_t SlotSize = RowsPerChunk * RowSize + 100;
+    const size_t AllocSize = TableSize + ChunkCount * SlotSize;
+    BufferV::BufferPos pos = CurDataBuffer->Allocate(AllocSize, ElemSize);
+    char *Block = (char *)GetPtr(pos.bufferIdx, pos.posInBuffer);
+    DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
+
+    std::vector<size_t> ChunkSize(ChunkCount);
+    auto lf_Compress = [&](core::Operator &ChunkOp, const size_t First,
+                           const size_t Stride) {
+        for (size_t c = First; c < ChunkCount; c += Stride)
+        {
+            Dims ChunkOffsets = Offsets;
+            Dims ChunkCounts = Count;
+            const size_t Row = c * RowsPerChunk;
+            ChunkCounts[ChunkDim] = std::min(RowsPerChunk, Rows - Row);
+            ChunkOffsets[ChunkDim] += Row;
+            ChunkSize[c] = ChunkOp.Operate(Data + Row * RowSize, ChunkOffsets,
+                                           ChunkCounts, Type,
+                                           Block + TableSize + c * SlotSize);
+        }
+    };
+    // every thread compresses with its own operator, and only codecs that
+    // keep no state outside of the operator are run concurrently
+    bool Reentrant = false;
+    switch (Op.m_TypeEnum)
+    {
+    case core::Operator::COMPRESS_BLOSC:
+    case core::Operator::COMPRESS_BZIP2:
+    case core::Operator::COMPRESS_PNG:
+    case core::Operator::COMPRESS_ZFP:
+    case core::Operator::COMPRESS_SHUFFLE:
+    case core::Operator::COMPRESS_NULL:
+        Reentrant = true;
+        break;
+    default:
+        break;
+    }
+    const size_t Threads =
+        Reentrant ? std::min(m_OperatorChunkThreads, ChunkCount) : 1;
+    if (Threads > 1)
+    {
+        std::vector<std::shared_ptr<core::Operator>> ThreadOps;
+        for (size_t t = 1; t < Threads; t++)
+        {
+            ThreadOps.push_back(
+                core::MakeOperator(Op.m_TypeString, Op.GetParameters()));
+        }
+        std::vector<std::future<void>> Futures;
+        for (size_t t = 1; t < Threads; t++)
+        {
+            Futures.push_back(std::async(std::launch::async, lf_Compress,
+                                         std::ref(*ThreadOps[t - 1]), t,
+                                         Threads));
+        }
+        lf_Compress(Op, 0, Threads);
+        for (auto &f : Futures)
+        {
+            f.get();
+        }
+    }
+    else
+    {
+        lf_Compress(Op, 0, 1);
+    }
+
+    OperatorChunksHeader Header = {OperatorChunksTag, OperatorChunksVersion, 0,
+                                   static_cast<uint32_t>(ChunkCount),
+                                   RowsPerChunk};
+    memcpy(Block, &Header, sizeof(Header));
+    uint64_t End = 0;
+    for (size_t c = 0; c < ChunkCount; c++)
+    {
+        memmove(Block + TableSize + End, Block + TableSize + c * SlotSize,
+                ChunkSize[c]);
+        End += ChunkSize[c];
+        memcpy(Block + sizeof(Header) + c * sizeof(uint64_t), &End,
+               sizeof(uint64_t));
+    }
+    CurDataBuffer->DownsizeLastAlloc(AllocSize, TableSize + End);
+    return TableSize + End;
+}
+
+BP5Serializer::KeyframeBlock *
+BP5Serializer::GetKeyframe(const BP5WriterRec Rec, const core::Operator &Op,
+                           const size_t Block)
+{
+    if (!m_KeyframeInterval)
+    {
+        return NULL;
+    }
+    // the keyframe must come back bit for bit
+    switch (Op.m_TypeEnum)
+    {
+    case core::Operator::COMPRESS_BLOSC:
+    case core::Operator::COMPRESS_BZIP2:
+    case core::Operator::COMPRESS_SHUFFLE:
+    case core::Operator::COMPRESS_NULL:
+        break;
+    default:
+        return NULL;
+    }
+    if (m_Keyframes.size() <= static_cast<size_t>(Rec->FieldID))
+    {
+        m_Keyframes.resize(Rec->FieldID + 1);
+    }
+    auto &Blocks = m_Keyframes[Rec->FieldID];
+    if (Blocks.size() <= Block)
+    {
+        Blocks.resize(Block + 1);
+    }
+    return &Blocks[Block];
+}
+
+bool BP5Serializer::OperateDelta(const KeyframeBlock &Keyframe,
+                                 core::Operator &Op, const char *Data,
+                                 const Dims &Offsets, const Dims &Count,
+                                 const DataType Type, const size_t ElemSize,
+                                 size_t &DataOffset, size_t &CompressedSize)
+{
+    if (Keyframe.Data.empty() || (Keyframe.Count != Count) ||
+        (m_WriterStep <= Keyframe.Step) ||
+        (m_WriterStep - Keyframe.Step >= m_KeyframeInterval))
+    {
+        return false;
+    }
+    const size_t Size = Keyframe.Data.size();
+    const size_t HeaderSize = sizeof(OperatorDeltaHeader);
+    m_DeltaBuffer.resize(2 * Size + HeaderSize + 100);
+    char *Diff = m_DeltaBuffer.data();
+    char *Out = Diff + Size;
+    XorBytes(Data, Keyframe.Data.data(), Diff, Size);
+    const size_t DeltaSize =
+        Op.Operate(Diff, Offsets, Count, Type, Out + HeaderSize);
+    // a reader of this step reads the keyframe block as well
+    if (DeltaSize > m_KeyframeDeltaRatio * Keyframe.Length)
+    {
+        return false;
+    }
+    OperatorDeltaHeader Header = {OperatorDeltaTag,
+                                  OperatorDeltaVersion,
+                                  {0},
+                                  Keyframe.Step,
+                                  Keyframe.Offset,
+                                  Keyframe.Length};
+    memcpy(Out, &Header, HeaderSize);
+    CompressedSize = HeaderSize + DeltaSize;
+    BufferV::BufferPos pos = CurDataBuffer->Allocate(CompressedSize, ElemSize);
+    memcpy(GetPtr(pos.bufferIdx, pos.posInBuffer), Out, CompressedSize);
+    DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
+    return true;
+}
+
 void BP5Serializer::DumpDeferredBlocks(bool forceCopyDeferred)
 {
     for (auto &Def : DeferredExterns)
@@ -656,16 +833,54 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
                 tmpCount.push_back(Count[i]);
                 tmpOffsets.push_back(Offsets[i]);
             }
-            size_t AllocSize = ElemCount * ElemSize + 100;
-            BufferV::BufferPos pos =
-                CurDataBuffer->Allocate(AllocSize, ElemSize);
-            char *CompressedData =
-                (char *)GetPtr(pos.bufferIdx, pos.posInBuffer);
-            DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
-            CompressedSize = VB->m_Operations[0]->Operate(
-                (const char *)Data, tmpOffsets, tmpCount, (DataType)Rec->Type,
-                CompressedData);
-            CurDataBuffer->DownsizeLastAlloc(AllocSize, CompressedSize);
+            KeyframeBlock *Keyframe = NULL;
+            if (MemSpace == MemorySpace::Host)
+            {
+                Keyframe =
+                    GetKeyframe(Rec, *VB->m_Operations[0],
+                                AlreadyWritten ? MetaEntry->BlockCount : 0);
+            }
+            bool Delta = false;
+            if (Keyframe)
+            {
+                Delta = OperateDelta(*Keyframe, *VB->m_Operations[0],
+                                     (const char *)Data, tmpOffsets, tmpCount,
+                                     (DataType)Rec->Type, ElemSize,
+                                     DataOffset, CompressedSize);
+            }
+            // sirius hands the tiers of one block to its sub-engines in turn
+            if (!Delta && m_OperatorChunkSize &&
+                (ElemCount * ElemSize > m_OperatorChunkSize) &&
+                (VB->m_Operations[0]->m_TypeEnum !=
+                 core::Operator::COMPRESS_SIRIUS))
+            {
+                CompressedSize = OperateChunks(
+                    *VB->m_Operations[0], (const char *)Data, tmpOffsets,
+                    tmpCount, (DataType)Rec->Type, ElemSize, DataOffset);
+            }
+            else if (!Delta)
+            {
+                size_t AllocSize = ElemCount * ElemSize + 100;
+                BufferV::BufferPos pos =
+                    CurDataBuffer->Allocate(AllocSize, ElemSize);
+                char *CompressedData =
+                    (char *)GetPtr(pos.bufferIdx, pos.posInBuffer);
+                DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
+                CompressedSize = VB->m_Operations[0]->Operate(
+                    (const char *)Data, tmpOffsets, tmpCount,
+                    (DataType)Rec->Type, CompressedData);
+                CurDataBuffer->DownsizeLastAlloc(AllocSize, CompressedSize);
+            }
+            if (Keyframe && !Delta)
+            {
+                Keyframe->Data.assign((const char *)Data,
+                                      (const char *)Data +
+                                          ElemCount * ElemSize);
+                Keyframe->Count = tmpCount;
+                Keyframe->Step = m_WriterStep;
+                Keyframe->Offset = DataOffset;
+                Keyframe->Length = CompressedSize;
+            }
         }
         else if (Span == nullptr)
         {
@@ -682,14 +897,35 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
             DataOffset = m_PriorDataBufferSizeTotal + Span->globalPos;
         }
 
+        PriorArrayLayout *Layout = GetPriorLayout(Rec);
         if (!AlreadyWritten)
         {
-            if (Shape)
-                MetaEntry->Shape = CopyDims(DimCount, Shape);
+            if (Layout && MatchesPriorLayout(*Layout, 0, DimCount, Shape,
+                                             Count, Offsets))
+            {
+                /* steady state, refer to the layout of the prior step */
+                Layout->Matching = true;
+                MetaEntry->Shape =
+                    Layout->HasShape ? Layout->Shape.data() : NULL;
+                MetaEntry->Count = Layout->Count.data();
+                MetaEntry->Offsets =
+                    Layout->HasOffsets ? Layout->Offsets.data() : NULL;
+            }
             else
-                MetaEntry->Shape = NULL;
+            {
+                if (Layout)
+                    Layout->Matching = false;
+                if (Shape)
+                    MetaEntry->Shape = CopyDims(DimCount, Shape);
+                else
+                    MetaEntry->Shape = NULL;
+                MetaEntry->Count = CopyDims(DimCount, Count);
+                if (Offsets)
+                    MetaEntry->Offsets = CopyDims(DimCount, Offsets);
+                else
+                    MetaEntry->Offsets = NULL;
+            }
             MetaEntry->DBCount = DimCount;
-            MetaEntry->Count = CopyDims(DimCount, Count);
             MetaEntry->BlockCount = 1;
             MetaEntry->DataBlockLocation = (size_t *)malloc(sizeof(size_t));
             MetaEntry->DataBlockLocation[0] = DataOffset;
@@ -700,10 +936,6 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
                 OpEntry->DataBlockSize = (size_t *)malloc(sizeof(size_t));
                 OpEntry->DataBlockSize[0] = CompressedSize;
             }
-            if (Offsets)
-                MetaEntry->Offsets = CopyDims(DimCount, Offsets);
-            else
-                MetaEntry->Offsets = NULL;
             if (m_StatsLevel > 0)
             {
                 void **MMPtrLoc =
@@ -724,19 +956,31 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
         {
             /* already got some metadata, add blocks */
             size_t PreviousDBCount = MetaEntry->DBCount;
+            bool SharedLayout = false;
+            if (Layout && Layout->Matching)
+            {
+                SharedLayout =
+                    MatchesPriorLayout(*Layout, MetaEntry->BlockCount,
+                                       DimCount, Shape, Count, Offsets);
+                if (!SharedLayout)
+                {
+                    UnsharePriorLayout(MetaEntry, *Layout);
+                }
+            }
             //  Assume shape is still valid   (modify this if shape /global
             //  dimensions can change )
             // Also assume Dims is always right and consistent, otherwise,
             // bad things
-            if (Shape && MetaEntry->Shape)
+            if (Shape && MetaEntry->Shape && !SharedLayout)
             {
                 // Shape can change with later writes, so must overwrite
                 memcpy(MetaEntry->Shape, Shape, DimCount * sizeof(Shape[0]));
             }
             MetaEntry->DBCount += DimCount;
             MetaEntry->BlockCount++;
-            MetaEntry->Count =
-                AppendDims(MetaEntry->Count, PreviousDBCount, DimCount, Count);
+            if (!SharedLayout)
+                MetaEntry->Count = AppendDims(MetaEntry->Count,
+                                              PreviousDBCount, DimCount, Count);
             MetaEntry->DataBlockLocation =
                 (size_t *)realloc(MetaEntry->DataBlockLocation,
                                   MetaEntry->BlockCount * sizeof(size_t));
@@ -771,13 +1015,136 @@ void BP5Serializer::Marshal(void *Variable, const char *Name,
                                            MetaEntry->BlockCount - 1, Data,
                                            ElemCount * ElemSize, ElemSize});
             }
-            if (Offsets)
+            if (Offsets && !SharedLayout)
                 MetaEntry->Offsets = AppendDims(
                     MetaEntry->Offsets, PreviousDBCount, DimCount, Offsets);
         }
     }
 }
 
+BP5Serializer::PriorArrayLayout *
+BP5Serializer::GetPriorLayout(const BP5WriterRec Rec)
+{
+    if (!m_MetadataDelta || (Rec->DimCount == 0))
+    {
+        return NULL;
+    }
+    if (m_PriorLayouts.size() <= static_cast<size_t>(Rec->FieldID))
+    {
+        m_PriorLayouts.resize(Rec->FieldID + 1);
+    }
+    return &m_PriorLayouts[Rec->FieldID];
+}
+
+bool BP5Serializer::MatchesPriorLayout(const PriorArrayLayout &Layout,
+                                       size_t Block, size_t DimCount,
+                                       const size_t *Shape, const size_t *Count,
+                                       const size_t *Offsets) const
+{
+    if ((Block >= Layout.BlockCount) || (DimCount != Layout.Dims) ||
+        ((Shape != NULL) != Layout.HasShape) ||
+        ((Offsets != NULL) != Layout.HasOffsets))
+    {
+        return false;
+    }
+    const size_t DimBytes = DimCount * sizeof(size_t);
+    if (Shape && memcmp(Shape, Layout.Shape.data(), DimBytes))
+    {
+        return false;
+    }
+    if (memcmp(Count, Layout.Count.data() + Block * DimCount, DimBytes))
+    {
+        return false;
+    }
+    if (Offsets &&
+        memcmp(Offsets, Layout.Offsets.data() + Block * DimCount, DimBytes))
+    {
+        return false;
+    }
+    return true;
+}
+
+void BP5Serializer::UnsharePriorLayout(MetaArrayRec *MetaEntry,
+                                       PriorArrayLayout &Layout)
+{
+    /* the step diverges from the prior layout, make the entry own copies of
+     * the blocks matched so far */
+    if (MetaEntry->Shape)
+        MetaEntry->Shape = CopyDims(MetaEntry->Dims, MetaEntry->Shape);
+    MetaEntry->Count = CopyDims(MetaEntry->DBCount, MetaEntry->Count);
+    if (MetaEntry->Offsets)
+        MetaEntry->Offsets = CopyDims(MetaEntry->DBCount, MetaEntry->Offsets);
+    Layout.Matching = false;
+}
+
+void BP5Serializer::MarkMetadataDeltas()
+{
+    BP5MetadataInfoStruct *MBase = (BP5MetadataInfoStruct *)MetadataBuf;
+    for (int i = 0; i < Info.RecCount; i++)
+    {
+        BP5WriterRec Rec = &Info.RecList[i];
+        PriorArrayLayout *Layout = GetPriorLayout(Rec);
+        if (!Layout || !Layout->Matching ||
+            !BP5BitfieldTest(MBase, Rec->FieldID))
+        {
+            continue;
+        }
+        MetaArrayRec *MetaEntry =
+            (MetaArrayRec *)((char *)(MetadataBuf) + Rec->MetaOffset);
+        if (MetaEntry->BlockCount == Layout->BlockCount)
+        {
+            /* Dims == 0 tells the reader to take Shape, Count and Offsets
+             * from the last full entry of this writer */
+            MetaEntry->Dims = 0;
+            MetaEntry->DBCount = 0;
+        }
+    }
+}
+
+void BP5Serializer::SavePriorLayouts()
+{
+    BP5MetadataInfoStruct *MBase = (BP5MetadataInfoStruct *)MetadataBuf;
+    for (int i = 0; i < Info.RecCount; i++)
+    {
+        BP5WriterRec Rec = &Info.RecList[i];
+        PriorArrayLayout *Layout = GetPriorLayout(Rec);
+        if (!Layout || !BP5BitfieldTest(MBase, Rec->FieldID))
+        {
+            continue;
+        }
+        MetaArrayRec *MetaEntry =
+            (MetaArrayRec *)((char *)(MetadataBuf) + Rec->MetaOffset);
+        if (Layout->Matching)
+        {
+            /* a full entry was sent if only the first blocks matched */
+            Layout->BlockCount = MetaEntry->BlockCount;
+            Layout->Count.resize(Layout->BlockCount * Layout->Dims);
+            if (Layout->HasOffsets)
+                Layout->Offsets.resize(Layout->BlockCount * Layout->Dims);
+            /* the arrays belong to the layout, not to the entry */
+            MetaEntry->Shape = NULL;
+            MetaEntry->Count = NULL;
+            MetaEntry->Offsets = NULL;
+            Layout->Matching = false;
+        }
+        else
+        {
+            Layout->Dims = MetaEntry->Dims;
+            Layout->BlockCount = MetaEntry->BlockCount;
+            Layout->HasShape = (MetaEntry->Shape != NULL);
+            Layout->HasOffsets = (MetaEntry->Offsets != NULL);
+            if (MetaEntry->Shape)
+                Layout->Shape.assign(MetaEntry->Shape,
+                                     MetaEntry->Shape + MetaEntry->Dims);
+            Layout->Count.assign(MetaEntry->Count,
+                                 MetaEntry->Count + MetaEntry->DBCount);
+            if (MetaEntry->Offsets)
+                Layout->Offsets.assign(MetaEntry->Offsets,
+                                       MetaEntry->Offsets + MetaEntry->DBCount);
+        }
+    }
+}
+
 void BP5Serializer::MarshalAttribute(const char *Name, const DataType Type,
                                      size_t ElemSize, size_t ElemCount,
                                      const void *Data)
@@ -960,8 +1327,14 @@ BP5Serializer::TimestepInfo BP5Serializer::CloseTimestep(int timestep,
 
     MBase->DataBlockSize += m_PriorDataBufferSizeTotal;
 
+    if (m_MetadataDelta)
+        MarkMetadataDeltas();
+
     void *MetaDataBlock = FFSencode(MetaEncodeBuffer, Info.MetaFormat,
                                     MetadataBuf, &MetaDataSize);
+
+    if (m_MetadataDelta)
+        SavePriorLayouts();
     BufferFFS *Metadata =
         new BufferFFS(MetaEncodeBuffer, MetaDataBlock, MetaDataSize);
 
@@ -110,6 +110,27 @@ public:
 
     int m_StatsLevel = 1;
 
+    /* Send only the data locations (and stats) of arrays whose Shape, Count
+     * and Offsets are the same as in the prior step of this writer.
+     * Readers must see every step to reconstruct the metadata. */
+    bool m_MetadataDelta = false;
+
+    /* Compress blocks of variables with an operator in independent chunks
+     * of about this many bytes along the slowest dimension (0: whole
+     * blocks), using up to m_OperatorChunkThreads threads */
+    size_t m_OperatorChunkSize = 0;
+    size_t m_OperatorChunkThreads = 1;
+    bool m_RowMajor = true; // ordering of the writer's arrays in memory
+
+    /* Store blocks of variables with a lossless operator as their difference
+     * to the same block of a keyframe step, written at least every
+     * m_KeyframeInterval steps (0: never) and whenever the difference would
+     * compress to more than m_KeyframeDeltaRatio times the keyframe block.
+     * m_WriterStep is the absolute step in the file. */
+    size_t m_KeyframeInterval = 0;
+    float m_KeyframeDeltaRatio = 0.5f;
+    size_t m_WriterStep = 0;
+
     /* Variables to help appending to existing file */
     size_t m_PreMetaMetadataFileLength = 0;
 
@@ -166,6 +187,36 @@ private:
 
     std::vector<MetaMetaInfoBlock> PreviousMetaMetaInfoBlocks;
 
+    /* Layout of an array in the last step it was written, with
+     * m_MetadataDelta.  While the blocks of the current step repeat it, the
+     * metadata entry points into these arrays instead of owning copies. */
+    struct PriorArrayLayout
+    {
+        size_t Dims = 0;
+        size_t BlockCount = 0;
+        bool HasShape = false;
+        bool HasOffsets = false;
+        std::vector<size_t> Shape;
+        std::vector<size_t> Count;   // [Dims * BlockCount]
+        std::vector<size_t> Offsets; // [Dims * BlockCount]
+        bool Matching = false;
+    };
+    std::vector<PriorArrayLayout> m_PriorLayouts; // indexed by FieldID
+
+    /* A block as put in its last keyframe step, with m_KeyframeInterval,
+     * and where it went in the data of that step */
+    struct KeyframeBlock
+    {
+        std::vector<char> Data;
+        std::vector<size_t> Count;
+        size_t Step = 0;
+        size_t Offset = 0;
+        size_t Length = 0;
+    };
+    // indexed by FieldID, then by block of the writer in a step
+    std::vector<std::vector<KeyframeBlock>> m_Keyframes;
+    std::vector<char> m_DeltaBuffer;
+
     size_t m_PriorDataBufferSizeTotal = 0;
 
     BP5WriterRec LookupWriterRec(void *Key);
@@ -202,6 +253,24 @@ private:
                        const size_t Count, const size_t *Vals);
 
     void DumpDeferredBlocks(bool forceCopyDeferred = false);
+    size_t OperateChunks(core::Operator &Op, const char *Data,
+                         const Dims &Offsets, const Dims &Count,
+                         const DataType Type, const size_t ElemSize,
+                         size_t &DataOffset);
+    KeyframeBlock *GetKeyframe(const BP5WriterRec Rec,
+                               const core::Operator &Op, const size_t Block);
+    bool OperateDelta(const KeyframeBlock &Keyframe, core::Operator &Op,
+                      const char *Data, const Dims &Offsets,
+                      const Dims &Count, const DataType Type,
+                      const size_t ElemSize, size_t &DataOffset,
+                      size_t &CompressedSize);
+    PriorArrayLayout *GetPriorLayout(const BP5WriterRec Rec);
+    bool MatchesPriorLayout(const PriorArrayLayout &Layout, size_t Block,
+                            size_t DimCount, const size_t *Shape,
+                            const size_t *Count, const size_t *Offsets) const;
+    void UnsharePriorLayout(MetaArrayRec *MetaEntry, PriorArrayLayout &Layout);
+    void MarkMetadataDeltas();
+    void SavePriorLayouts();
     void VariableStatsEnabled(void *Variable);
 
     typedef struct _ArrayRec
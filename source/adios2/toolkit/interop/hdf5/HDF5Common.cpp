@@ -11,6 +11,7 @@
 #include "HDF5Common.h"
 #include "HDF5Common.tcc"
 
+#include <algorithm>
 #include <complex>
 #include <ios>
 #include <iostream>
@@ -49,6 +50,12 @@ const std::string HDF5Common::PARAMETER_COLLECTIVE = "H5CollectiveMPIO";
 const std::string HDF5Common::PARAMETER_CHUNK_FLAG = "H5ChunkDim";
 const std::string HDF5Common::PARAMETER_CHUNK_VARS = "H5ChunkVars";
 const std::string HDF5Common::PARAMETER_HAS_IDLE_WRITER_RANK = "IdleH5Writer";
+const std::string HDF5Common::PARAMETER_ALIGNMENT = "H5Alignment";
+const std::string HDF5Common::PARAMETER_METADATA_CACHE_SIZE =
+    "H5MetadataCacheSize";
+const std::string HDF5Common::PARAMETER_PAGE_SIZE = "H5PageSize";
+const std::string HDF5Common::PARAMETER_PAGE_BUFFER_SIZE = "H5PageBufferSize";
+const std::string HDF5Common::PARAMETER_LAYOUT = "H5Layout";
 
 #define CHECK_H5_RETURN(returnCode, reason)                                    \
     {                                                                          \
@@ -95,6 +102,100 @@ HDF5Common::HDF5Common()
 
 HDF5Common::~HDF5Common() { Close(); }
 
+void HDF5Common::ParseFileParameters(core::IO &io)
+{
+    auto itKey = io.m_Parameters.find(PARAMETER_ALIGNMENT);
+    if (itKey != io.m_Parameters.end())
+    { // "alignment" or "threshold alignment", space is the delimiter
+        std::vector<hsize_t> values;
+        std::stringstream ss(itKey->second);
+        std::string token;
+        while (ss >> token)
+            values.push_back(helper::StringToByteUnits(
+                token, "for Parameter key=" + PARAMETER_ALIGNMENT));
+
+        if (values.empty() || values.size() > 2 || values.back() == 0)
+            helper::Throw<std::invalid_argument>(
+                "Toolkit", "interop::hdf5::HDF5Common", "ParseFileParameters",
+                PARAMETER_ALIGNMENT + " must be \"alignment\" or "
+                                      "\"threshold alignment\", found \"" +
+                    itKey->second + "\", in call to Open");
+        m_Alignment = values.back();
+        m_AlignThreshold = values.size() == 2 ? values.front() : 1;
+    }
+
+    itKey = io.m_Parameters.find(PARAMETER_METADATA_CACHE_SIZE);
+    if (itKey != io.m_Parameters.end())
+        m_MetadataCacheSize = helper::StringToByteUnits(
+            itKey->second,
+            "for Parameter key=" + PARAMETER_METADATA_CACHE_SIZE);
+
+    itKey = io.m_Parameters.find(PARAMETER_PAGE_SIZE);
+    if (itKey != io.m_Parameters.end())
+        m_PageSize = helper::StringToByteUnits(
+            itKey->second, "for Parameter key=" + PARAMETER_PAGE_SIZE);
+
+    itKey = io.m_Parameters.find(PARAMETER_PAGE_BUFFER_SIZE);
+    if (itKey != io.m_Parameters.end())
+        m_PageBufferSize = helper::StringToByteUnits(
+            itKey->second, "for Parameter key=" + PARAMETER_PAGE_BUFFER_SIZE);
+
+#if H5_VERSION_GE(1, 10, 1)
+    // the page buffer holds at least one page, 4 KiB is the HDF5 default
+    const size_t pageSize = m_PageSize > 0 ? m_PageSize : 4096;
+    if (m_PageBufferSize > 0 && m_PageBufferSize < pageSize)
+        helper::Throw<std::invalid_argument>(
+            "Toolkit", "interop::hdf5::HDF5Common", "ParseFileParameters",
+            PARAMETER_PAGE_BUFFER_SIZE + " must be at least one page of " +
+                std::to_string(pageSize) + " bytes, in call to Open");
+#else
+    if (m_PageSize > 0 || m_PageBufferSize > 0)
+        helper::Throw<std::invalid_argument>(
+            "Toolkit", "interop::hdf5::HDF5Common", "ParseFileParameters",
+            PARAMETER_PAGE_SIZE + " and " + PARAMETER_PAGE_BUFFER_SIZE +
+                " require HDF5 1.10.1 or later, in call to Open");
+#endif
+}
+
+void HDF5Common::SetFileAccessProperties(hid_t accessPID)
+{
+    herr_t ret;
+    if (m_Alignment > 1)
+    {
+        ret = H5Pset_alignment(accessPID, m_AlignThreshold, m_Alignment);
+        CHECK_H5_RETURN(ret, "SetFileAccessProperties, H5Pset_alignment");
+    }
+
+    if (m_MetadataCacheSize > 0)
+    {
+        H5AC_cache_config_t config;
+        config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+        ret = H5Pget_mdc_config(accessPID, &config);
+        CHECK_H5_RETURN(ret, "SetFileAccessProperties, H5Pget_mdc_config");
+        config.set_initial_size = true;
+        config.initial_size = m_MetadataCacheSize;
+        config.min_size = std::min(config.min_size, m_MetadataCacheSize);
+        config.max_size = std::max(config.max_size, m_MetadataCacheSize);
+        ret = H5Pset_mdc_config(accessPID, &config);
+        CHECK_H5_RETURN(ret, "SetFileAccessProperties, H5Pset_mdc_config");
+    }
+
+#if H5_VERSION_GE(1, 10, 1)
+    if (m_PageBufferSize > 0)
+    {
+        if (m_CommSize > 1)
+            helper::Throw<std::invalid_argument>(
+                "Toolkit", "interop::hdf5::HDF5Common",
+                "SetFileAccessProperties",
+                PARAMETER_PAGE_BUFFER_SIZE +
+                    " is not supported by parallel HDF5, in call to Open");
+        ret = H5Pset_page_buffer_size(accessPID, m_PageBufferSize, 0, 0);
+        CHECK_H5_RETURN(ret,
+                        "SetFileAccessProperties, H5Pset_page_buffer_size");
+    }
+#endif
+}
+
 void HDF5Common::ParseParameters(core::IO &io)
 {
     if (m_MPI)
@@ -119,11 +220,17 @@ void HDF5Common::ParseParameters(core::IO &io)
     m_ChunkVarNames.clear();
     m_ChunkPID = -1;
     m_ChunkDim = 0;
+    m_ChunkAuto = false;
 
     {
         std::vector<hsize_t> chunkDim;
         auto chunkFlagKey = io.m_Parameters.find(PARAMETER_CHUNK_FLAG);
-        if (chunkFlagKey != io.m_Parameters.end())
+        if (chunkFlagKey != io.m_Parameters.end() &&
+            chunkFlagKey->second == "auto")
+        {
+            m_ChunkAuto = true;
+        }
+        else if (chunkFlagKey != io.m_Parameters.end())
         { // note space is the delimiter
             std::stringstream ss(chunkFlagKey->second);
             int i;
@@ -140,7 +247,7 @@ void HDF5Common::ParseParameters(core::IO &io)
     //
     // if no chunk dim specified, then ignore this parameter
     //
-    if (-1 != m_ChunkPID)
+    if (-1 != m_ChunkPID || m_ChunkAuto)
     {
         auto chunkVarKey = io.m_Parameters.find(PARAMETER_CHUNK_VARS);
         if (chunkVarKey != io.m_Parameters.end())
@@ -152,6 +259,29 @@ void HDF5Common::ParseParameters(core::IO &io)
         }
     }
 
+    m_Layout = H5D_LAYOUT_ERROR;
+    auto layoutKey = io.m_Parameters.find(PARAMETER_LAYOUT);
+    if (layoutKey != io.m_Parameters.end())
+    {
+        if (layoutKey->second == "compact")
+            m_Layout = H5D_COMPACT;
+        else if (layoutKey->second == "contiguous")
+            m_Layout = H5D_CONTIGUOUS;
+        else if (layoutKey->second != "default")
+            helper::Throw<std::invalid_argument>(
+                "Toolkit", "interop::hdf5::HDF5Common", "ParseParameters",
+                PARAMETER_LAYOUT + " must be compact, contiguous or default, " +
+                    "found \"" + layoutKey->second + "\", in call to Open");
+
+        // every rank writes its own block, but all ranks would have to
+        // write the same data into the object header of a compact dataset
+        if (m_Layout == H5D_COMPACT && m_CommSize > 1)
+            helper::Throw<std::invalid_argument>(
+                "Toolkit", "interop::hdf5::HDF5Common", "ParseParameters",
+                PARAMETER_LAYOUT + "=compact is only supported by a single "
+                                   "writer, in call to Open");
+    }
+
     m_OrderByC = (io.m_ArrayOrder == ArrayOrdering::RowMajor);
 }
 
@@ -166,6 +296,8 @@ void HDF5Common::Append(const std::string &name, helper::Comm const &comm)
             m_MPI = mpi;
         }
     }
+    m_Comm = &comm;
+    SetFileAccessProperties(m_PropertyListId);
 
     m_FileId = H5Fopen(name.c_str(), H5F_ACC_RDWR, m_PropertyListId);
     H5Pclose(m_PropertyListId);
@@ -217,6 +349,8 @@ void HDF5Common::Init(const std::string &name, helper::Comm const &comm,
             m_MPI = mpi;
         }
     }
+    m_Comm = &comm;
+    SetFileAccessProperties(m_PropertyListId);
 
     // std::string ts0 = "/AdiosStep0";
     std::string ts0;
@@ -227,8 +361,22 @@ void HDF5Common::Init(const std::string &name, helper::Comm const &comm,
         /*
          * Create a new file collectively and release property list identifier.
          */
-        m_FileId = H5Fcreate(name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
+        hid_t createPID = H5P_DEFAULT;
+#if H5_VERSION_GE(1, 10, 1)
+        if (m_PageSize > 0)
+        { // paged aggregation of file space, required by the page buffer
+            createPID = H5Pcreate(H5P_FILE_CREATE);
+            herr_t ret = H5Pset_file_space_strategy(
+                createPID, H5F_FSPACE_STRATEGY_PAGE, 0, 1);
+            CHECK_H5_RETURN(ret, "Init, H5Pset_file_space_strategy");
+            ret = H5Pset_file_space_page_size(createPID, m_PageSize);
+            CHECK_H5_RETURN(ret, "Init, H5Pset_file_space_page_size");
+        }
+#endif
+        m_FileId = H5Fcreate(name.c_str(), H5F_ACC_TRUNC, createPID,
                              m_PropertyListId);
+        if (createPID != H5P_DEFAULT)
+            H5Pclose(createPID);
         if (m_FileId >= 0)
         {
             m_GroupId = H5Gcreate2(m_FileId, ts0.c_str(), H5P_DEFAULT,
@@ -977,9 +1125,82 @@ hid_t HDF5Common::GetTypeStringScalar(const std::string &input)
     return type;
 }
 
+hid_t HDF5Common::CreateDatasetProperties(
+    const std::string &varName, hid_t h5Type, hid_t filespaceID,
+    const std::vector<hsize_t> &blockCount)
+{
+    const bool chunkVar =
+        m_ChunkVarNames.empty() ||
+        m_ChunkVarNames.find(varName) != m_ChunkVarNames.end();
+    if (-1 != m_ChunkPID && chunkVar)
+        return m_ChunkPID;
+
+    herr_t ret;
+    const int ndims = H5Sget_simple_extent_ndims(filespaceID);
+    if (m_ChunkAuto && chunkVar && ndims > 0 &&
+        blockCount.size() == static_cast<size_t>(ndims))
+    {
+        std::vector<hsize_t> dims(ndims);
+        H5Sget_simple_extent_dims(filespaceID, dims.data(), NULL);
+
+        // the chunk shape is part of the dataset creation, which is
+        // collective, so take the largest Count of all ranks
+        std::vector<size_t> localCount(blockCount.begin(), blockCount.end());
+        std::vector<size_t> maxCount(ndims);
+        m_Comm->Allreduce(localCount.data(), maxCount.data(), ndims,
+                          helper::Comm::Op::Max);
+
+        std::vector<hsize_t> chunk(ndims);
+        hsize_t chunkBytes = H5Tget_size(h5Type);
+        for (int i = 0; i < ndims; ++i)
+        {
+            if (dims[i] == 0) // fixed size dimensions cannot be chunked
+                return H5P_DEFAULT;
+            chunk[i] = std::max<hsize_t>(
+                1, std::min<hsize_t>(maxCount[i], dims[i]));
+            chunkBytes *= chunk[i];
+        }
+
+        // chunks are limited to 4 GiB, halve the largest dimension
+        const hsize_t maxChunkBytes = (hsize_t(1) << 32) - 1;
+        while (chunkBytes > maxChunkBytes)
+        {
+            auto itMax = std::max_element(chunk.begin(), chunk.end());
+            chunkBytes = chunkBytes / *itMax * ((*itMax + 1) / 2);
+            *itMax = (*itMax + 1) / 2;
+        }
+
+        hid_t chunkPID = H5Pcreate(H5P_DATASET_CREATE);
+        ret = H5Pset_chunk(chunkPID, ndims, chunk.data());
+        CHECK_H5_RETURN(ret, "CreateDatasetProperties, H5Pset_chunk");
+        return chunkPID;
+    }
+
+    if (m_Layout == H5D_LAYOUT_ERROR)
+        return H5P_DEFAULT;
+
+    // the raw data of a compact dataset is stored in its object header,
+    // which is limited to 64 KiB, larger datasets fall back to contiguous
+    H5D_layout_t layout = m_Layout;
+    const hsize_t compactLimit = 60 * 1024;
+    if (layout == H5D_COMPACT &&
+        H5Sget_simple_extent_npoints(filespaceID) * H5Tget_size(h5Type) >
+            compactLimit)
+        layout = H5D_CONTIGUOUS;
+
+    hid_t layoutPID = H5Pcreate(H5P_DATASET_CREATE);
+    ret = H5Pset_layout(layoutPID, layout);
+    CHECK_H5_RETURN(ret, "CreateDatasetProperties, H5Pset_layout");
+    // blocks are written in full, skip writing fill values first
+    ret = H5Pset_fill_time(layoutPID, H5D_FILL_TIME_NEVER);
+    CHECK_H5_RETURN(ret, "CreateDatasetProperties, H5Pset_fill_time");
+    return layoutPID;
+}
+
 void HDF5Common::CreateDataset(const std::string &varName, hid_t h5Type,
                                hid_t filespaceID,
-                               std::vector<hid_t> &datasetChain)
+                               std::vector<hid_t> &datasetChain,
+                               const std::vector<hsize_t> &blockCount)
 {
     std::vector<std::string> list;
     char delimiter = '/';
@@ -1016,15 +1237,6 @@ void HDF5Common::CreateDataset(const std::string &varName, hid_t h5Type,
         }
     }
 
-    hid_t varCreateProperty = H5P_DEFAULT;
-    if (-1 != m_ChunkPID)
-    {
-        if (m_ChunkVarNames.size() == 0) // applies to all var
-            varCreateProperty = m_ChunkPID;
-        else if (m_ChunkVarNames.find(varName) != m_ChunkVarNames.end())
-            varCreateProperty = m_ChunkPID;
-    }
-
     /*
     hid_t dsetID = H5Dcreate(topId, list.back().c_str(), h5Type, filespaceID,
                              H5P_DEFAULT, varCreateProperty, H5P_DEFAULT);
@@ -1033,8 +1245,12 @@ void HDF5Common::CreateDataset(const std::string &varName, hid_t h5Type,
     hid_t dsetID = -1;
     if (H5Lexists(topId, list.back().c_str(), H5P_DEFAULT) == 0)
     {
+        hid_t varCreateProperty = CreateDatasetProperties(
+            varName, h5Type, filespaceID, blockCount);
         dsetID = H5Dcreate(topId, list.back().c_str(), h5Type, filespaceID,
                            H5P_DEFAULT, varCreateProperty, H5P_DEFAULT);
+        if (varCreateProperty != H5P_DEFAULT && varCreateProperty != m_ChunkPID)
+            H5Pclose(varCreateProperty);
         if (list.back().compare(varName) != 0)
         {
             StoreADIOSName(varName, dsetID); // only stores when not the same
@@ -127,7 +127,14 @@ public:
     static const std::string PARAMETER_CHUNK_FLAG;
     static const std::string PARAMETER_CHUNK_VARS;
     static const std::string PARAMETER_HAS_IDLE_WRITER_RANK;
-
+    static const std::string PARAMETER_ALIGNMENT;
+    static const std::string PARAMETER_METADATA_CACHE_SIZE;
+    static const std::string PARAMETER_PAGE_SIZE;
+    static const std::string PARAMETER_PAGE_BUFFER_SIZE;
+    static const std::string PARAMETER_LAYOUT;
+
+    /** file access and creation options, must be called before Init/Append */
+    void ParseFileParameters(core::IO &io);
     void ParseParameters(core::IO &io);
     void Init(const std::string &name, helper::Comm const &comm, bool toWrite);
     void Append(const std::string &name, helper::Comm const &comm);
@@ -144,8 +151,11 @@ public:
     template <class T>
     void DefineDataset(core::Variable<T> &variable);
 
-    void CreateDataset(const std::string &varName, hid_t h5Type,
-                       hid_t filespaceID, std::vector<hid_t> &chain);
+    /** blockCount is this rank's Count, used by H5ChunkDim=auto */
+    void CreateDataset(
+        const std::string &varName, hid_t h5Type, hid_t filespaceID,
+        std::vector<hid_t> &chain,
+        const std::vector<hsize_t> &blockCount = std::vector<hsize_t>());
     bool OpenDataset(const std::string &varName, std::vector<hid_t> &chain);
     void RemoveEmptyDataset(const std::string &varName);
     void StoreADIOSName(const std::string adiosName, hid_t dsetID);
@@ -268,7 +278,23 @@ private:
 
     hid_t m_ChunkPID;
     int m_ChunkDim;
+    bool m_ChunkAuto = false; // chunk shape from the Count of each variable
     std::set<std::string> m_ChunkVarNames;
+
+    // H5D_LAYOUT_ERROR means the HDF5 default layout
+    H5D_layout_t m_Layout = H5D_LAYOUT_ERROR;
+
+    hsize_t m_AlignThreshold = 1;
+    hsize_t m_Alignment = 1;
+    size_t m_MetadataCacheSize = 0;
+    size_t m_PageSize = 0;
+    size_t m_PageBufferSize = 0;
+    helper::Comm const *m_Comm = nullptr;
+
+    void SetFileAccessProperties(hid_t accessPID);
+    hid_t CreateDatasetProperties(const std::string &varName,
+                                  hid_t h5Type, hid_t filespaceID,
+                                  const std::vector<hsize_t> &blockCount);
     bool m_OrderByC = true; // C or fortran
 
     // Some write rank can be idle. This causes conflict with HDF5 collective
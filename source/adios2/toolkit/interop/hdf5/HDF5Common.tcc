@@ -47,7 +47,7 @@ void HDF5Common::DefineDataset(core::Variable<T> &variable)
     HDF5TypeGuard fs(fileSpace, E_H5_SPACE);
 
     std::vector<hid_t> chain;
-    CreateDataset(variable.m_Name, h5Type, fileSpace, chain);
+    CreateDataset(variable.m_Name, h5Type, fileSpace, chain, count);
     HDF5DatasetGuard g(chain);
 }
 
@@ -181,7 +181,7 @@ void HDF5Common::Write(core::Variable<T> &variable, const T *values)
 #ifndef RELAY_DEFINE_TO_HDF5 // RELAY_DEFINE_TO_HDF5 = variables in io are
                              // created at begin_step
     std::vector<hid_t> chain;
-    CreateDataset(variable.m_Name, h5Type, fileSpace, chain);
+    CreateDataset(variable.m_Name, h5Type, fileSpace, chain, count);
     hid_t dsetID = chain.back();
     HDF5DatasetGuard g(chain);
 #else
@@ -106,6 +106,16 @@ std::string JSONProfiler::GetRankProfilingJSON(
         {
             lf_WriterTimer(rankLog, transportTimerPair.second);
         }
+        for (const auto &transportBytesPair : transportsProfilers[t]->m_Bytes)
+        {
+            // only transports that count their bytes report them
+            if (transportBytesPair.second > 0)
+            {
+                rankLog += ", \"" + transportBytesPair.first +
+                           "_bytes\":" +
+                           std::to_string(transportBytesPair.second);
+            }
+        }
         rankLog += "}";
     }
     rankLog += " }"; // end rank entry
@@ -236,7 +236,7 @@ void CP_validateParams(SstStream Stream, SstParams Params, int Writer)
 
 static char *SstRegStr[] = {"File", "Screen", "Cloud"};
 static char *SstMarshalStr[] = {"FFS", "BP", "BP5"};
-static char *SstQueueFullStr[] = {"Block", "Discard"};
+static char *SstQueueFullStr[] = {"Block", "Discard", "Spill"};
 static char *SstCompressStr[] = {"None", "ZFP"};
 static char *SstCommPatternStr[] = {"Min", "Peer"};
 static char *SstPreloadModeStr[] = {"Off", "On", "Auto"};
@@ -259,6 +259,14 @@ extern void CP_dumpParams(SstStream Stream, struct _SstParams *Params,
                 (Params->QueueLimit == 0) ? "(unlimited)" : "");
         fprintf(stderr, "Param -   QueueFullPolicy=%s\n",
                 SstQueueFullStr[Params->QueueFullPolicy]);
+        if (Params->QueueFullPolicy == SstQueueFullSpill)
+        {
+            fprintf(stderr, "Param -   SpillMemoryLimit=%zu\n",
+                    Params->SpillMemoryLimit);
+            fprintf(stderr, "Param -   SpillDirectory=%s\n",
+                    Params->SpillDirectory ? Params->SpillDirectory
+                                           : "(default)");
+        }
         fprintf(stderr, "Param -   StepDistributionMode=%s\n",
                 SstStepDistributionModeStr[Params->StepDistributionMode]);
     }
@@ -293,6 +301,8 @@ extern void CP_dumpParams(SstStream Stream, struct _SstParams *Params,
     {
         fprintf(stderr, "Param -   AlwaysProvideLatestTimestep=%s\n",
                 Params->AlwaysProvideLatestTimestep ? "True" : "False");
+        fprintf(stderr, "Param -   SelectionPushdown=%s\n",
+                Params->SelectionPushdown ? "True" : "False");
     }
     fprintf(stderr, "Param -   OpenTimeoutSecs=%d (seconds)\n",
             Params->OpenTimeoutSecs);
@@ -1324,6 +1334,8 @@ extern void SstStreamDestroy(SstStream Stream)
         free(Stream->ConfigParams->DataInterface);
     if (Stream->ConfigParams->ControlModule)
         free(Stream->ConfigParams->ControlModule);
+    if (Stream->ConfigParams->SpillDirectory)
+        free(Stream->ConfigParams->SpillDirectory);
 
     if (Stream->Filename)
     {
@@ -1544,6 +1544,33 @@ extern void *SstReadRemoteMemory(SstStream Stream, int Rank, long Timestep,
         DP_TimestepInfo);
 }
 
+//  SstReadRemoteSlab is only called by the main program thread.  It
+//  returns NULL if the data plane or the writer cannot pack the
+//  selection, and then the caller reads the span with SstReadRemoteMemory.
+extern void *SstReadRemoteSlab(SstStream Stream, int Rank, long Timestep,
+                               size_t Offset, int DimCount, size_t ElementSize,
+                               const size_t *BlockCount,
+                               const size_t *SelStart, const size_t *SelCount,
+                               void *Buffer, void *DP_TimestepInfo)
+{
+    void *Ret;
+    size_t Length = ElementSize;
+    if (Stream->ConfigParams->ReaderShortCircuitReads ||
+        !Stream->ConfigParams->SelectionPushdown ||
+        !Stream->DP_Interface->readRemoteSlab)
+        return NULL;
+    Ret = Stream->DP_Interface->readRemoteSlab(
+        &Svcs, Stream->DP_Stream, Rank, Timestep, Offset, DimCount,
+        ElementSize, BlockCount, SelStart, SelCount, Buffer, DP_TimestepInfo);
+    if (!Ret)
+        return NULL;
+    for (int i = 0; i < DimCount; i++)
+        Length *= SelCount[i];
+    Stream->Stats.BytesTransferred += Length;
+    AddToReadStats(Stream, Rank, Timestep, Length);
+    return Ret;
+}
+
 static void sendOneToEachWriterRank(SstStream Stream, CMFormat f, void *Msg,
                                     void **WS_StreamPtr)
 {
@@ -2249,8 +2249,10 @@ extern void SstInternalProvideTimestep(
                 DiscardThisTimestep = 1;
             }
         }
-        else
+        else if (Stream->QueueFullPolicy == SstQueueFullBlock)
         {
+            /* with SstQueueFullSpill, the writer engine moves the data of
+             * timesteps queued beyond its memory budget to disk instead */
             while ((Stream->QueueLimit > 0) &&
                    (Stream->QueuedTimestepCount > Stream->QueueLimit))
             {
@@ -1,6 +1,7 @@
 #include <assert.h>
 #include <limits.h>
 #include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -151,6 +152,7 @@ typedef struct _EvpathWriterContactInfo
 {
     char *ContactString;
     void *WS_Stream;
+    int SlabReads; /* writer packs hyperslabs, see EvpathReadRemoteSlab */
 } * EvpathWriterContactInfo;
 
 typedef struct _EvpathReadRequestMsg
@@ -162,6 +164,12 @@ typedef struct _EvpathReadRequestMsg
     void *RS_Stream;
     int RequestingRank;
     int NotifyCondition;
+    /* if DimCount > 0, send only the selection of the block at Offset */
+    int DimCount;
+    size_t ElementSize;
+    size_t *BlockCount;
+    size_t *SelStart;
+    size_t *SelCount;
 } * EvpathReadRequestMsg;
 
 static FMField EvpathReadRequestList[] = {
@@ -179,6 +187,16 @@ static FMField EvpathReadRequestList[] = {
      FMOffset(EvpathReadRequestMsg, RequestingRank)},
     {"NotifyCondition", "integer", sizeof(int),
      FMOffset(EvpathReadRequestMsg, NotifyCondition)},
+    {"DimCount", "integer", sizeof(int),
+     FMOffset(EvpathReadRequestMsg, DimCount)},
+    {"ElementSize", "integer", sizeof(size_t),
+     FMOffset(EvpathReadRequestMsg, ElementSize)},
+    {"BlockCount", "integer[DimCount]", sizeof(size_t),
+     FMOffset(EvpathReadRequestMsg, BlockCount)},
+    {"SelStart", "integer[DimCount]", sizeof(size_t),
+     FMOffset(EvpathReadRequestMsg, SelStart)},
+    {"SelCount", "integer[DimCount]", sizeof(size_t),
+     FMOffset(EvpathReadRequestMsg, SelCount)},
     {NULL, NULL, 0, 0}};
 
 static FMStructDescRec EvpathReadRequestStructs[] = {
@@ -378,6 +396,94 @@ static void MarkReadRequest(TimestepList TS, DP_WSR_Stream WSR_Stream_v,
     TS->ReaderRequests = ReqTrk;
 }
 
+/*
+ * Copy the SelCount elements starting at SelStart of a row-major block of
+ * BlockCount elements to Dest, packed.  Inner dimensions that are selected
+ * in full are copied together with the next outer one as a single run.
+ */
+static void PackSlab(const char *Block, int DimCount, size_t ElementSize,
+                     const size_t *BlockCount, const size_t *SelStart,
+                     const size_t *SelCount, char *Dest)
+{
+    int Inner = DimCount - 1;
+    size_t Run = ElementSize * SelCount[Inner];
+    size_t Runs = 1;
+    size_t *Index = calloc(DimCount, sizeof(size_t));
+    while ((Inner > 0) && (SelCount[Inner] == BlockCount[Inner]))
+    {
+        Inner--;
+        Run *= SelCount[Inner];
+    }
+    for (int d = 0; d < Inner; d++)
+    {
+        Runs *= SelCount[d];
+    }
+    for (size_t r = 0; r < Runs; r++)
+    {
+        size_t Linear = 0;
+        for (int d = 0; d < DimCount; d++)
+        {
+            Linear = Linear * BlockCount[d] + SelStart[d] + Index[d];
+        }
+        memcpy(Dest, Block + Linear * ElementSize, Run);
+        Dest += Run;
+        for (int d = Inner - 1; d >= 0; d--)
+        {
+            if (++Index[d] < SelCount[d])
+            {
+                break;
+            }
+            Index[d] = 0;
+        }
+    }
+    free(Index);
+}
+
+/*
+ * A request may only name bytes of the writer's block.  A slab request must
+ * select within a block of BlockCount elements of ElementSize bytes that
+ * lies in the data at Offset, and its Length must be the packed size of the
+ * selection.
+ */
+static int ReadRequestIsValid(EvpathReadRequestMsg Req, size_t DataSize)
+{
+    size_t BlockElements = 1;
+    size_t SelElements = 1;
+    if (Req->Offset > DataSize)
+    {
+        return 0;
+    }
+    if (Req->DimCount <= 0)
+    {
+        return Req->Length <= DataSize - Req->Offset;
+    }
+    if ((Req->ElementSize == 0) || !Req->BlockCount || !Req->SelStart ||
+        !Req->SelCount)
+    {
+        return 0;
+    }
+    for (int d = 0; d < Req->DimCount; d++)
+    {
+        if ((Req->SelCount[d] > Req->BlockCount[d]) ||
+            (Req->SelStart[d] > Req->BlockCount[d] - Req->SelCount[d]))
+        {
+            return 0;
+        }
+        if (Req->BlockCount[d] &&
+            (BlockElements > SIZE_MAX / Req->BlockCount[d]))
+        {
+            return 0;
+        }
+        BlockElements *= Req->BlockCount[d];
+        SelElements *= Req->SelCount[d];
+    }
+    if (BlockElements > (DataSize - Req->Offset) / Req->ElementSize)
+    {
+        return 0;
+    }
+    return SelElements * Req->ElementSize == Req->Length;
+}
+
 // writer side routine, called by the network handler thread
 static void EvpathReadRequestHandler(CManager cm, CMConnection incoming_conn,
                                      void *msg_v, void *client_Data,
@@ -406,12 +512,33 @@ static void EvpathReadRequestHandler(CManager cm, CMConnection incoming_conn,
         {
             struct _EvpathReadReplyMsg ReadReplyMsg;
             CMConnection ReplyConn;
+            char *Packed = NULL;
             /* memset avoids uninit byte warnings from valgrind */
             MarkReadRequest(tmp, WSR_Stream, RequestingRank);
             memset(&ReadReplyMsg, 0, sizeof(ReadReplyMsg));
             ReadReplyMsg.Timestep = ReadRequestMsg->Timestep;
             ReadReplyMsg.DataLength = ReadRequestMsg->Length;
             ReadReplyMsg.Data = tmp->Data.block + ReadRequestMsg->Offset;
+            if (!ReadRequestIsValid(ReadRequestMsg, tmp->Data.DataSize))
+            {
+                /* reply without data, so the reader fails the read */
+                Svcs->verbose(WS_Stream->CP_Stream, DPCriticalVerbose,
+                              "Rejecting a read request from reader rank %d "
+                              "for timestep %ld that is outside the data\n",
+                              RequestingRank, ReadRequestMsg->Timestep);
+                ReadReplyMsg.DataLength = 0;
+                ReadReplyMsg.Data = NULL;
+            }
+            else if (ReadRequestMsg->DimCount > 0)
+            {
+                Packed = malloc(ReadRequestMsg->Length ? ReadRequestMsg->Length
+                                                       : 1);
+                PackSlab(ReadReplyMsg.Data, ReadRequestMsg->DimCount,
+                         ReadRequestMsg->ElementSize,
+                         ReadRequestMsg->BlockCount, ReadRequestMsg->SelStart,
+                         ReadRequestMsg->SelCount, Packed);
+                ReadReplyMsg.Data = Packed;
+            }
             ReadReplyMsg.RS_Stream = ReadRequestMsg->RS_Stream;
             ReadReplyMsg.NotifyCondition = ReadRequestMsg->NotifyCondition;
             Svcs->verbose(
@@ -440,6 +567,7 @@ static void EvpathReadRequestHandler(CManager cm, CMConnection incoming_conn,
             CMFormat Format = WS_Stream->ReadReplyFormat;
             pthread_mutex_unlock(&WS_Stream->DataLock);
             CMwrite(ReplyConn, Format, &ReadReplyMsg);
+            free(Packed);
 
             PERFSTUBS_TIMER_STOP_FUNC(timer);
             return;
@@ -481,6 +609,7 @@ typedef struct _EvpathCompletionHandle
     int Rank;
     long Offset;
     long Length;
+    int Packed;
     struct _EvpathCompletionHandle *Next;
 } * EvpathCompletionHandle;
 
@@ -518,6 +647,18 @@ static void EvpathReadReplyHandler(CManager cm, CMConnection conn, void *msg_v,
         "Got a reply to remote memory read from rank %d, condition is %d\n",
         Handle->Rank, ReadReplyMsg->NotifyCondition);
 
+    /* a writer replies without data to a request it rejected */
+    if (ReadReplyMsg->DataLength != (size_t)Handle->Length)
+    {
+        Svcs->verbose(RS_Stream->CP_Stream, DPCriticalVerbose,
+                      "Reply from rank %d carries %zu bytes for a read of "
+                      "%ld, failing the read\n",
+                      Handle->Rank, ReadReplyMsg->DataLength, Handle->Length);
+        Handle->Failed = 1;
+        CMCondition_signal(cm, ReadReplyMsg->NotifyCondition);
+        PERFSTUBS_TIMER_STOP_FUNC(timer);
+        return;
+    }
     /*
      * `Handle` contains the full request info and is `client_data`
      * associated with the CMCondition.  Once we get it, copy the incoming
@@ -567,7 +708,8 @@ static unsigned long writeBlockFingerprint(char *Page, size_t Size)
 static int HandleRequestWithPreloaded(CP_Services Svcs,
                                       Evpath_RS_Stream RS_Stream, int Rank,
                                       long Timestep, size_t Offset,
-                                      size_t Length, void *Buffer)
+                                      size_t Length, void *Buffer,
+                                      const struct _EvpathReadRequestMsg *Slab)
 {
     RSTimestepList Entry = NULL;
     Entry = RS_Stream->QueuedTimesteps;
@@ -585,6 +727,12 @@ static int HandleRequestWithPreloaded(CP_Services Svcs,
                   "%d for timestep %ld, fprint %lx\n",
                   Rank, Timestep,
                   writeBlockFingerprint(Entry->Data, Entry->DataSize));
+    if (Slab)
+    {
+        PackSlab(Entry->Data + Offset, Slab->DimCount, Slab->ElementSize,
+                 Slab->BlockCount, Slab->SelStart, Slab->SelCount, Buffer);
+        return 1;
+    }
     memcpy(Buffer, Entry->Data + Offset, Length);
     return 1;
 }
@@ -675,9 +823,12 @@ static void EvpathPreloadHandler(CManager cm, CMConnection conn, void *msg_v,
     {
         int HadPreload;
         EvpathCompletionHandle Next = Requests->Next;
-        HadPreload = HandleRequestWithPreloaded(
-            Svcs, RS_Stream, Requests->Rank, PreloadMsg->Timestep,
-            Requests->Offset, Requests->Length, Requests->Buffer);
+        /* packed selections are left to the reply of the writer */
+        HadPreload = !Requests->Packed &&
+                     HandleRequestWithPreloaded(
+                         Svcs, RS_Stream, Requests->Rank, PreloadMsg->Timestep,
+                         Requests->Offset, Requests->Length, Requests->Buffer,
+                         NULL);
         if (HadPreload)
         {
             CMCondition_signal(cm, Requests->CMcondition);
@@ -823,6 +974,7 @@ static DP_WSR_Stream EvpathInitWriterPerReader(CP_Services Svcs,
     memset(ContactInfo, 0, sizeof(struct _EvpathWriterContactInfo));
     ContactInfo->ContactString = EvpathContactString;
     ContactInfo->WS_Stream = WSR_Stream;
+    ContactInfo->SlabReads = 1;
     *WriterContactInfoPtr = ContactInfo;
     WSR_Stream->WriterContactInfo = ContactInfo;
 
@@ -868,6 +1020,8 @@ static void EvpathProvideWriterDataToReader(CP_Services Svcs,
             strdup(providedWriterInfo[i]->ContactString);
         RS_Stream->WriterContactInfo[i].WS_Stream =
             providedWriterInfo[i]->WS_Stream;
+        RS_Stream->WriterContactInfo[i].SlabReads =
+            providedWriterInfo[i]->SlabReads;
         Svcs->verbose(
             RS_Stream->CP_Stream, DPTraceVerbose,
             "Received contact info \"%s\", WS_stream %p for WSR Rank %d\n",
@@ -978,14 +1132,14 @@ typedef struct _EvpathPerTimestepInfo
     int CheckInt;
 } * EvpathPerTimestepInfo;
 
-// reader-side routine, called from the main program
-static void *EvpathReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
-                                    int Rank, long Timestep, size_t Offset,
-                                    size_t Length, void *Buffer,
-                                    void *DP_TimestepInfo)
+// reader-side routine, called from the main program.  Slab is NULL for
+// a read of Length bytes, else it holds the selection to send packed.
+static void *EvpathReadRemote(CP_Services Svcs, Evpath_RS_Stream Stream,
+                              int Rank, long Timestep, size_t Offset,
+                              size_t Length, void *Buffer,
+                              void *DP_TimestepInfo,
+                              const struct _EvpathReadRequestMsg *Slab)
 {
-    Evpath_RS_Stream Stream = (Evpath_RS_Stream)
-        Stream_v; /* DP_RS_Stream is the return from InitReader */
     CManager cm = Svcs->getCManager(Stream->CP_Stream);
     EvpathCompletionHandle ret = malloc(sizeof(struct _EvpathCompletionHandle));
     // EvpathPerTimestepInfo TimestepInfo =
@@ -1002,7 +1156,7 @@ static void *EvpathReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
     }
     LastRequestedTimestep = Timestep;
     HadPreload = HandleRequestWithPreloaded(Svcs, Stream, Rank, Timestep,
-                                            Offset, Length, Buffer);
+                                            Offset, Length, Buffer, Slab);
     ret->CPStream = Stream->CP_Stream;
     ret->DPStream = Stream;
     ret->Failed = 0;
@@ -1011,6 +1165,7 @@ static void *EvpathReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
     ret->Rank = Rank;
     ret->Offset = Offset;
     ret->Length = Length;
+    ret->Packed = (Slab != NULL);
 
     Stream->TotalReadRequests++;
     if (HadPreload)
@@ -1076,6 +1231,14 @@ static void *EvpathReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
     ReadRequestMsg.RS_Stream = Stream;
     ReadRequestMsg.RequestingRank = Stream->Rank;
     ReadRequestMsg.NotifyCondition = ret->CMcondition;
+    if (Slab)
+    {
+        ReadRequestMsg.DimCount = Slab->DimCount;
+        ReadRequestMsg.ElementSize = Slab->ElementSize;
+        ReadRequestMsg.BlockCount = Slab->BlockCount;
+        ReadRequestMsg.SelStart = Slab->SelStart;
+        ReadRequestMsg.SelCount = Slab->SelCount;
+    }
     if (!Svcs->sendToPeer(Stream->CP_Stream, Stream->PeerCohort, Rank,
                           Stream->ReadRequestFormat, &ReadRequestMsg))
     {
@@ -1086,6 +1249,54 @@ static void *EvpathReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
     return ret;
 }
 
+// reader-side routine, called from the main program
+static void *EvpathReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
+                                    int Rank, long Timestep, size_t Offset,
+                                    size_t Length, void *Buffer,
+                                    void *DP_TimestepInfo)
+{
+    Evpath_RS_Stream Stream = (Evpath_RS_Stream)
+        Stream_v; /* DP_RS_Stream is the return from InitReader */
+    return EvpathReadRemote(Svcs, Stream, Rank, Timestep, Offset, Length,
+                            Buffer, DP_TimestepInfo, NULL);
+}
+
+// reader-side routine, called from the main program
+static void *EvpathReadRemoteSlab(CP_Services Svcs, DP_RS_Stream Stream_v,
+                                  int Rank, long Timestep, size_t Offset,
+                                  int DimCount, size_t ElementSize,
+                                  const size_t *BlockCount,
+                                  const size_t *SelStart,
+                                  const size_t *SelCount, void *Buffer,
+                                  void *DP_TimestepInfo)
+{
+    Evpath_RS_Stream Stream = (Evpath_RS_Stream)Stream_v;
+    struct _EvpathReadRequestMsg Slab;
+    size_t Length = ElementSize;
+
+    /*
+     * preloaded timesteps arrive whole, and older writers do not know
+     * about selections, so read the span instead
+     */
+    if ((Stream->CurPreloadMode != SstPreloadNone) ||
+        !Stream->WriterContactInfo[Rank].SlabReads)
+    {
+        return NULL;
+    }
+    for (int i = 0; i < DimCount; i++)
+    {
+        Length *= SelCount[i];
+    }
+    memset(&Slab, 0, sizeof(Slab));
+    Slab.DimCount = DimCount;
+    Slab.ElementSize = ElementSize;
+    Slab.BlockCount = (size_t *)BlockCount;
+    Slab.SelStart = (size_t *)SelStart;
+    Slab.SelCount = (size_t *)SelCount;
+    return EvpathReadRemote(Svcs, Stream, Rank, Timestep, Offset, Length,
+                            Buffer, DP_TimestepInfo, &Slab);
+}
+
 // reader-side routine, called from the main program
 static int EvpathWaitForCompletion(CP_Services Svcs, void *Handle_v)
 {
@@ -1494,6 +1705,8 @@ static FMField EvpathWriterContactList[] = {
      FMOffset(EvpathWriterContactInfo, ContactString)},
     {"writer_ID", "integer", sizeof(void *),
      FMOffset(EvpathWriterContactInfo, WS_Stream)},
+    {"SlabReads", "integer", sizeof(int),
+     FMOffset(EvpathWriterContactInfo, SlabReads)},
     {NULL, NULL, 0, 0}};
 
 static FMStructDescRec EvpathWriterContactStructs[] = {
@@ -1515,7 +1728,7 @@ static FMStructDescRec EvpathWriterContactStructs[] = {
 
 static struct _CP_DP_Interface evpathDPInterface = {
     NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
-    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
 
 static int EvpathGetPriority(CP_Services Svcs, void *CP_Stream,
                              struct _SstParams *Params)
@@ -1538,6 +1751,7 @@ extern NO_SANITIZE_THREAD CP_DP_Interface LoadEVpathDP()
     evpathDPInterface.provideWriterDataToReader =
         EvpathProvideWriterDataToReader;
     evpathDPInterface.readRemoteMemory = EvpathReadRemoteMemory;
+    evpathDPInterface.readRemoteSlab = EvpathReadRemoteSlab;
     evpathDPInterface.waitForCompletion = EvpathWaitForCompletion;
     evpathDPInterface.notifyConnFailure = EvpathNotifyConnFailure;
     evpathDPInterface.provideTimestep = EvpathProvideTimestep;
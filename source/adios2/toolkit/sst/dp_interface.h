@@ -185,6 +185,22 @@ typedef DP_CompletionHandle (*CP_DP_ReadRemoteMemoryFunc)(
     CP_Services Svcs, DP_RS_Stream RS_Stream, int Rank, long Timestep,
     size_t Offset, size_t Length, void *Buffer, void *DP_TimestepInfo);
 
+/*!
+ * CP_DP_ReadRemoteSlabFunc is the type of an optional dataplane function
+ * that reads a hyperslab of an array block, packed contiguously into
+ * `buffer`.  The block starts at offset `offset` from the beginning of the
+ * writers data block and holds `BlockCount` elements of size `ElementSize`
+ * in row-major order (slowest dimension first).  Only the `SelCount`
+ * elements starting at `SelStart` within the block are returned.  The
+ * function returns NULL if it cannot serve this read, in which case the
+ * caller falls back to ReadRemoteMemoryFunc.
+ */
+typedef DP_CompletionHandle (*CP_DP_ReadRemoteSlabFunc)(
+    CP_Services Svcs, DP_RS_Stream RS_Stream, int Rank, long Timestep,
+    size_t Offset, int DimCount, size_t ElementSize, const size_t *BlockCount,
+    const size_t *SelStart, const size_t *SelCount, void *Buffer,
+    void *DP_TimestepInfo);
+
 /*!
  * CP_DP_WaitForCompletionFunc is the type of a dataplane function that
  * suspends the execution of the current thread until the asynchronous
@@ -383,6 +399,8 @@ struct _CP_DP_Interface
     CP_DP_GetPriorityFunc
         getPriority; // both sides, part of DP selection process.
     CP_DP_UnGetPriorityFunc unGetPriority;
+
+    CP_DP_ReadRemoteSlabFunc readRemoteSlab; // reader-side call, optional
 };
 #define DPTraceVerbose 5
 #define DPPerRankVerbose 4
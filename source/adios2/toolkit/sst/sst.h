@@ -67,7 +67,8 @@ typedef enum
 typedef enum
 {
     SstQueueFullBlock = 0,
-    SstQueueFullDiscard = 1
+    SstQueueFullDiscard = 1,
+    SstQueueFullSpill = 2
 } SstQueueFullPolicy;
 
 typedef enum
@@ -115,6 +116,11 @@ extern SstBlock SstGetAttributeData(SstStream stream, long timestep);
 extern void *SstReadRemoteMemory(SstStream s, int rank, long timestep,
                                  size_t offset, size_t length, void *buffer,
                                  void *DP_TimestepInfo);
+extern void *SstReadRemoteSlab(SstStream s, int rank, long timestep,
+                               size_t offset, int dimCount,
+                               size_t elementSize, const size_t *blockCount,
+                               const size_t *selStart, const size_t *selCount,
+                               void *buffer, void *DP_TimestepInfo);
 extern SstStatusValue SstWaitForCompletion(SstStream stream, void *completion);
 extern void SstReleaseStep(SstStream stream);
 extern SstStatusValue SstAdvanceStep(SstStream stream, const float timeout_sec);
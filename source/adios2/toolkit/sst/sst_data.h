@@ -65,6 +65,8 @@ typedef struct _SstStats
     MACRO(QueueLimit, Int, int, 0)                                             \
     MACRO(ReserveQueueLimit, Int, int, 0)                                      \
     MACRO(QueueFullPolicy, QueueFullPolicy, size_t, 0)                         \
+    MACRO(SpillMemoryLimit, SizeBytes, size_t, 1024 * 1024 * 1024)             \
+    MACRO(SpillDirectory, String, char *, NULL)                                \
     MACRO(IsRowMajor, IsRowMajor, int, 0)                                      \
     MACRO(FirstTimestepPrecious, Bool, int, 0)                                 \
     MACRO(ControlTransport, String, char *, NULL)                              \
@@ -77,6 +79,7 @@ typedef struct _SstStats
     MACRO(SpeculativePreloadMode, SpecPreloadMode, int, SpecPreloadAuto)       \
     MACRO(SpecAutoNodeThreshold, Int, int, 1)                                  \
     MACRO(ReaderShortCircuitReads, Bool, int, 0)                               \
+    MACRO(SelectionPushdown, Bool, int, 1)                                     \
     MACRO(ControlModule, String, char *, NULL)
 
 typedef enum
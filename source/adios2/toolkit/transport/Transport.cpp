@@ -107,6 +107,8 @@ void Transport::Flush()
 
 size_t Transport::GetSize() { return 0; }
 
+size_t Transport::GetStripeSize() { return 0; }
+
 void Transport::ProfilerStart(const std::string process) noexcept
 {
     if (m_Profiler.m_IsActive)
@@ -135,6 +135,13 @@ public:
      */
     virtual size_t GetSize();
 
+    /**
+     * Returns the stripe (or file system block) size of the opened file,
+     * the unit writes should be aligned to for best performance
+     * @return stripe size in bytes, 0 if unknown
+     */
+    virtual size_t GetStripeSize();
+
     /** flushes current contents to physical medium without closing */
     virtual void Flush();
 
@@ -9,6 +9,7 @@
  */
 #include "FilePOSIX.h"
 #include "adios2/helper/adiosLog.h"
+#include "adios2/helper/adiosString.h"
 
 #ifdef ADIOS2_HAVE_O_DIRECT
 #ifndef _GNU_SOURCE
@@ -26,6 +27,15 @@
 #include <sys/uio.h>   // writev
 #include <unistd.h>    // write, close, ftruncate
 
+#ifdef ADIOS2_HAVE_LUSTRE
+#ifdef ADIOS2_HAVE_LINUX_LUSTRE_USER_H // Lustre 2.12 and later
+#include <linux/lustre/lustre_user.h> // lov_user_md, LL_IOC_LOV_SETSTRIPE
+#else
+#include <lustre/lustre_user.h> // lov_user_md, LL_IOC_LOV_SETSTRIPE
+#endif
+#include <sys/ioctl.h> // ioctl
+#endif
+
 #include <iostream>
 
 /// \cond EXCLUDE_FROM_DOXYGEN
@@ -78,6 +88,59 @@ static int __GetOpenFlag(const int flag, const bool directio)
     }
 }
 
+void FilePOSIX::SetParameters(const Params &parameters)
+{
+    for (const auto &pair : parameters)
+    {
+        const std::string key = helper::LowerCase(pair.first);
+        const std::string value = helper::LowerCase(pair.second);
+
+        if (key == "stripecount")
+        {
+            m_StripeCount = helper::StringToSizeT(
+                value, " in Parameter key=StripeCount of POSIX transport");
+        }
+        else if (key == "stripesize")
+        {
+            m_StripeSize = helper::StringToByteUnits(
+                value, " in Parameter key=StripeSize of POSIX transport");
+        }
+    }
+}
+
+int FilePOSIX::OpenCreate(const int flag, const int mode)
+{
+#ifdef ADIOS2_HAVE_LUSTRE
+    if (m_StripeCount > 0 || m_StripeSize > 0)
+    {
+        // delay object allocation until the layout is set, an existing
+        // file keeps its layout and the ioctl fails harmlessly
+        const int fd = open(m_Name.c_str(), flag | O_LOV_DELAY_CREATE, mode);
+        if (fd != -1)
+        {
+            const int openErrno = errno;
+            struct lov_user_md_v1 lum;
+            std::memset(&lum, 0, sizeof(lum));
+            lum.lmm_magic = LOV_USER_MAGIC_V1;
+            lum.lmm_pattern = 0; // file system default (RAID0)
+            lum.lmm_stripe_size = static_cast<uint32_t>(m_StripeSize);
+            lum.lmm_stripe_count = static_cast<uint16_t>(m_StripeCount);
+            lum.lmm_stripe_offset = static_cast<uint16_t>(-1);
+            if (ioctl(fd, LL_IOC_LOV_SETSTRIPE, &lum) == -1 && errno != EEXIST)
+            {
+                helper::Log("Toolkit", "transport::file::FilePOSIX", "Open",
+                            "couldn't set stripe layout of file " + m_Name +
+                                ": " + strerror(errno),
+                            helper::WARNING);
+            }
+            errno = openErrno;
+        }
+        return fd;
+    }
+#endif
+    return open(m_Name.c_str(), flag, mode);
+}
+
 void FilePOSIX::Open(const std::string &name, const Mode openMode,
                      const bool async, const bool directio)
 {
@@ -86,7 +149,7 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode,
         ProfilerStart("open");
         errno = 0;
         int flag = __GetOpenFlag(O_WRONLY | O_CREAT | O_TRUNC, directio);
-        int FD = open(m_Name.c_str(), flag, 0666);
+        int FD = OpenCreate(flag, 0666);
         m_Errno = errno;
         ProfilerStop("open");
         return FD;
@@ -110,8 +173,7 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode,
         {
             ProfilerStart("open");
             errno = 0;
-            m_FileDescriptor = open(
-                m_Name.c_str(),
+            m_FileDescriptor = OpenCreate(
                 __GetOpenFlag(O_WRONLY | O_CREAT | O_TRUNC, directio), 0666);
             m_Errno = errno;
             ProfilerStop("open");
@@ -122,8 +184,8 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode,
         ProfilerStart("open");
         errno = 0;
         // m_FileDescriptor = open(m_Name.c_str(), O_RDWR);
-        m_FileDescriptor = open(
-            m_Name.c_str(), __GetOpenFlag(O_RDWR | O_CREAT, directio), 0777);
+        m_FileDescriptor =
+            OpenCreate(__GetOpenFlag(O_RDWR | O_CREAT, directio), 0777);
         lseek(m_FileDescriptor, 0, SEEK_END);
         m_Errno = errno;
         ProfilerStop("open");
@@ -158,7 +220,7 @@ void FilePOSIX::OpenChain(const std::string &name, Mode openMode,
         ProfilerStart("open");
         errno = 0;
         int flag = __GetOpenFlag(O_WRONLY | O_CREAT | O_TRUNC, directio);
-        int FD = open(m_Name.c_str(), flag, 0666);
+        int FD = OpenCreate(flag, 0666);
         m_Errno = errno;
         ProfilerStop("open");
         return FD;
@@ -194,10 +256,9 @@ void FilePOSIX::OpenChain(const std::string &name, Mode openMode,
             errno = 0;
             if (chainComm.Rank() == 0)
             {
-                m_FileDescriptor =
-                    open(m_Name.c_str(),
-                         __GetOpenFlag(O_WRONLY | O_CREAT | O_TRUNC, directio),
-                         0666);
+                m_FileDescriptor = OpenCreate(
+                    __GetOpenFlag(O_WRONLY | O_CREAT | O_TRUNC, directio),
+                    0666);
             }
             else
             {
@@ -216,8 +277,7 @@ void FilePOSIX::OpenChain(const std::string &name, Mode openMode,
         if (chainComm.Rank() == 0)
         {
             m_FileDescriptor =
-                open(m_Name.c_str(), __GetOpenFlag(O_RDWR | O_CREAT, directio),
-                     0666);
+                OpenCreate(__GetOpenFlag(O_RDWR | O_CREAT, directio), 0666);
         }
         else
         {
@@ -296,7 +356,8 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
     };*/
 
     WaitForOpen();
-    if (start != MaxSizeT)
+    const bool positioned = (start != MaxSizeT);
+    if (positioned)
     {
         errno = 0;
         const auto newPosition = lseek(m_FileDescriptor, start, SEEK_SET);
@@ -316,6 +377,19 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
         start = static_cast<size_t>(pos);
     }
 
+    if (m_Profiler.m_IsActive)
+    {
+        m_Profiler.m_Bytes["write"] += size;
+        // a positioned write not starting on a stripe boundary shares a
+        // stripe (and its lock) with another write, continuations of the
+        // previous write are not counted
+        const size_t stripeSize = positioned ? GetStripeSize() : 0;
+        if (stripeSize > 0 && start % stripeSize != 0)
+        {
+            m_Profiler.m_Bytes["misaligned"] += size;
+        }
+    }
+
     if (size > DefaultMaxFileBatchSize)
     {
         const size_t batches = size / DefaultMaxFileBatchSize;
@@ -513,6 +587,29 @@ size_t FilePOSIX::GetSize()
     return static_cast<size_t>(fileStat.st_size);
 }
 
+size_t FilePOSIX::GetStripeSize()
+{
+    if (m_FileStripeSize == 0)
+    {
+        if (m_StripeSize > 0)
+        {
+            m_FileStripeSize = m_StripeSize;
+        }
+        else
+        {
+            // Lustre reports the stripe size, GPFS the file system block
+            struct stat fileStat;
+            WaitForOpen();
+            if (fstat(m_FileDescriptor, &fileStat) == 0 &&
+                fileStat.st_blksize > 0)
+            {
+                m_FileStripeSize = static_cast<size_t>(fileStat.st_blksize);
+            }
+        }
+    }
+    return m_FileStripeSize;
+}
+
 void FilePOSIX::Flush()
 {
     /* Turn this off now because BP3/BP4 calls manager Flush and this syncing
@@ -53,6 +53,18 @@ public:
 
     size_t GetSize() final;
 
+    /**
+     * Stripe size requested at creation, otherwise the preferred I/O block
+     * size reported by the file system (Lustre stripe, GPFS block)
+     */
+    size_t GetStripeSize() final;
+
+    /**
+     * StripeCount and StripeSize set the Lustre layout of files created by
+     * this transport, ignored on other file systems
+     */
+    void SetParameters(const Params &parameters) final;
+
     /** Does nothing, each write is supposed to flush */
     void Flush() final;
 
@@ -77,6 +89,11 @@ private:
     bool m_IsOpening = false;
     std::future<int> m_OpenFuture;
     bool m_DirectIO = false;
+    /** requested layout of newly created files, 0 is file system default */
+    size_t m_StripeCount = 0;
+    size_t m_StripeSize = 0;
+    /** cached result of GetStripeSize */
+    size_t m_FileStripeSize = 0;
 
     /**
      * Check if m_FileDescriptor is -1 after an operation
@@ -84,6 +101,8 @@ private:
      */
     void CheckFile(const std::string hint) const;
     void WaitForOpen();
+    /** open(O_CREAT) applying the requested stripe layout if possible */
+    int OpenCreate(const int flag, const int mode);
     std::string SysErrMsg() const;
 };
 
@@ -407,6 +407,14 @@ size_t TransportMan::GetFileSize(const size_t transportIndex) const
     return itTransport->second->GetSize();
 }
 
+size_t TransportMan::GetStripeSize(const size_t transportIndex) const
+{
+    auto itTransport = m_Transports.find(transportIndex);
+    CheckFile(itTransport, ", in call to GetStripeSize with index " +
+                               std::to_string(transportIndex));
+    return itTransport->second->GetStripeSize();
+}
+
 void TransportMan::ReadFile(char *buffer, const size_t size, const size_t start,
                             const size_t transportIndex)
 {
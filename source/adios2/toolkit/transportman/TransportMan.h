@@ -164,6 +164,13 @@ public:
 
     size_t GetFileSize(const size_t transportIndex = 0) const;
 
+    /**
+     * Stripe (or block) size reported by the file system for a file
+     * @param transportIndex
+     * @return stripe size in bytes, 0 if unknown
+     */
+    size_t GetStripeSize(const size_t transportIndex = 0) const;
+
     /**
      * Read contents from a single file and assign it to buffer
      * @param buffer
@@ -9,6 +9,7 @@
  */
 
 #include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 
@@ -29,8 +30,27 @@ ZmqReqRep::ZmqReqRep()
     }
 }
 
+namespace
+{
+void FreeReply(void *, void *hint)
+{
+    delete static_cast<std::shared_ptr<std::vector<char>> *>(hint);
+}
+}
+
 ZmqReqRep::~ZmqReqRep()
 {
+    if (m_ProxyThread.joinable())
+    {
+        for (auto socket : m_ReplierSockets)
+        {
+            zmq_close(socket);
+        }
+        // terminates zmq_proxy
+        zmq_ctx_shutdown(m_Context);
+        m_ProxyThread.join();
+        zmq_close(m_Backend);
+    }
     if (m_Socket)
     {
         zmq_close(m_Socket);
@@ -77,12 +97,18 @@ void ZmqReqRep::OpenRequester(const std::string &address, const int timeout,
 }
 
 void ZmqReqRep::OpenReplier(const std::string &address, const int timeout,
-                            const size_t receiverBufferSize)
+                            const size_t receiverBufferSize,
+                            const size_t threads)
 {
     m_Timeout = timeout;
     m_ReceiverBuffer.reserve(receiverBufferSize);
+    m_ReplierBuffers.resize(threads < 1 ? 1 : threads);
+    for (auto &buffer : m_ReplierBuffers)
+    {
+        buffer.reserve(receiverBufferSize);
+    }
 
-    m_Socket = zmq_socket(m_Context, ZMQ_REP);
+    m_Socket = zmq_socket(m_Context, threads > 1 ? ZMQ_ROUTER : ZMQ_REP);
     if (not m_Socket)
     {
         helper::Throw<std::runtime_error>("Toolkit", "ZmqReqRep", "OpenReplier",
@@ -98,29 +124,80 @@ void ZmqReqRep::OpenReplier(const std::string &address, const int timeout,
 
     zmq_setsockopt(m_Socket, ZMQ_RCVTIMEO, &m_Timeout, sizeof(m_Timeout));
     zmq_setsockopt(m_Socket, ZMQ_LINGER, &m_Timeout, sizeof(m_Timeout));
+
+    if (threads <= 1)
+    {
+        m_ReplierSockets.push_back(m_Socket);
+        return;
+    }
+
+    const std::string backendAddress =
+        "inproc://adios2-zmqreqrep-" +
+        std::to_string(reinterpret_cast<uintptr_t>(this));
+    m_Backend = zmq_socket(m_Context, ZMQ_DEALER);
+    if (not m_Backend || zmq_bind(m_Backend, backendAddress.c_str()))
+    {
+        helper::Throw<std::runtime_error>("Toolkit", "ZmqReqRep", "OpenReplier",
+                                          "binding zmq backend socket failed");
+    }
+    zmq_setsockopt(m_Backend, ZMQ_LINGER, &m_Timeout, sizeof(m_Timeout));
+
+    for (size_t i = 0; i < threads; ++i)
+    {
+        void *socket = zmq_socket(m_Context, ZMQ_REP);
+        if (not socket || zmq_connect(socket, backendAddress.c_str()))
+        {
+            helper::Throw<std::runtime_error>(
+                "Toolkit", "ZmqReqRep", "OpenReplier",
+                "connecting zmq reply socket failed");
+        }
+        zmq_setsockopt(socket, ZMQ_RCVTIMEO, &m_Timeout, sizeof(m_Timeout));
+        zmq_setsockopt(socket, ZMQ_LINGER, &m_Timeout, sizeof(m_Timeout));
+        m_ReplierSockets.push_back(socket);
+    }
+
+    m_ProxyThread =
+        std::thread([this]() { zmq_proxy(m_Socket, m_Backend, nullptr); });
 }
 
-std::shared_ptr<std::vector<char>> ZmqReqRep::ReceiveRequest()
+std::shared_ptr<std::vector<char>>
+ZmqReqRep::ReceiveRequest(const size_t thread)
 {
-    int bytes = zmq_recv(m_Socket, m_ReceiverBuffer.data(),
-                         m_ReceiverBuffer.capacity(), 0);
+    auto &buffer = m_ReplierBuffers[thread];
+    int bytes =
+        zmq_recv(m_ReplierSockets[thread], buffer.data(), buffer.capacity(), 0);
     if (bytes <= 0)
     {
         return nullptr;
     }
     auto request = std::make_shared<std::vector<char>>(bytes);
-    std::memcpy(request->data(), m_ReceiverBuffer.data(), bytes);
+    std::memcpy(request->data(), buffer.data(), bytes);
     return request;
 }
 
-void ZmqReqRep::SendReply(std::shared_ptr<std::vector<char>> reply)
+void ZmqReqRep::SendReply(std::shared_ptr<std::vector<char>> reply,
+                          const size_t thread)
 {
-    zmq_send(m_Socket, reply->data(), reply->size(), 0);
+    // the message holds a reference to the reply until zmq has sent it, so a
+    // buffer replied to many requesters is never copied
+    auto hint = new std::shared_ptr<std::vector<char>>(reply);
+    zmq_msg_t msg;
+    if (zmq_msg_init_data(&msg, reply->data(), reply->size(), FreeReply,
+                          hint))
+    {
+        delete hint;
+        return;
+    }
+    if (zmq_msg_send(&msg, m_ReplierSockets[thread], 0) < 0)
+    {
+        zmq_msg_close(&msg);
+    }
 }
 
-void ZmqReqRep::SendReply(const void *reply, const size_t size)
+void ZmqReqRep::SendReply(const void *reply, const size_t size,
+                          const size_t thread)
 {
-    zmq_send(m_Socket, reply, size, 0);
+    zmq_send(m_ReplierSockets[thread], reply, size, 0);
 }
 
 std::shared_ptr<std::vector<char>>
@@ -164,9 +241,10 @@ ZmqReqRep::Request(const char *request, const size_t size,
         }
     }
 
+    // an empty reply is a valid answer, e.g. no step is ready yet
     ret = -1;
     start_time = std::chrono::system_clock::now();
-    while (ret < 1)
+    while (ret < 0)
     {
         ret = zmq_recv(socket, m_ReceiverBuffer.data(),
                        m_ReceiverBuffer.capacity(), 0);
@@ -208,7 +286,7 @@ std::shared_ptr<std::vector<char>> ZmqReqRep::Request(const char *request,
 
     ret = -1;
     start_time = std::chrono::system_clock::now();
-    while (ret < 1)
+    while (ret < 0)
     {
         ret = zmq_recv(m_Socket, m_ReceiverBuffer.data(),
                        m_ReceiverBuffer.capacity(), 0);
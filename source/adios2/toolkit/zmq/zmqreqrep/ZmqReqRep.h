@@ -14,6 +14,8 @@
 #include "adios2/core/IO.h"
 #include "adios2/core/Operator.h"
 
+#include <thread>
+
 #include <zmq.h>
 
 namespace adios2
@@ -37,12 +39,15 @@ public:
     std::shared_ptr<std::vector<char>> Request(const char *request,
                                                const size_t size);
 
-    // replier
+    // replier, with threads > 1 requests are spread over a pool of reply
+    // sockets and each thread receives and replies through its own one
     void OpenReplier(const std::string &address, const int timeout,
-                     const size_t receiverBufferSize);
-    std::shared_ptr<std::vector<char>> ReceiveRequest();
-    void SendReply(std::shared_ptr<std::vector<char>> reply);
-    void SendReply(const void *reply, const size_t size);
+                     const size_t receiverBufferSize, const size_t threads = 1);
+    std::shared_ptr<std::vector<char>> ReceiveRequest(const size_t thread = 0);
+    void SendReply(std::shared_ptr<std::vector<char>> reply,
+                   const size_t thread = 0);
+    void SendReply(const void *reply, const size_t size,
+                   const size_t thread = 0);
 
 private:
     int m_Timeout;
@@ -50,6 +55,14 @@ private:
     std::vector<char> m_ReceiverBuffer;
     void *m_Context = nullptr;
     void *m_Socket = nullptr;
+
+    // reply socket and receiver buffer of each replier thread
+    std::vector<void *> m_ReplierSockets;
+    std::vector<std::vector<char>> m_ReplierBuffers;
+    // with a pool, m_Socket is the router bound to the address and requests
+    // are forwarded to the reply sockets through m_Backend
+    void *m_Backend = nullptr;
+    std::thread m_ProxyThread;
 };
 
 } // end namespace zmq
@@ -486,6 +486,7 @@ H5VL_ObjDef_t *gGetVarObjDef(const char *name, H5VL_ObjDef_t *vol)
         }
         H5VL_VarDef_t *varDef =
             gCreateVarDef(name, handle->m_Engine, var, -1, -1);
+        gAttachFileDef(varDef, handle);
         return gVarToVolObj(varDef, vol);
     }
 
@@ -510,9 +511,10 @@ H5VL_ObjDef_t *gGetVarObjDef(const char *name, H5VL_ObjDef_t *vol)
     {
         if (curr->m_Parent == NULL)
         {
-            H5VL_VarDef_t *varDef = gCreateVarDef(
-                fullPath, ((H5VL_FileDef_t *)(curr->m_ObjPtr))->m_Engine, var,
-                -1, -1);
+            H5VL_FileDef_t *handle = (H5VL_FileDef_t *)(curr->m_ObjPtr);
+            H5VL_VarDef_t *varDef =
+                gCreateVarDef(fullPath, handle->m_Engine, var, -1, -1);
+            gAttachFileDef(varDef, handle);
 
             return gVarToVolObj(varDef, vol);
         }
@@ -807,6 +809,21 @@ void gChooseEngine(adios2_io *io)
     }
 }
 
+void gChooseReadBatch(H5VL_FileDef_t *handle)
+{
+    const char *batchCount = getenv("ADIOS2_VOL_READ_BATCH");
+    if (batchCount != NULL)
+        handle->m_ReadBatchCount = strtoull(batchCount, NULL, 10);
+
+    const char *batchSize = getenv("ADIOS2_VOL_READ_BATCH_SIZE");
+    if (batchSize != NULL)
+        handle->m_ReadBatchSize = strtoull(batchSize, NULL, 10);
+
+    if ((handle->m_ReadBatchCount > 0) || (handle->m_ReadBatchSize > 0))
+        RANK_ZERO_MSG(" batch reads: %zu datasets, %zu bytes\n",
+                      handle->m_ReadBatchCount, handle->m_ReadBatchSize);
+}
+
 H5VL_FileDef_t *gADIOS2CreateFile(const char *name)
 {
     H5VL_FileDef_t *handle = NULL;
@@ -843,6 +860,7 @@ H5VL_FileDef_t *gADIOS2OpenFile(const char *name)
     handle->m_IO = adios2_declare_io(m_ADIOS2, name);
 
     gChooseEngine(handle->m_IO);
+    gChooseReadBatch(handle);
     handle->m_Engine = adios2_open(handle->m_IO, name, adios2_mode_read);
 
     char engineType[10];
@@ -865,9 +883,36 @@ void gADIOS2CloseFile(H5VL_FileDef_t *handle)
         return;
 
     if (NULL != handle->m_Engine)
+    {
+        gADIOS2PerformGets(handle);
         adios2_close(handle->m_Engine);
+        handle->m_Engine = NULL;
+    }
+
+    // datasets still open keep the handle until they are closed
+    if (0 == handle->m_RefCount)
+        SAFE_FREE(handle);
+}
+
+void gAttachFileDef(H5VL_VarDef_t *varDef, H5VL_FileDef_t *handle)
+{
+    if ((NULL == varDef) || (NULL == handle))
+        return;
+
+    varDef->m_FileDef = handle;
+    handle->m_RefCount++;
+}
+
+void gDetachFileDef(H5VL_VarDef_t *varDef)
+{
+    H5VL_FileDef_t *handle = varDef->m_FileDef;
+    if (NULL == handle)
+        return;
 
-    SAFE_FREE(handle);
+    varDef->m_FileDef = NULL;
+    handle->m_RefCount--;
+    if ((0 == handle->m_RefCount) && (NULL == handle->m_Engine))
+        SAFE_FREE(handle);
 }
 
 adios2_variable *gADIOS2InqVar(adios2_io *io, const char *name)
@@ -875,6 +920,36 @@ adios2_variable *gADIOS2InqVar(adios2_io *io, const char *name)
     return adios2_inquire_variable(io, name);
 }
 
+H5VL_FileDef_t *gGetFileDef(H5VL_ObjDef_t *vol)
+{
+    if ((NULL != vol) && (VAR == vol->m_ObjType))
+        return ((H5VL_VarDef_t *)(vol->m_ObjPtr))->m_FileDef;
+
+    H5VL_ObjDef_t *curr = vol;
+    while (curr)
+    {
+        if (curr->m_Parent == NULL)
+            return (ROOT == curr->m_ObjType)
+                       ? (H5VL_FileDef_t *)(curr->m_ObjPtr)
+                       : NULL;
+        curr = curr->m_Parent;
+    }
+    return NULL;
+}
+
+herr_t gADIOS2PerformGets(H5VL_FileDef_t *handle)
+{
+    REQUIRE_NOT_NULL_ERR(handle, -1);
+    if (0 == handle->m_NumDeferredReads)
+        return 0;
+
+    handle->m_NumDeferredReads = 0;
+    handle->m_DeferredReadSize = 0;
+    if (adios2_error_none != adios2_perform_gets(handle->m_Engine))
+        return -1;
+    return 0;
+}
+
 herr_t gADIOS2ReadVar(H5VL_VarDef_t *varDef)
 {
     REQUIRE_NOT_NULL_ERR(varDef, -1);
@@ -884,6 +959,7 @@ herr_t gADIOS2ReadVar(H5VL_VarDef_t *varDef)
     if (varDim < 0)
         return -1;
 
+    size_t numElements = 1;
     if (varDim > 0)
     {
         size_t start[varDim], count[varDim];
@@ -893,6 +969,9 @@ herr_t gADIOS2ReadVar(H5VL_VarDef_t *varDef)
 
         adios2_set_selection(varDef->m_Variable, varDef->m_DimCount, start,
                              count);
+        int i;
+        for (i = 0; i < varDim; i++)
+            numElements *= count[i];
 
         if (varDef->m_MemSpaceID > 0)
         {
@@ -900,8 +979,34 @@ herr_t gADIOS2ReadVar(H5VL_VarDef_t *varDef)
                 "\n## No memory space is supported for reading in ADIOS...\n");
         }
     }
+
+    H5VL_FileDef_t *handle = varDef->m_FileDef;
+    if ((NULL != handle) && (NULL == handle->m_Engine))
+    {
+        SHOW_ERROR_MSG("H5VL_ADIOS2: Error: file of %s is closed\n",
+                       varDef->m_Name);
+        return -1;
+    }
+    if ((NULL == handle) ||
+        ((0 == handle->m_ReadBatchCount) && (0 == handle->m_ReadBatchSize)))
+    {
+        adios2_get(varDef->m_Engine, varDef->m_Variable, varDef->m_Data,
+                   adios2_mode_sync);
+        return 0;
+    }
+
+    // the selection is taken at adios2_get, the engine reads all deferred
+    // datasets together in gADIOS2PerformGets
     adios2_get(varDef->m_Engine, varDef->m_Variable, varDef->m_Data,
-               adios2_mode_sync);
+               adios2_mode_deferred);
+    handle->m_NumDeferredReads++;
+    handle->m_DeferredReadSize += numElements * H5Tget_size(varDef->m_TypeID);
+
+    if (((handle->m_ReadBatchCount > 0) &&
+         (handle->m_NumDeferredReads >= handle->m_ReadBatchCount)) ||
+        ((handle->m_ReadBatchSize > 0) &&
+         (handle->m_DeferredReadSize >= handle->m_ReadBatchSize)))
+        return gADIOS2PerformGets(handle);
 
     return 0;
 }
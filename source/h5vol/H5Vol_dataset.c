@@ -168,6 +168,7 @@ herr_t H5VL_adios2_dataset_close(void *dset, hid_t dxpl_id, void **req)
     H5VL_VarDef_t *varDef = (H5VL_VarDef_t *)(vol->m_ObjPtr);
 
     // H5VL_VarDef_t *varDef = (H5VL_VarDef_t *)dset;
+    gDetachFileDef(varDef);
     SAFE_FREE(varDef->m_Name);
     H5Sclose(varDef->m_ShapeID);
 
@@ -24,6 +24,17 @@ typedef struct H5VL_ADIOS2_t
 {
     adios2_engine *m_Engine;
     adios2_io *m_IO;
+
+    // reads are deferred until one of the limits is reached, H5Fflush or
+    // H5Fclose, if any limit is set (env ADIOS2_VOL_READ_BATCH[_SIZE])
+    size_t m_ReadBatchCount; // 0: no limit on the number of reads
+    size_t m_ReadBatchSize;  // bytes, 0: no limit on the size
+    size_t m_NumDeferredReads;
+    size_t m_DeferredReadSize;
+
+    // datasets opened for reading refer to the handle, it is freed by the
+    // last of H5Fclose and H5Dclose
+    size_t m_RefCount;
 } H5VL_FileDef_t;
 
 typedef struct H5VL_VARDef_t
@@ -38,6 +49,7 @@ typedef struct H5VL_VARDef_t
     adios2_engine *m_Engine;
     adios2_variable *m_Variable; // mainly for read reuse
     size_t m_DimCount;
+    H5VL_FileDef_t *m_FileDef; // NULL if not opened for reading
 } H5VL_VarDef_t;
 
 typedef struct H5VL_ATTRDef_t
@@ -273,6 +285,10 @@ extern adios2_variable *gADIOS2CreateVar(adios2_io *io, H5VL_VarDef_t *var);
 extern adios2_variable *gADIOS2DefineVar(adios2_io *io, H5VL_VarDef_t *varDef);
 extern adios2_variable *gADIOS2InqVar(adios2_io *io, const char *name);
 extern herr_t gADIOS2ReadVar(H5VL_VarDef_t *var);
+extern herr_t gADIOS2PerformGets(H5VL_FileDef_t *handle);
+extern H5VL_FileDef_t *gGetFileDef(H5VL_ObjDef_t *vol);
+extern void gAttachFileDef(H5VL_VarDef_t *varDef, H5VL_FileDef_t *handle);
+extern void gDetachFileDef(H5VL_VarDef_t *varDef);
 
 #ifdef __cplusplus
 }
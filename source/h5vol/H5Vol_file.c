@@ -45,6 +45,13 @@ herr_t H5VL_adios2_file_specific(void *file, H5VL_file_specific_args_t *args,
     //
     // This function is called after H5Fopen/create. Do not remove
     //
+    if ((NULL != args) && (H5VL_FILE_FLUSH == args->op_type))
+    {
+        // H5Fflush completes the deferred reads
+        H5VL_FileDef_t *handle = gGetFileDef((H5VL_ObjDef_t *)file);
+        if (NULL != handle)
+            return gADIOS2PerformGets(handle);
+    }
     return 0;
 }
 
@@ -53,7 +60,7 @@ herr_t H5VL_adios2_file_close(void *file, hid_t dxpl_id, void **req)
     H5VL_ObjDef_t *vol = (H5VL_ObjDef_t *)file;
     REQUIRE_SUCC((ROOT == vol->m_ObjType), -1);
     H5VL_FileDef_t *f = (H5VL_FileDef_t *)(vol->m_ObjPtr);
-    gADIOS2CloseFile(f); // f is freed in this call
+    gADIOS2CloseFile(f); // f is freed here or by the last H5Dclose
     gFreeVol(vol);
     return 0;
 }
@@ -0,0 +1,138 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPAdaptiveAggregation : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPAdaptiveAggregation() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_P(BPAdaptiveAggregation, WriteRead1D)
+{
+    /* The writer changes the number of aggregators (and subfiles) between
+     * steps while probing for the fastest setup. Every step must read back
+     * correctly from whichever subfile it ended up in. */
+    const std::string aggregationType = GetParam();
+    const std::string fname("BPAdaptiveAggregation_" + aggregationType +
+                            ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 1000;
+    const size_t NSteps = 6;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+
+    auto lf_StepData = [&](const size_t step, const int rank) {
+        std::vector<double> data(Nx);
+        std::iota(data.begin(), data.end(),
+                  static_cast<double>(step * 100000 + rank * Nx));
+        return data;
+    };
+
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        io.SetParameters({{"AggregationType", aggregationType},
+                          {"NumAggregators", "1"},
+                          {"AdaptiveAggregation", "true"},
+                          {"AdaptiveSteps", "4"}});
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+        auto var = io.DefineVariable<double>("r64", shape, start, count);
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            const std::vector<double> data = lf_StepData(step, mpiRank);
+            writer.BeginStep();
+            writer.Put(var, data.data());
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        EXPECT_EQ(reader.Steps(), NSteps);
+
+        size_t step = 0;
+        while (reader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var = io.InquireVariable<double>("r64");
+            ASSERT_TRUE(var);
+            ASSERT_EQ(var.Shape()[0], Nx * mpiSize);
+
+            std::vector<double> data;
+            var.SetSelection({{0}, {Nx * mpiSize}});
+            reader.Get(var, data, adios2::Mode::Sync);
+            for (int r = 0; r < mpiSize; ++r)
+            {
+                const std::vector<double> expected = lf_StepData(step, r);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    ASSERT_EQ(data[r * Nx + i], expected[i])
+                        << "step " << step << " writer " << r << " i " << i;
+                }
+            }
+            reader.EndStep();
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        reader.Close();
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AggregationType, BPAdaptiveAggregation,
+                         ::testing::Values("EveryoneWrites", "TwoLevelShm"));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    int result = RUN_ALL_TESTS();
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
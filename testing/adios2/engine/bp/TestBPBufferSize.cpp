@@ -259,6 +259,100 @@ TEST_F(BPBufferSizeTest, SyncDeferredIdenticalUsage)
     }
 }
 
+// A span stays valid while later Puts grow the buffer past its initial size
+TEST_F(BPBufferSizeTest, SpanWhileGrowing)
+{
+    const std::string fname = "ADIOS2BPBufferSizeSpanWhileGrowing.bp";
+    int mpiRank = 0, mpiSize = 1;
+    const std::size_t Nx = 100000;
+    const std::size_t NVars = 4;
+    const std::size_t NSteps = 2;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    const adios2::Dims shape{Nx * mpiSize};
+    const adios2::Dims start{Nx * mpiRank};
+    const adios2::Dims count{Nx};
+    auto lf_Value = [&](const size_t step, const size_t var, const size_t i) {
+        return static_cast<double>(step * 1000 + var * 100 + mpiRank) +
+               0.5 * static_cast<double>(i);
+    };
+
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("InitialBufferSize", "16Kb");
+        auto span = io.DefineVariable<double>("span", shape, start, count);
+        std::vector<adios2::Variable<double>> vars;
+        for (size_t v = 0; v < NVars; ++v)
+        {
+            vars.push_back(io.DefineVariable<double>(
+                "r64_" + std::to_string(v), shape, start, count));
+        }
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            adios2::Variable<double>::Span spanData = writer.Put(span);
+            for (size_t v = 0; v < NVars; ++v)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = lf_Value(step, v, i);
+                }
+                writer.Put(vars[v], data.data(), adios2::Mode::Sync);
+            }
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                spanData[i] = lf_Value(step, NVars, i);
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        std::vector<double> in;
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+            for (size_t v = 0; v <= NVars; ++v)
+            {
+                const std::string name =
+                    v < NVars ? "r64_" + std::to_string(v) : "span";
+                auto var = io.InquireVariable<double>(name);
+                ASSERT_TRUE(var);
+                var.SetSelection({start, count});
+                reader.Get(var, in, adios2::Mode::Sync);
+                ASSERT_EQ(in.size(), Nx);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    ASSERT_EQ(in[i], lf_Value(step, v, i))
+                        << name << " step " << step << " i " << i;
+                }
+            }
+            reader.EndStep();
+        }
+        reader.Close();
+    }
+}
+
 //******************************************************************************
 // main
 //******************************************************************************
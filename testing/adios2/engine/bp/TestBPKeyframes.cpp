@@ -0,0 +1,247 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPKeyframes : public ::testing::Test
+{
+public:
+    BPKeyframes() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+namespace
+{
+const size_t Ny = 64;
+const size_t Nx = 128;
+const size_t NSteps = 12;
+
+/* A smooth field in which one column changes per step. Block 1 of a rank
+ * changes its size in step 5 and is all new in step 9. */
+double Value(const size_t step, const size_t block, const size_t y,
+             const size_t x)
+{
+    if (block == 1 && step == 9)
+    {
+        return std::sin(1.7 * y * x + step);
+    }
+    double v = std::sin(0.05 * y) * std::cos(0.03 * x) + block;
+    if (x <= step)
+    {
+        v += 0.001 * x;
+    }
+    return v;
+}
+
+size_t BlockRows(const size_t step, const size_t block)
+{
+    return (block == 1 && step >= 5) ? Ny / 2 : Ny;
+}
+
+size_t DataSize(const std::string &name)
+{
+    size_t size = 0;
+    for (int i = 0;; ++i)
+    {
+        std::ifstream f(name + "/data." + std::to_string(i),
+                        std::ios::binary | std::ios::ate);
+        if (!f)
+        {
+            break;
+        }
+        size += static_cast<size_t>(f.tellg());
+    }
+    return size;
+}
+
+/* Global array r64 of 2 blocks per rank, compressed with bzip2 */
+void WriteSteps(const std::string &fname, const std::string &interval)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine(engineName);
+    io.SetParameter("KeyframeInterval", interval);
+
+    auto r64 = io.DefineVariable<double>("r64", {2 * Ny * mpiSize, Nx},
+                                         {0, 0}, {Ny, Nx});
+    r64.AddOperation("bzip2", {});
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+    std::vector<double> data[2];
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        writer.BeginStep();
+        for (size_t block = 0; block < 2; ++block)
+        {
+            const size_t rows = BlockRows(step, block);
+            data[block].resize(rows * Nx);
+            for (size_t y = 0; y < rows; ++y)
+            {
+                for (size_t x = 0; x < Nx; ++x)
+                {
+                    data[block][y * Nx + x] = Value(step, block, y, x);
+                }
+            }
+            r64.SetSelection({{(2 * mpiRank + block) * Ny, 0}, {rows, Nx}});
+            writer.Put(r64, data[block].data());
+        }
+        writer.EndStep();
+    }
+    writer.Close();
+}
+
+void CheckBlock(const std::vector<double> &in, const size_t step,
+                const size_t block, const size_t y0, const size_t ny,
+                const size_t x0, const size_t nx)
+{
+    ASSERT_EQ(in.size(), ny * nx);
+    for (size_t y = 0; y < ny; ++y)
+    {
+        for (size_t x = 0; x < nx; ++x)
+        {
+            ASSERT_EQ(in[y * nx + x], Value(step, block, y0 + y, x0 + x))
+                << "step " << step << " block " << block << " y " << y0 + y
+                << " x " << x0 + x;
+        }
+    }
+}
+
+/* the whole blocks of this rank and part of its first block */
+void ReadStep(adios2::Engine &reader, adios2::Variable<double> &r64,
+              const size_t step, const int rank)
+{
+    std::vector<double> in[2], part;
+    for (size_t block = 0; block < 2; ++block)
+    {
+        r64.SetBlockSelection(rank * 2 + block);
+        reader.Get(r64, in[block]);
+    }
+    reader.PerformGets();
+    r64.SetBlockSelection(rank * 2);
+    r64.SetSelection({{10, 20}, {7, 50}});
+    reader.Get(r64, part, adios2::Mode::Sync);
+    for (size_t block = 0; block < 2; ++block)
+    {
+        CheckBlock(in[block], step, block, 0, BlockRows(step, block), 0, Nx);
+    }
+    CheckBlock(part, step, 0, 10, 7, 20, 50);
+}
+}
+
+TEST_F(BPKeyframes, ADIOS2BPKeyframes)
+{
+    const std::string fname("BPKeyframes.bp");
+    const std::string fnameFull("BPKeyframesFull.bp");
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+
+    WriteSteps(fname, "4");
+    WriteSteps(fnameFull, "0");
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    if (mpiRank == 0)
+    {
+        EXPECT_LT(DataSize(fname) * 2, DataSize(fnameFull));
+    }
+
+    // every step
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+            auto r64 = io.InquireVariable<double>("r64");
+            ASSERT_TRUE(r64);
+            ReadStep(reader, r64, step, mpiRank);
+            reader.EndStep();
+        }
+        reader.Close();
+    }
+
+    // steps 2, 5, 8, 11 only, which do not include most keyframes
+    {
+        adios2::IO io = adios.DeclareIO("ReadSelectedIO");
+        io.SetEngine(engineName);
+        io.SetParameters({{"SelectSteps", "2:n:3"}, {"Threads", "2"}});
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        for (size_t step = 2; step < NSteps; step += 3)
+        {
+            ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+            auto r64 = io.InquireVariable<double>("r64");
+            ASSERT_TRUE(r64);
+            ReadStep(reader, r64, step, mpiRank);
+            reader.EndStep();
+        }
+        ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::EndOfStream);
+        reader.Close();
+    }
+
+    // random access, last step first
+    {
+        adios2::IO io = adios.DeclareIO("ReadRandomAccessIO");
+        io.SetEngine(engineName);
+        adios2::Engine reader =
+            io.Open(fname, adios2::Mode::ReadRandomAccess);
+        auto r64 = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(r64);
+        for (size_t i = 0; i < NSteps; ++i)
+        {
+            const size_t step = NSteps - 1 - i;
+            r64.SetStepSelection({step, 1});
+            ReadStep(reader, r64, step, mpiRank);
+        }
+        reader.Close();
+    }
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
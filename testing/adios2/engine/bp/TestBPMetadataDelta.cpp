@@ -0,0 +1,398 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPMetadataDelta : public ::testing::Test
+{
+public:
+    BPMetadataDelta() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+namespace
+{
+const size_t Nx = 10;
+const size_t NSteps = 8;
+
+/* Number of blocks a rank writes of the global array in a step: the layout
+ * repeats, except for steps 3 (more blocks) and 5 (fewer blocks) */
+size_t BlocksInStep(const size_t step)
+{
+    if (step == 3)
+    {
+        return 3;
+    }
+    if (step == 5)
+    {
+        return 1;
+    }
+    return 2;
+}
+
+double Value(const size_t step, const size_t block, const int rank,
+             const size_t i)
+{
+    return static_cast<double>(step * 10000 + block * 1000 + rank * 100 + i);
+}
+
+size_t FileSize(const std::string &name)
+{
+    std::ifstream f(name, std::ios::binary | std::ios::ate);
+    return static_cast<size_t>(f.tellg());
+}
+
+/* Global array r64 of 2 blocks per rank and a local array l32, which is
+ * skipped in step 6 */
+void WriteSteps(const std::string &fname, const std::string &metadataDelta)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine(engineName);
+    io.SetParameter("MetadataDelta", metadataDelta);
+
+    const size_t maxBlocks = 3;
+    auto r64 = io.DefineVariable<double>("r64", {maxBlocks * Nx * mpiSize},
+                                         {0}, {Nx});
+    auto l32 = io.DefineVariable<int32_t>("l32", {}, {}, {Nx});
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+    std::vector<std::vector<double>> r64Data(maxBlocks,
+                                             std::vector<double>(Nx));
+    std::vector<int32_t> l32Data(Nx);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        writer.BeginStep();
+        for (size_t b = 0; b < BlocksInStep(step); ++b)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                r64Data[b][i] = Value(step, b, mpiRank, i);
+            }
+            r64.SetSelection({{(mpiRank * maxBlocks + b) * Nx}, {Nx}});
+            writer.Put(r64, r64Data[b].data());
+        }
+        if (step != 6)
+        {
+            std::iota(l32Data.begin(), l32Data.end(),
+                      static_cast<int32_t>(step * 100 + mpiRank));
+            writer.Put(l32, l32Data.data());
+        }
+        writer.EndStep();
+    }
+    writer.Close();
+}
+
+void CheckStep(adios2::IO &io, adios2::Engine &reader, const size_t step,
+               const int mpiSize)
+{
+    auto r64 = io.InquireVariable<double>("r64");
+    ASSERT_TRUE(r64);
+    const size_t nBlocks = BlocksInStep(step);
+    const auto blocks = reader.BlocksInfo(r64, step);
+    ASSERT_EQ(blocks.size(), nBlocks * mpiSize);
+    std::vector<double> data;
+    for (int rank = 0; rank < mpiSize; ++rank)
+    {
+        for (size_t b = 0; b < nBlocks; ++b)
+        {
+            const auto &info = blocks[rank * nBlocks + b];
+            ASSERT_EQ(info.Count.size(), 1u);
+            EXPECT_EQ(info.Count[0], Nx);
+            EXPECT_EQ(info.Start[0], (rank * 3 + b) * Nx);
+
+            r64.SetSelection({{(rank * 3 + b) * Nx}, {Nx}});
+            reader.Get(r64, data, adios2::Mode::Sync);
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                EXPECT_EQ(data[i], Value(step, b, rank, i));
+            }
+        }
+    }
+
+    if (step >= 6)
+    {
+        return; // l32 is not written in step 6, read in streaming mode only
+    }
+    auto l32 = io.InquireVariable<int32_t>("l32");
+    ASSERT_TRUE(l32);
+    l32.SetStepSelection({step, 1});
+    std::vector<int32_t> ldata;
+    for (int rank = 0; rank < mpiSize; ++rank)
+    {
+        l32.SetBlockSelection(rank);
+        reader.Get(l32, ldata, adios2::Mode::Sync);
+        ASSERT_EQ(ldata.size(), Nx);
+        EXPECT_EQ(ldata[0], static_cast<int32_t>(step * 100 + rank));
+    }
+}
+}
+
+TEST_F(BPMetadataDelta, WriteReadSteps)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    const std::string fname("BPMetadataDelta.bp");
+    WriteSteps(fname, "true");
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+        EXPECT_EQ(reader.CurrentStep(), step);
+        auto r64 = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(r64);
+        const size_t nBlocks = BlocksInStep(step);
+        const auto blocks = reader.BlocksInfo(r64, step);
+        ASSERT_EQ(blocks.size(), nBlocks * mpiSize);
+        std::vector<double> data;
+        for (int rank = 0; rank < mpiSize; ++rank)
+        {
+            for (size_t b = 0; b < nBlocks; ++b)
+            {
+                EXPECT_EQ(blocks[rank * nBlocks + b].Start[0],
+                          (rank * 3 + b) * Nx);
+                r64.SetSelection({{(rank * 3 + b) * Nx}, {Nx}});
+                reader.Get(r64, data, adios2::Mode::Sync);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    EXPECT_EQ(data[i], Value(step, b, rank, i));
+                }
+            }
+        }
+        auto l32 = io.InquireVariable<int32_t>("l32");
+        EXPECT_EQ(static_cast<bool>(l32), step != 6);
+        if (l32)
+        {
+            std::vector<int32_t> ldata;
+            for (int rank = 0; rank < mpiSize; ++rank)
+            {
+                l32.SetBlockSelection(rank);
+                reader.Get(l32, ldata, adios2::Mode::Sync);
+                ASSERT_EQ(ldata.size(), Nx);
+                EXPECT_EQ(ldata[0], static_cast<int32_t>(step * 100 + rank));
+            }
+        }
+        reader.EndStep();
+    }
+    EXPECT_EQ(reader.BeginStep(), adios2::StepStatus::EndOfStream);
+    reader.Close();
+}
+
+TEST_F(BPMetadataDelta, RandomAccess)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    const std::string fname("BPMetadataDeltaRA.bp");
+    const std::string fnameFull("BPMetadataDeltaFull.bp");
+    WriteSteps(fname, "true");
+    WriteSteps(fnameFull, "false");
+
+    if (!mpiRank)
+    {
+        // Shape, Count and Offsets are sent only in steps 0, 3, 4, 5 and 6
+        EXPECT_LT(FileSize(fname + "/md.0"), FileSize(fnameFull + "/md.0"));
+    }
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    EXPECT_EQ(reader.Steps(), NSteps);
+    // out of order, the layouts of all steps must stay valid
+    for (size_t step = NSteps; step-- > 0;)
+    {
+        auto r64 = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(r64);
+        r64.SetStepSelection({step, 1});
+        CheckStep(io, reader, step, mpiSize);
+    }
+    reader.Close();
+}
+
+TEST_F(BPMetadataDelta, RandomAccessThreads)
+{
+    int mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    const std::string fname("BPMetadataDeltaThreads.bp");
+    WriteSteps(fname, "true");
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    // the metadata of r64 and l32 is installed by different threads
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    io.SetParameter("Threads", "4");
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    EXPECT_EQ(reader.Steps(), NSteps);
+    auto r64 = io.InquireVariable<double>("r64");
+    ASSERT_TRUE(r64);
+    EXPECT_EQ(r64.Steps(), NSteps);
+    auto l32 = io.InquireVariable<int32_t>("l32");
+    ASSERT_TRUE(l32);
+    EXPECT_EQ(l32.Steps(), NSteps - 1);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        r64.SetStepSelection({step, 1});
+        CheckStep(io, reader, step, mpiSize);
+    }
+    reader.Close();
+}
+
+TEST_F(BPMetadataDelta, RandomAccessMetadataCache)
+{
+    int mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    const std::string fname("BPMetadataDeltaCache.bp");
+    WriteSteps(fname, "true");
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    // no more than one step of metadata is kept after each call
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    io.SetParameter("MetadataCacheSize", "1");
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    EXPECT_EQ(reader.Steps(), NSteps);
+    auto r64 = io.InquireVariable<double>("r64");
+    ASSERT_TRUE(r64);
+    EXPECT_EQ(r64.Steps(), NSteps);
+    for (size_t i = 0; i < 2 * NSteps; ++i)
+    {
+        const size_t step = (i * 5) % NSteps;
+        r64.SetStepSelection({step, 1});
+        CheckStep(io, reader, step, mpiSize);
+    }
+
+    // a pending Get keeps the metadata of its step
+    std::vector<double> data;
+    r64.SetStepSelection({1, 1});
+    r64.SetSelection({{0}, {Nx}});
+    reader.Get(r64, data);
+    for (size_t step = 2; step < NSteps; ++step)
+    {
+        EXPECT_EQ(reader.BlocksInfo(r64, step).size(),
+                  BlocksInStep(step) * mpiSize);
+    }
+    reader.PerformGets();
+    ASSERT_EQ(data.size(), Nx);
+    for (size_t i = 0; i < Nx; ++i)
+    {
+        EXPECT_EQ(data[i], Value(1, 0, 0, i));
+    }
+    reader.Close();
+}
+
+TEST_F(BPMetadataDelta, RandomAccessMetadataCacheSelectSteps)
+{
+    int mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    const std::string fname("BPMetadataDeltaCacheSelect.bp");
+    WriteSteps(fname, "false");
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    // only the md.0 ranges of steps 3, 5 and 7 are read
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    io.SetParameters({{"MetadataCacheSize", "1"}, {"SelectSteps", "3:n:2"}});
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    const size_t nSelected = 3;
+    EXPECT_EQ(reader.Steps(), nSelected);
+    auto r64 = io.InquireVariable<double>("r64");
+    ASSERT_TRUE(r64);
+    EXPECT_EQ(r64.Steps(), nSelected);
+    std::vector<double> data;
+    for (size_t i = 0; i < 2 * nSelected; ++i)
+    {
+        const size_t step = (i * 2) % nSelected;
+        const size_t fileStep = 3 + 2 * step;
+        EXPECT_EQ(reader.BlocksInfo(r64, step).size(),
+                  BlocksInStep(fileStep) * mpiSize);
+        r64.SetStepSelection({step, 1});
+        r64.SetSelection({{0}, {Nx}});
+        reader.Get(r64, data, adios2::Mode::Sync);
+        ASSERT_EQ(data.size(), Nx);
+        for (size_t j = 0; j < Nx; ++j)
+        {
+            EXPECT_EQ(data[j], Value(fileStep, 0, 0, j));
+        }
+    }
+    reader.Close();
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -59,7 +59,16 @@ public:
 
     bool OutputWritten = false;
 
-    void CreateOutput()
+    // every case, thread count and engine writes its own file so that the
+    // tests can run concurrently
+    std::string FileName(const std::string &testName, int nThreads,
+                         int mpiSize)
+    {
+        return "BPReadMultithreaded" + testName + std::to_string(nThreads) +
+               "." + engineName + "." + std::to_string(mpiSize) + ".bp";
+    }
+
+    void CreateOutput(const std::string &filename)
     {
         // This is not really a test but to create a dataset for all read tests
         if (OutputWritten)
@@ -77,8 +86,6 @@ public:
 #else
         adios2::ADIOS adios;
 #endif
-        std::string filename =
-            "BPReadMultithreaded" + std::to_string(mpiSize) + ".bp";
         adios2::IO ioWrite = adios.DeclareIO("TestIOWrite");
         ioWrite.SetEngine(engineName);
         adios2::Engine engine = ioWrite.Open(filename, adios2::Mode::Write);
@@ -132,14 +139,16 @@ TEST_P(BPReadMultithreadedTestP, ReadFile)
 #else
     adios2::ADIOS adios;
 #endif
-    CreateOutput();
-    std::string filename =
-        "BPReadMultithreaded" + std::to_string(mpiSize) + ".bp";
+    std::string filename = FileName("ReadFile", nThreads, mpiSize);
+    CreateOutput(filename);
     adios2::IO ioRead = adios.DeclareIO("TestIORead");
     ioRead.SetEngine(engineName);
     ioRead.SetParameter("Threads", std::to_string(nThreads));
+    // BP4 reads all steps in Read mode when BeginStep is not called
     adios2::Engine reader =
-        ioRead.Open(filename, adios2::Mode::ReadRandomAccess);
+        ioRead.Open(filename, engineName == "BP4"
+                                  ? adios2::Mode::Read
+                                  : adios2::Mode::ReadRandomAccess);
     EXPECT_TRUE(reader);
 
     const size_t nsteps = reader.Steps();
@@ -202,9 +211,8 @@ TEST_P(BPReadMultithreadedTestP, ReadStream)
 #else
     adios2::ADIOS adios;
 #endif
-    CreateOutput();
-    std::string filename =
-        "BPReadMultithreaded" + std::to_string(mpiSize) + ".bp";
+    std::string filename = FileName("ReadStream", nThreads, mpiSize);
+    CreateOutput(filename);
     adios2::IO ioRead = adios.DeclareIO("TestIORead");
     ioRead.SetEngine(engineName);
     ioRead.SetParameter("Threads", std::to_string(nThreads));
@@ -256,6 +264,97 @@ TEST_P(BPReadMultithreadedTestP, ReadStream)
 #endif
 }
 
+#if defined(ADIOS2_HAVE_BLOSC) || defined(ADIOS2_HAVE_BZIP2)
+// Blocks of one compressed variable are decompressed on several threads
+TEST_P(BPReadMultithreadedTestP, ReadCompressed)
+{
+    int mpiRank = 0, mpiSize = 1;
+    int nThreads = GetThreads();
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+#ifdef ADIOS2_HAVE_BLOSC
+    const std::string opType = adios2::ops::LosslessBlosc;
+#else
+    const std::string opType = adios2::ops::LosslessBZIP2;
+#endif
+    const std::string filename = FileName("ReadCompressed", nThreads, mpiSize);
+    const size_t NBlocks = 16;
+    const size_t NxBlock = 5000;
+    auto lf_Value = [](const size_t step, const size_t i) {
+        return static_cast<int32_t>((i * 7 + step * 13) % 1000);
+    };
+
+    {
+        adios2::IO ioWrite = adios.DeclareIO("TestIOWriteCompressed");
+        ioWrite.SetEngine(engineName);
+        const size_t Nx = NBlocks * NxBlock;
+        auto var = ioWrite.DefineVariable<int32_t>(
+            "c", {mpiSize * Nx}, {mpiRank * Nx}, {NxBlock});
+        var.AddOperation(adios.DefineOperator("Compressor", opType));
+        adios2::Engine writer = ioWrite.Open(filename, adios2::Mode::Write);
+        std::vector<int32_t> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                data[i] = lf_Value(step, mpiRank * Nx + i);
+            }
+            writer.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                var.SetSelection({{mpiRank * Nx + b * NxBlock}, {NxBlock}});
+                writer.Put(var, data.data() + b * NxBlock, adios2::Mode::Sync);
+            }
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    adios2::IO ioRead = adios.DeclareIO("TestIORead");
+    ioRead.SetEngine(engineName);
+    ioRead.SetParameter("Threads", std::to_string(nThreads));
+    adios2::Engine reader =
+        ioRead.Open(filename, engineName == "BP4"
+                                  ? adios2::Mode::Read
+                                  : adios2::Mode::ReadRandomAccess);
+    const size_t nsteps = reader.Steps();
+    EXPECT_EQ(nsteps, NSteps);
+    auto var = ioRead.InquireVariable<int32_t>("c");
+    ASSERT_TRUE(var);
+    const size_t Nx = NBlocks * NxBlock;
+    // the selection cuts into the first and the last block
+    const size_t start = mpiRank * Nx + NxBlock / 2;
+    const size_t count = Nx - NxBlock;
+    var.SetSelection({{start}, {count}});
+    var.SetStepSelection({0, nsteps});
+    std::vector<int32_t> res(nsteps * count);
+    reader.Get(var, res.data(), adios2::Mode::Deferred);
+    reader.PerformGets();
+    reader.Close();
+
+    for (size_t step = 0; step < nsteps; ++step)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            ASSERT_EQ(res[step * count + i], lf_Value(step, start + i))
+                << "step " << step << " i " << i;
+        }
+    }
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+#endif
+
 INSTANTIATE_TEST_SUITE_P(BPReadMultithreadedTest, BPReadMultithreadedTestP,
                          ::testing::Values(1, 2, 3, 0));
 
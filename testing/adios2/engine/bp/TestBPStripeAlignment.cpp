@@ -0,0 +1,162 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPStripeAlignment : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPStripeAlignment() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+namespace
+{
+/* Write NSteps of a small 1D array with a StripeSize that does not match the
+ * stripe size of the data files and return the content of profiling.json */
+std::string WriteSteps(const std::string &fname,
+                       const std::string &aggregationType,
+                       const adios2::Params &parameters, const size_t Nx,
+                       const size_t NSteps)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine(engineName);
+    io.SetParameter("AggregationType", aggregationType);
+    io.SetParameter("StripeSize", "100");
+    io.SetParameters(parameters);
+
+    auto var = io.DefineVariable<double>("r64", {Nx * mpiSize}, {Nx * mpiRank},
+                                         {Nx});
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+    std::vector<double> data(Nx);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        std::iota(data.begin(), data.end(),
+                  static_cast<double>(step * 10000 + mpiRank * Nx));
+        writer.BeginStep();
+        writer.Put(var, data.data());
+        writer.EndStep();
+    }
+    writer.Close();
+
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    std::ifstream profilingJSONFile(fname + "/profiling.json");
+    return std::string(std::istreambuf_iterator<char>(profilingJSONFile),
+                       std::istreambuf_iterator<char>());
+}
+}
+
+TEST_P(BPStripeAlignment, Misaligned)
+{
+    /* Without AlignToFileStripes the blocks are padded to StripeSize only,
+     * which is not a multiple of the 64KB stripe of the data files */
+    const std::string aggregationType = GetParam();
+    const std::string fname("BPStripeMisaligned_" + aggregationType + ".bp");
+
+    const std::string profilingJSON =
+        WriteSteps(fname, aggregationType, {{"FileStripeSize", "64KB"}}, 10, 3);
+    ASSERT_FALSE(profilingJSON.empty());
+    EXPECT_NE(profilingJSON.find("\"write_bytes\""), std::string::npos);
+    EXPECT_NE(profilingJSON.find("\"misaligned_bytes\""), std::string::npos);
+}
+
+TEST_P(BPStripeAlignment, WriteRead1D)
+{
+    /* AlignToFileStripes replaces StripeSize with the 64KB stripe size of the
+     * data files, no write may start in the middle of a stripe */
+    const std::string aggregationType = GetParam();
+    const std::string fname("BPStripeAligned_" + aggregationType + ".bp");
+    const size_t Nx = 1000;
+    const size_t NSteps = 3;
+
+    const std::string profilingJSON =
+        WriteSteps(fname, aggregationType,
+                   {{"FileStripeCount", "1"},
+                    {"FileStripeSize", "64KB"},
+                    {"AlignToFileStripes", "true"}},
+                   Nx, NSteps);
+    ASSERT_FALSE(profilingJSON.empty());
+    EXPECT_NE(profilingJSON.find("\"write_bytes\""), std::string::npos);
+    EXPECT_EQ(profilingJSON.find("\"misaligned_bytes\""), std::string::npos);
+
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+    std::vector<double> data;
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+        auto var = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(var);
+        var.SetSelection({{Nx * mpiRank}, {Nx}});
+        reader.Get(var, data, adios2::Mode::Sync);
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            EXPECT_EQ(data[i], static_cast<double>(step * 10000 +
+                                                   mpiRank * Nx + i));
+        }
+        reader.EndStep();
+    }
+    reader.Close();
+}
+
+INSTANTIATE_TEST_SUITE_P(AggregationType, BPStripeAlignment,
+                         ::testing::Values("EveryoneWrites", "TwoLevelShm"));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 #include <adios2.h>
 
@@ -971,6 +972,171 @@ void WriteAggRead2D2x4(const std::string substreams)
     }
 }
 
+// blocks of different sizes passed to the aggregators through a tree
+void WriteAggReadTree(const std::string substreams)
+{
+    const std::string fname("BPWriteAggregateReadTree_" + substreams + ".bp");
+    const size_t NSteps = 3;
+
+    int mpiRank = 0, mpiSize = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+
+    auto lf_Count = [](const int rank) -> size_t {
+        return 1 + static_cast<size_t>(rank % 3) * 500;
+    };
+    size_t start = 0, shape = 0;
+    for (int r = 0; r < mpiSize; ++r)
+    {
+        if (r == mpiRank)
+        {
+            start = shape;
+        }
+        shape += lf_Count(r);
+    }
+    const size_t count = lf_Count(mpiRank);
+
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        io.SetEngine(engineName.empty() ? "File" : engineName);
+        io.SetParameter("NumAggregators", substreams);
+        io.SetParameter("AggregationFanIn", "2");
+        io.SetParameter("AggregationBuffers", "3");
+        auto var = io.DefineVariable<double>("r64", {shape}, {start}, {count});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> data(count);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                data[i] = static_cast<double>(step * shape + start + i);
+            }
+            bpWriter.BeginStep();
+            bpWriter.Put(var, data.data(), adios2::Mode::Sync);
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName.empty() ? "File" : engineName);
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        std::vector<double> in;
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            ASSERT_EQ(bpReader.BeginStep(), adios2::StepStatus::OK);
+            auto var = io.InquireVariable<double>("r64");
+            ASSERT_TRUE(var);
+            ASSERT_EQ(var.Shape()[0], shape);
+            bpReader.Get(var, in, adios2::Mode::Sync);
+            bpReader.EndStep();
+            for (size_t i = 0; i < shape; ++i)
+            {
+                ASSERT_EQ(in[i], static_cast<double>(step * shape + i))
+                    << "step " << step << " i " << i;
+            }
+        }
+        bpReader.Close();
+    }
+}
+
+// metadata of different numbers of blocks per rank merged through a tree
+void WriteAggReadMetadataTree(const std::string substreams)
+{
+    const std::string fname("BPWriteAggregateReadMetadataTree_" + substreams +
+                            ".bp");
+    const size_t NSteps = 4;
+    const size_t Nx = 10;
+
+    int mpiRank = 0, mpiSize = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+
+    auto lf_Blocks = [](const int rank) -> size_t {
+        return 1 + static_cast<size_t>(rank % 2);
+    };
+    auto lf_Value = [](const size_t step, const int rank, const size_t block,
+                       const size_t i) -> double {
+        return static_cast<double>(step * 10000 + rank * 100 + block * 10 + i);
+    };
+
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        io.SetEngine(engineName.empty() ? "File" : engineName);
+        io.SetParameter("NumAggregators", substreams);
+        io.SetParameter("MetadataFanIn", "2");
+        auto var = io.DefineVariable<double>("local", {}, {}, {Nx});
+        auto scalar = io.DefineVariable<int32_t>("step");
+        io.DefineAttribute<std::string>("note", "metadata tree");
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            if (mpiRank == 0)
+            {
+                bpWriter.Put(scalar, static_cast<int32_t>(step));
+            }
+            for (size_t b = 0; b < lf_Blocks(mpiRank); ++b)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = lf_Value(step, mpiRank, b, i);
+                }
+                bpWriter.Put(var, data.data(), adios2::Mode::Sync);
+            }
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName.empty() ? "File" : engineName);
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        std::vector<double> in;
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            ASSERT_EQ(bpReader.BeginStep(), adios2::StepStatus::OK);
+            auto attr = io.InquireAttribute<std::string>("note");
+            ASSERT_TRUE(attr);
+            EXPECT_EQ(attr.Data().front(), "metadata tree");
+            auto scalar = io.InquireVariable<int32_t>("step");
+            ASSERT_TRUE(scalar);
+            int32_t stepValue = -1;
+            bpReader.Get(scalar, stepValue, adios2::Mode::Sync);
+            EXPECT_EQ(stepValue, static_cast<int32_t>(step));
+
+            auto var = io.InquireVariable<double>("local");
+            ASSERT_TRUE(var);
+            size_t blockID = 0;
+            for (int r = 0; r < mpiSize; ++r)
+            {
+                for (size_t b = 0; b < lf_Blocks(r); ++b, ++blockID)
+                {
+                    var.SetBlockSelection(blockID);
+                    bpReader.Get(var, in, adios2::Mode::Sync);
+                    ASSERT_EQ(in.size(), Nx);
+                    for (size_t i = 0; i < Nx; ++i)
+                    {
+                        ASSERT_EQ(in[i], lf_Value(step, r, b, i))
+                            << "step " << step << " block " << blockID;
+                    }
+                }
+            }
+            EXPECT_EQ(bpReader.BlocksInfo(var, bpReader.CurrentStep()).size(),
+                      blockID);
+            bpReader.EndStep();
+        }
+        bpReader.Close();
+    }
+}
+
 class BPWriteAggregateReadTest : public ::testing::TestWithParam<std::string>
 {
 public:
@@ -997,6 +1163,16 @@ TEST_P(BPWriteAggregateReadTest, ADIOS2BPWriteAggregateRead2D4x2)
     WriteAggRead2D4x2(GetParam());
 }
 
+TEST_P(BPWriteAggregateReadTest, ADIOS2BPWriteAggregateReadTree)
+{
+    WriteAggReadTree(GetParam());
+}
+
+TEST_P(BPWriteAggregateReadTest, ADIOS2BPWriteAggregateReadMetadataTree)
+{
+    WriteAggReadMetadataTree(GetParam());
+}
+
 INSTANTIATE_TEST_SUITE_P(Substreams, BPWriteAggregateReadTest,
                          ::testing::Values("1", "2", "3", "4", "5", "0"));
 
@@ -845,6 +845,288 @@ void BZIP2Accuracy3DSel(const std::string accuracy)
     }
 }
 
+void BZIP2Blocks2D(const std::string accuracy)
+{
+    // Each process writes NBlocks blocks of Ny x Nx side by side, read back
+    // with several reader threads as whole blocks, as a selection spanning
+    // blocks and as block selections
+    const std::string fname("BPWRBZIP2Blocks2D_" + accuracy + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 50;
+    const size_t Ny = 20;
+    const size_t NBlocks = 4;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    const size_t NCols = Nx * NBlocks * mpiSize;
+    auto lf_Value = [&](const size_t y, const size_t x) {
+        return static_cast<double>(y * NCols + x);
+    };
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            // Create the BP Engine
+            io.SetEngine("BPFile");
+        }
+
+        auto var_r64 =
+            io.DefineVariable<double>("r64", {Ny, NCols}, {0, 0}, {Ny, Nx});
+        adios2::Operator BZIP2Op =
+            adios.DefineOperator("BZIP2Compressor", adios2::ops::LosslessBZIP2);
+        var_r64.AddOperation(
+            BZIP2Op, {{adios2::ops::bzip2::key::blockSize100k, accuracy}});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        bpWriter.BeginStep();
+        std::vector<double> r64s(Ny * Nx);
+        for (size_t b = 0; b < NBlocks; ++b)
+        {
+            const size_t x0 = (mpiRank * NBlocks + b) * Nx;
+            for (size_t y = 0; y < Ny; ++y)
+            {
+                for (size_t x = 0; x < Nx; ++x)
+                {
+                    r64s[y * Nx + x] = lf_Value(y, x0 + x);
+                }
+            }
+            var_r64.SetSelection({{0, x0}, {Ny, Nx}});
+            bpWriter.Put(var_r64, r64s.data(), adios2::Mode::Sync);
+        }
+        bpWriter.EndStep();
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            // Create the BP Engine
+            io.SetEngine("BPFile");
+        }
+        io.SetParameter("Threads", "2");
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        ASSERT_EQ(bpReader.BeginStep(), adios2::StepStatus::OK);
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+
+        // all blocks of this rank, one after the other
+        std::vector<std::vector<double>> blocks(NBlocks);
+        for (size_t b = 0; b < NBlocks; ++b)
+        {
+            const size_t x0 = (mpiRank * NBlocks + b) * Nx;
+            var_r64.SetSelection({{0, x0}, {Ny, Nx}});
+            bpReader.Get(var_r64, blocks[b]);
+        }
+        // the middle of the first two blocks, rows 1 to Ny-2
+        const size_t sx0 = mpiRank * NBlocks * Nx + Nx / 2;
+        std::vector<double> span;
+        var_r64.SetSelection({{1, sx0}, {Ny - 2, Nx}});
+        bpReader.Get(var_r64, span);
+        // the last block of this rank as a block selection
+        std::vector<double> local;
+        var_r64.SetBlockSelection(mpiRank * NBlocks + NBlocks - 1);
+        bpReader.Get(var_r64, local);
+        bpReader.EndStep();
+
+        for (size_t b = 0; b < NBlocks; ++b)
+        {
+            const size_t x0 = (mpiRank * NBlocks + b) * Nx;
+            for (size_t y = 0; y < Ny; ++y)
+            {
+                for (size_t x = 0; x < Nx; ++x)
+                {
+                    ASSERT_EQ(blocks[b][y * Nx + x], lf_Value(y, x0 + x))
+                        << "block=" << b << " y=" << y << " x=" << x
+                        << " rank=" << mpiRank;
+                }
+            }
+        }
+        for (size_t y = 0; y < Ny - 2; ++y)
+        {
+            for (size_t x = 0; x < Nx; ++x)
+            {
+                ASSERT_EQ(span[y * Nx + x], lf_Value(y + 1, sx0 + x))
+                    << "y=" << y << " x=" << x << " rank=" << mpiRank;
+            }
+        }
+        ASSERT_EQ(local, blocks[NBlocks - 1]);
+        bpReader.Close();
+    }
+}
+
+void BZIP2Chunks2D()
+{
+    // Each process writes one block of Ny x Nx hardly compressible values,
+    // compressed in chunks of rows, and reads back all of it, rows across
+    // chunk boundaries, a single row and rows of its block in random access
+    // mode
+    const std::string fname("BPWRBZIP2Chunks2D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 1000;
+    const size_t Ny = 200;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    const size_t NCols = Nx * mpiSize;
+    auto lf_Value = [&](const size_t y, const size_t x) {
+        uint64_t h = (y * NCols + x + 1) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 32;
+        return static_cast<double>(h >> 11) / 9007199254740992.0;
+    };
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            // Create the BP Engine
+            io.SetEngine("BPFile");
+        }
+        io.SetParameter("OperatorChunkSize", "64Kb");
+        io.SetParameter("OperatorChunkThreads", "2");
+
+        const size_t x0 = mpiRank * Nx;
+        auto var_r64 =
+            io.DefineVariable<double>("r64", {Ny, NCols}, {0, x0}, {Ny, Nx});
+        var_r64.AddOperation(adios2::ops::LosslessBZIP2);
+
+        std::vector<double> r64s(Ny * Nx);
+        for (size_t y = 0; y < Ny; ++y)
+        {
+            for (size_t x = 0; x < Nx; ++x)
+            {
+                r64s[y * Nx + x] = lf_Value(y, x0 + x);
+            }
+        }
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        bpWriter.BeginStep();
+        bpWriter.Put(var_r64, r64s.data());
+        bpWriter.EndStep();
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            // Create the BP Engine
+            io.SetEngine("BPFile");
+        }
+        io.SetParameter("Threads", "2");
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        ASSERT_EQ(bpReader.BeginStep(), adios2::StepStatus::OK);
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+
+        const size_t x0 = mpiRank * Nx;
+        std::vector<double> all;
+        var_r64.SetSelection({{0, x0}, {Ny, Nx}});
+        bpReader.Get(var_r64, all);
+        const size_t y0 = 37, ny = 64;
+        std::vector<double> rows;
+        var_r64.SetSelection({{y0, x0 + 10}, {ny, Nx - 20}});
+        bpReader.Get(var_r64, rows);
+        std::vector<double> row;
+        var_r64.SetSelection({{Ny - 1, x0}, {1, Nx}});
+        bpReader.Get(var_r64, row);
+        bpReader.EndStep();
+
+        for (size_t y = 0; y < Ny; ++y)
+        {
+            for (size_t x = 0; x < Nx; ++x)
+            {
+                ASSERT_EQ(all[y * Nx + x], lf_Value(y, x0 + x))
+                    << "y=" << y << " x=" << x << " rank=" << mpiRank;
+            }
+        }
+        for (size_t y = 0; y < ny; ++y)
+        {
+            for (size_t x = 0; x < Nx - 20; ++x)
+            {
+                ASSERT_EQ(rows[y * (Nx - 20) + x],
+                          lf_Value(y0 + y, x0 + 10 + x))
+                    << "y=" << y << " x=" << x << " rank=" << mpiRank;
+            }
+        }
+        for (size_t x = 0; x < Nx; ++x)
+        {
+            ASSERT_EQ(row[x], lf_Value(Ny - 1, x0 + x))
+                << "x=" << x << " rank=" << mpiRank;
+        }
+        bpReader.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadBlockIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            // Create the BP Engine
+            io.SetEngine("BPFile");
+        }
+
+        adios2::Engine bpReader =
+            io.Open(fname, adios2::Mode::ReadRandomAccess);
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+        // SetSelection replaces a block selection of a global array, so
+        // the rows of this rank's block are selected in global coordinates
+        var_r64.SetSelection({{150, mpiRank * Nx}, {20, Nx}});
+        std::vector<double> local;
+        bpReader.Get(var_r64, local, adios2::Mode::Sync);
+        for (size_t y = 0; y < 20; ++y)
+        {
+            for (size_t x = 0; x < Nx; ++x)
+            {
+                ASSERT_EQ(local[y * Nx + x],
+                          lf_Value(150 + y, mpiRank * Nx + x))
+                    << "y=" << y << " x=" << x << " rank=" << mpiRank;
+            }
+        }
+        bpReader.Close();
+    }
+}
+
 class BPWriteReadBZIP2 : public ::testing::TestWithParam<std::string>
 {
 public:
@@ -877,6 +1159,23 @@ TEST_P(BPWriteReadBZIP2, ADIOS2BPWriteReadBZIP23DSel)
 {
     BZIP2Accuracy3DSel(GetParam());
 }
+TEST_P(BPWriteReadBZIP2, ADIOS2BPWriteReadBZIP2Blocks2D)
+{
+    BZIP2Blocks2D(GetParam());
+}
+
+class BPWriteReadBZIP2Chunks : public ::testing::Test
+{
+public:
+    BPWriteReadBZIP2Chunks() = default;
+    virtual void SetUp(){};
+    virtual void TearDown(){};
+};
+
+TEST_F(BPWriteReadBZIP2Chunks, ADIOS2BPWriteReadBZIP2Chunks2D)
+{
+    BZIP2Chunks2D();
+}
 
 INSTANTIATE_TEST_SUITE_P(
     BZIP2Accuracy, BPWriteReadBZIP2,
@@ -882,6 +882,119 @@ void BloscAccuracy3DSel(const std::string accuracy, const std::string threshold,
     }
 }
 
+void BloscChunks2D()
+{
+    // Each process writes one block of Ny x Nx values, compressed in chunks
+    // of rows by several threads, and reads back all of it and rows across
+    // chunk boundaries
+    const std::string fname("BPWriteReadBloscChunks2D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 1000;
+    const size_t Ny = 200;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    const size_t NCols = Nx * mpiSize;
+    const size_t x0 = mpiRank * Nx;
+    auto lf_Value = [&](const size_t y, const size_t x) {
+        return static_cast<double>((y * NCols + x) % 1013) * 0.5;
+    };
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            // Create the BP Engine
+            io.SetEngine("BPFile");
+        }
+        io.SetParameter("OperatorChunkSize", "64Kb");
+        io.SetParameter("OperatorChunkThreads", "4");
+
+        auto var_r64 =
+            io.DefineVariable<double>("r64", {Ny, NCols}, {0, x0}, {Ny, Nx});
+        adios2::Operator BloscOp =
+            adios.DefineOperator("BloscCompressor", adios2::ops::LosslessBlosc);
+        var_r64.AddOperation(
+            BloscOp,
+            {{adios2::ops::blosc::key::nthreads, "2"},
+             {adios2::ops::blosc::key::doshuffle,
+              adios2::ops::blosc::value::doshuffle_shuffle}});
+
+        std::vector<double> r64s(Ny * Nx);
+        for (size_t y = 0; y < Ny; ++y)
+        {
+            for (size_t x = 0; x < Nx; ++x)
+            {
+                r64s[y * Nx + x] = lf_Value(y, x0 + x);
+            }
+        }
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        bpWriter.BeginStep();
+        bpWriter.Put(var_r64, r64s.data());
+        bpWriter.EndStep();
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            // Create the BP Engine
+            io.SetEngine("BPFile");
+        }
+        io.SetParameter("Threads", "4");
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        ASSERT_EQ(bpReader.BeginStep(), adios2::StepStatus::OK);
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+
+        std::vector<double> all;
+        var_r64.SetSelection({{0, x0}, {Ny, Nx}});
+        bpReader.Get(var_r64, all);
+        const size_t y0 = 37, ny = 64;
+        std::vector<double> rows;
+        var_r64.SetSelection({{y0, x0 + 10}, {ny, Nx - 20}});
+        bpReader.Get(var_r64, rows);
+        bpReader.EndStep();
+
+        for (size_t y = 0; y < Ny; ++y)
+        {
+            for (size_t x = 0; x < Nx; ++x)
+            {
+                ASSERT_EQ(all[y * Nx + x], lf_Value(y, x0 + x))
+                    << "y=" << y << " x=" << x << " rank=" << mpiRank;
+            }
+        }
+        for (size_t y = 0; y < ny; ++y)
+        {
+            for (size_t x = 0; x < Nx - 20; ++x)
+            {
+                ASSERT_EQ(rows[y * (Nx - 20) + x],
+                          lf_Value(y0 + y, x0 + 10 + x))
+                    << "y=" << y << " x=" << x << " rank=" << mpiRank;
+            }
+        }
+        bpReader.Close();
+    }
+}
+
 class BPWriteReadBlosc : public ::testing::TestWithParam<
                              std::tuple<std::string, std::string, std::string>>
 {
@@ -922,6 +1035,19 @@ TEST_P(BPWriteReadBlosc, ADIOS2BPWriteReadBlosc3DSel)
                        std::get<2>(GetParam()));
 }
 
+class BPWriteReadBloscChunks : public ::testing::Test
+{
+public:
+    BPWriteReadBloscChunks() = default;
+    virtual void SetUp(){};
+    virtual void TearDown(){};
+};
+
+TEST_F(BPWriteReadBloscChunks, ADIOS2BPWriteReadBloscChunks2D)
+{
+    BloscChunks2D();
+}
+
 INSTANTIATE_TEST_SUITE_P(
     BloscAccuracy, BPWriteReadBlosc,
     ::testing::Combine(
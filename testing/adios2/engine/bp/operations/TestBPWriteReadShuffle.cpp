@@ -0,0 +1,251 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+namespace
+{
+
+// Ny x Nx per rank, Nx chosen so rows are not a multiple of 16 values
+const size_t Nx = 37;
+const size_t Ny = 24;
+const size_t NSteps = 2;
+
+template <class T>
+T Value(const size_t step, const size_t y, const size_t x)
+{
+    return static_cast<T>(100.0 * std::sin(0.1 * y + 0.01 * x) + step);
+}
+
+template <>
+std::complex<double> Value(const size_t step, const size_t y, const size_t x)
+{
+    return {Value<double>(step, y, x), Value<double>(step, x, y)};
+}
+
+template <>
+int32_t Value(const size_t step, const size_t y, const size_t x)
+{
+    return static_cast<int32_t>(y * 1000 + x * 3 + step) - 5000;
+}
+
+template <>
+uint16_t Value(const size_t step, const size_t y, const size_t x)
+{
+    return static_cast<uint16_t>(y * 250 + x + step);
+}
+
+template <class T>
+void Fill(std::vector<T> &data, const size_t step, const size_t y0)
+{
+    for (size_t y = 0; y < Ny; ++y)
+    {
+        for (size_t x = 0; x < Nx; ++x)
+        {
+            data[y * Nx + x] = Value<T>(step, y0 + y, x);
+        }
+    }
+}
+
+template <class T>
+void Check(const std::vector<T> &data, const size_t step, const size_t y0,
+           const size_t ny, const size_t x0, const size_t nx,
+           const std::string &name)
+{
+    for (size_t y = 0; y < ny; ++y)
+    {
+        for (size_t x = 0; x < nx; ++x)
+        {
+            // lossless, compare bit for bit
+            ASSERT_EQ(data[y * nx + x], Value<T>(step, y0 + y, x0 + x))
+                << name << " step=" << step << " y=" << y << " x=" << x;
+        }
+    }
+}
+
+} // end anonymous namespace
+
+class BPWriteReadShuffle
+: public ::testing::TestWithParam<std::tuple<std::string, std::string>>
+{
+public:
+    BPWriteReadShuffle() = default;
+    virtual void SetUp(){};
+    virtual void TearDown(){};
+};
+
+TEST_P(BPWriteReadShuffle, ADIOS2BPWriteReadShuffle2D)
+{
+    const std::string predictor = std::get<0>(GetParam());
+    const std::string dimension = std::get<1>(GetParam());
+    const std::string fname("BPWRShuffle2D_" + predictor + "_" + dimension +
+                            ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    const adios2::Dims shape{Ny * mpiSize, Nx};
+    const adios2::Dims start{Ny * mpiRank, 0};
+    const adios2::Dims count{Ny, Nx};
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            // Create the BP Engine
+            io.SetEngine("BPFile");
+        }
+        const adios2::Params params = {
+            {adios2::ops::shuffle::key::predictor, predictor},
+            {adios2::ops::shuffle::key::dimension, dimension}};
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count);
+        var_r64.AddOperation(adios2::ops::LosslessShuffle, params);
+        auto var_r32 = io.DefineVariable<float>("r32", shape, start, count);
+        var_r32.AddOperation(adios2::ops::LosslessShuffle, params);
+        auto var_c64 =
+            io.DefineVariable<std::complex<double>>("c64", shape, start, count);
+        var_c64.AddOperation(adios2::ops::LosslessShuffle, params);
+        auto var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count);
+        var_i32.AddOperation(adios2::ops::LosslessShuffle, params);
+        // stored without a compressor behind the shuffle
+        auto var_u16 = io.DefineVariable<uint16_t>("u16", shape, start, count);
+        auto params_u16 = params;
+        params_u16[adios2::ops::shuffle::key::compressor] =
+            adios2::ops::shuffle::value::compressor_none;
+        var_u16.AddOperation(adios2::ops::LosslessShuffle, params_u16);
+
+        std::vector<double> r64s(Ny * Nx);
+        std::vector<float> r32s(Ny * Nx);
+        std::vector<std::complex<double>> c64s(Ny * Nx);
+        std::vector<int32_t> i32s(Ny * Nx);
+        std::vector<uint16_t> u16s(Ny * Nx);
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            Fill(r64s, step, Ny * mpiRank);
+            Fill(r32s, step, Ny * mpiRank);
+            Fill(c64s, step, Ny * mpiRank);
+            Fill(i32s, step, Ny * mpiRank);
+            Fill(u16s, step, Ny * mpiRank);
+            bpWriter.BeginStep();
+            bpWriter.Put(var_r64, r64s.data());
+            bpWriter.Put(var_r32, r32s.data());
+            bpWriter.Put(var_c64, c64s.data());
+            bpWriter.Put(var_i32, i32s.data());
+            bpWriter.Put(var_u16, u16s.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            // Create the BP Engine
+            io.SetEngine("BPFile");
+        }
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        // all of the own block, then a selection across all blocks
+        const size_t y0 = Ny * mpiRank;
+        const size_t sy0 = Ny / 2, sny = Ny * (mpiSize - 1) + 3;
+        const size_t sx0 = 5, snx = Nx - 9;
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            ASSERT_EQ(bpReader.BeginStep(), adios2::StepStatus::OK);
+            auto var_r64 = io.InquireVariable<double>("r64");
+            auto var_r32 = io.InquireVariable<float>("r32");
+            auto var_c64 = io.InquireVariable<std::complex<double>>("c64");
+            auto var_i32 = io.InquireVariable<int32_t>("i32");
+            auto var_u16 = io.InquireVariable<uint16_t>("u16");
+            ASSERT_TRUE(var_r64 && var_r32 && var_c64 && var_i32 && var_u16);
+
+            std::vector<double> r64s;
+            std::vector<float> r32s;
+            std::vector<std::complex<double>> c64s;
+            std::vector<int32_t> i32s;
+            std::vector<uint16_t> u16s;
+            var_r64.SetSelection({{y0, 0}, {Ny, Nx}});
+            var_r32.SetSelection({{y0, 0}, {Ny, Nx}});
+            var_c64.SetSelection({{y0, 0}, {Ny, Nx}});
+            var_i32.SetSelection({{y0, 0}, {Ny, Nx}});
+            var_u16.SetSelection({{y0, 0}, {Ny, Nx}});
+            bpReader.Get(var_r64, r64s);
+            bpReader.Get(var_r32, r32s);
+            bpReader.Get(var_c64, c64s);
+            bpReader.Get(var_i32, i32s);
+            bpReader.Get(var_u16, u16s);
+            bpReader.PerformGets();
+            std::vector<double> span;
+            var_r64.SetSelection({{sy0, sx0}, {sny, snx}});
+            bpReader.Get(var_r64, span, adios2::Mode::Sync);
+            bpReader.EndStep();
+
+            Check(r64s, step, y0, Ny, 0, Nx, "r64");
+            Check(r32s, step, y0, Ny, 0, Nx, "r32");
+            Check(c64s, step, y0, Ny, 0, Nx, "c64");
+            Check(i32s, step, y0, Ny, 0, Nx, "i32");
+            Check(u16s, step, y0, Ny, 0, Nx, "u16");
+            Check(span, step, sy0, sny, sx0, snx, "r64 span");
+        }
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Shuffle, BPWriteReadShuffle,
+    ::testing::Combine(
+        ::testing::Values(adios2::ops::shuffle::value::predictor_none,
+                          adios2::ops::shuffle::value::predictor_delta,
+                          adios2::ops::shuffle::value::predictor_xor),
+        ::testing::Values("0", "1")));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
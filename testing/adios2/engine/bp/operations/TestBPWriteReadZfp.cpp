@@ -2,6 +2,7 @@
  * Distributed under the OSI-approved Apache License, Version 2.0.  See
  * accompanying file Copyright.txt for details.
  */
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 
@@ -953,6 +954,101 @@ void ZFPRate2DSmallSel(const std::string rate)
     }
 }
 
+/* Writes a 2D block with the given zfp parameters and returns what this rank
+ * reads back */
+std::vector<double> ZFPThreadsRoundTrip(const std::string &fname,
+                                        const std::vector<double> &r64s,
+                                        const size_t Nx, const size_t Ny,
+                                        const adios2::Params &params)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize), Ny};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank), 0};
+        const adios2::Dims count{Nx, Ny};
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count,
+                                                 adios2::ConstantDims);
+        adios2::Operator zfpOp =
+            adios.DefineOperator("ZFPCompressor", adios2::ops::LossyZFP);
+        var_r64.AddOperation(zfpOp, params);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        bpWriter.BeginStep();
+        bpWriter.Put(var_r64, r64s.data());
+        bpWriter.EndStep();
+        bpWriter.Close();
+    }
+
+    std::vector<double> decompressedR64s;
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        EXPECT_EQ(bpReader.BeginStep(), adios2::StepStatus::OK);
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+        var_r64.SetSelection({{mpiRank * Nx, 0}, {Nx, Ny}});
+        bpReader.Get(var_r64, decompressedR64s);
+        bpReader.EndStep();
+        bpReader.Close();
+    }
+    return decompressedR64s;
+}
+
+void ZFPThreads2D(const std::string rate, const std::string &backend)
+{
+    // 102 rows do not split into equal 4-row slabs
+    const size_t Nx = 102;
+    const size_t Ny = 30;
+    std::vector<double> r64s(Nx * Ny);
+    for (size_t i = 0; i < r64s.size(); ++i)
+    {
+        r64s[i] = std::sin(0.01 * i) * 1000.;
+    }
+
+    adios2::Params params = {{adios2::ops::zfp::key::rate, rate}};
+    const std::string name("BPWRZFPThreads2D_" + rate + "_" + backend);
+    const auto single =
+        ZFPThreadsRoundTrip(name + "_1.bp", r64s, Nx, Ny, params);
+
+    params[adios2::ops::zfp::key::threads] = "4";
+    if (!backend.empty())
+    {
+        params[adios2::ops::zfp::key::backend] = backend;
+    }
+    const auto threaded =
+        ZFPThreadsRoundTrip(name + "_4.bp", r64s, Nx, Ny, params);
+
+    ASSERT_EQ(single.size(), Nx * Ny);
+    ASSERT_EQ(threaded.size(), Nx * Ny);
+    // the threaded result must be about as close to the input as the serial
+    // one, slab edges may pad zfp blocks differently
+    double maxError = 0.;
+    for (size_t i = 0; i < Nx * Ny; ++i)
+    {
+        maxError = std::max(maxError, std::abs(single[i] - r64s[i]));
+    }
+    for (size_t i = 0; i < Nx * Ny; ++i)
+    {
+        ASSERT_LE(std::abs(threaded[i] - r64s[i]), 2 * maxError) << "i=" << i;
+    }
+}
+
 class BPWRZFP : public ::testing::TestWithParam<std::string>
 {
 public:
@@ -969,6 +1065,11 @@ TEST_P(BPWRZFP, ADIOS2BPWRZFP1DSel) { ZFPRate1DSel(GetParam()); }
 TEST_P(BPWRZFP, ADIOS2BPWRZFP2DSel) { ZFPRate2DSel(GetParam()); }
 TEST_P(BPWRZFP, ADIOS2BPWRZFP3DSel) { ZFPRate3DSel(GetParam()); }
 TEST_P(BPWRZFP, ADIOS2BPWRZFP2DSmallSel) { ZFPRate2DSmallSel(GetParam()); }
+TEST_P(BPWRZFP, ADIOS2BPWRZFPThreads2D) { ZFPThreads2D(GetParam(), ""); }
+TEST_P(BPWRZFP, ADIOS2BPWRZFPThreadsSlabs2D)
+{
+    ZFPThreads2D(GetParam(), adios2::ops::zfp::value::backend_serial);
+}
 
 INSTANTIATE_TEST_SUITE_P(ZFPRate, BPWRZFP, ::testing::Values("8", "9", "10"));
 
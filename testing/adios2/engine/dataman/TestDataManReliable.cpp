@@ -3,6 +3,7 @@
  * accompanying file Copyright.txt for details.
  */
 
+#include <atomic>
 #include <numeric>
 #include <thread>
 
@@ -15,6 +16,7 @@ using namespace adios2;
 
 size_t print_lines = 0;
 size_t to_print_lines = 10;
+std::atomic<size_t> received_step_count(0);
 
 template <class T>
 void GenData(std::vector<std::complex<T>> &data, const size_t step)
@@ -234,6 +236,7 @@ void DataManReader(const Dims &shape, const Dims &start, const Dims &count,
             VerifyData(myComplexes, currentStep);
             VerifyData(myDComplexes, currentStep);
             engine.EndStep();
+            ++received_step_count;
         }
         else if (status == adios2::StepStatus::EndOfStream)
         {
@@ -268,7 +271,8 @@ TEST_F(DataManEngineTest, Reliable)
     Dims count = {10};
     size_t steps = 500;
 
-    // run workflow
+    // run workflow, the reader must receive every step
+    received_step_count = 0;
     adios2::Params readerEngineParams = {{"IPAddress", "127.0.0.1"},
                                          {"Port", "12380"},
                                          {"TransportMode", "reliable"}};
@@ -281,6 +285,43 @@ TEST_F(DataManEngineTest, Reliable)
                          writerEngineParams);
     w.join();
     r.join();
+    ASSERT_EQ(received_step_count, steps);
+}
+
+TEST_F(DataManEngineTest, ReliableFanOut)
+{
+    // set parameters
+    Dims shape = {10};
+    Dims start = {0};
+    Dims count = {10};
+    size_t steps = 200;
+    size_t readers = 3;
+
+    // run workflow, every reader must receive every step
+    received_step_count = 0;
+    adios2::Params readerEngineParams = {{"IPAddress", "127.0.0.1"},
+                                         {"Port", "12390"},
+                                         {"TransportMode", "reliable"}};
+    std::vector<std::thread> r;
+    for (size_t i = 0; i < readers; ++i)
+    {
+        r.emplace_back(DataManReader, shape, start, count, steps,
+                       readerEngineParams);
+    }
+    adios2::Params writerEngineParams = {
+        {"IPAddress", "127.0.0.1"},
+        {"Port", "12390"},
+        {"TransportMode", "reliable"},
+        {"RendezvousReaderCount", std::to_string(readers)},
+        {"ReplyThreads", "2"}};
+    auto w = std::thread(DataManWriter, shape, start, count, steps,
+                         writerEngineParams);
+    w.join();
+    for (auto &t : r)
+    {
+        t.join();
+    }
+    ASSERT_EQ(received_step_count, readers * steps);
 }
 #endif // ZEROMQ
 
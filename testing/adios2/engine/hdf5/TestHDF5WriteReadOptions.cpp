@@ -0,0 +1,287 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include <hdf5.h>
+
+std::string engineName; // comes from command line
+
+namespace
+{
+const size_t Ny = 6;
+const size_t Nx = 10;
+const size_t NSteps = 3;
+
+double Value(const size_t step, const size_t row, const size_t x)
+{
+    return static_cast<double>(step * 10000 + row * 100 + x);
+}
+
+// Check through the HDF5 C API that the options of params reached the file
+void CheckFileOptions(const std::string &fname, const adios2::Params &params)
+{
+    auto param = [&](const std::string &key) {
+        auto it = params.find(key);
+        return it == params.end() ? std::string() : it->second;
+    };
+
+    hid_t file = H5Fopen(fname.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    ASSERT_GE(file, 0);
+
+    if (!param("H5PageSize").empty())
+    {
+        hid_t fcpl = H5Fget_create_plist(file);
+        hsize_t pageSize = 0;
+        EXPECT_GE(H5Pget_file_space_page_size(fcpl, &pageSize), 0);
+        EXPECT_EQ(pageSize, 8 * 1024);
+        H5Pclose(fcpl);
+    }
+
+    const bool chunked = param("H5ChunkDim") == "auto";
+    for (const std::string var : {"r64", "i32"})
+    {
+        H5D_layout_t expected = H5D_CONTIGUOUS;
+        if (param("H5Layout") == "compact")
+        {
+            expected = H5D_COMPACT;
+        }
+        else if (chunked && (param("H5ChunkVars").empty() ||
+                             param("H5ChunkVars") == var))
+        {
+            expected = H5D_CHUNKED;
+        }
+
+        for (size_t s = 0; s < NSteps; ++s)
+        {
+            const std::string name = "/Step" + std::to_string(s) + "/" + var;
+            hid_t dataset = H5Dopen(file, name.c_str(), H5P_DEFAULT);
+            ASSERT_GE(dataset, 0) << name;
+            hid_t dcpl = H5Dget_create_plist(dataset);
+            EXPECT_EQ(H5Pget_layout(dcpl), expected) << name;
+            if (expected == H5D_CHUNKED)
+            {
+                // the largest block of the writers, here every block
+                hsize_t chunk[2] = {0, 0};
+                if (var == "r64")
+                {
+                    ASSERT_EQ(H5Pget_chunk(dcpl, 2, chunk), 2) << name;
+                    EXPECT_EQ(chunk[0], Ny) << name;
+                    EXPECT_EQ(chunk[1], Nx) << name;
+                }
+                else
+                {
+                    ASSERT_EQ(H5Pget_chunk(dcpl, 1, chunk), 1) << name;
+                    EXPECT_EQ(chunk[0], 1) << name;
+                }
+            }
+            H5Pclose(dcpl);
+            H5Dclose(dataset);
+        }
+    }
+    H5Fclose(file);
+}
+}
+
+class HDF5WriteReadOptions : public ::testing::TestWithParam<adios2::Params>
+{
+public:
+    HDF5WriteReadOptions() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+// Write a 2D array, a small 1D array and a scalar with the file access and
+// dataset creation options of the parameter, then read back every step
+TEST_P(HDF5WriteReadOptions, ADIOS2HDF5WriteReadOptions)
+{
+    const adios2::Params &params = GetParam();
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    auto itLayout = params.find("H5Layout");
+    if ((itLayout != params.end() && itLayout->second == "compact") ||
+        params.count("H5PageBufferSize") > 0)
+    {
+        if (mpiSize > 1)
+        {
+            return; // only supported by a single writer
+        }
+    }
+
+    std::string fname = "HDF5WriteReadOptions";
+    for (const auto &p : params)
+    {
+        fname += "_" + p.first + "_" + p.second;
+    }
+    std::replace(fname.begin(), fname.end(), ' ', '_');
+    fname += ".h5";
+
+    const size_t row0 = Ny * static_cast<size_t>(mpiRank);
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName.empty() ? "HDF5" : engineName);
+        io.SetParameters(params);
+        auto r64 = io.DefineVariable<double>(
+            "r64", {Ny * static_cast<size_t>(mpiSize), Nx}, {row0, 0},
+            {Ny, Nx});
+        auto i32 = io.DefineVariable<int32_t>(
+            "i32", {static_cast<size_t>(mpiSize)},
+            {static_cast<size_t>(mpiRank)}, {1});
+        auto step = io.DefineVariable<uint64_t>("step");
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        std::vector<double> data(Ny * Nx);
+        for (size_t s = 0; s < NSteps; ++s)
+        {
+            for (size_t y = 0; y < Ny; ++y)
+            {
+                for (size_t x = 0; x < Nx; ++x)
+                {
+                    data[y * Nx + x] = Value(s, row0 + y, x);
+                }
+            }
+            const int32_t rank = mpiRank + static_cast<int32_t>(s);
+            const uint64_t stepValue = s;
+            writer.BeginStep();
+            writer.Put(r64, data.data());
+            writer.Put(i32, &rank);
+            writer.Put(step, &stepValue);
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    if (mpiRank == 0)
+    {
+        CheckFileOptions(fname, params);
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName.empty() ? "HDF5" : engineName);
+        io.SetParameters(params);
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        for (size_t s = 0; s < NSteps; ++s)
+        {
+            ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+            auto r64 = io.InquireVariable<double>("r64");
+            auto i32 = io.InquireVariable<int32_t>("i32");
+            auto step = io.InquireVariable<uint64_t>("step");
+            ASSERT_TRUE(r64);
+            ASSERT_TRUE(i32);
+            ASSERT_TRUE(step);
+
+            // a selection across the blocks of two writers
+            const size_t ry = mpiSize > 1 ? Ny / 2 : 0;
+            const size_t ny = mpiSize > 1 ? Ny : Ny - 1;
+            r64.SetSelection({{row0 + ry, 2}, {ny, Nx - 3}});
+            std::vector<double> in;
+            std::vector<int32_t> ranks;
+            uint64_t stepValue = 0;
+            if (mpiRank < mpiSize - 1 || mpiSize == 1)
+            {
+                reader.Get(r64, in);
+            }
+            reader.Get(i32, ranks);
+            reader.Get(step, stepValue);
+            reader.EndStep();
+
+            EXPECT_EQ(stepValue, s);
+            ASSERT_EQ(ranks.size(), static_cast<size_t>(mpiSize));
+            for (int r = 0; r < mpiSize; ++r)
+            {
+                EXPECT_EQ(ranks[r], r + static_cast<int32_t>(s));
+            }
+            if (mpiRank < mpiSize - 1 || mpiSize == 1)
+            {
+                ASSERT_EQ(in.size(), ny * (Nx - 3));
+                for (size_t y = 0; y < ny; ++y)
+                {
+                    for (size_t x = 0; x < Nx - 3; ++x)
+                    {
+                        ASSERT_EQ(in[y * (Nx - 3) + x],
+                                  Value(s, row0 + ry + y, x + 2))
+                            << "step " << s << " y " << y << " x " << x;
+                    }
+                }
+            }
+        }
+        reader.Close();
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    HDF5Options, HDF5WriteReadOptions,
+    ::testing::Values(adios2::Params{{"H5Alignment", "4096"}},
+                      adios2::Params{{"H5Alignment", "1024 64kb"},
+                                     {"H5MetadataCacheSize", "4mb"}},
+                      adios2::Params{{"H5ChunkDim", "auto"}},
+                      adios2::Params{{"H5ChunkDim", "auto"},
+                                     {"H5ChunkVars", "r64"}},
+                      adios2::Params{{"H5Layout", "contiguous"}},
+                      adios2::Params{{"H5Layout", "compact"}},
+                      adios2::Params{{"H5PageSize", "8kb"},
+                                     {"H5PageBufferSize", "64kb"}}));
+
+TEST(HDF5Options, ADIOS2HDF5InvalidOptions)
+{
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("InvalidIO");
+    io.SetEngine(engineName.empty() ? "HDF5" : engineName);
+    io.SetParameter("H5Layout", "sparse");
+    EXPECT_THROW(io.Open("HDF5InvalidOptions.h5", adios2::Mode::Write),
+                 std::invalid_argument);
+
+    adios2::IO io2 = adios.DeclareIO("InvalidIO2");
+    io2.SetEngine(engineName.empty() ? "HDF5" : engineName);
+    io2.SetParameter("H5Alignment", "1 2 3");
+    EXPECT_THROW(io2.Open("HDF5InvalidOptions.h5", adios2::Mode::Write),
+                 std::invalid_argument);
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
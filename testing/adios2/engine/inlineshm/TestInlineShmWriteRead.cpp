@@ -0,0 +1,415 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class InlineShmWriteRead : public ::testing::Test
+{
+public:
+    InlineShmWriteRead() = default;
+};
+
+namespace
+{
+// serial and MPI tests can run concurrently, keep their streams apart
+std::string StreamName(const std::string &name)
+{
+#if ADIOS2_USE_MPI
+    return name + "_MPI.shm";
+#else
+    return name + "_Serial.shm";
+#endif
+}
+
+std::vector<double> StepData(size_t step, int rank, size_t Nx)
+{
+    std::vector<double> data(Nx);
+    std::iota(data.begin(), data.end(),
+              static_cast<double>(step * 1000 + rank * Nx));
+    return data;
+}
+}
+
+//******************************************************************************
+// 1D global array, values, strings and attributes, one writer per rank
+//******************************************************************************
+
+TEST_F(InlineShmWriteRead, WriteRead1D)
+{
+    const std::string fname(StreamName("InlineShmWriteRead1D"));
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 10;
+    const size_t NSteps = 3;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine("InlineShm");
+    // keep all steps in the arena so the writer never waits for the reader
+    writeIO.SetParameters({{"QueueDepth", std::to_string(NSteps)},
+                           {"SlotSize", "1Mb"},
+                           {"RendezvousReaderCount", "0"}});
+
+    const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+    const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+    const adios2::Dims count{Nx};
+    auto var_r64 = writeIO.DefineVariable<double>("r64", shape, start, count);
+    auto var_step = writeIO.DefineVariable<int32_t>("step");
+    auto var_rank =
+        writeIO.DefineVariable<int32_t>("rank", {adios2::LocalValueDim});
+    auto var_str = writeIO.DefineVariable<std::string>("str");
+    writeIO.DefineAttribute<std::string>("units", "m/s");
+    const std::vector<double> attrArray = {1.0, 2.0, 3.0};
+    writeIO.DefineAttribute<double>("coeffs", attrArray.data(),
+                                    attrArray.size());
+
+    adios2::Engine writer = writeIO.Open(fname, adios2::Mode::Write);
+
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine("InlineShm");
+    adios2::Engine reader = readIO.Open(fname, adios2::Mode::Read);
+
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        const std::vector<double> data = StepData(step, mpiRank, Nx);
+        writer.BeginStep();
+        writer.Put(var_r64, data.data());
+        writer.Put(var_step, static_cast<int32_t>(step));
+        writer.Put(var_rank, static_cast<int32_t>(mpiRank));
+        writer.Put(var_str, "step " + std::to_string(step));
+        writer.EndStep();
+    }
+
+#if ADIOS2_USE_MPI
+    // all writers of the node must have published before reading
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+        ASSERT_EQ(reader.CurrentStep(), step);
+
+        auto attr = readIO.InquireAttribute<std::string>("units");
+        ASSERT_TRUE(attr);
+        EXPECT_EQ(attr.Data().front(), "m/s");
+        auto attrCoeffs = readIO.InquireAttribute<double>("coeffs");
+        ASSERT_TRUE(attrCoeffs);
+        EXPECT_EQ(attrCoeffs.Data(), attrArray);
+
+        auto r_step = readIO.InquireVariable<int32_t>("step");
+        ASSERT_TRUE(r_step);
+        int32_t stepValue = -1;
+        reader.Get(r_step, stepValue, adios2::Mode::Sync);
+        EXPECT_EQ(stepValue, static_cast<int32_t>(step));
+
+        auto r_str = readIO.InquireVariable<std::string>("str");
+        ASSERT_TRUE(r_str);
+        std::string strValue;
+        reader.Get(r_str, strValue, adios2::Mode::Sync);
+        EXPECT_EQ(strValue, "step " + std::to_string(step));
+
+        // local values show up as a global array with one entry per writer
+        auto r_rank = readIO.InquireVariable<int32_t>("rank");
+        ASSERT_TRUE(r_rank);
+        ASSERT_EQ(r_rank.Shape().size(), 1);
+        ASSERT_EQ(r_rank.Shape()[0], static_cast<size_t>(mpiSize));
+        std::vector<int32_t> ranks;
+        reader.Get(r_rank, ranks, adios2::Mode::Sync);
+        for (int r = 0; r < mpiSize; ++r)
+        {
+            EXPECT_EQ(ranks[r], r);
+        }
+
+        auto r_r64 = readIO.InquireVariable<double>("r64");
+        ASSERT_TRUE(r_r64);
+        ASSERT_EQ(r_r64.Shape()[0], static_cast<size_t>(Nx * mpiSize));
+
+        // the whole global array, assembled from all writers
+        std::vector<double> global;
+        r_r64.SetSelection({{0}, {Nx * mpiSize}});
+        reader.Get(r_r64, global);
+        reader.PerformGets();
+        for (int r = 0; r < mpiSize; ++r)
+        {
+            const std::vector<double> expected = StepData(step, r, Nx);
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                EXPECT_EQ(global[r * Nx + i], expected[i]);
+            }
+        }
+
+        // a selection straddling two writers' blocks
+        if (mpiSize > 1)
+        {
+            std::vector<double> straddle(4);
+            r_r64.SetSelection({{Nx - 2}, {4}});
+            reader.Get(r_r64, straddle.data(), adios2::Mode::Sync);
+            EXPECT_EQ(straddle[0], StepData(step, 0, Nx)[Nx - 2]);
+            EXPECT_EQ(straddle[3], StepData(step, 1, Nx)[1]);
+        }
+
+        // zero-copy access to this rank's block
+        auto blocksInfo = reader.BlocksInfo(r_r64, step);
+        ASSERT_EQ(blocksInfo.size(), static_cast<size_t>(mpiSize));
+        EXPECT_EQ(blocksInfo[mpiRank].Start[0], Nx * mpiRank);
+        EXPECT_EQ(blocksInfo[mpiRank].Count[0], Nx);
+
+        r_r64.SetBlockSelection(mpiRank);
+        adios2::Variable<double>::Info info;
+        reader.Get(r_r64, info, adios2::Mode::Sync);
+        const double *blockData = info.Data();
+        double *blockPtr = nullptr;
+        reader.Get(r_r64, &blockPtr);
+        ASSERT_NE(blockData, nullptr);
+        EXPECT_EQ(blockData, blockPtr);
+        const std::vector<double> expected = StepData(step, mpiRank, Nx);
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            EXPECT_EQ(blockData[i], expected[i]);
+        }
+
+        reader.EndStep();
+    }
+
+    writer.Close();
+    EXPECT_EQ(reader.BeginStep(), adios2::StepStatus::EndOfStream);
+    reader.Close();
+}
+
+//******************************************************************************
+// Writer runs ahead of the reader, bounded by a queue of two steps
+//******************************************************************************
+
+TEST_F(InlineShmWriteRead, QueueDepth)
+{
+    const std::string fname(StreamName("InlineShmQueueDepth"));
+
+    int mpiRank = 0;
+    const size_t Nx = 100;
+    const size_t NSteps = 20;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine("InlineShm");
+    writeIO.SetParameters({{"QueueDepth", "2"}, {"SlotSize", "64Kb"}});
+    auto var = writeIO.DefineVariable<double>("data", {}, {}, {Nx});
+
+    adios2::Engine writer = writeIO.Open(fname, adios2::Mode::Write);
+
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine("InlineShm");
+    adios2::Engine reader = readIO.Open(fname, adios2::Mode::Read);
+
+    std::thread producer([&]() {
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            const std::vector<double> data = StepData(step, mpiRank, Nx);
+            writer.BeginStep();
+            writer.Put(var, data.data());
+            writer.EndStep();
+        }
+    });
+
+    size_t steps = 0;
+    while (steps < NSteps)
+    {
+        const adios2::StepStatus status =
+            reader.BeginStep(adios2::StepMode::Read, 0.0f);
+        if (status == adios2::StepStatus::NotReady)
+        {
+            // the writer has not published the next step yet
+            continue;
+        }
+        ASSERT_EQ(status, adios2::StepStatus::OK);
+        ASSERT_EQ(reader.CurrentStep(), steps);
+        auto r_var = readIO.InquireVariable<double>("data");
+        ASSERT_TRUE(r_var);
+        r_var.SetBlockSelection(0);
+        std::vector<double> block;
+        reader.Get(r_var, block, adios2::Mode::Sync);
+        const std::vector<double> expected = StepData(steps, 0, Nx);
+        EXPECT_EQ(block, expected);
+        reader.EndStep();
+        ++steps;
+    }
+
+    producer.join();
+    writer.Close();
+    reader.Close();
+}
+
+//******************************************************************************
+// Column-major host language, a 2D selection across the writers' blocks
+//******************************************************************************
+
+TEST_F(InlineShmWriteRead, ColumnMajor2D)
+{
+    const std::string fname(StreamName("InlineShmColumnMajor2D"));
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 4;
+    const size_t Ny = 3;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios("", MPI_COMM_WORLD, "Fortran");
+#else
+    adios2::ADIOS adios("", "Fortran");
+#endif
+
+    // the first index is the fastest, each writer holds Ny columns
+    const size_t NyGlobal = Ny * mpiSize;
+    auto value = [&](size_t i, size_t j) { return double(i + 10 * j); };
+
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine("InlineShm");
+    writeIO.SetParameters(
+        {{"QueueDepth", "1"}, {"RendezvousReaderCount", "0"}});
+    auto var = writeIO.DefineVariable<double>(
+        "a", {Nx, NyGlobal}, {0, Ny * mpiRank}, {Nx, Ny});
+    adios2::Engine writer = writeIO.Open(fname, adios2::Mode::Write);
+
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine("InlineShm");
+    adios2::Engine reader = readIO.Open(fname, adios2::Mode::Read);
+
+    std::vector<double> data(Nx * Ny);
+    for (size_t j = 0; j < Ny; ++j)
+    {
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            data[i + j * Nx] = value(i, Ny * mpiRank + j);
+        }
+    }
+    writer.BeginStep();
+    writer.Put(var, data.data());
+    writer.EndStep();
+
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+    auto r_var = readIO.InquireVariable<double>("a");
+    ASSERT_TRUE(r_var);
+    ASSERT_EQ(r_var.Shape(), adios2::Dims({Nx, NyGlobal}));
+
+    // an interior selection, crossing writer blocks with several writers
+    const size_t sx = Nx - 2;
+    const size_t sy = NyGlobal - 1;
+    r_var.SetSelection({{1, 1}, {sx, sy}});
+    std::vector<double> sel;
+    reader.Get(r_var, sel, adios2::Mode::Sync);
+    ASSERT_EQ(sel.size(), sx * sy);
+    for (size_t j = 0; j < sy; ++j)
+    {
+        for (size_t i = 0; i < sx; ++i)
+        {
+            EXPECT_EQ(sel[i + j * sx], value(i + 1, j + 1));
+        }
+    }
+    reader.EndStep();
+
+    writer.Close();
+    reader.Close();
+}
+
+//******************************************************************************
+// A stream path longer than a file name still gives a usable key file
+//******************************************************************************
+
+TEST_F(InlineShmWriteRead, LongStreamName)
+{
+    const std::string fname(
+        StreamName("deep/" + std::string(300, 'd') + "/InlineShmLongName"));
+
+    int mpiRank = 0;
+    const size_t Nx = 10;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine("InlineShm");
+    writeIO.SetParameters(
+        {{"QueueDepth", "1"}, {"RendezvousReaderCount", "0"}});
+    auto var = writeIO.DefineVariable<double>("data", {}, {}, {Nx});
+    adios2::Engine writer = writeIO.Open(fname, adios2::Mode::Write);
+
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine("InlineShm");
+    adios2::Engine reader = readIO.Open(fname, adios2::Mode::Read);
+
+    const std::vector<double> data = StepData(0, mpiRank, Nx);
+    writer.BeginStep();
+    writer.Put(var, data.data());
+    writer.EndStep();
+
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+    auto r_var = readIO.InquireVariable<double>("data");
+    ASSERT_TRUE(r_var);
+    r_var.SetBlockSelection(mpiRank);
+    std::vector<double> block;
+    reader.Get(r_var, block, adios2::Mode::Sync);
+    EXPECT_EQ(block, data);
+    reader.EndStep();
+
+    writer.Close();
+    reader.Close();
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
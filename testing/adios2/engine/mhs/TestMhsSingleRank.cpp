@@ -255,6 +255,74 @@ void Writer(const Dims &shape, const Dims &start, const Dims &count,
     writerEngine.Close();
 }
 
+// two Sirius variables with the same blocks, read together by one PerformGets
+void SiriusWriter(const Dims &shape, const Dims &count, const size_t rows,
+                  const adios2::Params &engineParams, const std::string &name)
+{
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ms");
+    io.SetEngine("mhs");
+    io.SetParameters(engineParams);
+    io.AddTransport("sirius", {{"variable", "bpFloats"}});
+    io.AddTransport("sirius", {{"variable", "bpFloatsNeg"}});
+    auto bpFloats =
+        io.DefineVariable<float>("bpFloats", shape, {0, 0, 0}, count);
+    auto bpFloatsNeg =
+        io.DefineVariable<float>("bpFloatsNeg", shape, {0, 0, 0}, count);
+    std::vector<float> myFloats(count[1] * count[2]);
+    std::vector<float> myFloatsNeg(myFloats.size());
+    adios2::Engine writerEngine = io.Open(name, adios2::Mode::Write);
+    writerEngine.BeginStep();
+    for (size_t i = 0; i < rows; ++i)
+    {
+        bpFloats.SetSelection({{i, 0, 0}, count});
+        bpFloatsNeg.SetSelection({{i, 0, 0}, count});
+        GenData(myFloats, i, count);
+        for (size_t j = 0; j < myFloats.size(); ++j)
+        {
+            myFloatsNeg[j] = -myFloats[j];
+        }
+        writerEngine.Put(bpFloats, myFloats.data(), adios2::Mode::Sync);
+        writerEngine.Put(bpFloatsNeg, myFloatsNeg.data(), adios2::Mode::Sync);
+    }
+    writerEngine.EndStep();
+    writerEngine.Close();
+}
+
+void SiriusReader(const Dims &shape, const size_t rows,
+                  const adios2::Params &engineParams, const std::string &name)
+{
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("ms");
+    io.SetEngine("mhs");
+    io.SetParameters(engineParams);
+    adios2::Engine readerEngine = io.Open(name, adios2::Mode::Read);
+    std::vector<float> myFloats(shape[0] * shape[1] * shape[2]);
+    std::vector<float> myFloatsNeg(myFloats.size());
+    readerEngine.BeginStep();
+    auto bpFloats = io.InquireVariable<float>("bpFloats");
+    auto bpFloatsNeg = io.InquireVariable<float>("bpFloatsNeg");
+    readerEngine.Get(bpFloats, myFloats.data(), adios2::Mode::Deferred);
+    readerEngine.Get(bpFloatsNeg, myFloatsNeg.data(), adios2::Mode::Deferred);
+    readerEngine.PerformGets();
+    VerifyData(myFloats.data(), rows, shape);
+    for (auto &f : myFloatsNeg)
+    {
+        f = -f;
+    }
+    VerifyData(myFloatsNeg.data(), rows, shape);
+    readerEngine.EndStep();
+    readerEngine.Close();
+}
+
 TEST_F(MhsEngineTest, TestMhsSingleRank)
 {
     std::string filename = "TestMhsSingleRank";
@@ -274,6 +342,44 @@ TEST_F(MhsEngineTest, TestMhsSingleRank)
 #endif
 }
 
+TEST_F(MhsEngineTest, TestMhsSingleRankThreads)
+{
+    std::string filename = "TestMhsSingleRankThreads";
+    adios2::Params engineParams = {
+        {"Verbose", "0"}, {"Tiers", "4"}, {"Threads", "4"}};
+
+    size_t rows = 100;
+    Dims shape = {rows, 1, 128};
+    Dims start = {0, 0, 0};
+    Dims count = {1, 1, 128};
+
+    Writer(shape, start, count, rows, engineParams, filename);
+
+    Reader(shape, start, count, rows, engineParams, filename);
+
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+TEST_F(MhsEngineTest, TestMhsSingleRankSiriusDeferred)
+{
+    std::string filename = "TestMhsSingleRankSiriusDeferred";
+    adios2::Params engineParams = {{"Verbose", "0"}, {"Tiers", "4"}};
+
+    size_t rows = 20;
+    Dims shape = {rows, 1, 128};
+    Dims count = {1, 1, 128};
+
+    SiriusWriter(shape, count, rows, engineParams, filename);
+
+    SiriusReader(shape, rows, engineParams, filename);
+
+#if ADIOS2_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
 int main(int argc, char **argv)
 {
 #if ADIOS2_USE_MPI
@@ -0,0 +1,153 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+
+#include "TestSscCommon.h"
+#include <adios2.h>
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <numeric>
+#include <thread>
+
+using namespace adios2;
+
+int mpiRank = 0;
+int mpiSize = 1;
+MPI_Comm mpiComm;
+
+class SscEngineTest : public ::testing::Test
+{
+public:
+    SscEngineTest() = default;
+};
+
+void Writer(const Dims &shape, const Dims &start, const Dims &count,
+            const size_t steps, const adios2::Params &engineParams,
+            const std::string &name)
+{
+    adios2::ADIOS adios(mpiComm);
+    adios2::IO io = adios.DeclareIO("WAN");
+    io.SetEngine("ssc");
+    io.SetParameters(engineParams);
+    std::vector<int> myInts;
+    std::vector<double> myDoubles;
+    auto varInts = io.DefineVariable<int>("varInts", shape, start, count);
+    auto varDoubles =
+        io.DefineVariable<double>("varDoubles", shape, start, count);
+    auto varStep = io.DefineVariable<uint64_t>("varStep");
+    adios2::Engine engine = io.Open(name, adios2::Mode::Write);
+    engine.LockWriterDefinitions();
+    for (size_t i = 0; i < steps; ++i)
+    {
+        engine.BeginStep();
+        GenData(myInts, i, start, count, shape);
+        GenData(myDoubles, i, start, count, shape);
+        engine.Put(varInts, myInts.data(), adios2::Mode::Sync);
+        engine.Put(varDoubles, myDoubles.data(), adios2::Mode::Sync);
+        engine.Put(varStep, static_cast<uint64_t>(i));
+        engine.EndStep();
+    }
+    engine.Close();
+}
+
+void Reader(const Dims &start, const Dims &count, const Dims &shape,
+            const adios2::Params &engineParams, const std::string &name)
+{
+    adios2::ADIOS adios(mpiComm);
+    adios2::IO io = adios.DeclareIO("Test");
+    io.SetEngine("ssc");
+    io.SetParameters(engineParams);
+    adios2::Engine engine = io.Open(name, adios2::Mode::Read);
+    engine.LockReaderSelections();
+
+    size_t datasize =
+        std::accumulate(count.begin(), count.end(), static_cast<size_t>(1),
+                        std::multiplies<size_t>());
+    std::vector<int> myInts(datasize);
+    std::vector<double> myDoubles(datasize);
+
+    while (true)
+    {
+        adios2::StepStatus status = engine.BeginStep(StepMode::Read, 5);
+        if (status == adios2::StepStatus::OK)
+        {
+            size_t currentStep = engine.CurrentStep();
+            auto varInts = io.InquireVariable<int>("varInts");
+            auto varDoubles = io.InquireVariable<double>("varDoubles");
+            auto varStep = io.InquireVariable<uint64_t>("varStep");
+            varInts.SetSelection({start, count});
+            varDoubles.SetSelection({start, count});
+            uint64_t step;
+            engine.Get(varInts, myInts.data(), adios2::Mode::Sync);
+            engine.Get(varDoubles, myDoubles.data(), adios2::Mode::Sync);
+            engine.Get(varStep, &step, adios2::Mode::Sync);
+            ASSERT_EQ(step, currentStep);
+            VerifyData(myInts.data(), currentStep, start, count, shape,
+                       mpiRank);
+            VerifyData(myDoubles.data(), currentStep, start, count, shape,
+                       mpiRank);
+            engine.EndStep();
+        }
+        else if (status == adios2::StepStatus::EndOfStream)
+        {
+            break;
+        }
+    }
+    engine.Close();
+}
+
+// Writers own blocks of rows while each reader selects a strip of columns in
+// the interior rows, so every reader needs a strided part of each writer block
+TEST_F(SscEngineTest, TestSscSubarray)
+{
+    std::string filename = "TestSscSubarray";
+    adios2::Params engineParams = {};
+    int worldRank, worldSize;
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+    int writers = 2;
+    if (worldSize < 3)
+    {
+        return;
+    }
+    int mpiGroup = worldRank < writers ? 0 : 1;
+    MPI_Comm_split(MPI_COMM_WORLD, mpiGroup, worldRank, &mpiComm);
+    MPI_Comm_rank(mpiComm, &mpiRank);
+    MPI_Comm_size(mpiComm, &mpiSize);
+
+    size_t steps = 20;
+    size_t rows = 4;
+    size_t columns = 3;
+    size_t readers = static_cast<size_t>(worldSize - writers);
+    Dims shape = {rows * writers, columns * readers + 2, 5};
+
+    if (mpiGroup == 0)
+    {
+        Dims start = {rows * mpiRank, 0, 0};
+        Dims count = {rows, shape[1], shape[2]};
+        Writer(shape, start, count, steps, engineParams, filename);
+    }
+
+    if (mpiGroup == 1)
+    {
+        Dims start = {1, columns * mpiRank + 1, 1};
+        Dims count = {shape[0] - 2, columns, 3};
+        Reader(start, count, shape, engineParams, filename);
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    int worldRank, worldSize;
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return result;
+}
@@ -178,6 +178,17 @@ set (LatestReaderHold.1x1_CMD "run_test.py.$<CONFIG> --test_protocol one_client
 # A faster writer and a queue policy that will cause timesteps to be discarded
 set (DiscardWriter.1x1_CMD "run_test.py.$<CONFIG> --test_protocol one_client -nw 1 -nr 1 --warg=--engine_params --warg=QueueLimit=1,QueueFullPolicy=discard,WENGINE_PARAMS --warg=--ms_delay --warg=250 --rarg=--discard")
 
+# Queued timesteps beyond a 1 byte memory budget go to disk, none are lost
+set (SpillWriter.1x1_CMD "run_test.py.$<CONFIG> --test_protocol one_client -nw 1 -nr 1 --warg=--engine_params --warg=MarshalMethod=BP5,QueueFullPolicy=spill,SpillMemoryLimit=1,WENGINE_PARAMS --rarg=--long_first_delay")
+set (SpillWriter.2x3_CMD "run_test.py.$<CONFIG> -nw 2 -nr 3 --warg=MarshalMethod=BP5,QueueFullPolicy=spill,SpillMemoryLimit=1,WENGINE_PARAMS")
+
+# Every reader selects part of the fast dimension of r64_2d_rev in each writer
+# block, so BP5 readers ask the writer for just those elements.  The Fortran
+# variants have the reader and writer disagree on array order.
+set (SelectionPushdown.3x5_CMD "run_test.py.$<CONFIG> -nw 3 -nr 5 --warg=MarshalMethod=BP5,WENGINE_PARAMS --rarg=SelectionPushdown=true,RENGINE_PARAMS")
+set (SelectionPushdown.CtoF.3x5_CMD "run_test.py.$<CONFIG> -nw 3 -nr 5 -r $<TARGET_FILE:TestCommonRead_f> --warg=MarshalMethod=BP5,WENGINE_PARAMS --rarg=SelectionPushdown=true,RENGINE_PARAMS")
+set (SelectionPushdown.FtoC.3x5_CMD "run_test.py.$<CONFIG> -nw 3 -nr 5 -w $<TARGET_FILE:TestCommonWrite_f> --warg=MarshalMethod=BP5,WENGINE_PARAMS --rarg=SelectionPushdown=true,RENGINE_PARAMS")
+
 # Readers using Advancing attributes
 set (CumulativeAttr.1x1_CMD "run_test.py.$<CONFIG> -nw 1 -nr 1 --warg=--advancing_attributes --rarg=--advancing_attributes")
 
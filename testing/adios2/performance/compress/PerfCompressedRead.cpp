@@ -0,0 +1,119 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PerfCompressedRead.cpp : time reading an operator-compressed BP5 array
+ * with an increasing number of reader threads
+ *
+ * Usage: PerfCompressedRead [operator [blocks [block size [max threads]]]]
+ *        defaults: bzip2 64 1048576 (doubles per block) 16
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+namespace
+{
+
+const std::string FileName = "PerfCompressedRead.bp";
+
+void Write(adios2::ADIOS &adios, const std::string &op, const size_t nBlocks,
+           const size_t blockSize)
+{
+    adios2::IO io = adios.DeclareIO("Write");
+    io.SetEngine("BP5");
+    auto var = io.DefineVariable<double>("data", {nBlocks * blockSize}, {0},
+                                         {blockSize});
+    adios2::Params opParams;
+    if (op == "zfp" || op == "sz" || op == "mgard")
+    {
+        opParams["accuracy"] = "0.0001";
+    }
+    var.AddOperation(op, opParams);
+
+    std::vector<double> data(blockSize);
+    adios2::Engine writer = io.Open(FileName, adios2::Mode::Write);
+    writer.BeginStep();
+    for (size_t b = 0; b < nBlocks; ++b)
+    {
+        for (size_t i = 0; i < blockSize; ++i)
+        {
+            data[i] = std::sin(static_cast<double>(b * blockSize + i) / 1000.);
+        }
+        var.SetSelection({{b * blockSize}, {blockSize}});
+        writer.Put(var, data.data(), adios2::Mode::Sync);
+    }
+    writer.EndStep();
+    writer.Close();
+}
+
+double Read(adios2::ADIOS &adios, const unsigned int threads)
+{
+    adios2::IO io = adios.DeclareIO("Read" + std::to_string(threads));
+    io.SetEngine("BP5");
+    io.SetParameter("Threads", std::to_string(threads));
+    adios2::Engine reader = io.Open(FileName, adios2::Mode::Read);
+    reader.BeginStep();
+    auto var = io.InquireVariable<double>("data");
+    std::vector<double> data(var.Shape()[0]);
+
+    const auto start = std::chrono::steady_clock::now();
+    reader.Get(var, data.data());
+    reader.PerformGets();
+    const auto end = std::chrono::steady_clock::now();
+
+    reader.EndStep();
+    reader.Close();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const std::string op = argc > 1 ? argv[1] : "bzip2";
+    const size_t nBlocks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+    const size_t blockSize =
+        argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1048576;
+    const unsigned int maxThreads =
+        argc > 4 ? static_cast<unsigned int>(std::atoi(argv[4])) : 16;
+
+    adios2::ADIOS adios;
+    try
+    {
+        Write(adios, op, nBlocks, blockSize);
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "Cannot write with operator " << op << ": " << e.what()
+                  << std::endl;
+        return 1;
+    }
+
+    const double mb = static_cast<double>(nBlocks * blockSize *
+                                          sizeof(double)) /
+                      1048576.0;
+    std::cout << op << ": " << nBlocks << " blocks, " << mb << " MB"
+              << std::endl;
+    std::cout << "threads    seconds       MB/s   speedup" << std::endl;
+    double base = 0.0;
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        const double t = Read(adios, threads);
+        if (threads == 1)
+        {
+            base = t;
+        }
+        std::cout << std::setw(7) << threads << std::setw(11)
+                  << std::setprecision(4) << std::fixed << t << std::setw(11)
+                  << std::setprecision(1) << mb / t << std::setw(10)
+                  << std::setprecision(2) << base / t << std::endl;
+    }
+    return 0;
+}
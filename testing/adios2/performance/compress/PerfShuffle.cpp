@@ -0,0 +1,199 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PerfShuffle.cpp : compression ratio and write/read throughput of a lossless
+ * compressor with and without the shuffle operator in front of it, on a few
+ * synthetic float64/int64 datasets
+ *
+ * Usage: PerfShuffle [compressor [values]]
+ *        defaults: bzip2 4194304 (rounded up to 128 x 128 planes)
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+namespace
+{
+
+const std::string FileName = "PerfShuffle.bp";
+size_t IOCount = 0; // for unique IO names
+
+struct Config
+{
+    std::string name;
+    adios2::Params params; // empty: the compressor alone
+};
+
+/* a smooth 3D field, the same with noise in the last 20 mantissa bits,
+ * a slowly increasing counter and uniform random values */
+template <class T>
+std::vector<T> MakeDataset(const std::string &name, const size_t n)
+{
+    std::vector<T> data(n);
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const size_t nx = 128, ny = 128;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double x = static_cast<double>(i % nx) / nx;
+        const double y = static_cast<double>((i / nx) % ny) / ny;
+        const double z = static_cast<double>(i / (nx * ny)) / 64;
+        double v = 0.0;
+        if (name == "smooth" || name == "noisy")
+        {
+            v = std::sin(6.28 * x) * std::cos(3.14 * y) + z * z;
+            if (name == "noisy")
+            {
+                v *= 1.0 + 1e-10 * uniform(rng);
+            }
+        }
+        else if (name == "counter")
+        {
+            v = static_cast<double>(i / 7 + (i % 3));
+        }
+        else
+        {
+            v = uniform(rng);
+        }
+        data[i] = static_cast<T>(v);
+    }
+    return data;
+}
+
+size_t DirectorySize(const std::string &name)
+{
+    size_t size = 0;
+    for (const auto &file : {"/data.0", "/md.0"})
+    {
+        FILE *f = std::fopen((name + file).c_str(), "rb");
+        if (f)
+        {
+            std::fseek(f, 0, SEEK_END);
+            size += static_cast<size_t>(std::ftell(f));
+            std::fclose(f);
+        }
+    }
+    return size;
+}
+
+template <class T>
+void Run(adios2::ADIOS &adios, const std::string &compressor,
+         const std::vector<T> &data, const Config &config, size_t &size,
+         double &writeTime, double &readTime)
+{
+    const size_t n = data.size();
+    adios2::IO io = adios.DeclareIO("Write" + std::to_string(IOCount++));
+    io.SetEngine("BP5");
+    // nz x 128 x 128
+    const adios2::Dims count = {n / 16384, 128, 128};
+    auto var = io.DefineVariable<T>("data", count, {0, 0, 0}, count);
+    if (config.params.empty())
+    {
+        var.AddOperation(compressor, {});
+    }
+    else
+    {
+        adios2::Params params = config.params;
+        params[adios2::ops::shuffle::key::compressor] = compressor;
+        var.AddOperation(adios2::ops::LosslessShuffle, params);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    adios2::Engine writer = io.Open(FileName, adios2::Mode::Write);
+    writer.BeginStep();
+    writer.Put(var, data.data());
+    writer.EndStep();
+    writer.Close();
+    writeTime = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    size = DirectorySize(FileName);
+
+    adios2::IO rio = adios.DeclareIO("Read" + std::to_string(IOCount++));
+    rio.SetEngine("BP5");
+    std::vector<T> in(n);
+    start = std::chrono::steady_clock::now();
+    adios2::Engine reader = rio.Open(FileName, adios2::Mode::Read);
+    reader.BeginStep();
+    auto rvar = rio.InquireVariable<T>("data");
+    reader.Get(rvar, in.data());
+    reader.EndStep();
+    reader.Close();
+    readTime = std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+    if (in != data)
+    {
+        std::cerr << "data mismatch with " << config.name << std::endl;
+        std::exit(1);
+    }
+}
+
+template <class T>
+void Report(adios2::ADIOS &adios, const std::string &compressor,
+            const std::string &dataset, const std::vector<Config> &configs,
+            const size_t n)
+{
+    const auto data = MakeDataset<T>(dataset, n);
+    const double mb = static_cast<double>(n * sizeof(T)) / 1048576.0;
+    for (const auto &config : configs)
+    {
+        size_t size;
+        double writeTime, readTime;
+        Run(adios, compressor, data, config, size, writeTime, readTime);
+        std::cout << std::setw(10) << dataset << std::setw(16) << config.name
+                  << std::setw(9) << std::setprecision(2) << std::fixed
+                  << static_cast<double>(n * sizeof(T)) / size
+                  << std::setw(11) << std::setprecision(1) << mb / writeTime
+                  << std::setw(11) << mb / readTime << std::endl;
+    }
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const std::string compressor = argc > 1 ? argv[1] : "bzip2";
+    size_t n = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4194304;
+    n = (n + 16383) / 16384 * 16384; // whole 128 x 128 planes
+
+    namespace key = adios2::ops::shuffle::key;
+    namespace value = adios2::ops::shuffle::value;
+    const std::vector<Config> configs = {
+        {compressor, {}},
+        {"shuffle", {{key::predictor, value::predictor_none}}},
+        {"xor+shuffle", {{key::predictor, value::predictor_xor}}},
+        {"delta+shuffle", {{key::predictor, value::predictor_delta}}},
+        {"xor(y)+shuffle",
+         {{key::predictor, value::predictor_xor}, {key::dimension, "1"}}},
+    };
+
+    adios2::ADIOS adios;
+    std::cout << "   dataset          config    ratio  write MB/s  read MB/s"
+              << std::endl;
+    try
+    {
+        for (const auto &dataset : {"smooth", "noisy", "random"})
+        {
+            Report<double>(adios, compressor, dataset, configs, n);
+        }
+        Report<int64_t>(adios, compressor, "counter", configs, n);
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "Cannot compress with " << compressor << ": " << e.what()
+                  << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PerfZfpThreads.cpp : compression ratio and write/read throughput of one
+ * large 3D block compressed with zfp for an increasing number of operator
+ * threads, with zfp's default backend (OpenMP when available) and with the
+ * serial backend (independently compressed slabs)
+ *
+ * Usage: PerfZfpThreads [nz [max threads [accuracy]]]
+ *        defaults: 256 (x 256 x 256 doubles) 16 0.0001
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+namespace
+{
+
+const std::string FileName = "PerfZfpThreads.bp";
+const size_t Ny = 256;
+const size_t Nx = 256;
+size_t IOCount = 0; // for unique IO names
+
+size_t DirectorySize(const std::string &name)
+{
+    size_t size = 0;
+    for (const auto &file : {"/data.0", "/md.0"})
+    {
+        FILE *f = std::fopen((name + file).c_str(), "rb");
+        if (f)
+        {
+            std::fseek(f, 0, SEEK_END);
+            size += static_cast<size_t>(std::ftell(f));
+            std::fclose(f);
+        }
+    }
+    return size;
+}
+
+void Run(adios2::ADIOS &adios, const std::vector<double> &data,
+         const adios2::Params &params, const double accuracy, size_t &size,
+         double &writeTime, double &readTime)
+{
+    const adios2::Dims count = {data.size() / (Ny * Nx), Ny, Nx};
+    adios2::IO io = adios.DeclareIO("Write" + std::to_string(IOCount++));
+    io.SetEngine("BP5");
+    auto var = io.DefineVariable<double>("data", count, {0, 0, 0}, count);
+    var.AddOperation(adios2::ops::LossyZFP, params);
+
+    auto start = std::chrono::steady_clock::now();
+    adios2::Engine writer = io.Open(FileName, adios2::Mode::Write);
+    writer.BeginStep();
+    writer.Put(var, data.data());
+    writer.EndStep();
+    writer.Close();
+    writeTime = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    size = DirectorySize(FileName);
+
+    adios2::IO rio = adios.DeclareIO("Read" + std::to_string(IOCount++));
+    rio.SetEngine("BP5");
+    std::vector<double> in(data.size());
+    start = std::chrono::steady_clock::now();
+    adios2::Engine reader = rio.Open(FileName, adios2::Mode::Read);
+    reader.BeginStep();
+    auto rvar = rio.InquireVariable<double>("data");
+    reader.Get(rvar, in.data());
+    reader.EndStep();
+    reader.Close();
+    readTime = std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        if (std::fabs(in[i] - data[i]) > accuracy)
+        {
+            std::cerr << "error above accuracy at " << i << std::endl;
+            std::exit(1);
+        }
+    }
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const size_t nz = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+    const size_t maxThreads =
+        argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+    const std::string accuracy = argc > 3 ? argv[3] : "0.0001";
+
+    std::vector<double> data(nz * Ny * Nx);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        const double x = static_cast<double>(i % Nx) / Nx;
+        const double y = static_cast<double>((i / Nx) % Ny) / Ny;
+        const double z = static_cast<double>(i / (Nx * Ny)) / nz;
+        data[i] = std::sin(6.28 * x) * std::cos(3.14 * y) + z * z;
+    }
+    const double mb = static_cast<double>(data.size() * sizeof(double)) /
+                      1048576.0;
+
+    namespace key = adios2::ops::zfp::key;
+    adios2::ADIOS adios;
+    std::cout << "  backend  threads    ratio  write MB/s  read MB/s"
+              << std::endl;
+    try
+    {
+        for (const std::string backend : {"default", "serial"})
+        {
+            for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+            {
+                adios2::Params params = {{key::accuracy, accuracy},
+                                         {key::threads,
+                                          std::to_string(threads)}};
+                if (backend != "default")
+                {
+                    params[key::backend] = backend;
+                }
+                size_t size;
+                double writeTime, readTime;
+                Run(adios, data, params, std::stod(accuracy), size, writeTime,
+                    readTime);
+                std::cout << std::setw(9) << backend << std::setw(9)
+                          << threads << std::setw(9) << std::setprecision(2)
+                          << std::fixed
+                          << static_cast<double>(data.size() *
+                                                 sizeof(double)) /
+                                 size
+                          << std::setw(12) << std::setprecision(1)
+                          << mb / writeTime << std::setw(11) << mb / readTime
+                          << std::endl;
+            }
+        }
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "Cannot compress with zfp: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
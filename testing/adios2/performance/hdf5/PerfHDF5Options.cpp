@@ -0,0 +1,180 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PerfHDF5Options.cpp : write and read time of many small 1D variables over
+ * several steps with the HDF5 engine and its file access and dataset creation
+ * options, with BP5 on the same workload as reference
+ *
+ * Usage: PerfHDF5Options [variables [elements [steps]]]
+ *        defaults: 1000 (variables of) 64 (doubles) 10 (steps)
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+namespace
+{
+
+size_t IOCount = 0; // for unique IO names
+
+/* one HDF5 file or the files of a BP5 directory */
+size_t FileSize(const std::string &name, const bool isDirectory)
+{
+    std::vector<std::string> files = {""};
+    if (isDirectory)
+    {
+        files = {"/data.0", "/md.0", "/mmd.0", "/md.idx"};
+    }
+    size_t size = 0;
+    for (const auto &file : files)
+    {
+        FILE *f = std::fopen((name + file).c_str(), "rb");
+        if (f)
+        {
+            std::fseek(f, 0, SEEK_END);
+            const long end = std::ftell(f);
+            size += end > 0 ? static_cast<size_t>(end) : 0;
+            std::fclose(f);
+        }
+    }
+    return size;
+}
+
+void Run(adios2::ADIOS &adios, const std::string &engine,
+         const adios2::Params &params, const std::string &fileName,
+         const size_t nVars, const size_t nElems, const size_t nSteps,
+         size_t &size, double &writeTime, double &readTime)
+{
+    adios2::IO io = adios.DeclareIO("Write" + std::to_string(IOCount++));
+    io.SetEngine(engine);
+    io.SetParameters(params);
+    std::vector<adios2::Variable<double>> vars;
+    for (size_t v = 0; v < nVars; ++v)
+    {
+        vars.push_back(io.DefineVariable<double>(
+            "var" + std::to_string(v), {nElems}, {0}, {nElems}));
+    }
+
+    std::vector<double> data(nElems);
+    auto start = std::chrono::steady_clock::now();
+    adios2::Engine writer = io.Open(fileName, adios2::Mode::Write);
+    for (size_t step = 0; step < nSteps; ++step)
+    {
+        writer.BeginStep();
+        for (size_t v = 0; v < nVars; ++v)
+        {
+            for (size_t i = 0; i < nElems; ++i)
+            {
+                data[i] = static_cast<double>(step * nVars + v) + 0.001 * i;
+            }
+            writer.Put(vars[v], data.data(), adios2::Mode::Sync);
+        }
+        writer.EndStep();
+    }
+    writer.Close();
+    writeTime = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    size = FileSize(fileName, engine == "BP5");
+
+    adios2::IO rio = adios.DeclareIO("Read" + std::to_string(IOCount++));
+    rio.SetEngine(engine);
+    rio.SetParameters(params);
+    std::vector<std::vector<double>> in(nVars);
+    start = std::chrono::steady_clock::now();
+    adios2::Engine reader = rio.Open(fileName, adios2::Mode::Read);
+    for (size_t step = 0; step < nSteps; ++step)
+    {
+        reader.BeginStep();
+        for (size_t v = 0; v < nVars; ++v)
+        {
+            auto var = rio.InquireVariable<double>("var" + std::to_string(v));
+            reader.Get(var, in[v]);
+        }
+        reader.EndStep();
+        for (size_t v = 0; v < nVars; ++v)
+        {
+            if (in[v].size() != nElems ||
+                in[v].back() != static_cast<double>(step * nVars + v) +
+                                    0.001 * (nElems - 1))
+            {
+                std::cerr << "wrong data in " << engine << " step " << step
+                          << " var" << v << std::endl;
+                std::exit(1);
+            }
+        }
+    }
+    reader.Close();
+    readTime = std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const size_t nVars =
+        argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+    const size_t nElems = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+    const size_t nSteps = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 10;
+
+    struct Case
+    {
+        std::string label;
+        std::string engine;
+        adios2::Params params;
+    };
+    const std::vector<Case> cases = {
+        {"BP5", "BP5", {}},
+        {"HDF5 default", "HDF5", {}},
+        {"alignment 4kb", "HDF5", {{"H5Alignment", "4kb"}}},
+        {"metadata cache 32mb", "HDF5", {{"H5MetadataCacheSize", "32mb"}}},
+        {"paged 64kb, buffer 4mb",
+         "HDF5",
+         {{"H5PageSize", "64kb"}, {"H5PageBufferSize", "4mb"}}},
+        {"chunk auto", "HDF5", {{"H5ChunkDim", "auto"}}},
+        {"contiguous", "HDF5", {{"H5Layout", "contiguous"}}},
+        {"compact", "HDF5", {{"H5Layout", "compact"}}},
+        {"compact, cache 32mb",
+         "HDF5",
+         {{"H5Layout", "compact"}, {"H5MetadataCacheSize", "32mb"}}}};
+
+    const double mb = static_cast<double>(nVars * nElems * nSteps *
+                                          sizeof(double)) /
+                      1048576.0;
+    adios2::ADIOS adios;
+    std::cout << "                   options   size MB  write MB/s  read MB/s"
+              << std::endl;
+    try
+    {
+        for (const auto &c : cases)
+        {
+            const std::string fileName =
+                c.engine == "BP5" ? "PerfHDF5Options.bp" : "PerfHDF5Options.h5";
+            size_t size;
+            double writeTime, readTime;
+            Run(adios, c.engine, c.params, fileName, nVars, nElems, nSteps,
+                size, writeTime, readTime);
+            std::cout << std::setw(26) << c.label << std::setw(10)
+                      << std::setprecision(2) << std::fixed
+                      << static_cast<double>(size) / 1048576.0
+                      << std::setw(12) << std::setprecision(1)
+                      << mb / writeTime << std::setw(11) << mb / readTime
+                      << std::endl;
+        }
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "Cannot run the benchmark: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -97,6 +97,9 @@ static void Usage()
     std::cout << "  --warpx   (Approx WarpX characteristics)" << std::endl;
     std::cout << "  --engine <enginename>" << std::endl;
     std::cout << "  --engine_params <param=value,param=value>" << std::endl;
+    std::cout << "      (e.g. --engine BP4 --engine_params MetadataFanIn=16"
+              << std::endl;
+    std::cout << "       to merge BP4 metadata through a tree)" << std::endl;
     std::cout << "  --file  (run in file mode)" << std::endl;
 }
 
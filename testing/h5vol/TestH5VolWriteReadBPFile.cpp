@@ -3,6 +3,7 @@
  * accompanying file Copyright.txt for details.
  */
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 
 #include <iostream>
@@ -1108,6 +1109,135 @@ TEST_F(H5VolWriteReadTest, H5VolWriteHDF5Read2D4x2)
     }
 }
 
+//******************************************************************************
+// Batched reads, ADIOS2_VOL_READ_BATCH
+//******************************************************************************
+
+// HDF5 API write, HDF5 API read of several datasets with one PerformGets
+TEST_F(H5VolWriteReadTest, H5VolBatchedRead)
+{
+    const std::string fname = "H5VolTestBatchedRead.bp";
+
+    int mpiRank = 0, mpiSize = 1;
+    const std::size_t Nx = 8;
+
+#ifdef TEST_HDF5_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const SmallTestData testData =
+        generateNewSmallTestData(m_TestData, 0, mpiRank, mpiSize);
+    {
+#ifdef TEST_HDF5_MPI
+        HDF5NativeWriter h5writer(fname, MPI_COMM_WORLD);
+#else
+        HDF5NativeWriter h5writer(fname);
+#endif
+        hsize_t global_dims[1] = {Nx * mpiSize};
+        hsize_t count[1] = {Nx};
+        hsize_t offset[1] = {Nx * mpiRank};
+        h5writer.CreateAndStoreVar("i32", 1, H5T_NATIVE_INT, global_dims,
+                                   offset, count, testData.I32.data());
+        h5writer.CreateAndStoreVar("u16", 1, H5T_NATIVE_USHORT, global_dims,
+                                   offset, count, testData.U16.data());
+        h5writer.CreateAndStoreVar("r64", 1, H5T_NATIVE_DOUBLE, global_dims,
+                                   offset, count, testData.R64.data());
+    }
+
+    // more than the reads of one round, they are performed at flush or close
+    setenv("ADIOS2_VOL_READ_BATCH", "16", 1);
+
+    hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+#ifdef TEST_HDF5_MPI
+    H5Pset_fapl_mpio(fapl, MPI_COMM_WORLD, MPI_INFO_NULL);
+#endif
+    H5VL_ADIOS2_set(fapl);
+    hid_t file = H5Fopen(fname.c_str(), H5F_ACC_RDONLY, fapl);
+    ASSERT_GE(file, 0);
+    hid_t group = H5Gopen(file, "/Step0", H5P_DEFAULT);
+    ASSERT_GE(group, 0);
+
+    hid_t dsetI32 = H5Dopen(group, "i32", H5P_DEFAULT);
+    hid_t dsetU16 = H5Dopen(group, "u16", H5P_DEFAULT);
+    hid_t dsetR64 = H5Dopen(group, "r64", H5P_DEFAULT);
+    ASSERT_GE(dsetI32, 0);
+    ASSERT_GE(dsetU16, 0);
+    ASSERT_GE(dsetR64, 0);
+
+    hsize_t count[1] = {Nx};
+    hsize_t offset[1] = {Nx * mpiRank};
+    hid_t spaceI32 = H5Dget_space(dsetI32);
+    hid_t spaceU16 = H5Dget_space(dsetU16);
+    hid_t spaceR64 = H5Dget_space(dsetR64);
+    H5Sselect_hyperslab(spaceI32, H5S_SELECT_SET, offset, NULL, count, NULL);
+    H5Sselect_hyperslab(spaceU16, H5S_SELECT_SET, offset, NULL, count, NULL);
+    H5Sselect_hyperslab(spaceR64, H5S_SELECT_SET, offset, NULL, count, NULL);
+    hid_t memspace = H5Screate_simple(1, count, NULL);
+
+    auto readAll = [&](std::array<int32_t, Nx> &I32,
+                       std::array<uint16_t, Nx> &U16,
+                       std::array<double, Nx> &R64) {
+        EXPECT_GE(H5Dread(dsetI32, H5T_NATIVE_INT, memspace, spaceI32,
+                          H5P_DEFAULT, I32.data()),
+                  0);
+        EXPECT_GE(H5Dread(dsetU16, H5T_NATIVE_USHORT, memspace, spaceU16,
+                          H5P_DEFAULT, U16.data()),
+                  0);
+        EXPECT_GE(H5Dread(dsetR64, H5T_NATIVE_DOUBLE, memspace, spaceR64,
+                          H5P_DEFAULT, R64.data()),
+                  0);
+    };
+    auto checkAll = [&](const std::array<int32_t, Nx> &I32,
+                        const std::array<uint16_t, Nx> &U16,
+                        const std::array<double, Nx> &R64) {
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            std::stringstream ss;
+            ss << "i=" << i << " rank=" << mpiRank;
+            std::string msg = ss.str();
+            EXPECT_EQ(I32[i], testData.I32[i]) << msg;
+            EXPECT_EQ(U16[i], testData.U16[i]) << msg;
+            EXPECT_EQ(R64[i], testData.R64[i]) << msg;
+        }
+    };
+
+    // the buffers are complete once the file is flushed
+    std::array<int32_t, Nx> I32;
+    std::array<uint16_t, Nx> U16;
+    std::array<double, Nx> R64;
+    I32.fill(-1);
+    U16.fill(0);
+    R64.fill(-1.0);
+    readAll(I32, U16, R64);
+    EXPECT_GE(H5Fflush(file, H5F_SCOPE_LOCAL), 0);
+    checkAll(I32, U16, R64);
+
+    // and once it is closed, with the datasets still open
+    std::array<int32_t, Nx> I32Close;
+    std::array<uint16_t, Nx> U16Close;
+    std::array<double, Nx> R64Close;
+    I32Close.fill(-1);
+    U16Close.fill(0);
+    R64Close.fill(-1.0);
+    readAll(I32Close, U16Close, R64Close);
+    H5Sclose(spaceI32);
+    H5Sclose(spaceU16);
+    H5Sclose(spaceR64);
+    H5Sclose(memspace);
+    H5Gclose(group);
+    EXPECT_GE(H5Fclose(file), 0);
+    checkAll(I32Close, U16Close, R64Close);
+
+    // the last dataset closed releases the file
+    EXPECT_GE(H5Dclose(dsetI32), 0);
+    EXPECT_GE(H5Dclose(dsetU16), 0);
+    EXPECT_GE(H5Dclose(dsetR64), 0);
+    H5Pclose(fapl);
+    H5VL_ADIOS2_unset();
+    unsetenv("ADIOS2_VOL_READ_BATCH");
+}
+
 //******************************************************************************
 // main
 //******************************************************************************